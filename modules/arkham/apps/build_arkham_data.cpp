@@ -74,14 +74,16 @@ std::vector<arkham::Encounter> getEncounters(const std::string& locationIn,
 
     // The html has embedded links that are not structured well. So I will
     // manually pull out the values I need.
-    std::string regex = "(<tr>\\n<td>(\\s|.)*?\n<\\/td>)";
-    const std::vector<std::string> text = core::regexMatches(xmlText, regex);
+    static const core::Regex ROW_REGEX("(<tr>\\n<td>(\\s|.)*?\n<\\/td>)");
+    static const core::Regex TEXT_REGEX("\\>(.*?)[\\<\\n]");
+    const std::vector<std::string> text =
+            core::regexMatches(xmlText, ROW_REGEX);
     std::vector<std::string> finalText;
 
     for (size_t ii = 0; ii < text.size(); ++ii)
     {
-        regex = "\\>(.*?)[\\<\\n]";
-        const std::vector<std::string> parts = core::regexMatches(text[ii], regex);
+        const std::vector<std::string> parts =
+                core::regexMatches(text[ii], TEXT_REGEX);
         std::string newText = "";
         for (const std::string& part : parts)
         {
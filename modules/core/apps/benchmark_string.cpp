@@ -0,0 +1,170 @@
+/*
+ * Copyright (c) 2018 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#include <iostream>
+#include <iomanip>
+#include <exception>
+#include <stdexcept>
+#include <chrono>
+#include <sstream>
+#include <vector>
+#include <nyra/core/String.h>
+
+using namespace nyra;
+
+namespace
+{
+//===========================================================================//
+template <typename FuncT>
+double benchmark(const std::string& name, size_t iterations, FuncT func)
+{
+    const auto start = std::chrono::steady_clock::now();
+    const double checksum = func(iterations);
+    const auto end = std::chrono::steady_clock::now();
+    const double ms =
+            std::chrono::duration<double, std::milli>(end - start).count();
+
+    // The checksum keeps the optimizer from throwing the work away.
+    std::cout << std::left << std::setw(24) << name
+              << std::right << std::setw(10) << std::fixed
+              << std::setprecision(2) << ms << " ms"
+              << "  (checksum " << checksum << ")\n";
+    return ms;
+}
+
+//===========================================================================//
+template <typename T>
+T streamToType(const std::string& string)
+{
+    // This is how toType used to convert every value.
+    std::stringstream stream(string);
+    T value;
+    stream >> value;
+    if (stream.fail())
+    {
+        throw std::runtime_error("Unable to covert string: " + string);
+    }
+    return value;
+}
+
+//===========================================================================//
+template <typename T, typename FuncT>
+double convert(const std::vector<std::string>& input,
+               size_t iterations,
+               FuncT func)
+{
+    double ret = 0.0;
+    for (size_t ii = 0; ii < iterations; ++ii)
+    {
+        for (const std::string& string : input)
+        {
+            ret += static_cast<double>(func(string));
+        }
+    }
+    return ret;
+}
+}
+
+//===========================================================================//
+int main(int argc, char** argv)
+{
+    try
+    {
+        const size_t iterations = argc > 1 ?
+                core::str::toType<size_t>(argv[1]) : 10000;
+
+        // Values shaped like the map, actor and Collada fields.
+        std::vector<std::string> ints;
+        std::vector<std::string> floats;
+        std::string line;
+        for (size_t ii = 0; ii < 64; ++ii)
+        {
+            ints.push_back(core::str::toString(ii * 37 + 5));
+            floats.push_back(core::str::toString(
+                    static_cast<float>(ii) * 0.731f - 12.5f));
+            line += floats.back() + " ";
+        }
+
+        benchmark("stringstream int", iterations,
+             [&](size_t count){ return convert<int>(ints, count,
+                     streamToType<int>); });
+        benchmark("toType int", iterations,
+             [&](size_t count){ return convert<int>(ints, count,
+                     [](const std::string& string)
+                     { return core::str::toType<int>(string); }); });
+        benchmark("stringstream float", iterations,
+             [&](size_t count){ return convert<float>(floats, count,
+                     streamToType<float>); });
+        benchmark("toType float", iterations,
+             [&](size_t count){ return convert<float>(floats, count,
+                     [](const std::string& string)
+                     { return core::str::toType<float>(string); }); });
+
+        benchmark("split strings", iterations, [&](size_t count)
+        {
+            double ret = 0.0;
+            for (size_t ii = 0; ii < count; ++ii)
+            {
+                ret += core::str::split(line, " ").size();
+            }
+            return ret;
+        });
+
+        benchmark("split tokens", iterations, [&](size_t count)
+        {
+            double ret = 0.0;
+            std::vector<core::str::Token> tokens;
+            for (size_t ii = 0; ii < count; ++ii)
+            {
+                core::str::split(line, " ", tokens);
+                ret += tokens.size();
+            }
+            return ret;
+        });
+
+        benchmark("forEachSplit toType", iterations, [&](size_t count)
+        {
+            double ret = 0.0;
+            for (size_t ii = 0; ii < count; ++ii)
+            {
+                core::str::forEachSplit(line, " ",
+                        [&ret](const core::str::Token& token)
+                {
+                    if (token.size)
+                    {
+                        ret += core::str::toType<float>(token);
+                    }
+                });
+            }
+            return ret;
+        });
+    }
+    catch (const std::exception& ex)
+    {
+        std::cout << "STD Exception: " << ex.what() << std::endl;
+    }
+    catch (...)
+    {
+        std::cout << "Unknown Exception: System Error!" << std::endl;
+    }
+
+    return 0;
+}
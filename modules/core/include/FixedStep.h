@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) 2018 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#ifndef __NYRA_CORE_FIXED_STEP_H__
+#define __NYRA_CORE_FIXED_STEP_H__
+
+#include <stddef.h>
+
+namespace nyra
+{
+namespace core
+{
+/*
+ *  \class FixedStep
+ *  \brief Turns variable frame times into a whole number of fixed size
+ *         simulation steps. Leftover time is carried into the next frame
+ *         and can be used to interpolate between the last two steps.
+ */
+class FixedStep
+{
+public:
+    /*
+     *  \func Constructor
+     *  \brief Sets up the step size.
+     *
+     *  \param rate The number of steps per second
+     *  \param maxSteps The most steps that will be run for a single
+     *         frame. Time past this is dropped so a long stall does not
+     *         turn into a long catch up.
+     */
+    FixedStep(double rate,
+              size_t maxSteps);
+
+    /*
+     *  \func Functor
+     *  \brief Adds frame time and gets the number of steps to run.
+     *
+     *  \param delta The time in seconds since the last frame
+     *  \return The number of steps to run this frame
+     */
+    size_t operator()(double delta);
+
+    /*
+     *  \func getStep
+     *  \brief Gets the time of a single step.
+     *
+     *  \return The step time in seconds
+     */
+    double getStep() const
+    {
+        return mStep;
+    }
+
+    /*
+     *  \func getAlpha
+     *  \brief Gets how far the leftover time is into the next step.
+     *
+     *  \return A value from 0.0 to 1.0
+     */
+    double getAlpha() const
+    {
+        return mAccumulator / mStep;
+    }
+
+private:
+    const double mStep;
+    const size_t mMaxSteps;
+    double mAccumulator;
+};
+}
+}
+
+#endif
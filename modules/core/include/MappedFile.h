@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) 2018 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#ifndef __NYRA_CORE_MAPPED_FILE_H__
+#define __NYRA_CORE_MAPPED_FILE_H__
+
+#include <string>
+#include <memory>
+#include <stdint.h>
+
+namespace boost
+{
+namespace interprocess
+{
+class file_mapping;
+class mapped_region;
+}
+}
+
+namespace nyra
+{
+namespace core
+{
+/*
+ *  \class MappedFile
+ *  \brief Maps a file read only into memory. The contents are paged in by
+ *         the OS as they are accessed, so opening a large file is cheap.
+ */
+class MappedFile
+{
+public:
+    /*
+     *  \func Constructor
+     *  \brief Maps a file into memory.
+     *
+     *  \param pathname The full pathname of the file.
+     *  \throw If the file cannot be opened.
+     */
+    MappedFile(const std::string& pathname);
+
+    /*
+     *  \func Destructor
+     *  \brief Unmaps the file.
+     */
+    ~MappedFile();
+
+    /*
+     *  \func getData
+     *  \brief Gets the start of the mapped bytes. This is nullptr for an
+     *         empty file.
+     *
+     *  \return The mapped bytes.
+     */
+    const uint8_t* getData() const
+    {
+        return mData;
+    }
+
+    /*
+     *  \func getSize
+     *  \brief Gets the size of the file in bytes.
+     *
+     *  \return The size in bytes.
+     */
+    size_t getSize() const
+    {
+        return mSize;
+    }
+
+    /*
+     *  \func getPathname
+     *  \brief Gets the pathname that was mapped.
+     *
+     *  \return The pathname
+     */
+    const std::string& getPathname() const
+    {
+        return mPathname;
+    }
+
+private:
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    const std::string mPathname;
+    std::unique_ptr<boost::interprocess::file_mapping> mFile;
+    std::unique_ptr<boost::interprocess::mapped_region> mRegion;
+    const uint8_t* mData;
+    size_t mSize;
+};
+}
+}
+
+#endif
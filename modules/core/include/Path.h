@@ -22,6 +22,7 @@
 #ifndef __NYRA_CORE_PATH_H__
 #define __NYRA_CORE_PATH_H__
 
+#include <ctime>
 #include <string>
 #include <vector>
 
@@ -132,6 +133,16 @@ std::string getDirectory(const std::string& pathname);
  */
 std::string getFilename(const std::string& pathname);
 
+/*
+ *  \func getModifiedTime
+ *  \brief Gets the last time a file was written.
+ *
+ *  \param pathname The pathname of the file
+ *  \return The time in seconds since the epoch
+ *  \throw If the file does not exist.
+ */
+std::time_t getModifiedTime(const std::string& pathname);
+
 /*
  *  \func makeDirectory
  *  \brief Creates a directory recursively.
@@ -0,0 +1,163 @@
+/*
+ * Copyright (c) 2018 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#ifndef __NYRA_CORE_PROFILER_H__
+#define __NYRA_CORE_PROFILER_H__
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+namespace nyra
+{
+namespace core
+{
+/*
+ *  \class ProfileSample
+ *  \brief A single timed scope. Times are in nanoseconds since the
+ *         profiler started.
+ */
+struct ProfileSample
+{
+    const char* name;
+    uint64_t start;
+    uint64_t end;
+    size_t thread;
+};
+
+/*
+ *  \class Profiler
+ *  \brief Collects timed scopes from every thread. Each thread writes into
+ *         its own fixed size ring buffer without taking a lock, so only the
+ *         most recent samples from each thread are kept. Use
+ *         NYRA_PROFILE_SCOPE rather than calling this directly so the
+ *         timing compiles away when NYRA_PROFILE is not defined.
+ */
+class Profiler
+{
+public:
+    /*
+     *  \var BUFFER_SIZE
+     *  \brief The number of samples kept per thread.
+     */
+    static const size_t BUFFER_SIZE;
+
+    /*
+     *  \func now
+     *  \brief Gets the current profiler time.
+     *
+     *  \return The number of nanoseconds since the profiler started.
+     */
+    static uint64_t now();
+
+    /*
+     *  \func record
+     *  \brief Adds a sample to the calling thread's buffer.
+     *
+     *  \param name The name of the scope. This must be a string literal or
+     *         otherwise outlive the profiler.
+     *  \param start The start time from now()
+     *  \param end The end time from now()
+     */
+    static void record(const char* name,
+                       uint64_t start,
+                       uint64_t end);
+
+    /*
+     *  \func getSamples
+     *  \brief Gets every sample still in the buffers. Threads can keep
+     *         recording while this runs.
+     *
+     *  \param since Only samples that ended after this time are returned.
+     *  \return The samples sorted by start time.
+     */
+    static std::vector<ProfileSample> getSamples(uint64_t since = 0);
+
+    /*
+     *  \func writeChromeTrace
+     *  \brief Writes the samples in the Chrome trace event format. Open
+     *         the file with chrome://tracing.
+     *
+     *  \param pathname The file to write
+     */
+    static void writeChromeTrace(const std::string& pathname);
+
+    /*
+     *  \func clear
+     *  \brief Throws away all of the samples.
+     */
+    static void clear();
+};
+
+/*
+ *  \class ProfileScope
+ *  \brief Records the time between construction and destruction.
+ */
+class ProfileScope
+{
+public:
+    /*
+     *  \func Constructor
+     *  \brief Starts the timer.
+     *
+     *  \param name The name of the scope. This must be a string literal.
+     */
+    ProfileScope(const char* name) :
+        mName(name),
+        mStart(Profiler::now())
+    {
+    }
+
+    /*
+     *  \func Destructor
+     *  \brief Records the sample.
+     */
+    ~ProfileScope()
+    {
+        Profiler::record(mName, mStart, Profiler::now());
+    }
+
+private:
+    const char* const mName;
+    const uint64_t mStart;
+};
+}
+}
+
+#define NYRA_PROFILE_CONCAT_IMPL(a, b) a##b
+#define NYRA_PROFILE_CONCAT(a, b) NYRA_PROFILE_CONCAT_IMPL(a, b)
+
+/*
+ *  \func NYRA_PROFILE_SCOPE
+ *  \brief Times the rest of the enclosing scope. This does nothing unless
+ *         NYRA_PROFILE is defined.
+ *
+ *  \param name A string literal naming the scope
+ */
+#ifdef NYRA_PROFILE
+#define NYRA_PROFILE_SCOPE(name) \
+    nyra::core::ProfileScope NYRA_PROFILE_CONCAT( \
+            nyraProfileScope, __LINE__)(name)
+#else
+#define NYRA_PROFILE_SCOPE(name)
+#endif
+
+#endif
@@ -25,22 +25,223 @@
 #include <string>
 #include <vector>
 #include <regex>
+#include <memory>
+#include <cstddef>
+#include <iterator>
+#include <nyra/core/String.h>
+#include <nyra/core/RegexDFA.h>
 
 namespace nyra
 {
 namespace core
 {
+/*
+ *  \class Regex
+ *  \brief A compiled ECMAScript pattern. Searches run through RegexDFA
+ *         when the pattern allows it and std::regex otherwise. Either way
+ *         std::regex fills in the sub matches, but with the DFA it only
+ *         looks at the text that matched.
+ */
+class Regex
+{
+public:
+    /*
+     *  \func Constructor
+     *  \brief Compiles a pattern.
+     *
+     *  \param pattern The ECMAScript pattern
+     *  \param useDFA Set to false to always search with std::regex.
+     *  \throw std::regex_error if the pattern is invalid.
+     */
+    explicit Regex(const std::string& pattern, bool useDFA = true);
+
+    /*
+     *  \func search
+     *  \brief Finds the first match in a range. With the DFA only the
+     *         sub matches are filled in, the prefix and suffix are not.
+     *
+     *  \param begin The start of the input
+     *  \param end One past the end of the input
+     *  \param match The match results
+     *  \param flags Any flags besides match_prev_avail skip the DFA.
+     *  \return True if a match was found.
+     */
+    bool search(const char* begin,
+                const char* end,
+                std::cmatch& match,
+                std::regex_constants::match_flag_type flags =
+                        std::regex_constants::match_default) const;
+
+    /*
+     *  \func getPattern
+     *  \brief Gets the pattern that was compiled.
+     *
+     *  \return The pattern
+     */
+    const std::string& getPattern() const
+    {
+        return mPattern;
+    }
+
+    /*
+     *  \func getRegex
+     *  \brief Gets the std::regex version of the pattern.
+     *
+     *  \return The regex
+     */
+    const std::regex& getRegex() const
+    {
+        return mRegex;
+    }
+
+    /*
+     *  \func hasDFA
+     *  \brief Checks if searches use the DFA.
+     *
+     *  \return True if the DFA is used.
+     */
+    bool hasDFA() const
+    {
+        return mDFA.get() != nullptr;
+    }
+
+private:
+    Regex(const Regex&) = delete;
+    Regex& operator=(const Regex&) = delete;
+
+    const std::string mPattern;
+    const std::regex mRegex;
+    std::unique_ptr<const RegexDFA> mDFA;
+};
+
+/*
+ *  \class RegexIterator
+ *  \brief Steps through every match in a string without copying it. This
+ *         follows the same rules as std::regex_iterator for empty matches.
+ *         A default constructed iterator is the end.
+ */
+class RegexIterator
+{
+public:
+    typedef std::forward_iterator_tag iterator_category;
+    typedef std::cmatch value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef const std::cmatch* pointer;
+    typedef const std::cmatch& reference;
+
+    /*
+     *  \func Constructor
+     *  \brief Creates an end iterator.
+     */
+    RegexIterator();
+
+    /*
+     *  \func Constructor
+     *  \brief Finds the first match. The input and regex must outlive the
+     *         iterator.
+     *
+     *  \param input The string to search
+     *  \param regex The pattern to match
+     */
+    RegexIterator(const str::Token& input, const Regex& regex);
+
+    /*
+     *  \func Dereference Operator
+     *  \brief Gets the current match.
+     *
+     *  \return The match
+     */
+    const std::cmatch& operator*() const
+    {
+        return mMatch;
+    }
+
+    /*
+     *  \func Arrow Operator
+     *  \brief Gets the current match.
+     *
+     *  \return The match
+     */
+    const std::cmatch* operator->() const
+    {
+        return &mMatch;
+    }
+
+    /*
+     *  \func Increment Operator
+     *  \brief Moves to the next match.
+     *
+     *  \return The iterator
+     */
+    RegexIterator& operator++();
+
+    /*
+     *  \func Equality Operator
+     *  \brief Checks if two iterators are at the same match.
+     *
+     *  \param other The iterator to compare
+     *  \return True if they are the same.
+     */
+    bool operator==(const RegexIterator& other) const;
+
+    /*
+     *  \func Inequality Operator
+     *  \brief Checks if two iterators are at different matches.
+     *
+     *  \param other The iterator to compare
+     *  \return True if they are different.
+     */
+    bool operator!=(const RegexIterator& other) const
+    {
+        return !(*this == other);
+    }
+
+private:
+    void search(const char* pos,
+                std::regex_constants::match_flag_type flags);
+
+    const char* mBegin;
+    const char* mEnd;
+    const Regex* mRegex;
+    std::cmatch mMatch;
+};
+
+/*
+ *  \func compileRegex
+ *  \brief Gets a compiled pattern from a cache shared by every thread.
+ *         Each pattern is only compiled once and is kept for the life of
+ *         the program.
+ *
+ *  \param pattern The ECMAScript pattern
+ *  \return The compiled pattern
+ *  \throw std::regex_error if the pattern is invalid.
+ */
+const Regex& compileRegex(const std::string& pattern);
+
 /*
  *  \func regexMatches
  *  \brief Gets all regex matches.
  *
- *  \input The string to check against. This is purposely non-const
- *         as it modifies the string under the hood.
+ *  \input The string to check against.
  *  \regex The pattern to match
- *  \return All matches.
+ *  \return The sub matches of every match.
  */
-std::vector<std::string> regexMatches(std::string input,
-                                      const std::regex& regex);
+std::vector<std::string> regexMatches(const str::Token& input,
+                                      const Regex& regex);
+
+/*
+ *  \func regexMatches
+ *  \brief Gets all regex matches.
+ *
+ *  \input The string to check against.
+ *  \regex The pattern to match
+ *  \return The sub matches of every match.
+ */
+inline std::vector<std::string> regexMatches(const std::string& input,
+                                             const Regex& regex)
+{
+    return regexMatches(str::Token(input.data(), input.size()), regex);
+}
 
 /*
  *  \func regexMatches
@@ -48,12 +249,24 @@ std::vector<std::string> regexMatches(std::string input,
  *
  *  \input The string to check against.
  *  \regex The pattern to match
- *  \return All matches.
+ *  \return The sub matches of every match.
+ */
+std::vector<std::string> regexMatches(const std::string& input,
+                                      const std::regex& regex);
+
+/*
+ *  \func regexMatches
+ *  \brief Gets all regex matches. The pattern is compiled through
+ *         compileRegex so repeated calls are cheap.
+ *
+ *  \input The string to check against.
+ *  \regex The pattern to match
+ *  \return The sub matches of every match.
  */
 inline std::vector<std::string> regexMatches(const std::string& input,
                                              const std::string& regex)
 {
-    return regexMatches(input, std::regex(regex));
+    return regexMatches(input, compileRegex(regex));
 }
 }
 }
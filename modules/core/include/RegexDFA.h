@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2018 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#ifndef __NYRA_CORE_REGEX_DFA_H__
+#define __NYRA_CORE_REGEX_DFA_H__
+
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+namespace nyra
+{
+namespace core
+{
+/*
+ *  \class RegexDFA
+ *  \brief Finds regex matches with precompiled state tables, so searching
+ *         is linear in the input. Only a subset of ECMAScript is handled:
+ *         literals, escapes, character classes, groups, alternation and
+ *         greedy or lazy quantifiers. Matches are leftmost first like
+ *         std::regex. Captures are not tracked, only the match bounds.
+ */
+class RegexDFA
+{
+public:
+    /*
+     *  \var MAX_STATES
+     *  \brief The largest table built before the pattern is rejected.
+     */
+    static const size_t MAX_STATES;
+
+    /*
+     *  \func Constructor
+     *  \brief Compiles a pattern into state tables.
+     *
+     *  \param pattern The ECMAScript pattern
+     *  \throw If the pattern uses a feature that is not supported, can
+     *         match an empty string or needs too many states.
+     */
+    RegexDFA(const std::string& pattern);
+
+    /*
+     *  \func search
+     *  \brief Finds the first match in a range.
+     *
+     *  \param begin The start of the input
+     *  \param end One past the end of the input
+     *  \param matchBegin Set to the start of the match
+     *  \param matchEnd Set to one past the end of the match
+     *  \return True if a match was found.
+     */
+    bool search(const char* begin,
+                const char* end,
+                const char*& matchBegin,
+                const char*& matchEnd) const;
+
+    /*
+     *  \func getNumStates
+     *  \brief Gets the number of states in the forward and reverse tables.
+     *
+     *  \return The number of states
+     */
+    size_t getNumStates() const
+    {
+        return mForward.matched.size() + mReverse.matched.size();
+    }
+
+private:
+    struct Table
+    {
+        std::vector<int32_t> next;
+        std::vector<uint8_t> matched;
+    };
+
+    uint8_t mClasses[256];
+    size_t mNumClasses;
+    Table mForward;
+    Table mReverse;
+};
+}
+}
+
+#endif
@@ -22,6 +22,7 @@
 #ifndef __NYRA_CORE_STRING_H__
 #define __NYRA_CORE_STRING_H__
 
+#include <cstring>
 #include <string>
 #include <vector>
 
@@ -31,6 +32,76 @@ namespace core
 {
 namespace str
 {
+/*
+ *  \class Token
+ *  \brief A piece of a larger string. Tokens do not own their characters
+ *         so they are only valid as long as the string they came from.
+ */
+struct Token
+{
+    /*
+     *  \func Constructor
+     *  \brief Creates an empty token.
+     */
+    Token() :
+        data(nullptr),
+        size(0)
+    {
+    }
+
+    /*
+     *  \func Constructor
+     *  \brief Creates a token over existing characters.
+     *
+     *  \param begin The first character
+     *  \param length The number of characters
+     */
+    Token(const char* begin, size_t length) :
+        data(begin),
+        size(length)
+    {
+    }
+
+    /*
+     *  \func str
+     *  \brief Copies the characters into a string.
+     *
+     *  \return The string
+     */
+    std::string str() const
+    {
+        return std::string(data, size);
+    }
+
+    /*
+     *  \func Equality Operator
+     *  \brief Compares against a string without copying.
+     *
+     *  \param other The string to compare
+     *  \return true if the characters match.
+     */
+    bool operator==(const std::string& other) const
+    {
+        return other.size() == size &&
+                std::memcmp(other.data(), data, size) == 0;
+    }
+
+    /*
+     *  \func Inequality Operator
+     *  \brief Compares against a string without copying.
+     *
+     *  \param other The string to compare
+     *  \return true if the characters differ.
+     */
+    bool operator!=(const std::string& other) const
+    {
+        return !(*this == other);
+    }
+
+    const char* data;
+    size_t size;
+};
+
 /*
  *  \func findAndReplace
  *  \brief Finds all instances of a target string in and replaces it with
@@ -70,6 +141,50 @@ std::string toString(const T& value);
 template<typename T>
 T toType(const std::string& s);
 
+/*
+ *  \func toType
+ *  \brief Converts a token to a type without copying it first.
+ *
+ *  \tparam T The desired type
+ *  \param token The token to covert
+ *  \return The value
+ *  \throw If the token cannot be converted.
+ */
+template<typename T>
+T toType(const Token& token);
+
+/*
+ *  \func fromChars
+ *  \brief Parses a number from the start of a range in the same way as
+ *         std::from_chars. Whitespace and a leading '+' are not allowed
+ *         and integers are base 10. Nothing is allocated.
+ *
+ *  \param begin The first character
+ *  \param end One past the last character
+ *  \param [OUTPUT] value The number. This is untouched on failure.
+ *  \return One past the last character used, or nullptr if the range does
+ *          not start with a number or the number is out of range.
+ */
+const char* fromChars(const char* begin, const char* end, short& value);
+const char* fromChars(const char* begin,
+                      const char* end,
+                      unsigned short& value);
+const char* fromChars(const char* begin, const char* end, int& value);
+const char* fromChars(const char* begin, const char* end, unsigned& value);
+const char* fromChars(const char* begin, const char* end, long& value);
+const char* fromChars(const char* begin,
+                      const char* end,
+                      unsigned long& value);
+const char* fromChars(const char* begin, const char* end, long long& value);
+const char* fromChars(const char* begin,
+                      const char* end,
+                      unsigned long long& value);
+const char* fromChars(const char* begin, const char* end, float& value);
+const char* fromChars(const char* begin, const char* end, double& value);
+const char* fromChars(const char* begin,
+                      const char* end,
+                      long double& value);
+
 /*
  *  \func split
  *  \brief Splits a string by a delimiter
@@ -81,6 +196,34 @@ T toType(const std::string& s);
 std::vector<std::string> split(const std::string& string,
                                const std::string& delim = " ");
 
+/*
+ *  \func split
+ *  \brief Splits a string by a delimiter without copying any of the
+ *         parts. The output is cleared first so the same vector can be
+ *         reused and only allocates when it needs to grow.
+ *
+ *  \param string The string to split
+ *  \param delim The delimiter to split by
+ *  \param [OUTPUT] parts The parts of the string
+ */
+void split(const std::string& string,
+           const std::string& delim,
+           std::vector<Token>& parts);
+
+/*
+ *  \func forEachSplit
+ *  \brief Calls a function with each part of a string split by a
+ *         delimiter. Nothing is allocated.
+ *
+ *  \param string The string to split
+ *  \param delim The delimiter to split by
+ *  \param func Called with a const Token& for each part
+ */
+template <typename FuncT>
+void forEachSplit(const std::string& string,
+                  const std::string& delim,
+                  FuncT func);
+
 /*
  *  \func startsWith
  *  \brief Checks is a string starts with a value
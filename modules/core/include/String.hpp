@@ -22,7 +22,10 @@
 #ifndef __NYRA_CORE_STRING_HPP__
 #define __NYRA_CORE_STRING_HPP__
 
+#include <cctype>
 #include <sstream>
+#include <stdexcept>
+#include <type_traits>
 
 namespace nyra
 {
@@ -47,6 +50,67 @@ std::string toString(const T& value)
     return buf.str();
 }
 
+//===========================================================================//
+template <typename T,
+          bool IsNumber = std::is_floating_point<T>::value ||
+                  (std::is_integral<T>::value && sizeof(T) > 1 &&
+                   !std::is_same<T, bool>::value &&
+                   !std::is_same<T, wchar_t>::value &&
+                   !std::is_same<T, char16_t>::value &&
+                   !std::is_same<T, char32_t>::value)>
+struct TypeConverter
+{
+    // Anything that is not a number is read from a stream
+    static T convert(const char* data, size_t size)
+    {
+        T value;
+
+        std::stringstream buf(std::string(data, size));
+        buf.precision(getPrecision(value));
+        buf >> value;
+
+        if (buf.fail())
+        {
+            throw std::runtime_error("Unable to covert string: " +
+                                     std::string(data, size));
+        }
+
+        return value;
+    }
+};
+
+//===========================================================================//
+template <typename T>
+struct TypeConverter<T, true>
+{
+    // Numbers are parsed in place. Leading whitespace, a leading '+' and
+    // trailing characters are allowed the same as reading from a stream.
+    static T convert(const char* data, size_t size)
+    {
+        const char* begin = data;
+        const char* const end = data + size;
+        while (begin != end &&
+               std::isspace(static_cast<unsigned char>(*begin)))
+        {
+            ++begin;
+        }
+
+        if (end - begin > 1 && begin[0] == '+' && begin[1] != '-')
+        {
+            ++begin;
+        }
+
+        T value;
+        if (fromChars(begin, end, value) == nullptr)
+        {
+            throw std::runtime_error("Unable to covert string: " +
+                                     std::string(data, size));
+        }
+
+        return value;
+    }
+};
+
 //===========================================================================//
 template<typename T> T toType(const std::string& s)
 {
@@ -55,18 +119,43 @@ template<typename T> T toType(const std::string& s)
         throw std::runtime_error("Cannot convert empty string");
     }
 
-    T value;
+    return TypeConverter<T>::convert(s.data(), s.size());
+}
 
-    std::stringstream buf(s);
-    buf.precision(getPrecision(value));
-    buf >> value;
+//===========================================================================//
+template<typename T> T toType(const Token& token)
+{
+    if (token.size == 0)
+    {
+        throw std::runtime_error("Cannot convert empty string");
+    }
 
-    if (buf.fail())
+    // Only numbers skip the copy. Everything else goes through the string
+    // version so its specializations are used.
+    if (std::is_same<TypeConverter<T>, TypeConverter<T, true> >::value)
     {
-        throw std::runtime_error("Unable to covert string: " + s);
+        return TypeConverter<T>::convert(token.data, token.size);
     }
+    return toType<T>(token.str());
+}
 
-    return value;
+//===========================================================================//
+template <typename FuncT>
+void forEachSplit(const std::string& string,
+                  const std::string& delim,
+                  FuncT func)
+{
+    size_t start = 0;
+    if (!delim.empty())
+    {
+        size_t pos = 0;
+        while ((pos = string.find(delim, start)) != std::string::npos)
+        {
+            func(Token(string.data() + start, pos - start));
+            start = pos + delim.size();
+        }
+    }
+    func(Token(string.data() + start, string.size() - start));
 }
 
 //===========================================================================//
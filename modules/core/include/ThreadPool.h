@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) 2018 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#ifndef __NYRA_CORE_THREAD_POOL_H__
+#define __NYRA_CORE_THREAD_POOL_H__
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace nyra
+{
+namespace core
+{
+/*
+ *  \class ThreadPool
+ *  \brief A fixed set of threads that split up batches of work. The thread
+ *         that submits a batch works on it too and waits until it is done.
+ */
+class ThreadPool
+{
+public:
+    /*
+     *  \func Constructor
+     *  \brief Starts the threads.
+     *
+     *  \param numThreads The number of threads that work on a batch,
+     *         counting the caller. Zero uses one per hardware thread.
+     */
+    explicit ThreadPool(size_t numThreads = 0);
+
+    /*
+     *  \func Destructor
+     *  \brief Stops and joins the threads.
+     */
+    ~ThreadPool();
+
+    /*
+     *  \func getNumThreads
+     *  \brief Gets the number of threads that work on a batch, counting
+     *         the caller.
+     *
+     *  \return The number of threads
+     */
+    size_t getNumThreads() const
+    {
+        return mThreads.size() + 1;
+    }
+
+    /*
+     *  \func parallelFor
+     *  \brief Calls a function for every index in a range and waits for
+     *         all of the calls to finish. Batches from different threads
+     *         run one after another. The function must not submit a batch
+     *         to the same pool.
+     *
+     *  \param count The number of indices
+     *  \param func Called with the index and the thread number. Thread
+     *         numbers are less than getNumThreads and no two calls that
+     *         run at the same time share one, so they can be used to pick
+     *         per thread scratch memory.
+     *  \throw The first exception thrown by func. The rest of the batch
+     *         is skipped.
+     */
+    void parallelFor(size_t count,
+                     const std::function<void(size_t, size_t)>& func);
+
+private:
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    void work(size_t thread);
+
+    void runJob(size_t thread);
+
+    std::vector<std::thread> mThreads;
+    std::mutex mBatchMutex;
+    std::mutex mMutex;
+    std::condition_variable mWake;
+    std::condition_variable mDone;
+    const std::function<void(size_t, size_t)>* mJob;
+    size_t mCount;
+    std::atomic<size_t> mNext;
+    size_t mBusy;
+    size_t mBatch;
+    bool mStop;
+    std::exception_ptr mError;
+};
+}
+}
+
+#endif
@@ -0,0 +1,58 @@
+/*
+ * Copyright (c) 2018 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#include <nyra/core/FixedStep.h>
+
+namespace nyra
+{
+namespace core
+{
+//===========================================================================//
+FixedStep::FixedStep(double rate,
+                     size_t maxSteps) :
+    mStep(1.0 / rate),
+    mMaxSteps(maxSteps),
+    mAccumulator(0.0)
+{
+}
+
+//===========================================================================//
+size_t FixedStep::operator()(double delta)
+{
+    mAccumulator += delta;
+
+    size_t steps = 0;
+    while (mAccumulator >= mStep && steps < mMaxSteps)
+    {
+        mAccumulator -= mStep;
+        ++steps;
+    }
+
+    // Drop whatever could not be caught up on
+    if (mAccumulator >= mStep)
+    {
+        mAccumulator = 0.0;
+    }
+
+    return steps;
+}
+}
+}
@@ -0,0 +1,65 @@
+/*
+ * Copyright (c) 2018 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <nyra/core/MappedFile.h>
+#include <nyra/core/File.h>
+
+namespace nyra
+{
+namespace core
+{
+//===========================================================================//
+MappedFile::MappedFile(const std::string& pathname) :
+    mPathname(pathname),
+    mData(nullptr),
+    mSize(getFileSize(pathname))
+{
+    // A zero length region cannot be mapped, but an empty file is still
+    // a valid file.
+    if (mSize == 0)
+    {
+        return;
+    }
+
+    try
+    {
+        mFile.reset(new boost::interprocess::file_mapping(
+                pathname.c_str(), boost::interprocess::read_only));
+        mRegion.reset(new boost::interprocess::mapped_region(
+                *mFile, boost::interprocess::read_only));
+    }
+    catch (const boost::interprocess::interprocess_exception& ex)
+    {
+        throw std::runtime_error("Failed to map file: " + pathname +
+                                 " " + ex.what());
+    }
+
+    mData = static_cast<const uint8_t*>(mRegion->get_address());
+}
+
+//===========================================================================//
+MappedFile::~MappedFile()
+{
+}
+}
+}
@@ -178,6 +178,12 @@ std::string getFilename(const std::string& pathname)
     return boostPath.filename().string();
 }
 
+//===========================================================================//
+std::time_t getModifiedTime(const std::string& pathname)
+{
+    return boost::filesystem::last_write_time(pathname);
+}
+
 //===========================================================================//
 void makeDirectory(const std::string& path)
 {
@@ -0,0 +1,301 @@
+/*
+ * Copyright (c) 2018 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <nyra/core/Profiler.h>
+
+namespace
+{
+typedef std::chrono::steady_clock Clock;
+
+//===========================================================================//
+struct Slot
+{
+    std::atomic<const char*> name;
+    std::atomic<uint64_t> start;
+    std::atomic<uint64_t> end;
+};
+
+//===========================================================================//
+class Buffer
+{
+public:
+    Buffer(size_t thread) :
+        mSlots(new Slot[nyra::core::Profiler::BUFFER_SIZE]()),
+        mHead(0),
+        mTail(0),
+        mThread(thread),
+        mInUse(true)
+    {
+    }
+
+    // Only the owning thread calls this
+    void record(const char* name, uint64_t start, uint64_t end)
+    {
+        const uint64_t head = mHead.load(std::memory_order_relaxed);
+        Slot& slot = mSlots[head % nyra::core::Profiler::BUFFER_SIZE];
+
+        // Pairs with the fence in read so a reader that sees any of these
+        // stores also sees the head they were written after.
+        std::atomic_thread_fence(std::memory_order_release);
+        slot.name.store(name, std::memory_order_relaxed);
+        slot.start.store(start, std::memory_order_relaxed);
+        slot.end.store(end, std::memory_order_relaxed);
+        mHead.store(head + 1, std::memory_order_release);
+    }
+
+    void read(std::vector<nyra::core::ProfileSample>& samples,
+              uint64_t since) const
+    {
+        const uint64_t head = mHead.load(std::memory_order_acquire);
+        const uint64_t first = std::max(getOldest(head),
+                                        mTail.load(std::memory_order_acquire));
+
+        std::vector<nyra::core::ProfileSample> copied;
+        for (uint64_t ii = first; ii < head; ++ii)
+        {
+            const Slot& slot = mSlots[ii % nyra::core::Profiler::BUFFER_SIZE];
+            nyra::core::ProfileSample sample;
+            sample.name = slot.name.load(std::memory_order_relaxed);
+            sample.start = slot.start.load(std::memory_order_relaxed);
+            sample.end = slot.end.load(std::memory_order_relaxed);
+            sample.thread = mThread;
+            copied.push_back(sample);
+        }
+
+        // The owner may have wrapped around while this was copying. Drop
+        // anything that could have been overwritten, including the slot
+        // that may be half written right now.
+        std::atomic_thread_fence(std::memory_order_acquire);
+        const uint64_t valid = getOldest(
+                mHead.load(std::memory_order_relaxed) + 1);
+        for (size_t ii = 0; ii < copied.size(); ++ii)
+        {
+            if (first + ii >= valid && copied[ii].end > since)
+            {
+                samples.push_back(copied[ii]);
+            }
+        }
+    }
+
+    void clear()
+    {
+        mTail.store(mHead.load(std::memory_order_acquire),
+                    std::memory_order_release);
+    }
+
+    bool isInUse() const
+    {
+        return mInUse;
+    }
+
+    void setInUse(bool inUse)
+    {
+        mInUse = inUse;
+    }
+
+private:
+    static uint64_t getOldest(uint64_t head)
+    {
+        return head > nyra::core::Profiler::BUFFER_SIZE ?
+                head - nyra::core::Profiler::BUFFER_SIZE : 0;
+    }
+
+    const std::unique_ptr<Slot[]> mSlots;
+    std::atomic<uint64_t> mHead;
+    std::atomic<uint64_t> mTail;
+    const size_t mThread;
+    bool mInUse;
+};
+
+//===========================================================================//
+struct Registry
+{
+    std::mutex mutex;
+    std::vector<std::unique_ptr<Buffer> > buffers;
+};
+
+//===========================================================================//
+Registry& getRegistry()
+{
+    static Registry registry;
+    return registry;
+}
+
+//===========================================================================//
+Clock::time_point getOrigin()
+{
+    static const Clock::time_point origin = Clock::now();
+    return origin;
+}
+
+//===========================================================================//
+// Hands the buffer back when the thread exits so a new thread can reuse it.
+// The samples stay until they are overwritten.
+struct ThreadBuffer
+{
+    ThreadBuffer() :
+        buffer(nullptr)
+    {
+    }
+
+    ~ThreadBuffer()
+    {
+        if (buffer)
+        {
+            std::lock_guard<std::mutex> lock(getRegistry().mutex);
+            buffer->setInUse(false);
+        }
+    }
+
+    Buffer* buffer;
+};
+
+//===========================================================================//
+Buffer& getBuffer()
+{
+    static thread_local ThreadBuffer threadBuffer;
+    if (!threadBuffer.buffer)
+    {
+        Registry& registry = getRegistry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        for (const auto& buffer : registry.buffers)
+        {
+            if (!buffer->isInUse())
+            {
+                buffer->setInUse(true);
+                threadBuffer.buffer = buffer.get();
+                break;
+            }
+        }
+
+        if (!threadBuffer.buffer)
+        {
+            registry.buffers.push_back(std::unique_ptr<Buffer>(
+                    new Buffer(registry.buffers.size())));
+            threadBuffer.buffer = registry.buffers.back().get();
+        }
+    }
+    return *threadBuffer.buffer;
+}
+
+//===========================================================================//
+void writeEscaped(std::ostream& os, const char* str)
+{
+    for (; *str; ++str)
+    {
+        if (*str == '"' || *str == '\\')
+        {
+            os << '\\';
+        }
+        os << *str;
+    }
+}
+}
+
+namespace nyra
+{
+namespace core
+{
+//===========================================================================//
+const size_t Profiler::BUFFER_SIZE = 16384;
+
+//===========================================================================//
+uint64_t Profiler::now()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            Clock::now() - getOrigin()).count();
+}
+
+//===========================================================================//
+void Profiler::record(const char* name,
+                      uint64_t start,
+                      uint64_t end)
+{
+    getBuffer().record(name, start, end);
+}
+
+//===========================================================================//
+std::vector<ProfileSample> Profiler::getSamples(uint64_t since)
+{
+    std::vector<ProfileSample> samples;
+    {
+        Registry& registry = getRegistry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        for (const auto& buffer : registry.buffers)
+        {
+            buffer->read(samples, since);
+        }
+    }
+
+    std::stable_sort(samples.begin(), samples.end(),
+                     [](const ProfileSample& a, const ProfileSample& b)
+                     {
+                         return a.start < b.start;
+                     });
+    return samples;
+}
+
+//===========================================================================//
+void Profiler::writeChromeTrace(const std::string& pathname)
+{
+    std::ofstream stream(pathname.c_str());
+    if (!stream)
+    {
+        throw std::runtime_error("Unable to write profile: " + pathname);
+    }
+
+    const std::vector<ProfileSample> samples = getSamples();
+    stream.setf(std::ios::fixed);
+    stream.precision(3);
+    stream << "{\"traceEvents\":[";
+    for (size_t ii = 0; ii < samples.size(); ++ii)
+    {
+        const ProfileSample& sample = samples[ii];
+        stream << (ii == 0 ? "\n" : ",\n")
+               << "{\"name\":\"";
+        writeEscaped(stream, sample.name);
+        stream << "\",\"cat\":\"nyra\",\"ph\":\"X\""
+               << ",\"ts\":" << sample.start / 1000.0
+               << ",\"dur\":" << (sample.end - sample.start) / 1000.0
+               << ",\"pid\":0,\"tid\":" << sample.thread << "}";
+    }
+    stream << "\n]}\n";
+}
+
+//===========================================================================//
+void Profiler::clear()
+{
+    Registry& registry = getRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    for (const auto& buffer : registry.buffers)
+    {
+        buffer->clear();
+    }
+}
+}
+}
@@ -19,30 +19,179 @@
  * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
  * IN THE SOFTWARE.
  */
-#include <regex>
+#include <mutex>
+#include <unordered_map>
 #include <nyra/core/Regex.h>
 
 namespace nyra
 {
 namespace core
 {
-std::vector<std::string> regexMatches(std::string input,
-                                      const std::regex& regex)
+//===========================================================================//
+Regex::Regex(const std::string& pattern, bool useDFA) :
+    mPattern(pattern),
+    mRegex(pattern)
 {
-    std::smatch match;
-    std::vector<std::string> matches;
+    if (useDFA)
+    {
+        try
+        {
+            mDFA.reset(new RegexDFA(pattern));
+        }
+        catch (const std::runtime_error&)
+        {
+            // The pattern needs features only std::regex has.
+        }
+    }
+}
 
-    while (std::regex_search(input, match, regex))
+//===========================================================================//
+bool Regex::search(const char* begin,
+                   const char* end,
+                   std::cmatch& match,
+                   std::regex_constants::match_flag_type flags) const
+{
+    if (mDFA && (flags & ~std::regex_constants::match_prev_avail) == 0)
     {
-        for (size_t ii = 1; ii < match.size(); ++ii)
+        const char* matchBegin = nullptr;
+        const char* matchEnd = nullptr;
+        if (!mDFA->search(begin, end, matchBegin, matchEnd))
         {
-            matches.push_back(match[ii]);
+            return false;
+        }
+
+        // The DFA and backtracking pick the same match, so matching just
+        // that text gives the same sub matches as searching everything.
+        if (std::regex_match(matchBegin, matchEnd, match, mRegex))
+        {
+            return true;
         }
-        input = match.suffix();
     }
 
+    return std::regex_search(begin, end, match, mRegex, flags);
+}
+
+//===========================================================================//
+RegexIterator::RegexIterator() :
+    mBegin(nullptr),
+    mEnd(nullptr),
+    mRegex(nullptr)
+{
+}
+
+//===========================================================================//
+RegexIterator::RegexIterator(const str::Token& input, const Regex& regex) :
+    mBegin(input.data),
+    mEnd(input.data + input.size),
+    mRegex(&regex)
+{
+    search(mBegin, std::regex_constants::match_default);
+}
+
+//===========================================================================//
+RegexIterator& RegexIterator::operator++()
+{
+    const char* pos = mMatch[0].second;
+    std::regex_constants::match_flag_type flags =
+            std::regex_constants::match_prev_avail;
+
+    // An empty match would be found again, so look for a longer one at
+    // the same spot before moving on.
+    if (mMatch[0].first == pos)
+    {
+        if (pos == mEnd)
+        {
+            mRegex = nullptr;
+            return *this;
+        }
+
+        if (mRegex->search(pos, mEnd, mMatch,
+                           flags | std::regex_constants::match_not_null |
+                           std::regex_constants::match_continuous))
+        {
+            return *this;
+        }
+        ++pos;
+    }
+
+    search(pos, flags);
+    return *this;
+}
+
+//===========================================================================//
+bool RegexIterator::operator==(const RegexIterator& other) const
+{
+    if (!mRegex || !other.mRegex)
+    {
+        return mRegex == other.mRegex;
+    }
+
+    return mRegex == other.mRegex && mBegin == other.mBegin &&
+           mEnd == other.mEnd && mMatch[0] == other.mMatch[0];
+}
+
+//===========================================================================//
+void RegexIterator::search(const char* pos,
+                           std::regex_constants::match_flag_type flags)
+{
+    if (!mRegex->search(pos, mEnd, mMatch, flags))
+    {
+        mRegex = nullptr;
+    }
+}
+
+//===========================================================================//
+const Regex& compileRegex(const std::string& pattern)
+{
+    static std::mutex mutex;
+    static std::unordered_map<std::string, std::unique_ptr<Regex> > cache;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    std::unique_ptr<Regex>& regex = cache[pattern];
+    if (!regex)
+    {
+        try
+        {
+            regex.reset(new Regex(pattern));
+        }
+        catch (...)
+        {
+            cache.erase(pattern);
+            throw;
+        }
+    }
+    return *regex;
+}
+
+//===========================================================================//
+std::vector<std::string> regexMatches(const str::Token& input,
+                                      const Regex& regex)
+{
+    std::vector<std::string> matches;
+    for (RegexIterator iter(input, regex); iter != RegexIterator(); ++iter)
+    {
+        for (size_t ii = 1; ii < iter->size(); ++ii)
+        {
+            matches.push_back((*iter)[ii]);
+        }
+    }
     return matches;
+}
 
+//===========================================================================//
+std::vector<std::string> regexMatches(const std::string& input,
+                                      const std::regex& regex)
+{
+    std::vector<std::string> matches;
+    for (std::sregex_iterator iter(input.begin(), input.end(), regex);
+         iter != std::sregex_iterator(); ++iter)
+    {
+        for (size_t ii = 1; ii < iter->size(); ++ii)
+        {
+            matches.push_back((*iter)[ii]);
+        }
+    }
+    return matches;
 }
 }
 }
@@ -0,0 +1,892 @@
+/*
+ * Copyright (c) 2018 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#include <algorithm>
+#include <bitset>
+#include <cctype>
+#include <limits>
+#include <map>
+#include <stdexcept>
+#include <nyra/core/RegexDFA.h>
+
+namespace
+{
+//===========================================================================//
+typedef std::bitset<256> CharSet;
+const size_t INFINITE = std::numeric_limits<size_t>::max();
+const size_t MAX_INSTRUCTIONS = 10000;
+const int32_t DEAD = 0;
+
+//===========================================================================//
+[[noreturn]] void unsupported(const std::string& message)
+{
+    throw std::runtime_error("Regex is not supported by the DFA: " + message);
+}
+
+//===========================================================================//
+struct Node
+{
+    enum Type
+    {
+        SET,
+        CONCAT,
+        ALTERNATE,
+        REPEAT
+    };
+
+    Node(Type type) :
+        type(type),
+        min(1),
+        max(1),
+        greedy(true)
+    {
+    }
+
+    Type type;
+    CharSet set;
+    std::vector<Node> children;
+    size_t min;
+    size_t max;
+    bool greedy;
+};
+
+//===========================================================================//
+bool isNullable(const Node& node)
+{
+    switch (node.type)
+    {
+    case Node::SET:
+        return false;
+    case Node::CONCAT:
+        for (const Node& child : node.children)
+        {
+            if (!isNullable(child))
+            {
+                return false;
+            }
+        }
+        return true;
+    case Node::ALTERNATE:
+        for (const Node& child : node.children)
+        {
+            if (isNullable(child))
+            {
+                return true;
+            }
+        }
+        return false;
+    case Node::REPEAT:
+        return node.min == 0 || isNullable(node.children[0]);
+    }
+    return false;
+}
+
+//===========================================================================//
+void reverse(Node& node)
+{
+    if (node.type == Node::CONCAT)
+    {
+        std::reverse(node.children.begin(), node.children.end());
+    }
+
+    for (Node& child : node.children)
+    {
+        reverse(child);
+    }
+}
+
+//===========================================================================//
+CharSet range(unsigned char first, unsigned char last)
+{
+    CharSet set;
+    for (size_t ii = first; ii <= last; ++ii)
+    {
+        set.set(ii);
+    }
+    return set;
+}
+
+//===========================================================================//
+CharSet single(char value)
+{
+    CharSet set;
+    set.set(static_cast<unsigned char>(value));
+    return set;
+}
+
+//===========================================================================//
+size_t getFirst(const CharSet& set)
+{
+    size_t ii = 0;
+    while (ii < set.size() && !set.test(ii))
+    {
+        ++ii;
+    }
+    return ii;
+}
+
+//===========================================================================//
+class PatternParser
+{
+public:
+    PatternParser(const std::string& pattern) :
+        mPattern(pattern),
+        mPos(0)
+    {
+    }
+
+    Node parse()
+    {
+        Node node = parseAlternate();
+        if (mPos != mPattern.size())
+        {
+            unsupported("Unmatched ')'");
+        }
+
+        if (isNullable(node))
+        {
+            unsupported("The pattern can match an empty string");
+        }
+        return node;
+    }
+
+private:
+    bool atEnd() const
+    {
+        return mPos >= mPattern.size();
+    }
+
+    char peek() const
+    {
+        return atEnd() ? '\0' : mPattern[mPos];
+    }
+
+    char next()
+    {
+        if (atEnd())
+        {
+            unsupported("Unexpected end of pattern");
+        }
+        return mPattern[mPos++];
+    }
+
+    Node parseAlternate()
+    {
+        Node node(Node::ALTERNATE);
+        node.children.push_back(parseConcat());
+        while (!atEnd() && peek() == '|')
+        {
+            ++mPos;
+            node.children.push_back(parseConcat());
+        }
+
+        if (node.children.size() == 1)
+        {
+            return node.children[0];
+        }
+        return node;
+    }
+
+    Node parseConcat()
+    {
+        Node node(Node::CONCAT);
+        while (!atEnd() && peek() != '|' && peek() != ')')
+        {
+            node.children.push_back(parseRepeat());
+        }
+
+        if (node.children.size() == 1)
+        {
+            return node.children[0];
+        }
+        return node;
+    }
+
+    size_t parseCount()
+    {
+        if (!std::isdigit(static_cast<unsigned char>(peek())))
+        {
+            unsupported("Expected a repeat count");
+        }
+
+        size_t count = 0;
+        while (std::isdigit(static_cast<unsigned char>(peek())))
+        {
+            count = count * 10 + (next() - '0');
+            if (count > MAX_INSTRUCTIONS)
+            {
+                unsupported("Repeat count is too large");
+            }
+        }
+        return count;
+    }
+
+    Node parseRepeat()
+    {
+        Node atom = parseAtom();
+
+        Node node(Node::REPEAT);
+        switch (peek())
+        {
+        case '*':
+            ++mPos;
+            node.min = 0;
+            node.max = INFINITE;
+            break;
+        case '+':
+            ++mPos;
+            node.max = INFINITE;
+            break;
+        case '?':
+            ++mPos;
+            node.min = 0;
+            break;
+        case '{':
+            ++mPos;
+            node.min = node.max = parseCount();
+            if (peek() == ',')
+            {
+                ++mPos;
+                node.max = peek() == '}' ? INFINITE : parseCount();
+            }
+
+            if (next() != '}' || node.min > node.max)
+            {
+                unsupported("Invalid repeat count");
+            }
+            break;
+        default:
+            return atom;
+        }
+
+        if (peek() == '?')
+        {
+            ++mPos;
+            node.greedy = false;
+        }
+
+        // Backtracking and the DFA disagree on how empty loop bodies
+        // repeat, so leave those to std::regex.
+        if (isNullable(atom))
+        {
+            unsupported("Repeated expression can be empty");
+        }
+
+        node.children.push_back(atom);
+        return node;
+    }
+
+    Node parseAtom()
+    {
+        const char value = next();
+        switch (value)
+        {
+        case '(':
+        {
+            if (peek() == '?')
+            {
+                ++mPos;
+                if (next() != ':')
+                {
+                    unsupported("Lookahead");
+                }
+            }
+
+            Node node = parseAlternate();
+            if (next() != ')')
+            {
+                unsupported("Expected ')'");
+            }
+            return node;
+        }
+        case '[':
+            return parseClass();
+        case '.':
+        {
+            Node node(Node::SET);
+            node.set.set();
+            node.set.reset('\n');
+            node.set.reset('\r');
+            return node;
+        }
+        case '\\':
+        {
+            bool isClass = false;
+            Node node(Node::SET);
+            node.set = parseEscape(false, isClass);
+            return node;
+        }
+        case '^':
+        case '$':
+            unsupported("Anchors");
+        case '*':
+        case '+':
+        case '?':
+        case '{':
+        case '}':
+        case ']':
+            unsupported(std::string("Unexpected '") + value + "'");
+        default:
+        {
+            Node node(Node::SET);
+            node.set = single(value);
+            return node;
+        }
+        }
+    }
+
+    CharSet parseEscape(bool inClass, bool& isClass)
+    {
+        const char value = next();
+        isClass = true;
+        CharSet set;
+        switch (value)
+        {
+        case 'd':
+        case 'D':
+            set = range('0', '9');
+            break;
+        case 'w':
+        case 'W':
+            set = range('a', 'z') | range('A', 'Z') |
+                  range('0', '9') | single('_');
+            break;
+        case 's':
+        case 'S':
+            set = range('\t', '\r') | single(' ');
+            break;
+        default:
+            isClass = false;
+            break;
+        }
+
+        if (isClass)
+        {
+            return std::isupper(static_cast<unsigned char>(value)) ?
+                    ~set : set;
+        }
+
+        switch (value)
+        {
+        case 'n':
+            return single('\n');
+        case 't':
+            return single('\t');
+        case 'r':
+            return single('\r');
+        case 'f':
+            return single('\f');
+        case 'v':
+            return single('\v');
+        case '0':
+            if (std::isdigit(static_cast<unsigned char>(peek())))
+            {
+                unsupported("Octal escape");
+            }
+            return single('\0');
+        }
+
+        // Anything else alphanumeric is a back reference, a word boundary
+        // or a hex, unicode or control escape.
+        if (std::isalnum(static_cast<unsigned char>(value)))
+        {
+            unsupported(std::string(inClass ? "Class escape \\" :
+                                              "Escape \\") + value);
+        }
+        return single(value);
+    }
+
+    Node parseClass()
+    {
+        Node node(Node::SET);
+        const bool negate = peek() == '^';
+        if (negate)
+        {
+            ++mPos;
+        }
+
+        if (peek() == ']')
+        {
+            unsupported("Empty character class");
+        }
+
+        while (peek() != ']')
+        {
+            bool isClass = false;
+            const CharSet first = parseClassAtom(isClass);
+            if (peek() == '-' && mPos + 1 < mPattern.size() &&
+                mPattern[mPos + 1] != ']')
+            {
+                ++mPos;
+                bool isLastClass = false;
+                const CharSet last = parseClassAtom(isLastClass);
+                if (isClass || isLastClass)
+                {
+                    unsupported("Range with a character class");
+                }
+
+                const size_t low = getFirst(first);
+                const size_t high = getFirst(last);
+
+                // std::regex compares plain chars, which may be signed.
+                if (low > high || high > 127)
+                {
+                    unsupported("Character range");
+                }
+                node.set |= range(static_cast<unsigned char>(low),
+                                  static_cast<unsigned char>(high));
+            }
+            else
+            {
+                node.set |= first;
+            }
+        }
+        ++mPos;
+
+        if (negate)
+        {
+            node.set.flip();
+        }
+        return node;
+    }
+
+    CharSet parseClassAtom(bool& isClass)
+    {
+        isClass = false;
+        const char value = next();
+        if (value == '\\')
+        {
+            return parseEscape(true, isClass);
+        }
+
+        if (value == '[' &&
+            (peek() == ':' || peek() == '.' || peek() == '='))
+        {
+            unsupported("POSIX character class");
+        }
+        return single(value);
+    }
+
+    const std::string& mPattern;
+    size_t mPos;
+};
+
+//===========================================================================//
+struct Instruction
+{
+    enum Op
+    {
+        CHARSET,
+        SPLIT,
+        JUMP,
+        MATCH
+    };
+
+    Op op;
+    size_t set;
+    size_t x;
+    size_t y;
+};
+
+//===========================================================================//
+class Program
+{
+public:
+    size_t add(Instruction::Op op, size_t x = 0, size_t y = 0)
+    {
+        if (instructions.size() >= MAX_INSTRUCTIONS)
+        {
+            unsupported("The pattern is too large");
+        }
+
+        Instruction instruction;
+        instruction.op = op;
+        instruction.set = 0;
+        instruction.x = x;
+        instruction.y = y;
+        instructions.push_back(instruction);
+        return instructions.size() - 1;
+    }
+
+    size_t addSet(const CharSet& set)
+    {
+        const size_t pc = add(Instruction::CHARSET, instructions.size() + 1);
+        for (size_t ii = 0; ii < sets.size(); ++ii)
+        {
+            if (sets[ii] == set)
+            {
+                instructions[pc].set = ii;
+                return pc;
+            }
+        }
+
+        instructions[pc].set = sets.size();
+        sets.push_back(set);
+        return pc;
+    }
+
+    void compile(const Node& node)
+    {
+        switch (node.type)
+        {
+        case Node::SET:
+            addSet(node.set);
+            break;
+        case Node::CONCAT:
+            for (const Node& child : node.children)
+            {
+                compile(child);
+            }
+            break;
+        case Node::ALTERNATE:
+        {
+            std::vector<size_t> jumps;
+            for (size_t ii = 0; ii + 1 < node.children.size(); ++ii)
+            {
+                const size_t split = add(Instruction::SPLIT);
+                instructions[split].x = split + 1;
+                compile(node.children[ii]);
+                jumps.push_back(add(Instruction::JUMP));
+                instructions[split].y = instructions.size();
+            }
+            compile(node.children.back());
+
+            for (size_t jump : jumps)
+            {
+                instructions[jump].x = instructions.size();
+            }
+            break;
+        }
+        case Node::REPEAT:
+        {
+            for (size_t ii = 0; ii < node.min; ++ii)
+            {
+                compile(node.children[0]);
+            }
+
+            if (node.max == INFINITE)
+            {
+                const size_t split = add(Instruction::SPLIT);
+                compile(node.children[0]);
+                add(Instruction::JUMP, split);
+                setBranches(split, split + 1, instructions.size(),
+                            node.greedy);
+            }
+            else
+            {
+                std::vector<size_t> splits;
+                for (size_t ii = node.min; ii < node.max; ++ii)
+                {
+                    splits.push_back(add(Instruction::SPLIT));
+                    compile(node.children[0]);
+                }
+
+                for (size_t split : splits)
+                {
+                    setBranches(split, split + 1, instructions.size(),
+                                node.greedy);
+                }
+            }
+            break;
+        }
+        }
+    }
+
+    std::vector<Instruction> instructions;
+    std::vector<CharSet> sets;
+
+private:
+    void setBranches(size_t split, size_t more, size_t done, bool greedy)
+    {
+        instructions[split].x = greedy ? more : done;
+        instructions[split].y = greedy ? done : more;
+    }
+};
+
+//===========================================================================//
+class TableBuilder
+{
+public:
+    TableBuilder(const Program& program,
+                 const std::vector<uint8_t>& representatives,
+                 bool leftmostFirst) :
+        mProgram(program),
+        mRepresentatives(representatives),
+        mLeftmostFirst(leftmostFirst),
+        mSeen(program.instructions.size(), 0),
+        mGeneration(0)
+    {
+    }
+
+    void build(size_t start,
+               std::vector<int32_t>& next,
+               std::vector<uint8_t>& matched)
+    {
+        const size_t numClasses = mRepresentatives.size();
+
+        // The dead state is always zero
+        std::vector<int32_t> key;
+        beginClosure();
+        addState(key, matched);
+
+        key.clear();
+        beginClosure();
+        addThread(start, key);
+        addState(key, matched);
+
+        for (size_t state = 1; state < mStates.size(); ++state)
+        {
+            next.resize(mStates.size() * numClasses, DEAD);
+            for (size_t cls = 0; cls < numClasses; ++cls)
+            {
+                step(mStates[state], mRepresentatives[cls], key);
+                next[state * numClasses + cls] = addState(key, matched);
+            }
+        }
+        next.resize(mStates.size() * numClasses, DEAD);
+    }
+
+private:
+    void beginClosure()
+    {
+        ++mGeneration;
+        mMatched = false;
+    }
+
+    void addThread(size_t pc, std::vector<int32_t>& list)
+    {
+        mStack.assign(1, pc);
+        while (!mStack.empty())
+        {
+            pc = mStack.back();
+            mStack.pop_back();
+            if (mSeen[pc] == mGeneration)
+            {
+                continue;
+            }
+            mSeen[pc] = mGeneration;
+
+            const Instruction& instruction = mProgram.instructions[pc];
+            switch (instruction.op)
+            {
+            case Instruction::CHARSET:
+                list.push_back(static_cast<int32_t>(pc));
+                break;
+            case Instruction::MATCH:
+                mMatched = true;
+
+                // Everything left is lower priority than this match.
+                if (mLeftmostFirst)
+                {
+                    return;
+                }
+                break;
+            case Instruction::JUMP:
+                mStack.push_back(instruction.x);
+                break;
+            case Instruction::SPLIT:
+                mStack.push_back(instruction.y);
+                mStack.push_back(instruction.x);
+                break;
+            }
+        }
+    }
+
+    void step(const std::vector<int32_t>& state,
+              uint8_t value,
+              std::vector<int32_t>& key)
+    {
+        key.clear();
+        beginClosure();
+        for (int32_t pc : state)
+        {
+            if (pc < 0)
+            {
+                break;
+            }
+
+            const Instruction& instruction = mProgram.instructions[pc];
+            if (mProgram.sets[instruction.set].test(value))
+            {
+                addThread(instruction.x, key);
+                if (mMatched && mLeftmostFirst)
+                {
+                    break;
+                }
+            }
+        }
+    }
+
+    int32_t addState(std::vector<int32_t>& key, std::vector<uint8_t>& matched)
+    {
+        // Without priorities the order of the threads does not matter.
+        if (!mLeftmostFirst)
+        {
+            std::sort(key.begin(), key.end());
+        }
+
+        if (mMatched)
+        {
+            key.push_back(-1);
+        }
+
+        auto iter = mIds.find(key);
+        if (iter != mIds.end())
+        {
+            return iter->second;
+        }
+
+        if (mStates.size() >= nyra::core::RegexDFA::MAX_STATES)
+        {
+            unsupported("Too many states");
+        }
+
+        const int32_t id = static_cast<int32_t>(mStates.size());
+        mIds[key] = id;
+        mStates.push_back(key);
+        matched.push_back(mMatched ? 1 : 0);
+        return id;
+    }
+
+    const Program& mProgram;
+    const std::vector<uint8_t>& mRepresentatives;
+    const bool mLeftmostFirst;
+    std::vector<size_t> mSeen;
+    size_t mGeneration;
+    bool mMatched;
+    std::vector<size_t> mStack;
+    std::map<std::vector<int32_t>, int32_t> mIds;
+    std::vector<std::vector<int32_t> > mStates;
+};
+}
+
+namespace nyra
+{
+namespace core
+{
+//===========================================================================//
+const size_t RegexDFA::MAX_STATES = 4096;
+
+//===========================================================================//
+RegexDFA::RegexDFA(const std::string& pattern)
+{
+    Node node = PatternParser(pattern).parse();
+
+    // Searching lets any number of characters come before the match. The
+    // skipped characters are the lowest priority so earlier starts win.
+    Program forward;
+    const size_t skip = forward.add(Instruction::SPLIT, 2, 1);
+    forward.addSet(CharSet().set());
+    forward.instructions.back().x = skip;
+    forward.compile(node);
+    forward.add(Instruction::MATCH);
+
+    // Running the pattern backwards from the end of a match finds where
+    // the match starts.
+    reverse(node);
+    Program backward;
+    backward.compile(node);
+    backward.add(Instruction::MATCH);
+
+    // Bytes that are in exactly the same sets share a column in the
+    // tables.
+    std::map<std::vector<bool>, uint8_t> signatures;
+    std::vector<uint8_t> representatives;
+    for (size_t ii = 0; ii < 256; ++ii)
+    {
+        std::vector<bool> signature;
+        for (const CharSet& set : forward.sets)
+        {
+            signature.push_back(set.test(ii));
+        }
+
+        auto iter = signatures.find(signature);
+        if (iter == signatures.end())
+        {
+            iter = signatures.insert(std::make_pair(
+                    signature,
+                    static_cast<uint8_t>(representatives.size()))).first;
+            representatives.push_back(static_cast<uint8_t>(ii));
+        }
+        mClasses[ii] = iter->second;
+    }
+    mNumClasses = representatives.size();
+
+    TableBuilder(forward, representatives, true).build(
+            0, mForward.next, mForward.matched);
+    TableBuilder(backward, representatives, false).build(
+            0, mReverse.next, mReverse.matched);
+}
+
+//===========================================================================//
+bool RegexDFA::search(const char* begin,
+                      const char* end,
+                      const char*& matchBegin,
+                      const char*& matchEnd) const
+{
+    // The forward table keeps going after a match in case a higher
+    // priority thread matches later on.
+    const char* stop = nullptr;
+    int32_t state = 1;
+    for (const char* pos = begin; pos != end; ++pos)
+    {
+        state = mForward.next[state * mNumClasses +
+                mClasses[static_cast<uint8_t>(*pos)]];
+        if (state == DEAD)
+        {
+            break;
+        }
+
+        if (mForward.matched[state])
+        {
+            stop = pos + 1;
+        }
+    }
+
+    if (!stop)
+    {
+        return false;
+    }
+
+    // The longest match backwards from the end is the leftmost start.
+    const char* start = stop;
+    state = 1;
+    for (const char* pos = stop; pos != begin; --pos)
+    {
+        state = mReverse.next[state * mNumClasses +
+                mClasses[static_cast<uint8_t>(pos[-1])]];
+        if (state == DEAD)
+        {
+            break;
+        }
+
+        if (mReverse.matched[state])
+        {
+            start = pos - 1;
+        }
+    }
+
+    matchBegin = start;
+    matchEnd = stop;
+    return true;
+}
+}
+}
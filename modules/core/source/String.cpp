@@ -19,11 +19,182 @@
  * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
  * IN THE SOFTWARE.
  */
+#include <cerrno>
+#include <cmath>
+#include <cstdlib>
 #include <limits>
 #include <algorithm>
-#include <boost/algorithm/string.hpp>
 #include <nyra/core/String.h>
 
+#if __cplusplus >= 201703L && defined(__has_include)
+#if __has_include(<charconv>)
+#include <charconv>
+#endif
+#endif
+
+namespace
+{
+//===========================================================================//
+bool isDigit(char c)
+{
+    return c >= '0' && c <= '9';
+}
+
+//===========================================================================//
+template <typename T>
+const char* parseUnsigned(const char* begin, const char* end, T& value)
+{
+    const T max = std::numeric_limits<T>::max();
+    T result = 0;
+    const char* pos = begin;
+    for (; pos != end && isDigit(*pos); ++pos)
+    {
+        const T digit = static_cast<T>(*pos - '0');
+        if (result > (max - digit) / 10)
+        {
+            return nullptr;
+        }
+        result = static_cast<T>(result * 10 + digit);
+    }
+
+    if (pos == begin)
+    {
+        return nullptr;
+    }
+
+    value = result;
+    return pos;
+}
+
+//===========================================================================//
+template <typename T>
+const char* parseSigned(const char* begin, const char* end, T& value)
+{
+    typedef typename std::make_unsigned<T>::type UnsignedT;
+
+    const bool negative = begin != end && *begin == '-';
+    UnsignedT magnitude = 0;
+    const char* pos = parseUnsigned(begin + negative, end, magnitude);
+    if (pos == nullptr)
+    {
+        return nullptr;
+    }
+
+    const UnsignedT max =
+            static_cast<UnsignedT>(std::numeric_limits<T>::max());
+    if (magnitude > max + (negative ? 1 : 0))
+    {
+        return nullptr;
+    }
+
+    // The minimum value does not fit as a positive number
+    value = negative ? static_cast<T>(-static_cast<T>(magnitude - 1) - 1) :
+                       static_cast<T>(magnitude);
+    return pos;
+}
+
+//===========================================================================//
+float toFloating(const char* string, char** end, float)
+{
+    return std::strtof(string, end);
+}
+
+//===========================================================================//
+double toFloating(const char* string, char** end, double)
+{
+    return std::strtod(string, end);
+}
+
+//===========================================================================//
+long double toFloating(const char* string, char** end, long double)
+{
+    return std::strtold(string, end);
+}
+
+//===========================================================================//
+template <typename T>
+const char* parseFloating(const char* begin, const char* end, T& value)
+{
+    // Find the extent of a plain decimal number first. This keeps strtod
+    // from reading hex, inf or nan and from running past the range.
+    const char* pos = begin;
+    if (pos != end && *pos == '-')
+    {
+        ++pos;
+    }
+
+    size_t digits = 0;
+    for (; pos != end && isDigit(*pos); ++pos, ++digits)
+    {
+    }
+
+    if (pos != end && *pos == '.')
+    {
+        for (++pos; pos != end && isDigit(*pos); ++pos, ++digits)
+        {
+        }
+    }
+
+    if (digits == 0)
+    {
+        return nullptr;
+    }
+
+    if (pos != end && (*pos == 'e' || *pos == 'E'))
+    {
+        const char* exponent = pos + 1;
+        if (exponent != end && (*exponent == '+' || *exponent == '-'))
+        {
+            ++exponent;
+        }
+
+        if (exponent != end && isDigit(*exponent))
+        {
+            for (pos = exponent; pos != end && isDigit(*pos); ++pos)
+            {
+            }
+        }
+    }
+
+    const size_t size = pos - begin;
+    T result;
+
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+    if (std::from_chars(begin, pos, result).ec != std::errc())
+    {
+        return nullptr;
+    }
+#else
+    // strtod needs a terminated string. Numbers are nearly always short so
+    // they are copied to the stack rather than allocated.
+    char buffer[64];
+    std::string large;
+    const char* terminated = buffer;
+    if (size < sizeof(buffer))
+    {
+        std::memcpy(buffer, begin, size);
+        buffer[size] = '\0';
+    }
+    else
+    {
+        large.assign(begin, pos);
+        terminated = large.c_str();
+    }
+
+    errno = 0;
+    char* stop = nullptr;
+    result = toFloating(terminated, &stop, T());
+    if (stop != terminated + size || (errno == ERANGE && std::isinf(result)))
+    {
+        return nullptr;
+    }
+#endif
+
+    value = result;
+    return pos;
+}
+}
+
 namespace nyra
 {
 namespace core
@@ -84,24 +255,104 @@ template<> size_t getPrecision(const long double& )
     return std::numeric_limits<long double>::digits10 + 1;
 }
 
+//===========================================================================//
+const char* fromChars(const char* begin, const char* end, short& value)
+{
+    return parseSigned(begin, end, value);
+}
+
+//===========================================================================//
+const char* fromChars(const char* begin,
+                      const char* end,
+                      unsigned short& value)
+{
+    return parseUnsigned(begin, end, value);
+}
+
+//===========================================================================//
+const char* fromChars(const char* begin, const char* end, int& value)
+{
+    return parseSigned(begin, end, value);
+}
+
+//===========================================================================//
+const char* fromChars(const char* begin, const char* end, unsigned& value)
+{
+    return parseUnsigned(begin, end, value);
+}
+
+//===========================================================================//
+const char* fromChars(const char* begin, const char* end, long& value)
+{
+    return parseSigned(begin, end, value);
+}
+
+//===========================================================================//
+const char* fromChars(const char* begin,
+                      const char* end,
+                      unsigned long& value)
+{
+    return parseUnsigned(begin, end, value);
+}
+
+//===========================================================================//
+const char* fromChars(const char* begin, const char* end, long long& value)
+{
+    return parseSigned(begin, end, value);
+}
+
+//===========================================================================//
+const char* fromChars(const char* begin,
+                      const char* end,
+                      unsigned long long& value)
+{
+    return parseUnsigned(begin, end, value);
+}
+
+//===========================================================================//
+const char* fromChars(const char* begin, const char* end, float& value)
+{
+    return parseFloating(begin, end, value);
+}
+
+//===========================================================================//
+const char* fromChars(const char* begin, const char* end, double& value)
+{
+    return parseFloating(begin, end, value);
+}
+
+//===========================================================================//
+const char* fromChars(const char* begin,
+                      const char* end,
+                      long double& value)
+{
+    return parseFloating(begin, end, value);
+}
+
 //===========================================================================//
 std::vector<std::string> split(const std::string& string,
                                const std::string& delim)
 {
     std::vector<std::string> ret;
-
-    using namespace boost::algorithm;
-    typedef split_iterator<std::string::const_iterator> Iter;
-
-    for(Iter iter=make_split_iterator(string, first_finder(delim, is_equal()));
-        iter != Iter(); ++iter)
+    forEachSplit(string, delim, [&ret](const Token& token)
     {
-        ret.push_back(boost::copy_range<std::string>(*iter));
-    }
-
+        ret.push_back(token.str());
+    });
     return ret;
 }
 
+//===========================================================================//
+void split(const std::string& string,
+           const std::string& delim,
+           std::vector<Token>& parts)
+{
+    parts.clear();
+    forEachSplit(string, delim, [&parts](const Token& token)
+    {
+        parts.push_back(token);
+    });
+}
+
 //===========================================================================//
 bool startsWith(const std::string& input,
                 const std::string& start)
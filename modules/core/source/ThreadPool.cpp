@@ -0,0 +1,165 @@
+/*
+ * Copyright (c) 2018 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#include <nyra/core/ThreadPool.h>
+
+namespace nyra
+{
+namespace core
+{
+//===========================================================================//
+ThreadPool::ThreadPool(size_t numThreads) :
+    mJob(nullptr),
+    mCount(0),
+    mNext(0),
+    mBusy(0),
+    mBatch(0),
+    mStop(false)
+{
+    if (numThreads == 0)
+    {
+        numThreads = std::thread::hardware_concurrency();
+    }
+
+    // The caller is one of the threads
+    for (size_t ii = 1; ii < numThreads; ++ii)
+    {
+        mThreads.push_back(std::thread(&ThreadPool::work, this, ii));
+    }
+}
+
+//===========================================================================//
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mStop = true;
+    }
+    mWake.notify_all();
+
+    for (std::thread& thread : mThreads)
+    {
+        thread.join();
+    }
+}
+
+//===========================================================================//
+void ThreadPool::parallelFor(size_t count,
+                             const std::function<void(size_t, size_t)>& func)
+{
+    if (count == 0)
+    {
+        return;
+    }
+
+    std::lock_guard<std::mutex> batchLock(mBatchMutex);
+
+    // Not worth waking anyone for
+    if (mThreads.empty() || count == 1)
+    {
+        for (size_t ii = 0; ii < count; ++ii)
+        {
+            func(ii, 0);
+        }
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mJob = &func;
+        mCount = count;
+        mNext = 0;
+        mBusy = mThreads.size();
+        mError = nullptr;
+        ++mBatch;
+    }
+    mWake.notify_all();
+
+    runJob(0);
+
+    std::unique_lock<std::mutex> lock(mMutex);
+    mDone.wait(lock, [this]()
+    {
+        return mBusy == 0;
+    });
+    mJob = nullptr;
+
+    if (mError)
+    {
+        std::exception_ptr error = mError;
+        mError = nullptr;
+        std::rethrow_exception(error);
+    }
+}
+
+//===========================================================================//
+void ThreadPool::work(size_t thread)
+{
+    size_t batch = 0;
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> lock(mMutex);
+            mWake.wait(lock, [this, batch]()
+            {
+                return mStop || mBatch != batch;
+            });
+
+            if (mStop)
+            {
+                return;
+            }
+            batch = mBatch;
+        }
+
+        runJob(thread);
+
+        std::lock_guard<std::mutex> lock(mMutex);
+        if (--mBusy == 0)
+        {
+            mDone.notify_one();
+        }
+    }
+}
+
+//===========================================================================//
+void ThreadPool::runJob(size_t thread)
+{
+    // Indices are handed out one at a time so uneven work still balances
+    for (size_t index = mNext++; index < mCount; index = mNext++)
+    {
+        try
+        {
+            (*mJob)(index, thread);
+        }
+        catch (...)
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            if (!mError)
+            {
+                mError = std::current_exception();
+            }
+            mNext = mCount;
+        }
+    }
+}
+}
+}
@@ -0,0 +1,51 @@
+/*
+ * Copyright (c) 2018 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#include <nyra/core/FixedStep.h>
+#include <nyra/test/Test.h>
+
+namespace nyra
+{
+namespace core
+{
+TEST(FixedStep, Steps)
+{
+    FixedStep step(10.0, 5);
+    EXPECT_DOUBLE_EQ(0.1, step.getStep());
+    EXPECT_EQ(static_cast<size_t>(0), step(0.05));
+    EXPECT_NEAR(0.5, step.getAlpha(), 0.0001);
+    EXPECT_EQ(static_cast<size_t>(1), step(0.06));
+    EXPECT_NEAR(0.1, step.getAlpha(), 0.0001);
+    EXPECT_EQ(static_cast<size_t>(2), step(0.2));
+    EXPECT_NEAR(0.1, step.getAlpha(), 0.0001);
+}
+
+TEST(FixedStep, CatchUp)
+{
+    FixedStep step(10.0, 3);
+    EXPECT_EQ(static_cast<size_t>(3), step(10.0));
+    EXPECT_DOUBLE_EQ(0.0, step.getAlpha());
+    EXPECT_EQ(static_cast<size_t>(1), step(0.1));
+}
+}
+}
+
+NYRA_TEST()
@@ -19,6 +19,8 @@
  * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
  * IN THE SOFTWARE.
  */
+#include <cmath>
+#include <cstdio>
 #include <fstream>
 #include <nyra/core/Path.h>
 #include <nyra/test/Test.h>
@@ -168,6 +170,21 @@ TEST(Path, GetFilename)
     EXPECT_EQ("test.txt", getFilename("/my/full/path/test.txt"));
 }
 
+//===========================================================================//
+TEST(Path, ModifiedTime)
+{
+    const std::time_t now = std::time(nullptr);
+    const std::string pathname = join(INSTALL_PATH, "test_modified_time");
+    std::ofstream(pathname.c_str()) << "modified";
+
+    const std::time_t modified = getModifiedTime(pathname);
+    std::remove(pathname.c_str());
+
+    // Allow for file systems with coarse timestamps
+    EXPECT_LE(std::abs(static_cast<double>(modified - now)), 2.0);
+    EXPECT_ANY_THROW(getModifiedTime(pathname));
+}
+
 //===========================================================================//
 TEST(Path, MkRmDir)
 {
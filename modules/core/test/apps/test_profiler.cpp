@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2018 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#ifndef NYRA_PROFILE
+#define NYRA_PROFILE
+#endif
+#include <thread>
+#include <nyra/core/Path.h>
+#include <nyra/core/File.h>
+#include <nyra/core/Profiler.h>
+#include <nyra/core/String.h>
+#include <nyra/test/Test.h>
+
+namespace
+{
+void profileThread()
+{
+    NYRA_PROFILE_SCOPE("thread");
+}
+}
+
+namespace nyra
+{
+namespace core
+{
+TEST(Profiler, Scope)
+{
+    Profiler::clear();
+    {
+        NYRA_PROFILE_SCOPE("outer");
+        {
+            NYRA_PROFILE_SCOPE("inner");
+        }
+    }
+
+    const std::vector<ProfileSample> samples = Profiler::getSamples();
+    ASSERT_EQ(static_cast<size_t>(2), samples.size());
+    EXPECT_EQ(std::string("outer"), samples[0].name);
+    EXPECT_EQ(std::string("inner"), samples[1].name);
+    EXPECT_LE(samples[0].start, samples[1].start);
+    EXPECT_GE(samples[0].end, samples[1].end);
+    EXPECT_TRUE(Profiler::getSamples(samples[0].end).empty());
+}
+
+TEST(Profiler, Threads)
+{
+    Profiler::clear();
+    std::thread thread(profileThread);
+    thread.join();
+    profileThread();
+
+    const std::vector<ProfileSample> samples = Profiler::getSamples();
+    ASSERT_EQ(static_cast<size_t>(2), samples.size());
+    EXPECT_NE(samples[0].thread, samples[1].thread);
+}
+
+TEST(Profiler, Wrap)
+{
+    Profiler::clear();
+    for (size_t ii = 0; ii < Profiler::BUFFER_SIZE + 10; ++ii)
+    {
+        NYRA_PROFILE_SCOPE("wrap");
+    }
+
+    // The slot after the newest may be mid write so it is never returned
+    EXPECT_EQ(Profiler::BUFFER_SIZE - 1, Profiler::getSamples().size());
+}
+
+TEST(Profiler, ChromeTrace)
+{
+    Profiler::clear();
+    {
+        NYRA_PROFILE_SCOPE("trace \"quoted\"");
+    }
+
+    const std::string pathname = "test_profiler.json";
+    Profiler::writeChromeTrace(pathname);
+    const std::string trace = readFile(pathname);
+    EXPECT_TRUE(str::startsWith(trace, "{\"traceEvents\":["));
+    EXPECT_NE(std::string::npos,
+              trace.find("\"name\":\"trace \\\"quoted\\\"\""));
+    EXPECT_NE(std::string::npos, trace.find("\"ph\":\"X\""));
+    path::removeAll(pathname);
+}
+}
+}
+
+NYRA_TEST()
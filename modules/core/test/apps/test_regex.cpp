@@ -46,6 +46,63 @@ TEST(Regex, Matches)
         EXPECT_EQ("867", results[1]);
         EXPECT_EQ("5309", results[2]);
     }
+
+    for (bool useDFA : {true, false})
+    {
+        const Regex regex("(\\d{3,4})", useDFA);
+        EXPECT_EQ(useDFA, regex.hasDFA());
+        const std::vector<std::string> results =
+                regexMatches("555-867-5309", regex);
+        ASSERT_EQ(static_cast<size_t>(3), results.size());
+        EXPECT_EQ("555", results[0]);
+        EXPECT_EQ("867", results[1]);
+        EXPECT_EQ("5309", results[2]);
+    }
+}
+
+//===========================================================================//
+TEST(Regex, Iterator)
+{
+    const std::string input = "name=(Bob) age=[42] (x)";
+    const str::Token token(input.data(), input.size());
+    const Regex regex("([(\\[])(.*?)[)\\]]");
+    ASSERT_TRUE(regex.hasDFA());
+
+    std::vector<std::string> groups;
+    for (RegexIterator iter(token, regex); iter != RegexIterator(); ++iter)
+    {
+        // Matches point into the original string
+        EXPECT_EQ(input.data() + input.find((*iter)[0].str()),
+                  (*iter)[0].first);
+        groups.push_back((*iter)[2]);
+    }
+
+    const std::vector<std::string> expected = {"Bob", "42", "x"};
+    EXPECT_EQ(expected, groups);
+}
+
+//===========================================================================//
+TEST(Regex, EmptyMatches)
+{
+    // Patterns that can match nothing are left to std::regex
+    const Regex regex("(a*)");
+    EXPECT_FALSE(regex.hasDFA());
+
+    const std::string input = "baac";
+    const std::vector<std::string> expected =
+            regexMatches(input, std::regex("(a*)"));
+    EXPECT_EQ(expected, regexMatches(input, regex));
+    EXPECT_EQ(static_cast<size_t>(4), expected.size());
+}
+
+//===========================================================================//
+TEST(Regex, Cache)
+{
+    const Regex& regex = compileRegex("[a-z]+");
+    EXPECT_EQ(&regex, &compileRegex("[a-z]+"));
+    EXPECT_NE(&regex, &compileRegex("[a-z]*"));
+    EXPECT_EQ("[a-z]+", regex.getPattern());
+    EXPECT_THROW(compileRegex("(abc"), std::regex_error);
 }
 }
 }
@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) 2018 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#include <regex>
+#include <nyra/core/RegexDFA.h>
+#include <nyra/test/Test.h>
+
+namespace nyra
+{
+namespace core
+{
+namespace
+{
+//===========================================================================//
+::testing::AssertionResult matchesStd(const std::string& pattern,
+                                      const std::string& input)
+{
+    const RegexDFA dfa(pattern);
+    const std::regex regex(pattern);
+
+    const char* begin = input.data();
+    const char* end = begin + input.size();
+    while (true)
+    {
+        std::cmatch match;
+        const bool expected = std::regex_search(begin, end, match, regex);
+
+        const char* matchBegin = nullptr;
+        const char* matchEnd = nullptr;
+        const bool found = dfa.search(begin, end, matchBegin, matchEnd);
+
+        if (expected != found)
+        {
+            return ::testing::AssertionFailure()
+                    << "/" << pattern << "/ found " << found
+                    << " at " << (begin - input.data());
+        }
+
+        if (!found)
+        {
+            return ::testing::AssertionSuccess();
+        }
+
+        if (match[0].first != matchBegin || match[0].second != matchEnd)
+        {
+            return ::testing::AssertionFailure()
+                    << "/" << pattern << "/ matched \""
+                    << std::string(matchBegin, matchEnd)
+                    << "\" instead of \"" << match[0].str() << "\"";
+        }
+        begin = matchEnd;
+    }
+}
+}
+
+//===========================================================================//
+TEST(RegexDFA, Search)
+{
+    const std::string input = "555-867-5309";
+    const RegexDFA dfa("\\d{3,4}");
+
+    const char* begin = nullptr;
+    const char* end = nullptr;
+    ASSERT_TRUE(dfa.search(input.data() + 3,
+                           input.data() + input.size(),
+                           begin,
+                           end));
+    EXPECT_EQ("867", std::string(begin, end));
+    EXPECT_FALSE(dfa.search(input.data(), input.data() + 2, begin, end));
+}
+
+//===========================================================================//
+TEST(RegexDFA, MatchesStd)
+{
+    const std::string html =
+            "<tr>\n<td>One <a>link</a>\n</td>\n<tr>\n<td>Two\n\n</td>";
+    const std::string rom =
+            "Game (USA) [!] (Rev 1) [b2] [a] (1998)(Acme)[h Fixed].smc";
+
+    EXPECT_TRUE(matchesStd("(<tr>\\n<td>(\\s|.)*?\n<\\/td>)", html));
+    EXPECT_TRUE(matchesStd("\\>(.*?)[\\<\\n]", html));
+    EXPECT_TRUE(matchesStd("([(\\[].*?[)\\]])", rom));
+    EXPECT_TRUE(matchesStd("(\\w+)(\\s*)", rom));
+    EXPECT_TRUE(matchesStd("[^ ]+?\\.", rom));
+    EXPECT_TRUE(matchesStd("(a|ab)(c|bcd)", "abcd abc abcd"));
+    EXPECT_TRUE(matchesStd("a{2,3}?b|a+", "aaaab aab ab aaaa"));
+    EXPECT_TRUE(matchesStd("(?:x|xy)+?z|\\.", "xyxz xxxz . xyz"));
+}
+
+//===========================================================================//
+TEST(RegexDFA, Unsupported)
+{
+    EXPECT_ANY_THROW(RegexDFA("a*"));
+    EXPECT_ANY_THROW(RegexDFA("^abc"));
+    EXPECT_ANY_THROW(RegexDFA("abc$"));
+    EXPECT_ANY_THROW(RegexDFA("(a)\\1"));
+    EXPECT_ANY_THROW(RegexDFA("\\bword"));
+    EXPECT_ANY_THROW(RegexDFA("a(?=b)"));
+    EXPECT_ANY_THROW(RegexDFA("(a?)+b"));
+    EXPECT_NO_THROW(RegexDFA("[a-z]+@[a-z]+\\.com"));
+}
+}
+}
+
+NYRA_TEST()
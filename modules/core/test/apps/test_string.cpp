@@ -19,6 +19,7 @@
  * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
  * IN THE SOFTWARE.
  */
+#include <limits>
 #include <nyra/core/String.h>
 #include <nyra/test/Test.h>
 
@@ -72,6 +73,101 @@ TEST(String, toType)
     EXPECT_FALSE(toType<bool>("0"));
     EXPECT_TRUE(toType<bool>("1"));
     EXPECT_ANY_THROW(toType<int>("foo"));
+    EXPECT_EQ(12, toType<int>(" +12abc"));
+    EXPECT_EQ(-7, toType<long long>("-7"));
+    EXPECT_ANY_THROW(toType<int>(""));
+    EXPECT_ANY_THROW(toType<int>("99999999999"));
+    EXPECT_ANY_THROW(toType<unsigned>("-1"));
+    EXPECT_ANY_THROW(toType<double>("nan"));
+}
+
+//===========================================================================//
+TEST(String, FromChars)
+{
+    {
+        const std::string string = "-2147483648,";
+        int value = 0;
+        const char* end = fromChars(string.data(),
+                                    string.data() + string.size(),
+                                    value);
+        EXPECT_EQ(std::numeric_limits<int>::min(), value);
+        EXPECT_EQ(string.data() + string.size() - 1, end);
+    }
+
+    {
+        // The range is respected even if more digits follow
+        const std::string string = "12345";
+        unsigned short value = 0;
+        EXPECT_EQ(string.data() + 3,
+                  fromChars(string.data(), string.data() + 3, value));
+        EXPECT_EQ(123, value);
+    }
+
+    {
+        const std::string string = "1.5e3x";
+        double value = 0.0;
+        EXPECT_EQ(string.data() + 5,
+                  fromChars(string.data(),
+                            string.data() + string.size(),
+                            value));
+        EXPECT_DOUBLE_EQ(1500.0, value);
+    }
+
+    {
+        const std::string string = "-.25e";
+        float value = 0.0f;
+        EXPECT_EQ(string.data() + 4,
+                  fromChars(string.data(),
+                            string.data() + string.size(),
+                            value));
+        EXPECT_FLOAT_EQ(-0.25f, value);
+    }
+
+    {
+        // Failures leave the value untouched
+        const std::string string = "-x";
+        int value = 42;
+        EXPECT_EQ(nullptr, fromChars(string.data(), string.data(), value));
+        EXPECT_EQ(nullptr, fromChars(string.data(),
+                                     string.data() + string.size(),
+                                     value));
+        EXPECT_EQ(42, value);
+    }
+
+    {
+        const std::string string = "65536";
+        unsigned short value = 0;
+        EXPECT_EQ(nullptr, fromChars(string.data(),
+                                     string.data() + string.size(),
+                                     value));
+    }
+
+    {
+        const std::string string = "1e999";
+        double value = 0.0;
+        EXPECT_EQ(nullptr, fromChars(string.data(),
+                                     string.data() + string.size(),
+                                     value));
+    }
+}
+
+//===========================================================================//
+TEST(String, TokenToType)
+{
+    const std::string string = "42,-1.5,true,name";
+    const std::vector<Token> tokens = [&string]()
+    {
+        std::vector<Token> ret;
+        split(string, ",", ret);
+        return ret;
+    }();
+
+    ASSERT_EQ(4, tokens.size());
+    EXPECT_EQ(42, toType<int>(tokens[0]));
+    EXPECT_DOUBLE_EQ(-1.5, toType<double>(tokens[1]));
+    EXPECT_TRUE(toType<bool>(tokens[2]));
+    EXPECT_EQ("name", toType<std::string>(tokens[3]));
+    EXPECT_ANY_THROW(toType<int>(tokens[3]));
 }
 
 //===========================================================================//
@@ -97,6 +193,45 @@ TEST(String, Split)
                 {"this", "now", "works"};
         EXPECT_EQ(expected, split(string, "split"));
     }
+
+    {
+        const std::vector<std::string> expected = {""};
+        EXPECT_EQ(expected, split("", ","));
+    }
+
+    {
+        const std::vector<std::string> expected = {"a", "", "b", ""};
+        EXPECT_EQ(expected, split("a,,b,", ","));
+    }
+
+    {
+        const std::vector<std::string> expected = {"", "a"};
+        EXPECT_EQ(expected, split("aaa", "aa"));
+    }
+}
+
+//===========================================================================//
+TEST(String, SplitTokens)
+{
+    const std::string string = "a,bc,,def";
+    std::vector<Token> tokens = {Token("stale", 5)};
+    split(string, ",", tokens);
+
+    ASSERT_EQ(4, tokens.size());
+    EXPECT_EQ("a", tokens[0].str());
+    EXPECT_EQ("bc", tokens[1].str());
+    EXPECT_EQ("", tokens[2].str());
+    EXPECT_EQ("def", tokens[3].str());
+
+    // Tokens point into the original string
+    EXPECT_EQ(string.data() + 6, tokens[3].data);
+
+    std::vector<std::string> visited;
+    forEachSplit(string, ",", [&visited](const Token& token)
+    {
+        visited.push_back(token.str());
+    });
+    EXPECT_EQ(split(string, ","), visited);
 }
 
 //===========================================================================//
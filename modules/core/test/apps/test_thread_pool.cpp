@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) 2018 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+#include <nyra/core/ThreadPool.h>
+#include <nyra/test/Test.h>
+
+namespace nyra
+{
+namespace core
+{
+TEST(ThreadPool, ParallelFor)
+{
+    ThreadPool pool(4);
+    EXPECT_EQ(static_cast<size_t>(4), pool.getNumThreads());
+
+    for (size_t batch = 0; batch < 50; ++batch)
+    {
+        std::vector<size_t> values(1000, 0);
+        std::atomic<bool> badThread(false);
+        pool.parallelFor(values.size(), [&](size_t index, size_t thread)
+        {
+            if (thread >= pool.getNumThreads())
+            {
+                badThread = true;
+            }
+            values[index] = index * 2;
+        });
+
+        EXPECT_FALSE(badThread);
+        for (size_t ii = 0; ii < values.size(); ++ii)
+        {
+            ASSERT_EQ(ii * 2, values[ii]);
+        }
+    }
+}
+
+TEST(ThreadPool, Scratch)
+{
+    // No two calls running together should share a thread number
+    ThreadPool pool(3);
+    std::vector<std::atomic<int> > inUse(pool.getNumThreads());
+    for (std::atomic<int>& flag : inUse)
+    {
+        flag = 0;
+    }
+
+    std::atomic<bool> shared(false);
+    pool.parallelFor(5000, [&](size_t, size_t thread)
+    {
+        if (inUse[thread]++ != 0)
+        {
+            shared = true;
+        }
+        --inUse[thread];
+    });
+    EXPECT_FALSE(shared);
+}
+
+TEST(ThreadPool, SingleThread)
+{
+    ThreadPool pool(1);
+    EXPECT_EQ(static_cast<size_t>(1), pool.getNumThreads());
+    size_t sum = 0;
+    pool.parallelFor(10, [&](size_t index, size_t thread)
+    {
+        EXPECT_EQ(static_cast<size_t>(0), thread);
+        sum += index;
+    });
+    EXPECT_EQ(static_cast<size_t>(45), sum);
+    pool.parallelFor(0, [&](size_t, size_t)
+    {
+        FAIL();
+    });
+}
+
+TEST(ThreadPool, Exception)
+{
+    ThreadPool pool(4);
+    EXPECT_THROW(pool.parallelFor(100, [](size_t index, size_t)
+    {
+        if (index == 10)
+        {
+            throw std::runtime_error("Failed");
+        }
+    }), std::runtime_error);
+
+    // The pool still works afterwards
+    std::atomic<size_t> count(0);
+    pool.parallelFor(100, [&](size_t, size_t)
+    {
+        ++count;
+    });
+    EXPECT_EQ(static_cast<size_t>(100), count.load());
+}
+}
+}
+
+NYRA_TEST()
@@ -34,7 +34,7 @@ Map::Map() :
             math::Vector2I(30, 30)),
     mTarget(mWindow),
     mInput(mWindow, "empty.json"),
-    mMap(mInput, mTarget)
+    mMap(mInput, mTarget, 60.0, game::PhysicsOptions())
 {
     core::read(core::path::join(core::DATA_PATH, "maps/sprite_editor.json"), mMap);
 }
@@ -49,7 +49,10 @@ bool Map::update()
         mMap.update(0.0);
 
         mTarget.clear(img::Color(192, 192, 192));
-        mMap.render(mTarget);
+        mMap.acquireSnapshot();
+        mMap.render(mTarget, 1.0);
+        mMap.renderCollision(mTarget);
+        mMap.renderGui(mTarget, 1.0);
         mTarget.flush();
     }
 
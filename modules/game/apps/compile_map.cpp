@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2018 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#include <iostream>
+#include <exception>
+#include <nyra/cli/Parser.h>
+#include <nyra/core/Path.h>
+#include <nyra/game/CompiledMap.h>
+
+using namespace nyra;
+
+int main(int argc, char** argv)
+{
+    try
+    {
+        cli::Options opt("Bakes a map and every actor it references into a "
+                         "compiled map that the game can load directly");
+        opt.add("map", "The map JSON filename within data/maps").
+                setPositional();
+        opt.add("output", "The output pathname. Defaults to the map "
+                          "pathname with the compiled map extension.");
+        cli::Parser options(opt, argc, argv);
+
+        const std::string mapPathname = core::path::join(
+                core::DATA_PATH, "maps/" + options.get("map"));
+
+        std::string outPathname;
+        if (options.isSet("output"))
+        {
+            outPathname = options.get("output");
+        }
+        else
+        {
+            const std::string extension =
+                    core::path::getExtension(mapPathname, 1);
+            outPathname = mapPathname.substr(
+                    0, mapPathname.size() - extension.size()) +
+                    game::CompiledMap::EXTENSION;
+        }
+
+        game::compileMap(mapPathname, outPathname);
+        std::cout << "Wrote compiled map to " << outPathname << "\n";
+    }
+    catch (const std::exception& ex)
+    {
+        std::cout << "STD Exception: " << ex.what() << std::endl;
+    }
+    catch (...)
+    {
+        std::cout << "Unknown Exception: System Error!" << std::endl;
+    }
+
+    return 0;
+}
@@ -21,24 +21,49 @@
  */
 #include <iostream>
 #include <exception>
+#include <nyra/cli/Parser.h>
 #include <nyra/game/Game.h>
 #include <nyra/game/Options.h>
 
+using namespace nyra;
+
 int main(int argc, char** argv)
 {
     try
     {
-        nyra::game::Options options;
-        nyra::game::Game game(options);
+        cli::Options opt("Runs the game");
+        opt.add("record", "Writes the session to this replay file on exit");
+        opt.add("replay", "Plays a replay file back as fast as possible "
+                          "without rendering and checks the result");
+        opt.add("seed", "The script random seed. Defaults to the clock.");
+        cli::Parser parser(opt, argc, argv);
+
+        game::Options options;
+        if (parser.isSet("record"))
+        {
+            options.game.recordReplay = parser.get("record");
+        }
+        if (parser.isSet("replay"))
+        {
+            options.game.playReplay = parser.get("replay");
+        }
+        if (parser.isSet("seed"))
+        {
+            options.game.seed = parser.get<uint32_t>("seed");
+        }
+
+        game::Game game(options);
         game.run();
     }
     catch (const std::exception& ex)
     {
         std::cout << "STD Exception: " << ex.what() << std::endl;
+        return 1;
     }
     catch (...)
     {
         std::cout << "Unknown Exception: System Error!" << std::endl;
+        return 1;
     }
 
     return 0;
@@ -38,6 +38,8 @@ namespace nyra
 {
 namespace game
 {
+class Prefab;
+
 /*
  *  \class Actor
  *  \brief Generic class for anything that interacts with the game
@@ -74,6 +76,16 @@ public:
      */
     void initialize();
 
+    /*
+     *  \func reset
+     *  \brief Puts a recycled actor back into its just spawned state. The
+     *         transform and query groups are cleared, no animation is
+     *         playing and initialize will run again. The script keeps its
+     *         instance, so its reset function is called last to clear any
+     *         variables it set. See ActorPtr::reset for the prefab state.
+     */
+    void reset();
+
     /*
      *  \func addNavMesh
      *  \brief Adds a nav mesh to the actor
@@ -164,10 +176,58 @@ public:
 
     /*
      *  \func updateTransform
-     *  \brief Updates the spatial transform of the actor
+     *  \brief Updates the spatial transform of the actor. The renderable
+     *         is left alone, it belongs to render and is only moved by
+     *         interpolate.
      */
     void updateTransform();
 
+    /*
+     *  \func snapshot
+     *  \brief Saves the current transform as the latest simulation state.
+     *         The state that was there before is kept to interpolate from.
+     *         This should be called at the end of every simulation step.
+     */
+    void snapshot();
+
+    /*
+     *  \func getPreviousSnapshot
+     *  \brief Gets the transform from the simulation step before the
+     *         latest one.
+     *
+     *  \return The transform
+     */
+    const math::Transform2D& getPreviousSnapshot() const
+    {
+        return mPrevious;
+    }
+
+    /*
+     *  \func getSnapshot
+     *  \brief Gets the transform from the latest simulation step.
+     *
+     *  \return The transform
+     */
+    const math::Transform2D& getSnapshot() const
+    {
+        return mCurrent;
+    }
+
+    /*
+     *  \func interpolate
+     *  \brief Places the renderable between two snapshots. This only
+     *         touches state that render uses, so it can run while the
+     *         actor is being updated.
+     *
+     *  \param previous The older snapshot
+     *  \param current The newer snapshot
+     *  \param alpha How far to move from the older snapshot to the newer
+     *         one, from 0.0 to 1.0.
+     */
+    void interpolate(const math::Transform2D& previous,
+                     const math::Transform2D& current,
+                     double alpha);
+
     /*
      *  \func render
      *  \brief Renders the actor to the screen
@@ -175,6 +235,15 @@ public:
      *  \param target The target to render to
      */
     void render(graphics::RenderTarget& target) override;
+
+    /*
+     *  \func renderCollision
+     *  \brief Renders the collision shapes where the last call to
+     *         interpolate placed the actor.
+     *
+     *  \param target The target to render to
+     */
+    void renderCollision(graphics::RenderTarget& target);
     /*
      *  \func setScript
      *  \brief Sets the script that is used to control the actor
@@ -199,6 +268,15 @@ public:
      */
     void setInitializeFunction(const std::string& name);
 
+    /*
+     *  \func setResetFunction
+     *  \brief Sets the function that puts the script back into its just
+     *         spawned state when a pooled actor is reused.
+     *
+     *  \param name The name of the function
+     */
+    void setResetFunction(const std::string& name);
+
     void callActivateFunction(const std::string& name);
 
     void setActivatedFunction(const std::string& name,
@@ -268,6 +346,17 @@ public:
 
     gui::Widget& getWidget(const std::string& name);
 
+    /*
+     *  \func getGUI
+     *  \brief Gets the widgets of a GUI actor
+     *
+     *  \return The GUI or nullptr if the actor has no widgets
+     */
+    Gui* getGUI()
+    {
+        return mGUI;
+    }
+
     Type getType() const
     {
         return mType;
@@ -278,6 +367,51 @@ public:
         mType = type;
     }
 
+    /*
+     *  \func getQueryGroups
+     *  \brief Gets the group bits used by the Map spatial queries
+     *
+     *  \return The group bits
+     */
+    uint32_t getQueryGroups() const
+    {
+        return mQueryGroups;
+    }
+
+    /*
+     *  \func setQueryGroups
+     *  \brief Sets the group bits used by the Map spatial queries. Queries
+     *         only return actors that share a bit with the query.
+     *
+     *  \param groups The group bits
+     */
+    void setQueryGroups(uint32_t groups)
+    {
+        mQueryGroups = groups;
+    }
+
+    /*
+     *  \func getPrefab
+     *  \brief Gets the prefab the actor was spawned from
+     *
+     *  \return The prefab or nullptr if it was built by hand
+     */
+    const Prefab* getPrefab() const
+    {
+        return mPrefab;
+    }
+
+    /*
+     *  \func setPrefab
+     *  \brief Sets the prefab. This should only be called internally
+     *
+     *  \param prefab The prefab the actor was spawned from
+     */
+    void setPrefab(const Prefab* prefab)
+    {
+        mPrefab = prefab;
+    }
+
     Physics& getPhysics()
     {
         return mPhysics;
@@ -302,6 +436,7 @@ private:
 
     script::FunctionPtr mUpdate;
     script::FunctionPtr mInitialize;
+    script::FunctionPtr mReset;
 
     std::unique_ptr<graphics::Renderable2D> mRenderable;
     std::unordered_map<std::string,
@@ -309,12 +444,18 @@ private:
     anim::Animation* mCurrentAnimation;
     Gui* mGUI;
     Physics mPhysics;
+    const Prefab* mPrefab;
 
     std::string mCurrentAnimationName;
     std::string mName;
     int32_t mLayer;
+    uint32_t mQueryGroups;
     bool mHasInit;
     Type mType;
+    math::Transform2D mPrevious;
+    math::Transform2D mCurrent;
+    math::Transform2D mInterpolated;
+    bool mHasSnapshot;
 };
 }
 }
@@ -24,6 +24,7 @@
 
 #include <nyra/game/Actor.h>
 #include <nyra/game/Input.h>
+#include <nyra/game/Prefab.h>
 #include <nyra/game/Types.h>
 
 namespace nyra
@@ -46,7 +47,8 @@ public:
 
     /*
      *  \func Constructor
-     *  \brief Creates an Actor from a filename
+     *  \brief Creates an Actor from a filename. The file is only parsed
+     *         the first time it is requested, see Prefab::get.
      *
      *  \param filename The filename without the path.
      */
@@ -55,6 +57,26 @@ public:
              const graphics::RenderTarget& target,
              physics::World2D& world);
 
+    /*
+     *  \func Constructor
+     *  \brief Creates an Actor from an already parsed prefab.
+     *
+     *  \param prefab The actor description
+     */
+    ActorPtr(const Prefab& prefab,
+             const game::Input& input,
+             const graphics::RenderTarget& target,
+             physics::World2D& world);
+
+    /*
+     *  \func reset
+     *  \brief Puts a pooled actor back into the state its prefab spawns
+     *         it in. The existing widgets get their text, size, position
+     *         and visibility back, and the layer comes back from the
+     *         prefab. The rest is done by Actor::reset.
+     */
+    void reset();
+
     /*
      *  \func get
      *  \brief Gets the underlying actor
@@ -77,37 +99,40 @@ public:
 
 private:
     //=======================================================================//
-    void parsePhysics(const mem::Tree<std::string>& map,
-                      physics::World2D& world,
-                      bool isTrigger);
+    void createPhysics(const Prefab::Physics& physics,
+                       physics::World2D& world,
+                       bool isTrigger);
+
+    //=======================================================================//
+    void createGui(const std::vector<Prefab::Widget>& widgets,
+                   const input::Mouse& mouse);
 
     //=======================================================================//
-    void parseGui(const mem::Tree<std::string>& map,
-                  const input::Mouse& mouse);
+    void createWidgets(const std::vector<Prefab::Widget>& widgets,
+                       mem::Tree<gui::Widget>& gui);
 
     //=======================================================================//
-    void parseWidgets(const mem::Tree<std::string>& map,
+    void resetWidgets(const std::vector<Prefab::Widget>& widgets,
                       mem::Tree<gui::Widget>& gui);
 
     //=======================================================================//
-    void parseScript(const mem::Tree<std::string>& map);
+    void createScript(const Prefab::Script& script);
 
     //=======================================================================//
     void createActor(const std::string& className, IncludeT& include);
 
     //=======================================================================//
-    graphics::Sprite* parseSprite(const mem::Tree<std::string>& map) const;
+    graphics::Sprite* createSprite(const Prefab::Sprite& sprite) const;
 
     //=======================================================================//
-    void parseTileMap(const mem::Tree<std::string>& map) const;
+    void createTileMap(const Prefab::TileMap& tileMap) const;
 
     //=======================================================================//
-    void parseCamera(const mem::Tree<std::string>& map,
-                     const graphics::RenderTarget& target) const;
+    void createCamera(const graphics::RenderTarget& target) const;
 
     //=======================================================================//
-    void parseAnimation(const mem::Tree<std::string>& map,
-                        graphics::Sprite* sprite) const;
+    void createAnimations(const Prefab& prefab,
+                          graphics::Sprite* sprite) const;
 
     //=======================================================================//
     Actor* mActor;
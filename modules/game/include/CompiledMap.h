@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) 2018 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#ifndef __NYRA_GAME_COMPILED_MAP_H__
+#define __NYRA_GAME_COMPILED_MAP_H__
+
+#include <string>
+#include <vector>
+#include <nyra/core/MappedFile.h>
+#include <nyra/game/MapData.h>
+
+namespace nyra
+{
+namespace game
+{
+/*
+ *  \class CompiledMap
+ *  \brief A map that has been baked into a single binary file by
+ *         compileMap. The file holds every prefab the map references, the
+ *         actor placements and the textures the map will need. The file is
+ *         memory mapped and the fixed size records are used in place, so
+ *         loading does not parse any text.
+ *
+ *         Layout (native byte order, sections are 8 byte aligned):
+ *             Header
+ *             Strings   - Every string in the map, referenced by offset
+ *             Prefabs   - PrefabRecord table followed by the encoded prefabs
+ *             Actors    - ActorRecord per placed actor
+ *             Variables - VariableRecord per script variable
+ *             Textures  - StringRef per texture
+ */
+class CompiledMap
+{
+public:
+    /*
+     *  \var VERSION
+     *  \brief The current file version. Bump this whenever the layout or
+     *         the prefab encoding changes.
+     */
+    static const uint32_t VERSION;
+
+    /*
+     *  \var EXTENSION
+     *  \brief The file extension used for compiled maps.
+     */
+    static const std::string EXTENSION;
+
+    /*
+     *  \func Constructor
+     *  \brief Maps a compiled map into memory and validates the header.
+     *
+     *  \param pathname The compiled map on disk.
+     *  \throw If the file is not a compiled map or the version is wrong.
+     */
+    CompiledMap(const std::string& pathname);
+
+    /*
+     *  \func getTextures
+     *  \brief Gets every texture used by the map. The names are relative
+     *         to the data directory.
+     *
+     *  \return The texture filenames
+     */
+    std::vector<std::string> getTextures() const;
+
+    /*
+     *  \func registerPrefabs
+     *  \brief Adds all of the baked prefabs to the global prefab registry.
+     *         Prefabs that are already registered are left alone.
+     */
+    void registerPrefabs() const;
+
+    /*
+     *  \func read
+     *  \brief Registers the baked prefabs and fills out the actor
+     *         placements and textures. This does not touch a Map, so it
+     *         can be called from a loader thread.
+     *
+     *  \param data The map data to fill
+     */
+    void read(MapData& data) const;
+
+private:
+    const core::MappedFile mFile;
+};
+
+/*
+ *  \func compileMap
+ *  \brief Reads a map JSON and every actor it references and writes them
+ *         out as a compiled map. The file is written beside the target
+ *         and moved over it once complete, so a failed write never
+ *         leaves a partial map.
+ *
+ *  \param mapPathname The map JSON
+ *  \param outPathname The compiled map to write
+ *  \throw If the file cannot be written
+ */
+void compileMap(const std::string& mapPathname,
+                const std::string& outPathname);
+}
+}
+
+#endif
@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2018 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#ifndef __NYRA_GAME_FLOW_FIELD_H__
+#define __NYRA_GAME_FLOW_FIELD_H__
+
+#include <nyra/math/FlowField.h>
+#include <nyra/game/NavMesh.h>
+
+namespace nyra
+{
+namespace game
+{
+/*
+ *  \class FlowField
+ *  \brief Points every tile of a NavMesh toward a shared goal. This is much
+ *         cheaper than a path per actor when many actors chase the same
+ *         target. Moving the goal by a tile only updates the tiles that
+ *         got closer.
+ */
+class FlowField
+{
+public:
+    /*
+     *  \func Constructor
+     *  \brief Creates a field with no goal. The nav mesh must outlive the
+     *         field.
+     *
+     *  \param navMesh The tiles to cover
+     */
+    FlowField(const NavMesh& navMesh);
+
+    /*
+     *  \func setGoal
+     *  \brief Sets the tile everything flows toward.
+     *
+     *  \param tile The goal tile
+     */
+    void setGoal(const math::Vector2F& tile);
+
+    /*
+     *  \func getGoal
+     *  \brief Gets the tile everything flows toward.
+     *
+     *  \return The goal tile
+     */
+    math::Vector2F getGoal() const;
+
+    /*
+     *  \func hasPath
+     *  \brief Checks if the goal can be reached from a tile.
+     *
+     *  \param tile The tile to check
+     *  \return True if there is a path
+     */
+    bool hasPath(const math::Vector2F& tile) const;
+
+    /*
+     *  \func getDistance
+     *  \brief Gets the length of the shortest path to the goal.
+     *
+     *  \param tile The tile to check
+     *  \return The distance in tiles, or a negative value if there is no
+     *          path
+     */
+    float getDistance(const math::Vector2F& tile) const;
+
+    /*
+     *  \func getNext
+     *  \brief Gets the next tile on the way to the goal.
+     *
+     *  \param tile The current tile
+     *  \return The tile to move to. This is the same tile at the goal or
+     *          if there is no path.
+     */
+    math::Vector2F getNext(const math::Vector2F& tile) const;
+
+private:
+    bool getIndex(const math::Vector2F& tile, size_t& index) const;
+
+    void sync() const;
+
+    const NavMesh& mNavMesh;
+    mutable math::FlowField mField;
+    mutable size_t mVersion;
+};
+}
+}
+
+#endif
@@ -22,9 +22,16 @@
 #ifndef __NYRA_GAME_GAME_H__
 #define __NYRA_GAME_GAME_H__
 
+#include <atomic>
+#include <mutex>
+#include <thread>
 #include <nyra/game/Options.h>
 #include <nyra/game/Map.h>
+#include <nyra/game/MapLoader.h>
+#include <nyra/game/ProfilerOverlay.h>
+#include <nyra/game/Replay.h>
 #include <nyra/core/FPS.h>
+#include <nyra/core/FixedStep.h>
 #include <nyra/game/Input.h>
 #include <nyra/game/Types.h>
 
@@ -48,28 +55,123 @@ public:
      */
     Game(const Options& options);
 
+    /*
+     *  \func Destructor
+     *  \brief Stops the render thread if it is running.
+     */
+    ~Game();
+
     /*
      *  \func loadMap
-     *  \brief Loads a map object
+     *  \brief Loads a map object. This blocks until the map is loaded. If
+     *         the map was preloaded this only waits for what is left.
      *
      *  \param The filename of the map.
      */
     void loadMap(const std::string filename);
 
+    /*
+     *  \func preloadMap
+     *  \brief Starts loading a map in the background while the current
+     *         map keeps playing.
+     *
+     *  \param filename The filename of the map.
+     */
+    void preloadMap(const std::string& filename);
+
+    /*
+     *  \func changeMap
+     *  \brief Switches to a new map. The current map keeps running until
+     *         the new one has finished loading in the background, then the
+     *         swap happens between frames. Starts a preload if one has not
+     *         been started already.
+     *
+     *  \param filename The filename of the map.
+     */
+    void changeMap(const std::string& filename);
+
+    /*
+     *  \func getGame
+     *  \brief Gets the global game object
+     *
+     *  \return The running game
+     */
+    static Game& getGame()
+    {
+        return *mGame;
+    }
+
+    /*
+     *  \func hasGame
+     *  \brief Checks if a game is running. Tools such as the editor run
+     *         maps and scripts without one.
+     *
+     *  \return True if getGame can be called
+     */
+    static bool hasGame()
+    {
+        return mGame != nullptr;
+    }
+
     /*
      *  \func run
      *  \brief Runs the game. This function blocks until the game
-     *         has ended.
+     *         has ended. The map is updated in fixed steps at the
+     *         simulation rate and rendered as often as possible.
      */
     void run();
 
+    /*
+     *  \func getSeed
+     *  \brief Gets the random seed of the session. Scripts are seeded with
+     *         this so a replay makes the same choices.
+     *
+     *  \return The seed
+     */
+    uint32_t getSeed() const
+    {
+        return mSeed;
+    }
+
 private:
+    void render();
+
+    void renderLoop();
+
+    void stopRendering();
+
+    void runReplay();
+
+    RenderTargetT& getWindowTarget();
+
     const Options mOptions;
-    WindowT mWindow;
-    Input mInput;
-    RenderTargetT mTarget;
+
+    // A replay runs without a display, so it has no window and draws to a
+    // target that does nothing
+    std::unique_ptr<WindowT> mWindow;
+    std::unique_ptr<Input> mInput;
+    std::unique_ptr<graphics::RenderTarget> mTarget;
     std::unique_ptr<Map> mMap;
+    MapLoader mLoader;
+    std::string mNextMap;
     core::FPS mFPS;
+    core::FixedStep mStep;
+    uint32_t mSeed;
+    double mSimulationRate;
+    Replay mReplay;
+    size_t mFrame;
+
+    // Guards the map between the simulation and the render thread. The
+    // simulation holds it for one step at a time. The render thread holds
+    // it while it draws, since drawing writes to the actors. Only clearing
+    // and presenting the frame run alongside the simulation.
+    std::mutex mMutex;
+    std::atomic<double> mAlpha;
+    std::thread mRenderThread;
+    std::atomic<bool> mRendering;
+    std::atomic<size_t> mRenderFPS;
+    std::unique_ptr<ProfilerOverlay> mProfiler;
+    static Game* mGame;
 };
 }
 }
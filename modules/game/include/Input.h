@@ -22,10 +22,12 @@
 #ifndef __NYRA_GAME_INPUT_H__
 #define __NYRA_GAME_INPUT_H__
 
+#include <memory>
 #include <vector>
 #include <unordered_map>
 #include <nyra/json/JSON.h>
 #include <nyra/game/InputValues.h>
+#include <nyra/game/Replay.h>
 #include <nyra/input/sfml/Mouse.h>
 #include <nyra/input/sfml/Keyboard.h>
 
@@ -52,12 +54,57 @@ public:
     Input(nyra::win::Window& window,
           const std::string& filename);
 
+    /*
+     *  \func Constructor
+     *  \brief Sets up an Input object without a window. The devices never
+     *         change, so the inputs only move when they are set by play.
+     *
+     *  \param filename The name of the input.json file.
+     */
+    Input(const std::string& filename);
+
     /*
      *  \func update
      *  \brief Updates the input object.
      */
     void update();
 
+    /*
+     *  \func getNames
+     *  \brief Gets the names of every mapped input, sorted.
+     *
+     *  \return The input names
+     */
+    std::vector<std::string> getNames() const;
+
+    /*
+     *  \func hasInput
+     *  \brief Checks if an input is mapped.
+     *
+     *  \param name The name of the input map
+     *  \return True if the input exists
+     */
+    bool hasInput(const std::string& name) const;
+
+    /*
+     *  \func record
+     *  \brief Adds the current state of every input in the replay as a
+     *         new step. Call this after update.
+     *
+     *  \param replay The replay to add to
+     */
+    void record(Replay& replay);
+
+    /*
+     *  \func play
+     *  \brief Sets every input to a recorded step instead of reading the
+     *         devices. Call this in place of update.
+     *
+     *  \param replay The recorded session
+     *  \param frame The step index
+     */
+    void play(const Replay& replay, size_t frame);
+
     /*
      *  \func isPressed
      *  \brief Checks if the input is pressed
@@ -103,13 +150,26 @@ public:
      */
     const input::Mouse& getMouse() const
     {
-        return mMouse;
+        return *mMouse;
+    }
+
+    /*
+     *  \func hasWindow
+     *  \brief Checks if the devices are read from a window.
+     *
+     *  \return False if the input is only fed by play
+     */
+    bool hasWindow() const
+    {
+        return mHasWindow;
     }
 
 private:
-    input::sfml::Mouse mMouse;
-    input::sfml::Keyboard mKeyboard;
+    std::unique_ptr<input::Mouse> mMouse;
+    std::unique_ptr<input::Keyboard> mKeyboard;
+    bool mHasWindow;
     std::unordered_map<std::string, std::unique_ptr<InputValue>> mInputMap;
+    std::vector<Replay::State> mStates;
     static Input* mInput;
 };
 }
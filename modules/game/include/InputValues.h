@@ -57,6 +57,20 @@ public:
     void update(const input::Mouse& mouse,
                 const input::Keyboard& keyboard);
 
+    /*
+     *  \func setState
+     *  \brief Overrides the input state, for example from a replay.
+     *
+     *  \param isPressed Was the input pressed this step
+     *  \param isDown Is the input held down
+     *  \param isReleased Was the input released this step
+     *  \param value The analog value
+     */
+    void setState(bool isPressed,
+                  bool isDown,
+                  bool isReleased,
+                  float value);
+
     /*
      *  \func isPressed
      *  \brief Checks if the input is pressed
@@ -23,8 +23,16 @@
 #define __NYRA_GAME_MAP_H__
 
 #include <iostream>
+#include <limits>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <nyra/math/SpatialHash.h>
 #include <nyra/game/ActorPtr.h>
 #include <nyra/game/Input.h>
+#include <nyra/game/MapData.h>
+#include <nyra/game/Options.h>
 
 namespace nyra
 {
@@ -41,25 +49,84 @@ public:
     /*
      *  \func Constructor
      *  \brief Sets an empty map and assigns it to the global object.
+     *
+     *  \param input The game input
+     *  \param target The target the map will render to
+     *  \param simulationRate The number of times per second update will
+     *         be called. The physics world steps at this rate.
+     *  \param physics The physics world settings
      */
     Map(const game::Input& input,
-        const graphics::RenderTarget& target);
+        const graphics::RenderTarget& target,
+        double simulationRate,
+        const PhysicsOptions& physics);
 
     /*
      *  \func update
-     *  \brief Updates everything on the map
+     *  \brief Runs a single simulation step on everything on the map
      *
-     *  \param delta The time in seconds since the last update
+     *  \param delta The time in seconds of the step
      */
     void update(double delta);
 
+    /*
+     *  \func acquireSnapshot
+     *  \brief Hands the latest snapshot published by update over to
+     *         render. This must not run at the same time as update, so
+     *         call it under the same lock. Actors destroyed after this
+     *         call are kept alive until the next one.
+     */
+    void acquireSnapshot();
+
     /*
      *  \func render
-     *  \brief Renders the map to the screen.
+     *  \brief Renders the map to the screen. Actors are drawn between
+     *         their positions from the last two simulation steps of the
+     *         acquired snapshot. Drawing moves each actor's renderable
+     *         and advances its animation, so this must not run at the
+     *         same time as update. GUI actors are skipped, see renderGui.
+     *
+     *  \param target The target to render to
+     *  \param alpha How far into the next simulation step the frame is,
+     *         from 0.0 to 1.0.
+     */
+    void render(graphics::RenderTarget& target,
+                double alpha);
+
+    /*
+     *  \func renderCollision
+     *  \brief Renders the collision shapes of the acquired snapshot if
+     *         they are toggled on. The shapes come from the live physics
+     *         bodies, so this must not run at the same time as update.
+     *         Call it after render.
      *
      *  \param target The target to render to
      */
-    void render(graphics::RenderTarget& target);
+    void renderCollision(graphics::RenderTarget& target);
+
+    /*
+     *  \func renderGui
+     *  \brief Renders the GUI actors of the acquired snapshot. The GUI
+     *         library keeps global state that scripts change during
+     *         update, so this must not run at the same time as update.
+     *
+     *  \param target The target to render to
+     *  \param alpha How far into the next simulation step the frame is,
+     *         from 0.0 to 1.0.
+     */
+    void renderGui(graphics::RenderTarget& target,
+                   double alpha);
+
+    /*
+     *  \func hasGui
+     *  \brief Checks if the acquired snapshot has any GUI actors.
+     *
+     *  \return True if renderGui has something to draw
+     */
+    bool hasGui() const
+    {
+        return mFront.hasGui;
+    }
 
     /*
      *  \func spawnActor
@@ -73,6 +140,19 @@ public:
     game::Actor& spawnActor(const std::string& filename,
                             const std::string& name,
                             bool initalize);
+
+    /*
+     *  \func spawnActor
+     *  \brief Adds a new actor to the map from an already parsed prefab
+     *
+     *  \param prefab The actor description
+     *  \param name The name of the actor
+     *  \param initialize Should the actor call initialize when loaded?
+     *  \return The actor
+     */
+    game::Actor& spawnActor(const Prefab& prefab,
+                            const std::string& name,
+                            bool initalize);
     /*
      *  \func destroyActor
      *  \brief Destroys an existing actor. The actor will actually stick
@@ -82,6 +162,30 @@ public:
      */
     void destroyActor(const Actor* actor);
 
+    /*
+     *  \func reservePool
+     *  \brief Turns on pooling for a prefab and creates actors up front so
+     *         count of them can be alive at once without building new
+     *         ones. Destroyed actors of a pooled prefab are parked instead
+     *         of freed and spawnActor hands them out again. This must be
+     *         called from the main thread.
+     *
+     *  \param filename The filename of the Actor json
+     *  \param count The number of actors to keep ready
+     */
+    void reservePool(const std::string& filename,
+                     size_t count);
+
+    /*
+     *  \func reservePool
+     *  \brief Turns on pooling for an already parsed prefab.
+     *
+     *  \param prefab The actor description
+     *  \param count The number of actors to keep ready
+     */
+    void reservePool(const Prefab& prefab,
+                     size_t count);
+
     /*
      *  \func initialize
      *  \brief Called after the map has been loaded and all actors have
@@ -89,16 +193,31 @@ public:
      */
     void initialize();
 
+    /*
+     *  \func load
+     *  \brief Spawns every actor described by the map data and then
+     *         initializes the map. This must be called from the main thread.
+     *
+     *  \param data The parsed map
+     */
+    void load(const MapData& data);
+
     /*
      *  \func getActor
      *  \brief Returns a named actor
      *
      *  \param name The provided name of the actor
      *  \return The actor object
+     *  \throw std::out_of_range If no live actor has the name
      */
     static Actor& getActor(const std::string& name)
     {
-        return *mMap->mActorMap.at(name);
+        Actor* actor = mMap->mActorMap.at(name);
+        if (!actor)
+        {
+            throw std::out_of_range("No actor named " + name);
+        }
+        return *actor;
     }
 
     /*
@@ -112,6 +231,60 @@ public:
         return *mMap;
     }
 
+    /*
+     *  \func queryRect
+     *  \brief Finds the sprite actors whose bounds overlap a rectangle.
+     *         Bounds are taken at the end of the last simulation step.
+     *
+     *  \param min The top left corner
+     *  \param max The bottom right corner
+     *  \param groups Only actors with one of these query group bits are
+     *         returned
+     *  \return The actors
+     */
+    std::vector<Actor*> queryRect(
+            const math::Vector2F& min,
+            const math::Vector2F& max,
+            uint32_t groups = math::SpatialHash::ALL_GROUPS) const;
+
+    /*
+     *  \func queryRadius
+     *  \brief Finds the sprite actors whose bounds overlap a circle.
+     *
+     *  \param center The center of the circle
+     *  \param radius The radius of the circle
+     *  \param groups Only actors with one of these query group bits are
+     *         returned
+     *  \return The actors
+     */
+    std::vector<Actor*> queryRadius(
+            const math::Vector2F& center,
+            float radius,
+            uint32_t groups = math::SpatialHash::ALL_GROUPS) const;
+
+    /*
+     *  \func queryPairs
+     *  \brief Finds every pair of sprite actors with overlapping bounds
+     *         where the first is in groupsA and the second is in groupsB.
+     *         For example bullets against enemies.
+     *
+     *  \param groupsA The query group bits of the first actor
+     *  \param groupsB The query group bits of the second actor
+     *  \return The pairs. Each pair is only listed once.
+     */
+    std::vector<std::pair<Actor*, Actor*> > queryPairs(
+            uint32_t groupsA = math::SpatialHash::ALL_GROUPS,
+            uint32_t groupsB = math::SpatialHash::ALL_GROUPS) const;
+
+    /*
+     *  \func getChecksum
+     *  \brief Hashes the name and transform of every actor. Two maps that
+     *         simulated the same way have the same checksum.
+     *
+     *  \return The checksum
+     */
+    uint64_t getChecksum() const;
+
     static void toggle_render_collision()
     {
         getMap().mRenderCollision = !getMap().mRenderCollision;
@@ -120,15 +293,63 @@ public:
 private:
     void sort();
 
+    void snapshot();
+
+    void updateSpatialHash();
+
+    void releaseActor(const ActorPtr& actor);
+
+    struct ActorSnapshot
+    {
+        Actor* actor;
+        math::Transform2D previous;
+        math::Transform2D current;
+    };
+
+    // Everything render reads from a step. Until render acquires one, the
+    // front snapshot is from no step and holds on to nothing.
+    struct Snapshot
+    {
+        Snapshot() :
+            step(std::numeric_limits<size_t>::max()),
+            renderCollision(false),
+            hasGui(false)
+        {
+        }
+
+        std::vector<ActorSnapshot> actors;
+        size_t step;
+        bool renderCollision;
+        bool hasGui;
+    };
+
     std::vector<ActorPtr> mActors;
     std::unordered_map<std::string, Actor*> mActorMap;
     std::vector<const Actor*> mDestroyedActors;
     std::vector<ActorPtr> mSpawnedActors;
+    std::unordered_map<const Prefab*, std::vector<ActorPtr> > mPools;
     const game::Input& mInput;
     const graphics::RenderTarget& mTarget;
     physics::box2d::World mWorld;
     bool mRenderCollision;
     const Actor* mCamera;
+    math::SpatialHash mSpatialHash;
+    std::vector<Actor*> mIndexedActors;
+    mutable std::vector<uint32_t> mQueryResults;
+
+    // Update fills the back snapshot and swaps it with the published one.
+    // acquireSnapshot swaps the published one to the front, which decides
+    // the actors render draws and the transforms it blends between.
+    Snapshot mBack;
+    Snapshot mPublished;
+    Snapshot mFront;
+    bool mHasPublished;
+    size_t mStep;
+
+    // Destroyed actors and the step of the first snapshot without them.
+    // They are freed, or put back in their pool, once the front snapshot
+    // is at least that new.
+    std::vector<std::pair<size_t, ActorPtr> > mRetiredActors;
     static Map* mMap;
 };
 }
@@ -137,7 +358,8 @@ namespace core
 {
 /*
  *  \func read
- *  \brief Reads an map from file.
+ *  \brief Reads an map from file and loads it. See
+ *         read(const std::string&, game::MapData&) for the formats.
  *
  *  \param pathname The location to save to.
  *  \param actor The map to load
@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2018 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#ifndef __NYRA_GAME_MAP_DATA_H__
+#define __NYRA_GAME_MAP_DATA_H__
+
+#include <string>
+#include <utility>
+#include <vector>
+#include <nyra/math/Vector2.h>
+#include <nyra/game/Prefab.h>
+
+namespace nyra
+{
+namespace game
+{
+/*
+ *  \class ActorPlacement
+ *  \brief Describes a single actor placed in a map. This is only data, so
+ *         it can be built on any thread.
+ */
+struct ActorPlacement
+{
+    /*
+     *  \func Constructor
+     *  \brief Creates an unplaced actor.
+     */
+    ActorPlacement() :
+        prefab(nullptr),
+        hasPosition(false)
+    {
+    }
+
+    const Prefab* prefab;
+    std::string name;
+    bool hasPosition;
+    math::Vector2F position;
+    std::vector<std::pair<std::string, std::string> > variables;
+};
+
+/*
+ *  \class MapData
+ *  \brief Everything needed to build a map without touching a script,
+ *         physics world or window. Reading this is the expensive part of
+ *         loading a map and it is safe to do away from the main thread.
+ */
+struct MapData
+{
+    std::vector<ActorPlacement> actors;
+
+    /*
+     *  \var textures
+     *  \brief Every texture the actors use, relative to the data directory.
+     */
+    std::vector<std::string> textures;
+};
+}
+
+namespace core
+{
+/*
+ *  \func read
+ *  \brief Reads the description of a map. Files ending in
+ *         CompiledMap::EXTENSION are read as compiled maps, anything else
+ *         is read as JSON. Every prefab the map uses is registered.
+ *
+ *  \param pathname The location of the map.
+ *  \param data The map data to fill
+ */
+void read(const std::string& pathname,
+          game::MapData& data);
+}
+}
+
+#endif
@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2018 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#ifndef __NYRA_GAME_MAP_LOADER_H__
+#define __NYRA_GAME_MAP_LOADER_H__
+
+#include <future>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <nyra/game/MapData.h>
+#include <nyra/game/Types.h>
+
+namespace nyra
+{
+namespace game
+{
+/*
+ *  \class LoadedMap
+ *  \brief A map that has been parsed and had all of its textures decoded.
+ *         The sprites are only held so the textures stay resident in the
+ *         shared texture cache until the actors that use them are spawned.
+ */
+struct LoadedMap
+{
+    MapData data;
+    std::vector<std::unique_ptr<SpriteT> > textures;
+};
+
+/*
+ *  \class MapLoader
+ *  \brief Loads maps on worker threads. Reading the map, parsing prefabs
+ *         and decoding textures all happen in the background. Spawning the
+ *         actors still has to happen on the main thread with Map::load,
+ *         because actors own script objects and physics bodies.
+ */
+class MapLoader
+{
+public:
+    /*
+     *  \func preload
+     *  \brief Starts loading a map in the background. Calling this for a
+     *         map that is already loading does nothing.
+     *
+     *  \param filename The filename of the map, relative to the maps
+     *         directory.
+     */
+    void preload(const std::string& filename);
+
+    /*
+     *  \func isReady
+     *  \brief Checks if a preloaded map has finished loading.
+     *
+     *  \param filename The filename of the map
+     *  \return True if get will not block
+     */
+    bool isReady(const std::string& filename) const;
+
+    /*
+     *  \func get
+     *  \brief Takes a loaded map out of the loader. This blocks until the
+     *         map is ready. A map that was never preloaded is loaded
+     *         immediately on the calling thread.
+     *
+     *  \param filename The filename of the map
+     *  \throw If the map could not be loaded
+     *  \return The loaded map
+     */
+    std::unique_ptr<LoadedMap> get(const std::string& filename);
+
+private:
+    static std::unique_ptr<LoadedMap> load(const std::string& filename);
+
+    static std::vector<std::unique_ptr<SpriteT> > loadTextures(
+            const std::vector<std::string>& textures,
+            size_t start,
+            size_t step);
+
+    std::unordered_map<std::string,
+            std::future<std::unique_ptr<LoadedMap> > > mPending;
+};
+}
+}
+
+#endif
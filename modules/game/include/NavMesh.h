@@ -22,8 +22,13 @@
 #ifndef __NYRA_GAME_NAV_MESH_H__
 #define __NYRA_GAME_NAV_MESH_H__
 
+#include <mutex>
+#include <unordered_map>
 #include <unordered_set>
-#include <nyra/math/Graph.h>
+#include <utility>
+#include <vector>
+#include <nyra/math/HierarchicalGraph.h>
+#include <nyra/math/Vector2.h>
 #include <nyra/game/Types.h>
 
 namespace nyra
@@ -49,28 +54,78 @@ public:
 
     /*
      *  \func getPath
-     *  \brief Gets a shortest path from the nav mesh
+     *  \brief Gets a shortest path from the nav mesh. Paths are cached
+     *         until the collision changes. This must not be called from
+     *         more than one thread at a time.
      *
-     *  \param start The starting node
-     *  \param end The ending node
-     *  \return The shortest available path
+     *  \param start The starting tile
+     *  \param end The ending tile
+     *  \return The shortest available path in tiles. This is empty if
+     *          there is no path.
      */
     math::PathResults<math::Vector2F> getPath(
             const math::Vector2F& start,
-            const math::Vector2F& end) const
+            const math::Vector2F& end) const;
+
+    /*
+     *  \func getPaths
+     *  \brief Gets many paths at once. The searches are split across a
+     *         shared thread pool and share the path cache with getPath.
+     *
+     *  \param queries The start and end tile of each path
+     *  \return The paths in the same order as the queries
+     */
+    std::vector<math::PathResults<math::Vector2F> > getPaths(
+            const std::vector<std::pair<math::Vector2F,
+                                        math::Vector2F> >& queries) const;
+
+    /*
+     *  \func setWalkable
+     *  \brief Changes if a tile can be walked through. Only the parts of the
+     *         mesh around the tile are rebuilt and the path cache is
+     *         cleared.
+     *
+     *  \param tile The tile to change
+     *  \param walkable True if paths can go through the tile
+     */
+    void setWalkable(const math::Vector2F& tile, bool walkable);
+
+    /*
+     *  \func getGrid
+     *  \brief Gets the walkable tiles.
+     *
+     *  \return The tile grid
+     */
+    const math::GridGraph& getGrid() const
     {
-        return mGraph.getPath(start, end, mEvent);
+        return mGraph.getGrid();
     }
 
+    /*
+     *  \func getVersion
+     *  \brief Gets a number that changes every time the walkable tiles do.
+     *
+     *  \return The version
+     */
+    size_t getVersion() const
+    {
+        return mVersion;
+    }
 
 private:
-    void addTile(const TileMapT& map,
-                 const std::unordered_set<size_t>& collision,
-                 size_t x, size_t y,
-                 int32_t dx, int32_t dy);
+    bool getIndex(const math::Vector2F& tile, size_t& index) const;
+
+    math::PathResults<math::Vector2F> findPath(
+            const math::Vector2F& start,
+            const math::Vector2F& end,
+            math::HierarchicalGraph::Search& search) const;
 
-    math::Graph<math::Vector2F> mGraph;
-    typename math::Graph<math::Vector2F>::HeuristicEvent mEvent;
+    math::HierarchicalGraph mGraph;
+    mutable std::vector<math::HierarchicalGraph::Search> mSearches;
+    mutable std::unordered_map<uint64_t,
+            math::PathResults<math::Vector2F> > mCache;
+    mutable std::mutex mCacheMutex;
+    size_t mVersion;
 };
 }
 }
@@ -22,6 +22,7 @@
 #ifndef __NYRA_GAME_OPTIONS_H__
 #define __NYRA_GAME_OPTIONS_H__
 
+#include <cstdint>
 #include <string>
 #include <nyra/math/Vector2.h>
 #include <nyra/img/Color.h>
@@ -104,6 +105,108 @@ struct GameOptions
      *  \brief The filename of the input map to load.
      */
     std::string inputMap;
+
+    /*
+     *  \var simulationRate
+     *  \brief The number of times per second scripts and physics are
+     *         updated. This is independent of the render rate.
+     */
+    double simulationRate;
+
+    /*
+     *  \var maxSimulationSteps
+     *  \brief The most simulation steps that will run for a single frame.
+     *         If the game falls further behind than this, the extra time
+     *         is dropped and the game slows down instead.
+     */
+    size_t maxSimulationSteps;
+
+    /*
+     *  \var threadedRendering
+     *  \brief Renders from a separate thread. Window events, input,
+     *         scripts and physics stay on the main thread.
+     */
+    bool threadedRendering;
+
+    /*
+     *  \var showProfiler
+     *  \brief Draws the profiler overlay. This only has an effect when
+     *         built with NYRA_PROFILE.
+     */
+    bool showProfiler;
+
+    /*
+     *  \var profileTrace
+     *  \brief If set, the last profiler samples are written to this file
+     *         as a Chrome trace when the game exits. This only has an
+     *         effect when built with NYRA_PROFILE.
+     */
+    std::string profileTrace;
+
+    /*
+     *  \var seed
+     *  \brief Seeds the script random number generator. 0 picks a seed
+     *         from the clock.
+     */
+    uint32_t seed;
+
+    /*
+     *  \var recordReplay
+     *  \brief If set, the seed and every simulation step of input are
+     *         written to this file when the game exits.
+     */
+    std::string recordReplay;
+
+    /*
+     *  \var playReplay
+     *  \brief If set, the recorded session in this file is played back
+     *         as fast as possible with fixed steps and without rendering.
+     *         No window is opened, so this runs without a display. Actor
+     *         widgets are not built. The game exits once every step has
+     *         run and throws if the final map does not match the
+     *         recording.
+     */
+    std::string playReplay;
+};
+
+/*
+ *  \class PhysicsOptions
+ *  \brief Options related to the physics simulation
+ */
+struct PhysicsOptions
+{
+    /*
+     *  \func Constructor
+     *  \brief Sets default physics options.
+     */
+    PhysicsOptions();
+
+    /*
+     *  \var allowSleeping
+     *  \brief Lets bodies at rest drop out of the simulation until they are
+     *         touched or moved. This saves a lot of work in scenes with
+     *         many bodies that are not moving.
+     */
+    bool allowSleeping;
+
+    /*
+     *  \var subSteps
+     *  \brief The number of physics steps per simulation step. Raise this
+     *         if fast bodies pass through thin walls.
+     */
+    size_t subSteps;
+
+    /*
+     *  \var velocityIterations
+     *  \brief The number of velocity solver iterations per physics step.
+     */
+    int32_t velocityIterations;
+
+    /*
+     *  \var positionIterations
+     *  \brief The number of position solver iterations per physics step.
+     */
+    int32_t positionIterations;
 };
 
 /*
@@ -129,6 +232,12 @@ struct Options
      *  \brief The game options (see above)
      */
     GameOptions game;
+
+    /*
+     *  \var physics
+     *  \brief The physics options (see above)
+     */
+    PhysicsOptions physics;
 };
 }
 }
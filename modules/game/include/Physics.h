@@ -49,10 +49,13 @@ public:
 
     void addTrigger(physics::Trigger2D* trigger);
 
-    void render(graphics::RenderTarget& target);
+    void render(graphics::RenderTarget& target,
+                const math::Transform2D& parent);
 
     void update();
 
+    void setActive(bool active);
+
     math::Vector2F getVelocity() const
     {
         return mBody->getVelocity();
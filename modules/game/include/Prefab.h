@@ -0,0 +1,226 @@
+/*
+ * Copyright (c) 2018 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#ifndef __NYRA_GAME_PREFAB_H__
+#define __NYRA_GAME_PREFAB_H__
+
+#include <string>
+#include <vector>
+#include <unordered_set>
+#include <nyra/json/Document.h>
+#include <nyra/anim/Animation.h>
+#include <nyra/physics/Body.h>
+#include <nyra/math/Vector2.h>
+#include <nyra/mem/Buffer2D.h>
+
+namespace nyra
+{
+namespace game
+{
+/*
+ *  \class Prefab
+ *  \brief A fully parsed actor description. The actor JSON (and any sprite
+ *         JSON it references) is read once and converted into typed values
+ *         so actors can be instantiated without touching the disk or
+ *         converting strings.
+ */
+class Prefab
+{
+public:
+    /*
+     *  \class Script
+     *  \brief The python class that drives the actor.
+     */
+    struct Script
+    {
+        std::string filename;
+        std::string className;
+        std::string update;
+        std::string initialize;
+        std::string reset;
+    };
+
+    /*
+     *  \class Physics
+     *  \brief A physics body or trigger and its collision shapes.
+     */
+    struct Physics
+    {
+        Physics();
+
+        physics::Type type;
+        uint64_t mask;
+        bool hasCircle;
+        double radius;
+        math::Vector2F circleOffset;
+        bool hasBox;
+        math::Vector2F boxSize;
+        math::Vector2F boxOffset;
+        std::string onEnter;
+        std::string onExit;
+    };
+
+    /*
+     *  \class Widget
+     *  \brief A single GUI widget and its children.
+     */
+    struct Widget
+    {
+        Widget();
+
+        std::string type;
+        std::string name;
+        std::string text;
+        bool hasSize;
+        math::Vector2F size;
+        bool hasPosition;
+        math::Vector2F position;
+        std::string activated;
+        std::vector<Widget> children;
+    };
+
+    /*
+     *  \class TileMap
+     *  \brief A tile map and the tiles that should be treated as collision.
+     */
+    struct TileMap
+    {
+        TileMap(const math::Vector2U& mapSize);
+
+        std::string filename;
+        math::Vector2U tileSize;
+        mem::Buffer2D<size_t> tiles;
+        bool hasCollision;
+        std::unordered_set<size_t> collision;
+    };
+
+    /*
+     *  \class Sprite
+     *  \brief The resolved contents of a sprite JSON file.
+     */
+    struct Sprite
+    {
+        Sprite();
+
+        std::string filename;
+        math::Vector2F pivot;
+        math::Vector2U frames;
+    };
+
+    /*
+     *  \class Animation
+     *  \brief A single named frame animation.
+     */
+    struct Animation
+    {
+        std::string name;
+        size_t start;
+        size_t end;
+        double duration;
+        anim::Animation::PlayType playType;
+    };
+
+    /*
+     *  \func Constructor
+     *  \brief Creates an empty prefab. This is an actor with no components.
+     */
+    Prefab();
+
+    /*
+     *  \func Constructor
+     *  \brief Parses a prefab from an actor JSON tree. Any referenced
+     *         sprite files are read as well.
+     *
+     *  \param tree The actor JSON
+     */
+    Prefab(const json::Document& tree);
+
+    /*
+     *  \func get
+     *  \brief Gets a prefab from the global registry. The first request for
+     *         a file parses it, every request after returns the cached copy.
+     *         This is safe to call from loader threads.
+     *
+     *  \param filename The actor filename without the path.
+     *  \return The prefab
+     */
+    static const Prefab& get(const std::string& filename);
+
+    /*
+     *  \func add
+     *  \brief Adds an already built prefab to the global registry. This is
+     *         used by loaders that do not start from JSON. If the filename
+     *         is already registered the existing prefab is kept.
+     *
+     *  \param filename The actor filename without the path.
+     *  \param prefab The prefab. The registry takes ownership.
+     *  \return The registered prefab
+     */
+    static const Prefab& add(const std::string& filename, Prefab* prefab);
+
+    /*
+     *  \func has
+     *  \brief Checks if a prefab is already in the global registry.
+     *
+     *  \param filename The actor filename without the path.
+     *  \return True if the prefab has been loaded.
+     */
+    static bool has(const std::string& filename);
+
+    /*
+     *  \func clear
+     *  \brief Empties the global registry. Any references returned from get
+     *         are invalid after this call.
+     */
+    static void clear();
+
+    /*
+     *  \func getTextures
+     *  \brief Gets every texture an instance of this prefab will load.
+     *         The names are relative to the data directory.
+     *
+     *  \return The texture filenames
+     */
+    std::vector<std::string> getTextures() const;
+
+    bool hasScript;
+    Script script;
+    bool hasPhysics;
+    Physics physics;
+    bool hasTrigger;
+    Physics trigger;
+    bool hasGui;
+    std::vector<Widget> widgets;
+    std::vector<TileMap> tileMaps;
+    bool hasSprite;
+    Sprite sprite;
+    bool hasCamera;
+    bool hasAnimation;
+    math::Vector2U animationFrames;
+    std::vector<Animation> animations;
+    std::string initialAnimation;
+    bool hasLayer;
+    int32_t layer;
+};
+}
+}
+
+#endif
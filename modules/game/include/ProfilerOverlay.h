@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2018 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#ifndef __NYRA_GAME_PROFILER_OVERLAY_H__
+#define __NYRA_GAME_PROFILER_OVERLAY_H__
+
+#include <stdint.h>
+#include <nyra/game/Gui.h>
+
+namespace nyra
+{
+namespace game
+{
+/*
+ *  \class ProfilerOverlay
+ *  \brief Draws a table of the profiled scopes over the game. Each row
+ *         shows the average and worst time for a scope over the last
+ *         second. This only has data when built with NYRA_PROFILE.
+ */
+class ProfilerOverlay
+{
+public:
+    /*
+     *  \func Constructor
+     *  \brief Creates the overlay GUI.
+     *
+     *  \param mouse The mouse object
+     */
+    ProfilerOverlay(const input::Mouse& mouse);
+
+    /*
+     *  \func render
+     *  \brief Refreshes the table once a second and draws it.
+     *
+     *  \param target The target to render to
+     */
+    void render(graphics::RenderTarget& target);
+
+private:
+    void refresh();
+
+    Gui mGui;
+    gui::Widget* mLabel;
+    uint64_t mLastRefresh;
+};
+}
+}
+
+#endif
@@ -0,0 +1,249 @@
+/*
+ * Copyright (c) 2018 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#ifndef __NYRA_GAME_REPLAY_H__
+#define __NYRA_GAME_REPLAY_H__
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+#include <nyra/core/Archive.h>
+
+namespace nyra
+{
+namespace game
+{
+/*
+ *  \class Replay
+ *  \brief Everything needed to play a session back exactly: the seed, the
+ *         starting map, the state of every input for every simulation step
+ *         and when maps were changed. The state of the map at the end is
+ *         stored as a checksum so a playback can tell if it diverged.
+ */
+class Replay
+{
+public:
+    /*
+     *  \class State
+     *  \brief The state of one input for one step
+     */
+    struct State
+    {
+        State();
+
+        State(bool isPressed,
+              bool isDown,
+              bool isReleased,
+              float value);
+
+        bool isPressed;
+        bool isDown;
+        bool isReleased;
+        float value;
+
+        NYRA_SERIALIZE()
+
+        template<class ArchiveT>
+        void serialize(ArchiveT& archive, const unsigned int version)
+        {
+            archive & BOOST_SERIALIZATION_NVP(isPressed);
+            archive & BOOST_SERIALIZATION_NVP(isDown);
+            archive & BOOST_SERIALIZATION_NVP(isReleased);
+            archive & BOOST_SERIALIZATION_NVP(value);
+        }
+    };
+
+    /*
+     *  \func Constructor
+     *  \brief Creates an empty replay to read into.
+     */
+    Replay();
+
+    /*
+     *  \func Constructor
+     *  \brief Starts a new recording.
+     *
+     *  \param seed The random seed of the session
+     *  \param map The filename of the first map
+     *  \param simulationRate The number of steps per second
+     *  \param inputs The names of the recorded inputs
+     */
+    Replay(uint32_t seed,
+           const std::string& map,
+           double simulationRate,
+           const std::vector<std::string>& inputs);
+
+    /*
+     *  \func addFrame
+     *  \brief Records one simulation step.
+     *
+     *  \param states The state of each input, in the order of getInputs
+     */
+    void addFrame(const std::vector<State>& states);
+
+    /*
+     *  \func getFrame
+     *  \brief Gets the input states of a step
+     *
+     *  \param frame The step index
+     *  \return The first of getInputs().size() states
+     */
+    const State* getFrame(size_t frame) const
+    {
+        return mStates.data() + frame * mInputs.size();
+    }
+
+    /*
+     *  \func getNumFrames
+     *  \brief Gets the number of recorded steps
+     *
+     *  \return The number of steps
+     */
+    size_t getNumFrames() const
+    {
+        return mNumFrames;
+    }
+
+    /*
+     *  \func validate
+     *  \brief Checks that a loaded replay can be played. Throws if the
+     *         step count does not match the stored inputs or the
+     *         simulation rate is not positive.
+     */
+    void validate() const;
+
+    /*
+     *  \func addMapChange
+     *  \brief Records that a new map was loaded before a step.
+     *
+     *  \param frame The step that ran first on the new map
+     *  \param map The filename of the map
+     */
+    void addMapChange(size_t frame, const std::string& map);
+
+    /*
+     *  \func getMapChanges
+     *  \brief Gets the map changes in step order.
+     *
+     *  \return The step and map filename of each change
+     */
+    const std::vector<std::pair<uint64_t, std::string> >&
+    getMapChanges() const
+    {
+        return mMapChanges;
+    }
+
+    /*
+     *  \func getSeed
+     *  \brief Gets the random seed of the session
+     *
+     *  \return The seed
+     */
+    uint32_t getSeed() const
+    {
+        return mSeed;
+    }
+
+    /*
+     *  \func getMap
+     *  \brief Gets the first map of the session
+     *
+     *  \return The map filename
+     */
+    const std::string& getMap() const
+    {
+        return mMap;
+    }
+
+    /*
+     *  \func getSimulationRate
+     *  \brief Gets the number of steps per second
+     *
+     *  \return The rate
+     */
+    double getSimulationRate() const
+    {
+        return mSimulationRate;
+    }
+
+    /*
+     *  \func getInputs
+     *  \brief Gets the names of the recorded inputs
+     *
+     *  \return The input names
+     */
+    const std::vector<std::string>& getInputs() const
+    {
+        return mInputs;
+    }
+
+    /*
+     *  \func getChecksum
+     *  \brief Gets the checksum of the map at the end of the recording
+     *
+     *  \return The checksum
+     */
+    uint64_t getChecksum() const
+    {
+        return mChecksum;
+    }
+
+    /*
+     *  \func setChecksum
+     *  \brief Sets the checksum of the map at the end of the recording
+     *
+     *  \param checksum The checksum
+     */
+    void setChecksum(uint64_t checksum)
+    {
+        mChecksum = checksum;
+    }
+
+private:
+    NYRA_SERIALIZE()
+
+    template<class ArchiveT>
+    void serialize(ArchiveT& archive, const unsigned int version)
+    {
+        archive & BOOST_SERIALIZATION_NVP(mSeed);
+        archive & BOOST_SERIALIZATION_NVP(mMap);
+        archive & BOOST_SERIALIZATION_NVP(mSimulationRate);
+        archive & BOOST_SERIALIZATION_NVP(mInputs);
+        archive & BOOST_SERIALIZATION_NVP(mStates);
+        archive & BOOST_SERIALIZATION_NVP(mNumFrames);
+        archive & BOOST_SERIALIZATION_NVP(mMapChanges);
+        archive & BOOST_SERIALIZATION_NVP(mChecksum);
+    }
+
+    uint32_t mSeed;
+    std::string mMap;
+    double mSimulationRate;
+    std::vector<std::string> mInputs;
+    std::vector<State> mStates;
+    uint64_t mNumFrames;
+    std::vector<std::pair<uint64_t, std::string> > mMapChanges;
+    uint64_t mChecksum;
+};
+}
+}
+
+#endif
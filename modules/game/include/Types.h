@@ -23,7 +23,7 @@
 #define __NYRA_GAME_TYPES_H__
 
 #include <nyra/win/sfml/Window.h>
-#include <nyra/graphics/TileMap.h>
+#include <nyra/graphics/sfml/TileMap.h>
 #include <nyra/graphics/sfml/RenderTarget.h>
 #include <nyra/graphics/sfml/Sprite.h>
 #include <nyra/graphics/sfml/Camera.h>
@@ -40,7 +40,7 @@ typedef win::sfml::Window WindowT;
 
 typedef graphics::sfml::RenderTarget RenderTargetT;
 typedef graphics::sfml::Sprite SpriteT;
-typedef graphics::TileMap<SpriteT> TileMapT;
+typedef graphics::sfml::TileMap TileMapT;
 typedef graphics::sfml::Camera CameraT;
 
 typedef physics::box2d::World WorldT;
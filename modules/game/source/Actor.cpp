@@ -20,6 +20,7 @@
  * IN THE SOFTWARE.
  */
 #include <iostream>
+#include <stdexcept>
 #include <nyra/core/Path.h>
 #include <nyra/game/Actor.h>
 
@@ -32,8 +33,11 @@ Actor::Actor() :
     mCurrentAnimation(nullptr),
     mGUI(nullptr),
     mPhysics(*this),
+    mPrefab(nullptr),
     mLayer(0),
-    mHasInit(false)
+    mQueryGroups(1),
+    mHasInit(false),
+    mHasSnapshot(false)
 {
 }
 
@@ -71,6 +75,25 @@ void Actor::initialize()
     mHasInit = true;
 }
 
+//===========================================================================//
+void Actor::reset()
+{
+    setPosition(math::Vector2F());
+    setRotation(0.0f);
+    setScale(math::Vector2F(1.0f, 1.0f));
+
+    mCurrentAnimation = nullptr;
+    mCurrentAnimationName.clear();
+    mQueryGroups = 1;
+    mHasInit = false;
+    mHasSnapshot = false;
+
+    if (mScript.get() && mReset.get())
+    {
+        mReset->call();
+    }
+}
+
 //===========================================================================//
 void Actor::addNavMesh(NavMesh* mesh)
 {
@@ -119,9 +142,56 @@ void Actor::updateTransform()
 {
     static math::Transform2D transform;
     math::Transform2D::updateTransform(transform);
+}
+
+//===========================================================================//
+void Actor::snapshot()
+{
+    mPrevious = mCurrent;
+    mCurrent.setPosition(getPosition());
+    mCurrent.setRotation(getRotation());
+    mCurrent.setScale(getScale());
+    mCurrent.setSize(getSize());
+    mCurrent.setPivot(getPivot());
+
+    // A new actor has nothing to move from
+    if (!mHasSnapshot)
+    {
+        mPrevious = mCurrent;
+        mHasSnapshot = true;
+    }
+}
+
+//===========================================================================//
+void Actor::interpolate(const math::Transform2D& previous,
+                        const math::Transform2D& current,
+                        double alpha)
+{
+    // Rotate the short way around
+    float rotation = current.getRotation() - previous.getRotation();
+    if (rotation > 180.0f)
+    {
+        rotation -= 360.0f;
+    }
+    else if (rotation < -180.0f)
+    {
+        rotation += 360.0f;
+    }
+
+    const math::Transform2D world;
+    mInterpolated.setPosition(previous.getPosition() +
+            (current.getPosition() - previous.getPosition()) * alpha);
+    mInterpolated.setScale(previous.getScale() +
+            (current.getScale() - previous.getScale()) * alpha);
+    mInterpolated.setRotation(previous.getRotation() +
+            rotation * static_cast<float>(alpha));
+    mInterpolated.setSize(current.getSize());
+    mInterpolated.setPivot(current.getPivot());
+    mInterpolated.updateTransform(world);
+
     if (mRenderable.get())
     {
-        mRenderable->updateTransform(*this);
+        mRenderable->updateTransform(mInterpolated);
     }
 }
 
@@ -134,6 +204,12 @@ void Actor::render(graphics::RenderTarget& target)
     }
 }
 
+//===========================================================================//
+void Actor::renderCollision(graphics::RenderTarget& target)
+{
+    mPhysics.render(target, mInterpolated);
+}
+
 //===========================================================================//
 void Actor::setScript(script::Object* script)
 {
@@ -153,6 +229,12 @@ void Actor::setInitializeFunction(const std::string& name)
     mInitialize = mScript->function(name);
 }
 
+//===========================================================================//
+void Actor::setResetFunction(const std::string& name)
+{
+    mReset = mScript->function(name);
+}
+
 //===========================================================================//
 void Actor::callActivateFunction(const std::string& name)
 {
@@ -219,6 +301,10 @@ void Actor::setLayer(int32_t layer)
 //===========================================================================//
 gui::Widget& Actor::getWidget(const std::string& name)
 {
+    if (!mGUI)
+    {
+        throw std::runtime_error("Actor " + mName + " has no widgets");
+    }
     return mGUI->getWidget(name);
 }
 }
@@ -22,7 +22,6 @@
 #include <nyra/game/ActorPtr.h>
 #include <nyra/game/Types.h>
 #include <nyra/core/Path.h>
-#include <nyra/core/String.h>
 
 namespace nyra
 {
@@ -39,14 +38,20 @@ ActorPtr::ActorPtr(const std::string& filename,
                    const game::Input& input,
                    const graphics::RenderTarget& target,
                    physics::World2D& world) :
-    mActor(nullptr)
+    ActorPtr(Prefab::get(filename), input, target, world)
 {
-    const json::JSON map = core::read<json::JSON>(
-            core::path::join(core::DATA_PATH, "actors/" + filename));
+}
 
-    if (map.has("script"))
+//===========================================================================//
+ActorPtr::ActorPtr(const Prefab& prefab,
+                   const game::Input& input,
+                   const graphics::RenderTarget& target,
+                   physics::World2D& world) :
+    mActor(nullptr)
+{
+    if (prefab.hasScript)
     {
-        parseScript(map["script"]);
+        createScript(prefab.script);
     }
     else
     {
@@ -54,250 +59,198 @@ ActorPtr::ActorPtr(const std::string& filename,
         createActor("Actor", include);
     }
 
-    if (map.has("physics"))
+    if (prefab.hasPhysics)
     {
-        parsePhysics(map["physics"], world, false);
+        createPhysics(prefab.physics, world, false);
     }
 
-    if (map.has("trigger"))
+    if (prefab.hasTrigger)
     {
-        parsePhysics(map["trigger"], world, true);
+        createPhysics(prefab.trigger, world, true);
     }
 
-    if (map.has("gui"))
+    // Widgets need a graphics context, and without a window nothing could
+    // click them anyway
+    if (prefab.hasGui && input.hasWindow())
     {
-        parseGui(map["gui"], input.getMouse());
+        createGui(prefab.widgets, input.getMouse());
     }
 
-    if (map.has("tile_map"))
+    for (const Prefab::TileMap& tileMap : prefab.tileMaps)
     {
-        for (size_t ii = 0; ii < map["tile_map"].loopSize(); ++ii)
-        {
-            parseTileMap(map["tile_map"][ii]);
-        }
+        createTileMap(tileMap);
     }
 
     graphics::Sprite* sprite = nullptr;
-    if (map.has("sprite"))
+    if (prefab.hasSprite)
     {
-        if (map["sprite"].loopSize() > 1)
-        {
-            throw std::runtime_error(
-                    "TODO: Cannot support more than 1 "
-                    "sprite on an actor.");
-        }
-
-        for (size_t ii = 0; ii < map["sprite"].loopSize(); ++ii)
-        {
-            sprite = parseSprite(map["sprite"][ii]);
-        }
+        sprite = createSprite(prefab.sprite);
     }
 
-    if (map.has("camera"))
+    if (prefab.hasCamera)
     {
-        parseCamera(map["camera"], target);
+        createCamera(target);
     }
 
     // For now we know we only have one sprite per actor
-    if (map.has("animation"))
+    if (prefab.hasAnimation)
     {
-        parseAnimation(map["animation"], sprite);
+        createAnimations(prefab, sprite);
     }
 
-    if (map.has("layer"))
+    if (prefab.hasLayer)
     {
-        const int32_t layer = core::str::toType<int32_t>(
-                map["layer"].get());
-        mActor->setLayer(layer);
+        mActor->setLayer(prefab.layer);
     }
+
+    mActor->setPrefab(&prefab);
 }
 
 //===========================================================================//
-void ActorPtr::parsePhysics(const mem::Tree<std::string>& map,
-                            physics::World2D& world,
-                            bool isTrigger)
+void ActorPtr::reset()
 {
-    const std::string stype = map["type"].get();
-    physics::Type type = physics::STATIC;
+    const Prefab& prefab = *mActor->getPrefab();
 
-    if (stype == "dynamic")
-    {
-        type = physics::DYNAMIC;
-    }
-    else if (stype == "character")
+    // The widgets were built when the actor was created, so only what a
+    // script could have changed is put back
+    if (mActor->getGUI())
     {
-        type = physics::CHARACTER;
+        resetWidgets(prefab.widgets, mActor->getGUI()->get());
     }
 
-    // TODO: Expose mask names to a serial interface
-    // 00001 Player collision   0x01
-    // 00010 Enemy collision    0x02
-    // 10000 Rigid collision    0x04
-    uint64_t mask = 0;
-    if (map.has("mask"))
-    {
-        const std::vector<std::string> maskNames =
-                core::str::split(map["mask"].get(), ",");
-
-        for (const std::string& name : maskNames)
-        {
-            if (name == "player")
-            {
-                mask |= 0x01;
-            }
-            else if (name == "enemy")
-            {
-                mask |= 0x02;
-            }
-            else if (name == "rigid")
-            {
-                mask |= 0x04;
-            }
-        }
-    }
-    else
-    {
-        mask = 0x01 | 0x02 | 0x04;
-    }
+    mActor->setLayer(prefab.hasLayer ? prefab.layer : 0);
+    mActor->reset();
+}
 
+//===========================================================================//
+void ActorPtr::createPhysics(const Prefab::Physics& physics,
+                             physics::World2D& world,
+                             bool isTrigger)
+{
     if (isTrigger)
     {
-        auto body = world.createTrigger(type, mask, *mActor);
+        auto body = world.createTrigger(physics.type, physics.mask, *mActor);
         mActor->getPhysics().addTrigger(body.release());
 
-        if (map.has("onEnter"))
+        if (!physics.onEnter.empty())
         {
-            mActor->getPhysics().setOnEnter(map["onEnter"].get());
+            mActor->getPhysics().setOnEnter(physics.onEnter);
         }
 
-        if (map.has("onExit"))
+        if (!physics.onExit.empty())
         {
-            mActor->getPhysics().setOnExit(map["onExit"].get());
+            mActor->getPhysics().setOnExit(physics.onExit);
         }
     }
     else
     {
-        auto body = world.createBody(type, mask, *mActor, 1.0, 0.3);
+        auto body = world.createBody(physics.type, physics.mask,
+                                     *mActor, 1.0, 0.3);
         mActor->getPhysics().addBody(body.release());
     }
 
-    if (map.has("circle"))
+    if (physics.hasCircle)
     {
-        const auto& circle = map["circle"];
-        const double radius = core::str::toType<double>(
-                circle["radius"].get());
-        math::Vector2F offset;
-        if (circle.has("offset"))
-        {
-            offset.x = core::str::toType<double>(
-                    circle["offset"]["x"].get());
-            offset.y = core::str::toType<double>(
-                    circle["offset"]["y"].get());
-        }
-
-        mActor->getPhysics().addCircleCollision(radius, offset);
+        mActor->getPhysics().addCircleCollision(physics.radius,
+                                                physics.circleOffset);
     }
 
-    if (map.has("box"))
+    if (physics.hasBox)
     {
-        const auto& box = map["box"];
-
-        math::Vector2F size(
-                core::str::toType<double>(box["size"]["x"].get()),
-                core::str::toType<double>(box["size"]["y"].get()));
-
-        math::Vector2F offset;
-        if (box.has("offset"))
-        {
-            offset.x = core::str::toType<double>(
-                    box["offset"]["x"].get());
-            offset.y = core::str::toType<double>(
-                    box["offset"]["y"].get());
-        }
-
-        mActor->getPhysics().addBoxCollision(size, offset);
+        mActor->getPhysics().addBoxCollision(physics.boxSize,
+                                             physics.boxOffset);
     }
 }
 
 //===========================================================================//
-void ActorPtr::parseGui(const mem::Tree<std::string>& map,
-                        const input::Mouse& mouse)
+void ActorPtr::createGui(const std::vector<Prefab::Widget>& widgets,
+                         const input::Mouse& mouse)
 {
     Gui* gui = new Gui(mouse);
-    parseWidgets(map, gui->get());
+    createWidgets(widgets, gui->get());
     gui->finalize();
     mActor->addGUI(gui);
     mActor->setType(Actor::GUI);
 }
 
 //===========================================================================//
-void ActorPtr::parseWidgets(const mem::Tree<std::string>& map,
+void ActorPtr::createWidgets(const std::vector<Prefab::Widget>& widgets,
+                             mem::Tree<gui::Widget>& gui)
+{
+    for (const Prefab::Widget& wDef : widgets)
+    {
+        gui::Widget* widget = Gui::addWidget(
+                wDef.type, wDef.text, wDef.name, gui);
+
+        if (wDef.hasSize)
+        {
+            widget->setSize(wDef.size);
+        }
+
+        if (wDef.hasPosition)
+        {
+            widget->setPosition(wDef.position);
+        }
+
+        if (!wDef.activated.empty())
+        {
+            mActor->setActivatedFunction(wDef.activated, widget->activated);
+        }
+
+        createWidgets(wDef.children, gui[wDef.name]);
+    }
+}
+
+//===========================================================================//
+void ActorPtr::resetWidgets(const std::vector<Prefab::Widget>& widgets,
                             mem::Tree<gui::Widget>& gui)
 {
-    if (map.has("widget"))
+    for (const Prefab::Widget& wDef : widgets)
     {
-        for (size_t ii = 0; ii < map["widget"].loopSize(); ++ii)
+        mem::Tree<gui::Widget>& node = gui[wDef.name];
+        gui::Widget& widget = node.get();
+
+        // The parameter of an image is its texture, not text
+        if (wDef.type != "image")
+        {
+            widget.setText(wDef.text);
+        }
+
+        if (wDef.hasSize)
+        {
+            widget.setSize(wDef.size);
+        }
+
+        if (wDef.hasPosition)
         {
-            const auto& wMap = map["widget"][ii];
-            const std::string type = wMap["type"].get();
-            const std::string name = wMap["name"].get();
-            std::string param;
-
-            if (wMap.has("text"))
-            {
-                param = wMap["text"].get();
-            }
-            gui::Widget* widget = Gui::addWidget(
-                    type, param, name, gui);
-
-            if (wMap.has("size"))
-            {
-                const math::Vector2F size(
-                        core::str::toType<float>(
-                                wMap["size"]["width"].get()),
-                        core::str::toType<float>(
-                                wMap["size"]["height"].get()));
-                widget->setSize(size);
-            }
-
-            if (wMap.has("position"))
-            {
-                const math::Vector2F position(
-                        core::str::toType<float>(
-                                wMap["position"]["x"].get()),
-                        core::str::toType<float>(
-                                wMap["position"]["y"].get()));
-                widget->setPosition(position);
-            }
-
-            if (wMap.has("activated"))
-            {
-                const std::string onPressed = wMap["activated"].get();
-                mActor->setActivatedFunction(onPressed, widget->activated);
-            }
-
-            parseWidgets(wMap, gui[name]);
+            widget.setPosition(wDef.position);
         }
+
+        widget.setVisible(true);
+        resetWidgets(wDef.children, node);
     }
 }
 
 //===========================================================================//
-void ActorPtr::parseScript(const mem::Tree<std::string>& map)
+void ActorPtr::createScript(const Prefab::Script& script)
 {
-    const std::string filename = map["filename"].get();
-    const std::string className = map["class"].get();
-    IncludeT include(filename);
+    IncludeT include(script.filename);
+
+    createActor(script.className, include);
 
-    createActor(className, include);
+    if (!script.update.empty())
+    {
+        mActor->setUpdateFunction(script.update);
+    }
 
-    if (map.has("update"))
+    if (!script.initialize.empty())
     {
-        mActor->setUpdateFunction(map["update"].get());
+        mActor->setInitializeFunction(script.initialize);
     }
 
-    if (map.has("initialize"))
+    if (!script.reset.empty())
     {
-        mActor->setInitializeFunction(map["initialize"].get());
+        mActor->setResetFunction(script.reset);
     }
 }
 
@@ -313,68 +266,39 @@ void ActorPtr::createActor(const std::string& className,
 }
 
 //===========================================================================//
-graphics::Sprite* ActorPtr::parseSprite(
-        const mem::Tree<std::string>& map) const
+graphics::Sprite* ActorPtr::createSprite(const Prefab::Sprite& sprite) const
 {
-    const std::string filename = map["filename"].get();
-    std::unique_ptr<Sprite> sprite(new Sprite());
+    std::unique_ptr<Sprite> newSprite(new Sprite());
 
-    if (!filename.empty())
+    if (!sprite.filename.empty())
     {
-        core::read(core::path::join(core::DATA_PATH, "sprites/" + filename), *sprite);
+        newSprite->initialize(sprite.filename, sprite.pivot, sprite.frames);
     }
-    mActor->addSprite(sprite.release());
+    mActor->addSprite(newSprite.release());
 
     // TODO: We don't need to return a sprite here
     return nullptr;
 }
 
 //===========================================================================//
-void ActorPtr::parseTileMap(const mem::Tree<std::string>& map) const
+void ActorPtr::createTileMap(const Prefab::TileMap& tileMap) const
 {
-    const std::string filename = map["filename"].get();
-
-    math::Vector2U tileSize(
-            core::str::toType<size_t>(
-                    map["tile_size"]["width"].get()),
-            core::str::toType<size_t>(
-                    map["tile_size"]["height"].get()));
-    math::Vector2U mapSize(map["tiles"][0].loopSize(),
-                           map["tiles"].loopSize());
-    mem::Buffer2D<size_t> tiles(mapSize);
-
-    for (size_t row = 0; row < tiles.getNumRows(); ++row)
-    {
-        for (size_t col = 0; col < tiles.getNumCols(); ++col)
-        {
-            tiles(col, row) = core::str::toType<size_t>(
-                    map["tiles"][row][col].get());
-        }
-    }
-
     const std::string pathname = core::path::join(
-            core::DATA_PATH, "textures/" + filename);
+            core::DATA_PATH, "textures/" + tileMap.filename);
     TileMapT* mapPtr = new TileMapT(
-            pathname, tiles, tileSize);
+            pathname, tileMap.tiles, tileMap.tileSize);
     mActor->addTileMap(mapPtr);
 
     // Check for a navmesh
-    if (map.has("collision"))
+    if (tileMap.hasCollision)
     {
-        std::unordered_set<size_t> collision;
-        for (size_t ii = 0; ii < map["collision"].loopSize(); ++ii)
-        {
-            collision.insert(core::str::toType<size_t>(
-                    map["collision"][ii].get()));
-        }
-        NavMesh* navMesh = new NavMesh(*mapPtr, collision);
+        NavMesh* navMesh = new NavMesh(*mapPtr, tileMap.collision);
         mActor->addNavMesh(navMesh);
     }
 }
 
 //===========================================================================//
-void ActorPtr::parseCamera(const mem::Tree<std::string>& map,
-                           const graphics::RenderTarget& target) const
+void ActorPtr::createCamera(const graphics::RenderTarget& target) const
 {
     graphics::Camera2D* camera = new CameraT(target);
 
@@ -385,60 +309,21 @@ void ActorPtr::parseCamera(const mem::Tree<std::string>& map,
 }
 
 //===========================================================================//
-void ActorPtr::parseAnimation(const mem::Tree<std::string>& map,
-                              graphics::Sprite* sprite) const
+void ActorPtr::createAnimations(const Prefab& prefab,
+                                graphics::Sprite* sprite) const
 {
-    // TODO: Support different frames for each animation
-    const math::Vector2U frames(
-            core::str::toType<size_t>(
-                    map["frames"]["cols"].get()),
-            core::str::toType<size_t>(
-                    map["frames"]["rows"].get()));
-
-    for (size_t ii = 0; ii < map["anims"].loopSize(); ++ii)
+    for (const Prefab::Animation& animDef : prefab.animations)
     {
-        const auto& currAnim = map["anims"][ii];
-        const std::string name = currAnim["name"].get();
-        const size_t start = core::str::toType<size_t>(
-                currAnim["start"].get());
-        const size_t end = core::str::toType<size_t>(
-                currAnim["end"].get());
-        const double duration = core::str::toType<double>(
-                currAnim["duration"].get());
-        anim::Animation::PlayType playType = anim::Animation::LOOP;
-
-        if (currAnim.has("type"))
-        {
-            const std::string type = currAnim["type"].get();
-            if (type == "ping_pong")
-            {
-                playType = anim::Animation::PING_PONG;
-            }
-            else if (type == "once")
-            {
-                playType = anim::Animation::ONCE;
-            }
-            else if (type == "loop")
-            {
-                playType = anim::Animation::LOOP;
-            }
-            else
-            {
-                throw std::runtime_error(
-                        "Unknown animation type: " + type);
-            }
-        }
         anim::Frame<graphics::Sprite>* anim =
                 new anim::Frame<graphics::Sprite>(
-                        start, end, duration,
-                        playType, frames, *sprite);
-        mActor->addAnimation(name, anim);
+                        animDef.start, animDef.end, animDef.duration,
+                        animDef.playType, prefab.animationFrames, *sprite);
+        mActor->addAnimation(animDef.name, anim);
     }
 
-    if (map.has("initial"))
+    if (!prefab.initialAnimation.empty())
     {
-        const std::string initial = map["initial"].get();
-        mActor->playAnimation(initial);
+        mActor->playAnimation(prefab.initialAnimation);
     }
 }
 }
@@ -0,0 +1,836 @@
+/*
+ * Copyright (c) 2018 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <unordered_map>
+#include <nyra/game/CompiledMap.h>
+#include <nyra/json/Document.h>
+#include <nyra/core/Path.h>
+#include <nyra/core/String.h>
+
+namespace
+{
+//===========================================================================//
+static const char MAGIC[8] = {'N', 'Y', 'R', 'A', 'M', 'A', 'P', '\0'};
+
+// GUI layouts are never close to this deep. Anything past it is corrupt.
+static const size_t MAX_WIDGET_DEPTH = 64;
+
+//===========================================================================//
+struct StringRef
+{
+    uint32_t offset;
+    uint32_t length;
+};
+
+//===========================================================================//
+struct Header
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t numPrefabs;
+    uint32_t numActors;
+    uint32_t numVariables;
+    uint32_t numTextures;
+    uint32_t reserved;
+    uint64_t stringsOffset;
+    uint64_t stringsSize;
+    uint64_t prefabsOffset;
+    uint64_t actorsOffset;
+    uint64_t variablesOffset;
+    uint64_t texturesOffset;
+};
+
+//===========================================================================//
+struct PrefabRecord
+{
+    StringRef filename;
+    uint64_t offset;
+    uint64_t size;
+};
+
+//===========================================================================//
+struct ActorRecord
+{
+    uint32_t prefab;
+    uint32_t hasPosition;
+    StringRef name;
+    float x;
+    float y;
+    uint32_t firstVariable;
+    uint32_t numVariables;
+};
+
+//===========================================================================//
+struct VariableRecord
+{
+    StringRef name;
+    StringRef value;
+};
+
+static_assert(sizeof(StringRef) == 8, "Unexpected StringRef padding");
+static_assert(sizeof(Header) == 80, "Unexpected Header padding");
+static_assert(sizeof(PrefabRecord) == 24, "Unexpected PrefabRecord padding");
+static_assert(sizeof(ActorRecord) == 32, "Unexpected ActorRecord padding");
+static_assert(sizeof(VariableRecord) == 16,
+              "Unexpected VariableRecord padding");
+
+// The fewest bytes each repeated prefab element can be encoded in. Counts
+// read from the file are checked against these before anything is sized.
+static const size_t MIN_WIDGET_SIZE = 4 * sizeof(StringRef) +
+        2 * sizeof(uint8_t) + 4 * sizeof(float) + sizeof(uint32_t);
+static const size_t MIN_TILE_MAP_SIZE = sizeof(StringRef) +
+        4 * sizeof(uint32_t) + sizeof(uint8_t) + sizeof(uint32_t);
+static const size_t MIN_ANIMATION_SIZE = sizeof(StringRef) +
+        3 * sizeof(uint32_t) + sizeof(double);
+
+//===========================================================================//
+class StringTable
+{
+public:
+    StringRef add(const std::string& value)
+    {
+        auto iter = mOffsets.find(value);
+        if (iter == mOffsets.end())
+        {
+            iter = mOffsets.insert(std::make_pair(
+                    value, static_cast<uint32_t>(mData.size()))).first;
+            mData += value;
+        }
+
+        StringRef ref;
+        ref.offset = iter->second;
+        ref.length = static_cast<uint32_t>(value.size());
+        return ref;
+    }
+
+    const std::string& getData() const
+    {
+        return mData;
+    }
+
+private:
+    std::unordered_map<std::string, uint32_t> mOffsets;
+    std::string mData;
+};
+
+//===========================================================================//
+class Writer
+{
+public:
+    Writer(StringTable& strings) :
+        mStrings(strings)
+    {
+    }
+
+    template <typename T>
+    void put(const T& value)
+    {
+        const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&value);
+        mBuffer.insert(mBuffer.end(), bytes, bytes + sizeof(T));
+    }
+
+    void putBytes(const void* data, size_t size)
+    {
+        const uint8_t* bytes = static_cast<const uint8_t*>(data);
+        mBuffer.insert(mBuffer.end(), bytes, bytes + size);
+    }
+
+    void putString(const std::string& value)
+    {
+        put(mStrings.add(value));
+    }
+
+    void putVector(const nyra::math::Vector2F& value)
+    {
+        put<float>(value.x);
+        put<float>(value.y);
+    }
+
+    void putVector(const nyra::math::Vector2U& value)
+    {
+        put<uint32_t>(value.x);
+        put<uint32_t>(value.y);
+    }
+
+    void align()
+    {
+        mBuffer.resize((mBuffer.size() + 7) & ~static_cast<size_t>(7));
+    }
+
+    size_t getSize() const
+    {
+        return mBuffer.size();
+    }
+
+    const std::vector<uint8_t>& getBuffer() const
+    {
+        return mBuffer;
+    }
+
+    std::vector<uint8_t>& getBuffer()
+    {
+        return mBuffer;
+    }
+
+private:
+    StringTable& mStrings;
+    std::vector<uint8_t> mBuffer;
+};
+
+//===========================================================================//
+class Reader
+{
+public:
+    Reader(const uint8_t* data,
+           size_t size,
+           const char* strings,
+           size_t stringsSize) :
+        mData(data),
+        mEnd(data + size),
+        mStrings(strings),
+        mStringsSize(stringsSize)
+    {
+    }
+
+    template <typename T>
+    T get()
+    {
+        if (getRemaining() < sizeof(T))
+        {
+            throw std::runtime_error("Compiled map prefab is truncated");
+        }
+
+        T value;
+        std::memcpy(&value, mData, sizeof(T));
+        mData += sizeof(T);
+        return value;
+    }
+
+    uint32_t getCount(size_t elementSize)
+    {
+        const uint32_t count = get<uint32_t>();
+        if (count > getRemaining() / elementSize)
+        {
+            throw std::runtime_error("Compiled map prefab is truncated");
+        }
+        return count;
+    }
+
+    std::string getString()
+    {
+        return toString(get<StringRef>());
+    }
+
+    nyra::math::Vector2F getVector2F()
+    {
+        const float x = get<float>();
+        const float y = get<float>();
+        return nyra::math::Vector2F(x, y);
+    }
+
+    nyra::math::Vector2U getVector2U()
+    {
+        const uint32_t x = get<uint32_t>();
+        const uint32_t y = get<uint32_t>();
+        return nyra::math::Vector2U(x, y);
+    }
+
+    nyra::math::Vector2U getGridSize(size_t elementSize)
+    {
+        const nyra::math::Vector2U size = getVector2U();
+        if (static_cast<uint64_t>(size.x) * size.y >
+                getRemaining() / elementSize)
+        {
+            throw std::runtime_error("Compiled map prefab is truncated");
+        }
+        return size;
+    }
+
+    size_t getRemaining() const
+    {
+        return mEnd - mData;
+    }
+
+    std::string toString(const StringRef& ref) const
+    {
+        if (static_cast<size_t>(ref.offset) + ref.length > mStringsSize)
+        {
+            throw std::runtime_error("Compiled map string is out of bounds");
+        }
+        return std::string(mStrings + ref.offset, ref.length);
+    }
+
+private:
+    const uint8_t* mData;
+    const uint8_t* const mEnd;
+    const char* const mStrings;
+    const size_t mStringsSize;
+};
+
+//===========================================================================//
+void writePhysics(const nyra::game::Prefab::Physics& physics,
+                  Writer& writer)
+{
+    writer.put<uint32_t>(physics.type);
+    writer.put<uint64_t>(physics.mask);
+    writer.put<uint8_t>(physics.hasCircle);
+    writer.put<double>(physics.radius);
+    writer.putVector(physics.circleOffset);
+    writer.put<uint8_t>(physics.hasBox);
+    writer.putVector(physics.boxSize);
+    writer.putVector(physics.boxOffset);
+    writer.putString(physics.onEnter);
+    writer.putString(physics.onExit);
+}
+
+//===========================================================================//
+void readPhysics(Reader& reader,
+                 nyra::game::Prefab::Physics& physics)
+{
+    physics.type = static_cast<nyra::physics::Type>(reader.get<uint32_t>());
+    physics.mask = reader.get<uint64_t>();
+    physics.hasCircle = reader.get<uint8_t>() != 0;
+    physics.radius = reader.get<double>();
+    physics.circleOffset = reader.getVector2F();
+    physics.hasBox = reader.get<uint8_t>() != 0;
+    physics.boxSize = reader.getVector2F();
+    physics.boxOffset = reader.getVector2F();
+    physics.onEnter = reader.getString();
+    physics.onExit = reader.getString();
+}
+
+//===========================================================================//
+void writeWidgets(const std::vector<nyra::game::Prefab::Widget>& widgets,
+                  Writer& writer)
+{
+    writer.put<uint32_t>(widgets.size());
+    for (const auto& widget : widgets)
+    {
+        writer.putString(widget.type);
+        writer.putString(widget.name);
+        writer.putString(widget.text);
+        writer.put<uint8_t>(widget.hasSize);
+        writer.putVector(widget.size);
+        writer.put<uint8_t>(widget.hasPosition);
+        writer.putVector(widget.position);
+        writer.putString(widget.activated);
+        writeWidgets(widget.children, writer);
+    }
+}
+
+//===========================================================================//
+void readWidgets(Reader& reader,
+                 std::vector<nyra::game::Prefab::Widget>& widgets,
+                 size_t depth = 0)
+{
+    if (depth > MAX_WIDGET_DEPTH)
+    {
+        throw std::runtime_error("Compiled map widgets are nested too deep");
+    }
+
+    const uint32_t numWidgets = reader.getCount(MIN_WIDGET_SIZE);
+    widgets.resize(numWidgets);
+    for (auto& widget : widgets)
+    {
+        widget.type = reader.getString();
+        widget.name = reader.getString();
+        widget.text = reader.getString();
+        widget.hasSize = reader.get<uint8_t>() != 0;
+        widget.size = reader.getVector2F();
+        widget.hasPosition = reader.get<uint8_t>() != 0;
+        widget.position = reader.getVector2F();
+        widget.activated = reader.getString();
+        readWidgets(reader, widget.children, depth + 1);
+    }
+}
+
+//===========================================================================//
+void writePrefab(const nyra::game::Prefab& prefab,
+                 Writer& writer)
+{
+    writer.put<uint8_t>(prefab.hasScript);
+    writer.putString(prefab.script.filename);
+    writer.putString(prefab.script.className);
+    writer.putString(prefab.script.update);
+    writer.putString(prefab.script.initialize);
+    writer.putString(prefab.script.reset);
+
+    writer.put<uint8_t>(prefab.hasPhysics);
+    writePhysics(prefab.physics, writer);
+    writer.put<uint8_t>(prefab.hasTrigger);
+    writePhysics(prefab.trigger, writer);
+
+    writer.put<uint8_t>(prefab.hasGui);
+    writeWidgets(prefab.widgets, writer);
+
+    writer.put<uint32_t>(prefab.tileMaps.size());
+    for (const auto& tileMap : prefab.tileMaps)
+    {
+        writer.putString(tileMap.filename);
+        writer.putVector(tileMap.tileSize);
+        writer.putVector(tileMap.tiles.getSize());
+        for (size_t ii = 0; ii < tileMap.tiles.getSize().product(); ++ii)
+        {
+            writer.put<uint32_t>(tileMap.tiles(ii));
+        }
+        writer.put<uint8_t>(tileMap.hasCollision);
+        writer.put<uint32_t>(tileMap.collision.size());
+        for (size_t tile : tileMap.collision)
+        {
+            writer.put<uint32_t>(tile);
+        }
+    }
+
+    writer.put<uint8_t>(prefab.hasSprite);
+    writer.putString(prefab.sprite.filename);
+    writer.putVector(prefab.sprite.pivot);
+    writer.putVector(prefab.sprite.frames);
+
+    writer.put<uint8_t>(prefab.hasCamera);
+
+    writer.put<uint8_t>(prefab.hasAnimation);
+    writer.putVector(prefab.animationFrames);
+    writer.put<uint32_t>(prefab.animations.size());
+    for (const auto& anim : prefab.animations)
+    {
+        writer.putString(anim.name);
+        writer.put<uint32_t>(anim.start);
+        writer.put<uint32_t>(anim.end);
+        writer.put<double>(anim.duration);
+        writer.put<uint32_t>(anim.playType);
+    }
+    writer.putString(prefab.initialAnimation);
+
+    writer.put<uint8_t>(prefab.hasLayer);
+    writer.put<int32_t>(prefab.layer);
+}
+
+//===========================================================================//
+nyra::game::Prefab* readPrefab(Reader& reader)
+{
+    std::unique_ptr<nyra::game::Prefab> prefab(new nyra::game::Prefab());
+
+    prefab->hasScript = reader.get<uint8_t>() != 0;
+    prefab->script.filename = reader.getString();
+    prefab->script.className = reader.getString();
+    prefab->script.update = reader.getString();
+    prefab->script.initialize = reader.getString();
+    prefab->script.reset = reader.getString();
+
+    prefab->hasPhysics = reader.get<uint8_t>() != 0;
+    readPhysics(reader, prefab->physics);
+    prefab->hasTrigger = reader.get<uint8_t>() != 0;
+    readPhysics(reader, prefab->trigger);
+
+    prefab->hasGui = reader.get<uint8_t>() != 0;
+    readWidgets(reader, prefab->widgets);
+
+    const uint32_t numTileMaps = reader.getCount(MIN_TILE_MAP_SIZE);
+    for (size_t ii = 0; ii < numTileMaps; ++ii)
+    {
+        const std::string filename = reader.getString();
+        const nyra::math::Vector2U tileSize = reader.getVector2U();
+        nyra::game::Prefab::TileMap tileMap(
+                reader.getGridSize(sizeof(uint32_t)));
+        tileMap.filename = filename;
+        tileMap.tileSize = tileSize;
+        for (size_t jj = 0; jj < tileMap.tiles.getSize().product(); ++jj)
+        {
+            tileMap.tiles(jj) = reader.get<uint32_t>();
+        }
+        tileMap.hasCollision = reader.get<uint8_t>() != 0;
+        const uint32_t numCollision = reader.getCount(sizeof(uint32_t));
+        for (size_t jj = 0; jj < numCollision; ++jj)
+        {
+            tileMap.collision.insert(reader.get<uint32_t>());
+        }
+        prefab->tileMaps.push_back(tileMap);
+    }
+
+    prefab->hasSprite = reader.get<uint8_t>() != 0;
+    prefab->sprite.filename = reader.getString();
+    prefab->sprite.pivot = reader.getVector2F();
+    prefab->sprite.frames = reader.getVector2U();
+
+    prefab->hasCamera = reader.get<uint8_t>() != 0;
+
+    prefab->hasAnimation = reader.get<uint8_t>() != 0;
+    prefab->animationFrames = reader.getVector2U();
+    const uint32_t numAnimations = reader.getCount(MIN_ANIMATION_SIZE);
+    prefab->animations.resize(numAnimations);
+    for (auto& anim : prefab->animations)
+    {
+        anim.name = reader.getString();
+        anim.start = reader.get<uint32_t>();
+        anim.end = reader.get<uint32_t>();
+        anim.duration = reader.get<double>();
+        anim.playType = static_cast<nyra::anim::Animation::PlayType>(
+                reader.get<uint32_t>());
+    }
+    prefab->initialAnimation = reader.getString();
+
+    prefab->hasLayer = reader.get<uint8_t>() != 0;
+    prefab->layer = reader.get<int32_t>();
+
+    return prefab.release();
+}
+
+//===========================================================================//
+template <typename T>
+const T* getSection(const nyra::core::MappedFile& file,
+                    uint64_t offset,
+                    size_t count)
+{
+    if (offset > file.getSize() ||
+        count > (file.getSize() - offset) / sizeof(T))
+    {
+        throw std::runtime_error("Compiled map section is out of bounds: " +
+                                 file.getPathname());
+    }
+    return reinterpret_cast<const T*>(file.getData() + offset);
+}
+
+//===========================================================================//
+const Header& getHeader(const nyra::core::MappedFile& file)
+{
+    return *getSection<Header>(file, 0, 1);
+}
+
+//===========================================================================//
+Reader getReader(const nyra::core::MappedFile& file,
+                 const uint8_t* data,
+                 size_t size)
+{
+    const Header& header = getHeader(file);
+    const char* strings = getSection<char>(
+            file, header.stringsOffset, header.stringsSize);
+    return Reader(data, size, strings, header.stringsSize);
+}
+}
+
+namespace nyra
+{
+namespace game
+{
+//===========================================================================//
+const uint32_t CompiledMap::VERSION = 2;
+const std::string CompiledMap::EXTENSION = ".nmap";
+
+//===========================================================================//
+CompiledMap::CompiledMap(const std::string& pathname) :
+    mFile(pathname)
+{
+    if (mFile.getSize() < sizeof(Header))
+    {
+        throw std::runtime_error("File is too small to be a compiled map: " +
+                                 pathname);
+    }
+
+    const Header& header = getHeader(mFile);
+    if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0)
+    {
+        throw std::runtime_error("File is not a compiled map: " + pathname);
+    }
+
+    if (header.version != VERSION)
+    {
+        throw std::runtime_error(
+                "Compiled map " + pathname + " is version " +
+                core::str::toString(header.version) + ", expected " +
+                core::str::toString(VERSION) + ". Recompile the map.");
+    }
+
+    // Validate all of the sections up front so they can be used in place
+    getSection<char>(mFile, header.stringsOffset, header.stringsSize);
+    getSection<PrefabRecord>(mFile, header.prefabsOffset, header.numPrefabs);
+    getSection<ActorRecord>(mFile, header.actorsOffset, header.numActors);
+    getSection<VariableRecord>(
+            mFile, header.variablesOffset, header.numVariables);
+    getSection<StringRef>(mFile, header.texturesOffset, header.numTextures);
+}
+
+//===========================================================================//
+std::vector<std::string> CompiledMap::getTextures() const
+{
+    const Header& header = getHeader(mFile);
+    const StringRef* textures = getSection<StringRef>(
+            mFile, header.texturesOffset, header.numTextures);
+    const Reader reader = getReader(mFile, nullptr, 0);
+
+    std::vector<std::string> ret;
+    ret.reserve(header.numTextures);
+    for (size_t ii = 0; ii < header.numTextures; ++ii)
+    {
+        ret.push_back(reader.toString(textures[ii]));
+    }
+    return ret;
+}
+
+//===========================================================================//
+void CompiledMap::registerPrefabs() const
+{
+    const Header& header = getHeader(mFile);
+    const PrefabRecord* prefabs = getSection<PrefabRecord>(
+            mFile, header.prefabsOffset, header.numPrefabs);
+
+    for (size_t ii = 0; ii < header.numPrefabs; ++ii)
+    {
+        const Reader names = getReader(mFile, nullptr, 0);
+        const std::string filename = names.toString(prefabs[ii].filename);
+
+        if (Prefab::has(filename))
+        {
+            continue;
+        }
+
+        Reader reader = getReader(
+                mFile,
+                getSection<uint8_t>(mFile, prefabs[ii].offset,
+                                    prefabs[ii].size),
+                prefabs[ii].size);
+        Prefab::add(filename, readPrefab(reader));
+    }
+}
+
+//===========================================================================//
+void CompiledMap::read(MapData& data) const
+{
+    registerPrefabs();
+
+    const Header& header = getHeader(mFile);
+    const PrefabRecord* prefabRecords = getSection<PrefabRecord>(
+            mFile, header.prefabsOffset, header.numPrefabs);
+    const ActorRecord* actors = getSection<ActorRecord>(
+            mFile, header.actorsOffset, header.numActors);
+    const VariableRecord* variables = getSection<VariableRecord>(
+            mFile, header.variablesOffset, header.numVariables);
+    const Reader reader = getReader(mFile, nullptr, 0);
+
+    std::vector<const Prefab*> prefabs(header.numPrefabs);
+    for (size_t ii = 0; ii < prefabs.size(); ++ii)
+    {
+        prefabs[ii] = &Prefab::get(reader.toString(prefabRecords[ii].filename));
+    }
+
+    data.actors.resize(header.numActors);
+    for (size_t ii = 0; ii < header.numActors; ++ii)
+    {
+        const ActorRecord& record = actors[ii];
+        if (record.prefab >= prefabs.size() ||
+            record.firstVariable > header.numVariables ||
+            record.numVariables > header.numVariables - record.firstVariable)
+        {
+            throw std::runtime_error("Compiled map actor is corrupt: " +
+                                     mFile.getPathname());
+        }
+
+        ActorPlacement& actor = data.actors[ii];
+        actor.prefab = prefabs[record.prefab];
+        actor.name = reader.toString(record.name);
+        actor.hasPosition = record.hasPosition != 0;
+        actor.position = math::Vector2F(record.x, record.y);
+
+        for (size_t var = 0; var < record.numVariables; ++var)
+        {
+            const VariableRecord& variable =
+                    variables[record.firstVariable + var];
+            actor.variables.push_back(std::make_pair(
+                    reader.toString(variable.name),
+                    reader.toString(variable.value)));
+        }
+    }
+
+    data.textures = getTextures();
+}
+
+//===========================================================================//
+void compileMap(const std::string& mapPathname,
+                const std::string& outPathname)
+{
+    const json::Document tree = core::read<json::Document>(mapPathname);
+
+    StringTable strings;
+    std::vector<std::string> prefabNames;
+    std::unordered_map<std::string, uint32_t> prefabIndices;
+    std::vector<ActorRecord> actors;
+    std::vector<VariableRecord> variables;
+
+    if (tree.has("actors"))
+    {
+        for (size_t ii = 0; ii < tree["actors"].loopSize(); ++ii)
+        {
+            const auto& actorMap = tree["actors"][ii];
+            const std::string filename = actorMap["filename"].get();
+
+            auto index = prefabIndices.find(filename);
+            if (index == prefabIndices.end())
+            {
+                index = prefabIndices.insert(std::make_pair(
+                        filename,
+                        static_cast<uint32_t>(prefabNames.size()))).first;
+                prefabNames.push_back(filename);
+            }
+
+            ActorRecord record;
+            std::memset(&record, 0, sizeof(record));
+            record.prefab = index->second;
+            record.name = strings.add(
+                    actorMap.has("name") ? actorMap["name"].get() : "");
+
+            if (actorMap.has("position"))
+            {
+                record.hasPosition = 1;
+                record.x = core::str::toType<double>(
+                        actorMap["position"]["x"].get());
+                record.y = core::str::toType<double>(
+                        actorMap["position"]["y"].get());
+            }
+
+            record.firstVariable = variables.size();
+            if (actorMap.has("var"))
+            {
+                const auto& vars = actorMap["var"];
+                for (size_t var = 0; var < vars.loopSize(); ++var)
+                {
+                    VariableRecord variable;
+                    variable.name = strings.add(vars[var]["name"].get());
+                    variable.value = strings.add(vars[var]["value"].get());
+                    variables.push_back(variable);
+                }
+            }
+            record.numVariables = variables.size() - record.firstVariable;
+            actors.push_back(record);
+        }
+    }
+
+    // Encode the prefabs and gather up every texture they use.
+    std::vector<PrefabRecord> prefabRecords;
+    std::vector<StringRef> textures;
+    std::unordered_map<std::string, bool> seenTextures;
+    Writer prefabData(strings);
+    for (const std::string& filename : prefabNames)
+    {
+        const Prefab& prefab = Prefab::get(filename);
+
+        PrefabRecord record;
+        record.filename = strings.add(filename);
+        record.offset = prefabData.getSize();
+        writePrefab(prefab, prefabData);
+        record.size = prefabData.getSize() - record.offset;
+        prefabData.align();
+        prefabRecords.push_back(record);
+
+        for (const std::string& texture : prefab.getTextures())
+        {
+            if (seenTextures.insert(std::make_pair(texture, true)).second)
+            {
+                textures.push_back(strings.add(texture));
+            }
+        }
+    }
+
+    // Lay out the file. Every section starts on an 8 byte boundary.
+    StringTable unused;
+    Writer file(unused);
+
+    Header header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = CompiledMap::VERSION;
+    header.numPrefabs = prefabRecords.size();
+    header.numActors = actors.size();
+    header.numVariables = variables.size();
+    header.numTextures = textures.size();
+    file.put(header);
+
+    header.stringsOffset = file.getSize();
+    header.stringsSize = strings.getData().size();
+    file.putBytes(strings.getData().data(), strings.getData().size());
+    file.align();
+
+    header.prefabsOffset = file.getSize();
+    const size_t prefabDataOffset = header.prefabsOffset +
+            prefabRecords.size() * sizeof(PrefabRecord);
+    for (PrefabRecord& record : prefabRecords)
+    {
+        record.offset += prefabDataOffset;
+        file.put(record);
+    }
+    file.putBytes(prefabData.getBuffer().data(), prefabData.getSize());
+    file.align();
+
+    header.actorsOffset = file.getSize();
+    for (const ActorRecord& record : actors)
+    {
+        file.put(record);
+    }
+
+    header.variablesOffset = file.getSize();
+    for (const VariableRecord& record : variables)
+    {
+        file.put(record);
+    }
+
+    header.texturesOffset = file.getSize();
+    for (const StringRef& texture : textures)
+    {
+        file.put(texture);
+    }
+
+    std::memcpy(file.getBuffer().data(), &header, sizeof(header));
+
+    // Write next to the map and move it into place so a short write
+    // never leaves a corrupt map behind, and a map that is already
+    // mapped is never truncated under its reader.
+    const std::string tempPathname = outPathname + ".tmp";
+    {
+        std::ofstream stream(tempPathname, std::ofstream::binary);
+        if (!stream.good())
+        {
+            throw std::runtime_error("Failed to open file: " + tempPathname);
+        }
+        stream.write(reinterpret_cast<const char*>(file.getBuffer().data()),
+                     file.getSize());
+        stream.close();
+        if (!stream.good())
+        {
+            std::remove(tempPathname.c_str());
+            throw std::runtime_error("Failed to write file: " + tempPathname);
+        }
+    }
+
+    if (std::rename(tempPathname.c_str(), outPathname.c_str()) != 0)
+    {
+        // Windows will not rename over an existing file
+        std::remove(outPathname.c_str());
+        if (std::rename(tempPathname.c_str(), outPathname.c_str()) != 0)
+        {
+            std::remove(tempPathname.c_str());
+            throw std::runtime_error("Failed to write file: " + outPathname);
+        }
+    }
+}
+}
+}
@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) 2018 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#include <nyra/game/FlowField.h>
+
+namespace nyra
+{
+namespace game
+{
+FlowField::FlowField(const NavMesh& navMesh) :
+    mNavMesh(navMesh),
+    mField(navMesh.getGrid()),
+    mVersion(navMesh.getVersion())
+{
+}
+
+void FlowField::setGoal(const math::Vector2F& tile)
+{
+    sync();
+
+    size_t index = 0;
+    if (getIndex(tile, index))
+    {
+        mField.setGoal(index);
+    }
+}
+
+math::Vector2F FlowField::getGoal() const
+{
+    const size_t width = mNavMesh.getGrid().getWidth();
+    return math::Vector2F(mField.getGoal() % width,
+                          mField.getGoal() / width);
+}
+
+bool FlowField::hasPath(const math::Vector2F& tile) const
+{
+    sync();
+
+    size_t index = 0;
+    return getIndex(tile, index) && mField.hasPath(index);
+}
+
+float FlowField::getDistance(const math::Vector2F& tile) const
+{
+    sync();
+
+    size_t index = 0;
+    return getIndex(tile, index) ? mField.getDistance(index) : -1.0f;
+}
+
+math::Vector2F FlowField::getNext(const math::Vector2F& tile) const
+{
+    sync();
+
+    size_t index = 0;
+    if (!getIndex(tile, index))
+    {
+        return tile;
+    }
+
+    const size_t next = mField.getNext(index);
+    const size_t width = mNavMesh.getGrid().getWidth();
+    return math::Vector2F(next % width, next / width);
+}
+
+bool FlowField::getIndex(const math::Vector2F& tile, size_t& index) const
+{
+    if (tile.x < 0.0f || tile.y < 0.0f)
+    {
+        return false;
+    }
+
+    const size_t x = static_cast<size_t>(tile.x);
+    const size_t y = static_cast<size_t>(tile.y);
+    const math::GridGraph& grid = mNavMesh.getGrid();
+    if (x >= grid.getWidth() || y >= grid.getHeight())
+    {
+        return false;
+    }
+
+    index = grid.getIndex(x, y);
+    return true;
+}
+
+void FlowField::sync() const
+{
+    // The collision changed since the field was last built
+    if (mVersion != mNavMesh.getVersion())
+    {
+        mField.rebuild();
+        mVersion = mNavMesh.getVersion();
+    }
+}
+}
+}
@@ -19,57 +19,311 @@
  * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
  * IN THE SOFTWARE.
  */
+#include <iostream>
+#include <stdexcept>
 #include <nyra/game/Game.h>
 #include <nyra/core/Path.h>
 #include <nyra/core/String.h>
+#include <nyra/core/Time.h>
+#include <nyra/core/Profiler.h>
+#include <nyra/graphics/NullRenderTarget.h>
 
 namespace nyra
 {
 namespace game
 {
+Game* Game::mGame = nullptr;
+
 Game::Game(const Options& options) :
     mOptions(options),
-    mWindow(mOptions.window.name,
-            mOptions.window.size,
-            mOptions.window.position),
-    mInput(mWindow, mOptions.game.inputMap),
-    mTarget(mWindow)
+    mStep(mOptions.game.simulationRate,
+          mOptions.game.maxSimulationSteps),
+    mSeed(mOptions.game.seed),
+    mSimulationRate(mOptions.game.simulationRate),
+    mFrame(0),
+    mAlpha(0.0),
+    mRendering(false),
+    mRenderFPS(0)
 {
-    loadMap(mOptions.game.startingMap);
+    mGame = this;
+
+    if (mOptions.game.playReplay.empty())
+    {
+        mWindow.reset(new WindowT(mOptions.window.name,
+                                  mOptions.window.size,
+                                  mOptions.window.position));
+        mInput.reset(new Input(*mWindow, mOptions.game.inputMap));
+        mTarget.reset(new RenderTargetT(*mWindow));
+    }
+    else
+    {
+        mInput.reset(new Input(mOptions.game.inputMap));
+        mTarget.reset(new graphics::NullRenderTarget(mOptions.window.size));
+    }
+
+    std::string startingMap = mOptions.game.startingMap;
+    if (!mOptions.game.playReplay.empty())
+    {
+        core::read(mOptions.game.playReplay, mReplay, core::BINARY);
+        mReplay.validate();
+        for (const std::string& name : mReplay.getInputs())
+        {
+            if (!mInput->hasInput(name))
+            {
+                throw std::runtime_error("Replay " +
+                                         mOptions.game.playReplay +
+                                         " uses unknown input " + name);
+            }
+        }
+        mSeed = mReplay.getSeed();
+        mSimulationRate = mReplay.getSimulationRate();
+        startingMap = mReplay.getMap();
+    }
+    else
+    {
+        if (mSeed == 0)
+        {
+            mSeed = static_cast<uint32_t>(core::epoch());
+        }
+
+        if (!mOptions.game.recordReplay.empty())
+        {
+            mReplay = Replay(mSeed, startingMap, mSimulationRate,
+                             mInput->getNames());
+        }
+    }
+    loadMap(startingMap);
+
+#ifdef NYRA_PROFILE
+    if (mOptions.game.showProfiler && mWindow.get())
+    {
+        mProfiler.reset(new ProfilerOverlay(mInput->getMouse()));
+    }
+#endif
 
     // Prep the fps object
     mFPS();
 }
 
+Game::~Game()
+{
+    stopRendering();
+    mGame = nullptr;
+}
+
 void Game::loadMap(const std::string filename)
 {
-    mMap.reset(new Map(mInput, mTarget));
-    core::read(
-            core::path::join(core::DATA_PATH, "maps/" + filename),
-            *mMap);
+    std::unique_ptr<LoadedMap> loaded = mLoader.get(filename);
+    std::lock_guard<std::mutex> lock(mMutex);
+    mMap.reset(new Map(*mInput, *mTarget, mSimulationRate,
+                       mOptions.physics));
+    mMap->load(loaded->data);
+}
+
+void Game::preloadMap(const std::string& filename)
+{
+    mLoader.preload(filename);
+}
+
+void Game::changeMap(const std::string& filename)
+{
+    mLoader.preload(filename);
+    mNextMap = filename;
 }
 
 void Game::run()
 {
+    if (!mOptions.game.playReplay.empty())
+    {
+        runReplay();
+        return;
+    }
+
+    const bool recording = !mOptions.game.recordReplay.empty();
+
+    if (mOptions.game.threadedRendering)
+    {
+        // The render thread takes over the OpenGL context
+        getWindowTarget().setActive(false);
+        mRendering = true;
+        mRenderThread = std::thread(&Game::renderLoop, this);
+    }
+
     double elapsed = 0.0;
-    while (mWindow.isOpen())
+    while (mWindow->isOpen())
     {
+        NYRA_PROFILE_SCOPE("Game::frame");
+
+        // Swap maps between frames so nothing is running on the old map
+        if (!mNextMap.empty() && mLoader.isReady(mNextMap))
+        {
+            const std::string filename = mNextMap;
+            mNextMap.clear();
+            loadMap(filename);
+            if (recording)
+            {
+                mReplay.addMapChange(mFrame, filename);
+            }
+
+            // Do not count spawning the actors as frame time
+            mFPS();
+        }
+
         const double delta = mFPS();
         elapsed += delta;
 
         if (elapsed > 1.0)
         {
-            mWindow.setName(mOptions.window.name + " " +
-                    core::str::toString(mFPS.getFPS()) +
+            const size_t fps = mOptions.game.threadedRendering ?
+                    mRenderFPS.load() : mFPS.getFPS();
+            mWindow->setName(mOptions.window.name + " " +
+                    core::str::toString(fps) +
                     " FPS");
             elapsed = 0.0;
         }
-        mWindow.update();
-        mInput.update();
-        mMap->update(delta);
-        mTarget.clear(mOptions.graphics.clearColor);
-        mMap->render(mTarget);
-        mTarget.flush();
+        mWindow->update();
+
+        const size_t steps = mStep(delta);
+        for (size_t ii = 0; ii < steps; ++ii)
+        {
+            // Each step takes the lock on its own so the render thread can
+            // draw in between catch up steps.
+            {
+                std::lock_guard<std::mutex> lock(mMutex);
+                mInput->update();
+                if (recording)
+                {
+                    mInput->record(mReplay);
+                }
+                mMap->update(mStep.getStep());
+                ++mFrame;
+            }
+
+            if (mOptions.game.threadedRendering)
+            {
+                std::this_thread::yield();
+            }
+        }
+        mAlpha = mStep.getAlpha();
+
+        if (!mOptions.game.threadedRendering)
+        {
+            render();
+        }
+        else if (steps == 0)
+        {
+            // Nothing is due yet so let the render thread have the map
+            core::sleep(1);
+        }
+    }
+
+    stopRendering();
+
+    if (recording)
+    {
+        mReplay.setChecksum(mMap->getChecksum());
+        core::write(mReplay, mOptions.game.recordReplay, core::BINARY);
+    }
+
+#ifdef NYRA_PROFILE
+    if (!mOptions.game.profileTrace.empty())
+    {
+        core::Profiler::writeChromeTrace(mOptions.game.profileTrace);
+    }
+#endif
+}
+
+void Game::runReplay()
+{
+    // Steps are a fixed size and run back to back. Wall clock time is
+    // never looked at so the simulation matches the recording exactly.
+    // There is no window, the input only changes through play and nothing
+    // is drawn.
+    const double step = 1.0 / mSimulationRate;
+    const auto& changes = mReplay.getMapChanges();
+    size_t change = 0;
+    const size_t start = core::epoch();
+
+    for (size_t frame = 0; frame < mReplay.getNumFrames(); ++frame)
+    {
+        while (change < changes.size() && changes[change].first == frame)
+        {
+            loadMap(changes[change].second);
+            ++change;
+        }
+
+        // Scripts still ask for map changes but the recording decides when
+        // they happen
+        mNextMap.clear();
+
+        mInput->play(mReplay, frame);
+        mMap->update(step);
+    }
+
+    const double seconds = (core::epoch() - start) / 1000.0;
+    std::cout << "Replayed " << mReplay.getNumFrames() << " steps in "
+              << seconds << " seconds" << std::endl;
+
+    if (mMap->getChecksum() != mReplay.getChecksum())
+    {
+        throw std::runtime_error("Replay " + mOptions.game.playReplay +
+                                 " did not match the recording");
+    }
+}
+
+void Game::render()
+{
+    NYRA_PROFILE_SCOPE("Game::render");
+
+    mTarget->clear(mOptions.graphics.clearColor);
+
+    {
+        // Drawing moves the actors' renderables, advances animations and
+        // builds tile map chunks, so the simulation waits until it is done
+        std::lock_guard<std::mutex> lock(mMutex);
+        Map& map = *mMap;
+        map.acquireSnapshot();
+        map.render(*mTarget, mAlpha);
+        map.renderCollision(*mTarget);
+        if (map.hasGui())
+        {
+            map.renderGui(*mTarget, mAlpha);
+        }
+
+        if (mProfiler.get())
+        {
+            mProfiler->render(*mTarget);
+        }
+    }
+
+    // Presenting can wait on vsync, so the simulation is free to run
+    mTarget->flush();
+}
+
+void Game::renderLoop()
+{
+    core::FPS fps;
+    while (mRendering)
+    {
+        render();
+        fps();
+        mRenderFPS = fps.getFPS();
+    }
+}
+
+RenderTargetT& Game::getWindowTarget()
+{
+    // Only called with a window, a replay never renders
+    return static_cast<RenderTargetT&>(*mTarget);
+}
+
+void Game::stopRendering()
+{
+    if (mRenderThread.joinable())
+    {
+        mRendering = false;
+        mRenderThread.join();
+        getWindowTarget().setActive(true);
     }
 }
 }
@@ -19,9 +19,13 @@
 * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
 * IN THE SOFTWARE.
 */
-#include <nyra/json/JSON.h>
+#include <algorithm>
+#include <nyra/json/Document.h>
 #include <nyra/game/Input.h>
 #include <nyra/core/Path.h>
+#include <nyra/core/Profiler.h>
+#include <nyra/input/NullMouse.h>
+#include <nyra/input/NullKeyboard.h>
 
 namespace nyra
 {
@@ -31,8 +35,17 @@ Input* Input::mInput = nullptr;
 
 Input::Input(nyra::win::Window& window,
              const std::string& filename) :
-    mMouse(window),
-    mKeyboard(window)
+    Input(filename)
+{
+    mMouse.reset(new input::sfml::Mouse(window));
+    mKeyboard.reset(new input::sfml::Keyboard(window));
+    mHasWindow = true;
+}
+
+Input::Input(const std::string& filename) :
+    mMouse(new input::NullMouse()),
+    mKeyboard(new input::NullKeyboard()),
+    mHasWindow(false)
 {
     mInput = this;
 
@@ -41,8 +54,8 @@ Input::Input(nyra::win::Window& window,
 
     if (core::path::exists(pathname))
     {
-        const json::JSON tree =
-                core::read<json::JSON>(pathname);
+        const json::Document tree =
+                core::read<json::Document>(pathname);
 
         if (tree.has("input"))
         {
@@ -63,11 +76,56 @@ Input::Input(nyra::win::Window& window,
 
 void Input::update()
 {
-    mMouse.update();
-    mKeyboard.update();
+    NYRA_PROFILE_SCOPE("Input::update");
+    mMouse->update();
+    mKeyboard->update();
     for (auto& map : mInputMap)
     {
-        map.second->update(mMouse, mKeyboard);
+        map.second->update(*mMouse, *mKeyboard);
+    }
+}
+
+std::vector<std::string> Input::getNames() const
+{
+    std::vector<std::string> names;
+    for (const auto& map : mInputMap)
+    {
+        names.push_back(map.first);
+    }
+    std::sort(names.begin(), names.end());
+    return names;
+}
+
+bool Input::hasInput(const std::string& name) const
+{
+    return mInputMap.find(name) != mInputMap.end();
+}
+
+void Input::record(Replay& replay)
+{
+    const std::vector<std::string>& names = replay.getInputs();
+    mStates.resize(names.size());
+    for (size_t ii = 0; ii < names.size(); ++ii)
+    {
+        const InputValue& value = *mInputMap.at(names[ii]);
+        mStates[ii] = Replay::State(value.isPressed(),
+                                    value.isDown(),
+                                    value.isReleased(),
+                                    value.getValue());
+    }
+    replay.addFrame(mStates);
+}
+
+void Input::play(const Replay& replay, size_t frame)
+{
+    const std::vector<std::string>& names = replay.getInputs();
+    const Replay::State* states = replay.getFrame(frame);
+    for (size_t ii = 0; ii < names.size(); ++ii)
+    {
+        mInputMap.at(names[ii])->setState(states[ii].isPressed,
+                                          states[ii].isDown,
+                                          states[ii].isReleased,
+                                          states[ii].value);
     }
 }
 
@@ -126,6 +126,17 @@ void InputValue::update(const input::Mouse& mouse,
         mValue = mIsDown ? 1.0f : 0.0f;
     }
 }
+
+void InputValue::setState(bool isPressed,
+                          bool isDown,
+                          bool isReleased,
+                          float value)
+{
+    mIsPressed = isPressed;
+    mIsDown = isDown;
+    mIsReleased = isReleased;
+    mValue = value;
+}
 }
 }
 
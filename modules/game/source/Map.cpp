@@ -19,8 +19,15 @@
 * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
 * IN THE SOFTWARE.
 */
+#include <algorithm>
 #include <nyra/game/Map.h>
-#include <nyra/core/String.h>
+#include <nyra/core/Profiler.h>
+
+namespace
+{
+// Size of a spatial query cell in pixels
+static const float QUERY_CELL_SIZE = 128.0f;
+}
 
 namespace nyra
 {
@@ -31,23 +38,37 @@ Map* Map::mMap = nullptr;
 
 //===========================================================================//
 Map::Map(const game::Input& input,
-         const graphics::RenderTarget& target) :
+         const graphics::RenderTarget& target,
+         double simulationRate,
+         const PhysicsOptions& physics) :
     mInput(input),
     mTarget(target),
-    // TODO: This should be a part of config params
-    mWorld(64.0, 0.0, 60.0),
+    // TODO: Pixels per meter and gravity should be a part of config params
+    mWorld(64.0, 0.0, simulationRate),
     mRenderCollision(false),
-    mCamera(nullptr)
+    mCamera(nullptr),
+    mSpatialHash(QUERY_CELL_SIZE),
+    mHasPublished(false),
+    mStep(0)
 {
     mMap = this;
+    mWorld.setAllowSleeping(physics.allowSleeping);
+    mWorld.setSubSteps(physics.subSteps);
+    mWorld.setIterations(physics.velocityIterations,
+                         physics.positionIterations);
 }
 
 //===========================================================================//
 void Map::update(double delta)
 {
-    for (size_t ii = 0; ii < mActors.size(); ++ii)
+    NYRA_PROFILE_SCOPE("Map::update");
+
     {
-        mActors[ii].get()->update(delta);
+        NYRA_PROFILE_SCOPE("Map::update scripts");
+        for (size_t ii = 0; ii < mActors.size(); ++ii)
+        {
+            mActors[ii].get()->update(delta);
+        }
     }
 
     // Add new actors
@@ -61,72 +82,149 @@ void Map::update(double delta)
         mSpawnedActors.clear();
     }
 
-    if (mWorld.update(delta))
     {
-        for (size_t ii = 0; ii < mActors.size(); ++ii)
+        NYRA_PROFILE_SCOPE("Map::update physics");
+        if (mWorld.update(delta))
         {
-            mActors[ii].get()->getPhysics().update();
+            mWorld.syncTransforms();
         }
     }
 
-    for (size_t ii = 0; ii < mActors.size(); ++ii)
     {
-        mActors[ii].get()->updateTransform();
+        NYRA_PROFILE_SCOPE("Map::update transforms");
+        for (size_t ii = 0; ii < mActors.size(); ++ii)
+        {
+            mActors[ii].get()->updateTransform();
+        }
     }
 
-    // Kill dead actors
-    for (auto actor : mDestroyedActors)
+    // Kill dead actors in a single pass over the list
+    if (!mDestroyedActors.empty())
     {
-        for (auto it = mActors.begin();  it!=mActors.end(); ++it)
+        std::sort(mDestroyedActors.begin(), mDestroyedActors.end());
+
+        size_t alive = 0;
+        for (size_t ii = 0; ii < mActors.size(); ++ii)
         {
-            if(it->get() == actor)
+            if (std::binary_search(mDestroyedActors.begin(),
+                                   mDestroyedActors.end(),
+                                   mActors[ii].get()))
             {
-                const auto mapIter = mActorMap.find(actor->getName());
-                if (mapIter != mActorMap.end())
-                {
-                    mActorMap.erase(mapIter);
-                }
-
-                // TODO: This is a strange interaction. The actor pointer is
-                //       actually owned by the script. So to make it fall
-                //       out of scope, we need to remove the script.
-                it->get()->setScript(nullptr);
-                mActors.erase(it);
-                break;
+                releaseActor(mActors[ii]);
+            }
+            else
+            {
+                mActors[alive++] = mActors[ii];
             }
         }
+        mActors.resize(alive);
+        mDestroyedActors.clear();
     }
-    mDestroyedActors.clear();
+
+    // Sort for rendering. This keeps everything drawing in the correct
+    // order. Without this an object in front in terms of y position will
+    // render differently above or below an object. Sorting here instead of
+    // in render keeps the update order independent of the frame rate.
+    sort();
+
+    updateSpatialHash();
+    snapshot();
 }
 
 //===========================================================================//
-void Map::render(graphics::RenderTarget& target)
+void Map::render(graphics::RenderTarget& target,
+                 double alpha)
 {
-    // Sort before rendering. This keeps everything drawing in the correct
-    // order. Without this an object in front in terms of y position will
-    // render differently above or below an object
-    sort();
+    NYRA_PROFILE_SCOPE("Map::render");
 
-    for (size_t ii = 0; ii < mActors.size(); ++ii)
+    for (const ActorSnapshot& snapshot : mFront.actors)
     {
-        mActors[ii].get()->render(target);
+        if (snapshot.actor->getType() != Actor::GUI)
+        {
+            snapshot.actor->interpolate(snapshot.previous,
+                                        snapshot.current,
+                                        alpha);
+            snapshot.actor->render(target);
+        }
     }
+}
 
-    if (mRenderCollision)
+//===========================================================================//
+void Map::renderCollision(graphics::RenderTarget& target)
+{
+    NYRA_PROFILE_SCOPE("Map::renderCollision");
+
+    if (mFront.renderCollision)
     {
-        for (size_t ii = 0; ii < mActors.size(); ++ii)
+        for (const ActorSnapshot& snapshot : mFront.actors)
         {
-            mActors[ii].get()->getPhysics().render(target);
+            snapshot.actor->renderCollision(target);
         }
     }
 }
 
+//===========================================================================//
+void Map::renderGui(graphics::RenderTarget& target,
+                    double alpha)
+{
+    NYRA_PROFILE_SCOPE("Map::renderGui");
+
+    for (const ActorSnapshot& snapshot : mFront.actors)
+    {
+        if (snapshot.actor->getType() == Actor::GUI)
+        {
+            snapshot.actor->interpolate(snapshot.previous,
+                                        snapshot.current,
+                                        alpha);
+            snapshot.actor->render(target);
+        }
+    }
+}
+
+//===========================================================================//
+void Map::acquireSnapshot()
+{
+    if (mHasPublished)
+    {
+        std::swap(mFront, mPublished);
+        mHasPublished = false;
+    }
+}
+
 //===========================================================================//
 game::Actor& Map::spawnActor(const std::string& filename,
                              const std::string& name,
                              bool initalize)
 {
-    game::ActorPtr actor(filename, mInput, mTarget, mWorld);
+    return spawnActor(Prefab::get(filename), name, initalize);
+}
+
+//===========================================================================//
+game::Actor& Map::spawnActor(const Prefab& prefab,
+                             const std::string& name,
+                             bool initalize)
+{
+    game::ActorPtr actor;
+    const auto pool = mPools.find(&prefab);
+    if (pool != mPools.end() && !pool->second.empty())
+    {
+        actor = pool->second.back();
+        pool->second.pop_back();
+
+        actor.reset();
+        if (!prefab.initialAnimation.empty())
+        {
+            actor.get()->playAnimation(prefab.initialAnimation);
+        }
+
+        // Move the body to the reset transform before it wakes up
+        actor.get()->getPhysics().update();
+        actor.get()->getPhysics().setActive(true);
+    }
+    else
+    {
+        actor = game::ActorPtr(prefab, mInput, mTarget, mWorld);
+    }
     actor.get()->setName(name);
 
     if (!initalize)
@@ -158,6 +256,27 @@ void Map::destroyActor(const Actor* actor)
     mDestroyedActors.push_back(actor);
 }
 
+//===========================================================================//
+void Map::reservePool(const std::string& filename,
+                      size_t count)
+{
+    reservePool(Prefab::get(filename), count);
+}
+
+//===========================================================================//
+void Map::reservePool(const Prefab& prefab,
+                      size_t count)
+{
+    std::vector<ActorPtr>& pool = mPools[&prefab];
+    pool.reserve(count);
+    while (pool.size() < count)
+    {
+        ActorPtr actor(prefab, mInput, mTarget, mWorld);
+        actor.get()->getPhysics().setActive(false);
+        pool.push_back(actor);
+    }
+}
+
 //===========================================================================//
 void Map::initialize()
 {
@@ -166,6 +285,115 @@ void Map::initialize()
     {
         mActors[ii].get()->initialize();
     }
+    updateSpatialHash();
+    snapshot();
+}
+
+//===========================================================================//
+void Map::load(const MapData& data)
+{
+    for (const ActorPlacement& placement : data.actors)
+    {
+        game::Actor& actor = spawnActor(
+                *placement.prefab, placement.name, false);
+
+        if (placement.hasPosition)
+        {
+            actor.setPosition(placement.position);
+
+            // Update the physics position
+            actor.getPhysics().update();
+        }
+
+        for (const auto& variable : placement.variables)
+        {
+            actor.getScript().variable(variable.first)->set(variable.second);
+        }
+    }
+    initialize();
+}
+
+//===========================================================================//
+std::vector<Actor*> Map::queryRect(const math::Vector2F& min,
+                                   const math::Vector2F& max,
+                                   uint32_t groups) const
+{
+    mQueryResults.clear();
+    mSpatialHash.queryRect(min.x, min.y, max.x, max.y,
+                           mQueryResults, groups);
+
+    std::vector<Actor*> actors;
+    actors.reserve(mQueryResults.size());
+    for (uint32_t index : mQueryResults)
+    {
+        actors.push_back(mIndexedActors[index]);
+    }
+    return actors;
+}
+
+//===========================================================================//
+std::vector<Actor*> Map::queryRadius(const math::Vector2F& center,
+                                     float radius,
+                                     uint32_t groups) const
+{
+    mQueryResults.clear();
+    mSpatialHash.queryRadius(center.x, center.y, radius,
+                             mQueryResults, groups);
+
+    std::vector<Actor*> actors;
+    actors.reserve(mQueryResults.size());
+    for (uint32_t index : mQueryResults)
+    {
+        actors.push_back(mIndexedActors[index]);
+    }
+    return actors;
+}
+
+//===========================================================================//
+std::vector<std::pair<Actor*, Actor*> > Map::queryPairs(
+        uint32_t groupsA,
+        uint32_t groupsB) const
+{
+    std::vector<std::pair<uint32_t, uint32_t> > pairs;
+    mSpatialHash.queryPairs(groupsA, groupsB, pairs);
+
+    std::vector<std::pair<Actor*, Actor*> > actors;
+    actors.reserve(pairs.size());
+    for (const std::pair<uint32_t, uint32_t>& pair : pairs)
+    {
+        actors.push_back(std::make_pair(mIndexedActors[pair.first],
+                                        mIndexedActors[pair.second]));
+    }
+    return actors;
+}
+
+//===========================================================================//
+uint64_t Map::getChecksum() const
+{
+    // Actors are hashed one at a time and summed so the order they are
+    // stored in does not matter.
+    uint64_t checksum = 0;
+    for (size_t ii = 0; ii < mActors.size(); ++ii)
+    {
+        const Actor& actor = *mActors[ii].get();
+        const float values[] = {actor.getPosition().x,
+                                actor.getPosition().y,
+                                actor.getRotation()};
+
+        uint64_t hash = 14695981039346656037ULL;
+        for (char c : actor.getName())
+        {
+            hash = (hash ^ static_cast<uint8_t>(c)) * 1099511628211ULL;
+        }
+
+        const uint8_t* bytes = reinterpret_cast<const uint8_t*>(values);
+        for (size_t jj = 0; jj < sizeof(values); ++jj)
+        {
+            hash = (hash ^ bytes[jj]) * 1099511628211ULL;
+        }
+        checksum += hash;
+    }
+    return checksum;
 }
 
 //===========================================================================//
@@ -173,51 +401,150 @@ void Map::sort()
 {
     std::stable_sort(mActors.begin(), mActors.end());
 }
+
+//===========================================================================//
+void Map::updateSpatialHash()
+{
+    NYRA_PROFILE_SCOPE("Map::updateSpatialHash");
+
+    mSpatialHash.clear();
+    mIndexedActors.clear();
+    for (size_t ii = 0; ii < mActors.size(); ++ii)
+    {
+        Actor* actor = mActors[ii].get();
+        if (actor->getType() != Actor::SPRITE)
+        {
+            continue;
+        }
+
+        // Bounding box of the four corners of the sprite in world space.
+        // The matrix of the renderable belongs to render, so the sprite is
+        // placed from its layout and the transform of the actor instead.
+        const graphics::Renderable2D& renderable = actor->getRenderable();
+        math::Transform2D bounds;
+        bounds.setPosition(renderable.getPosition());
+        bounds.setScale(renderable.getScale());
+        bounds.setRotation(renderable.getRotation());
+        bounds.setSize(renderable.getSize());
+        bounds.setPivot(renderable.getPivot());
+        bounds.updateTransform(*actor);
+        const math::Matrix3x3& m = bounds.getMatrix();
+        const math::Vector2F& size = bounds.getSize();
+        const float cornersX[] = {0.0f, size.x, size.x, 0.0f};
+        const float cornersY[] = {0.0f, 0.0f, size.y, size.y};
+        float minX = m(0, 2);
+        float minY = m(1, 2);
+        float maxX = minX;
+        float maxY = minY;
+        for (size_t corner = 0; corner < 4; ++corner)
+        {
+            const float x = m(0, 0) * cornersX[corner] +
+                            m(0, 1) * cornersY[corner] + m(0, 2);
+            const float y = m(1, 0) * cornersX[corner] +
+                            m(1, 1) * cornersY[corner] + m(1, 2);
+            minX = std::min(minX, x);
+            minY = std::min(minY, y);
+            maxX = std::max(maxX, x);
+            maxY = std::max(maxY, y);
+        }
+
+        mSpatialHash.insert(mIndexedActors.size(), minX, minY, maxX, maxY,
+                            actor->getQueryGroups());
+        mIndexedActors.push_back(actor);
+    }
 }
 
-namespace core
+//===========================================================================//
+void Map::releaseActor(const ActorPtr& actor)
 {
+    Actor* ptr = actor.get();
+    const bool pooled = mPools.find(ptr->getPrefab()) != mPools.end();
+    const auto mapIter = mActorMap.find(ptr->getName());
+    if (mapIter != mActorMap.end() && mapIter->second == ptr)
+    {
+        // Pooled actors tend to come back under the same name, so their
+        // entry is kept empty instead of being allocated again
+        if (pooled)
+        {
+            mapIter->second = nullptr;
+        }
+        else
+        {
+            mActorMap.erase(mapIter);
+        }
+    }
+
+    // The front snapshot may still point at the actor, so it is only
+    // freed or reused once render has moved past every snapshot that has
+    // it. The body belongs to the simulation and can stop right away.
+    if (pooled)
+    {
+        ptr->getPhysics().setActive(false);
+    }
+    mRetiredActors.push_back(std::make_pair(mStep, actor));
+}
+
 //===========================================================================//
-void read(const std::string& pathname,
-          game::Map& map)
+void Map::snapshot()
 {
-    const json::JSON tree = core::read<json::JSON>(pathname);
+    mBack.actors.resize(mActors.size());
+    mBack.hasGui = false;
+    for (size_t ii = 0; ii < mActors.size(); ++ii)
+    {
+        Actor* actor = mActors[ii].get();
+        actor->snapshot();
+        mBack.actors[ii].actor = actor;
+        mBack.actors[ii].previous = actor->getPreviousSnapshot();
+        mBack.actors[ii].current = actor->getSnapshot();
+        mBack.hasGui |= actor->getType() == Actor::GUI;
+    }
+    mBack.step = mStep++;
+    mBack.renderCollision = mRenderCollision;
+
+    std::swap(mBack, mPublished);
+    mHasPublished = true;
 
-    if (tree.has("actors"))
+    // Only free or pool actors that neither the front nor the published snapshot
+    // can see. The published one is newer than anything retired before
+    // this step, so the front snapshot is all that has to be checked.
+    // Without a renderer nothing is ever acquired and they go right away.
+    size_t kept = 0;
+    for (size_t ii = 0; ii < mRetiredActors.size(); ++ii)
     {
-        for (size_t ii = 0; ii < tree["actors"].loopSize(); ++ii)
+        if (mRetiredActors[ii].first <= mFront.step)
         {
-            const auto& actorMap = tree["actors"][ii];
-            const std::string filename = actorMap["filename"].get();
-            const std::string name =
-                    actorMap.has("name") ? actorMap["name"].get() : "";
-            game::Actor& actor = map.spawnActor(filename, name, false);
-
-            if (actorMap.has("position"))
+            const ActorPtr& actor = mRetiredActors[ii].second;
+            const auto pool = mPools.find(actor.get()->getPrefab());
+            if (pool != mPools.end())
             {
-                math::Vector2F position(
-                        core::str::toType<double>(
-                                actorMap["position"]["x"].get()),
-                        core::str::toType<double>(
-                                actorMap["position"]["y"].get()));
-                actor.setPosition(position);
-
-                // Update the physics position
-                actor.getPhysics().update();
+                pool->second.push_back(actor);
             }
-
-            if (actorMap.has("var"))
+            else
             {
-                const auto& vars = actorMap["var"];
-                for (size_t var = 0; var < vars.loopSize(); ++var)
-                {
-                    actor.getScript().variable(
-                            vars[var]["name"].get())->set(vars[var]["value"].get());
-                }
+                // TODO: This is a strange interaction. The actor pointer is
+                //       actually owned by the script. So to make it fall
+                //       out of scope, we need to remove the script.
+                actor.get()->setScript(nullptr);
             }
         }
+        else
+        {
+            mRetiredActors[kept++] = mRetiredActors[ii];
+        }
     }
-    map.initialize();
+    mRetiredActors.resize(kept);
+}
+}
+
+namespace core
+{
+//===========================================================================//
+void read(const std::string& pathname,
+          game::Map& map)
+{
+    game::MapData data;
+    read(pathname, data);
+    map.load(data);
 }
 }
 }
@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) 2018 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#include <unordered_set>
+#include <nyra/game/MapData.h>
+#include <nyra/game/CompiledMap.h>
+#include <nyra/json/Document.h>
+#include <nyra/core/String.h>
+
+namespace nyra
+{
+namespace core
+{
+//===========================================================================//
+void read(const std::string& pathname,
+          game::MapData& data)
+{
+    data = game::MapData();
+
+    if (core::str::endsWith(pathname, game::CompiledMap::EXTENSION))
+    {
+        game::CompiledMap(pathname).read(data);
+        return;
+    }
+
+    const json::Document tree = core::read<json::Document>(pathname);
+    std::unordered_set<std::string> seenTextures;
+
+    if (tree.has("actors"))
+    {
+        for (size_t ii = 0; ii < tree["actors"].loopSize(); ++ii)
+        {
+            const auto& actorMap = tree["actors"][ii];
+            game::ActorPlacement actor;
+            actor.prefab = &game::Prefab::get(actorMap["filename"].get());
+            actor.name = actorMap.has("name") ? actorMap["name"].get() : "";
+
+            if (actorMap.has("position"))
+            {
+                actor.hasPosition = true;
+                actor.position.x = core::str::toType<double>(
+                        actorMap["position"]["x"].get());
+                actor.position.y = core::str::toType<double>(
+                        actorMap["position"]["y"].get());
+            }
+
+            if (actorMap.has("var"))
+            {
+                const auto& vars = actorMap["var"];
+                for (size_t var = 0; var < vars.loopSize(); ++var)
+                {
+                    actor.variables.push_back(std::make_pair(
+                            vars[var]["name"].get(),
+                            vars[var]["value"].get()));
+                }
+            }
+
+            for (const std::string& texture : actor.prefab->getTextures())
+            {
+                if (seenTextures.insert(texture).second)
+                {
+                    data.textures.push_back(texture);
+                }
+            }
+
+            data.actors.push_back(actor);
+        }
+    }
+}
+}
+}
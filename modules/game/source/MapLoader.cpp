@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) 2018 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <nyra/game/MapLoader.h>
+#include <nyra/core/Path.h>
+
+namespace nyra
+{
+namespace game
+{
+//===========================================================================//
+void MapLoader::preload(const std::string& filename)
+{
+    if (mPending.find(filename) != mPending.end())
+    {
+        return;
+    }
+
+    mPending[filename] = std::async(std::launch::async,
+                                    &MapLoader::load,
+                                    filename);
+}
+
+//===========================================================================//
+bool MapLoader::isReady(const std::string& filename) const
+{
+    const auto iter = mPending.find(filename);
+    return iter != mPending.end() &&
+           iter->second.wait_for(std::chrono::seconds(0)) ==
+                   std::future_status::ready;
+}
+
+//===========================================================================//
+std::unique_ptr<LoadedMap> MapLoader::get(const std::string& filename)
+{
+    const auto iter = mPending.find(filename);
+    if (iter == mPending.end())
+    {
+        return load(filename);
+    }
+
+    std::future<std::unique_ptr<LoadedMap> > future = std::move(iter->second);
+    mPending.erase(iter);
+    return future.get();
+}
+
+//===========================================================================//
+std::unique_ptr<LoadedMap> MapLoader::load(const std::string& filename)
+{
+    std::unique_ptr<LoadedMap> map(new LoadedMap());
+    core::read(core::path::join(core::DATA_PATH, "maps/" + filename),
+               map->data);
+
+    // Split the textures across the hardware threads. Each worker takes
+    // every Nth texture so large and small textures spread out evenly.
+    const std::vector<std::string>& textures = map->data.textures;
+    const size_t numWorkers = std::max<size_t>(1, std::min<size_t>(
+            std::thread::hardware_concurrency(), textures.size()));
+
+    std::vector<std::future<std::vector<std::unique_ptr<SpriteT> > > >
+            workers;
+    for (size_t ii = 1; ii < numWorkers; ++ii)
+    {
+        workers.push_back(std::async(std::launch::async,
+                                     &MapLoader::loadTextures,
+                                     std::cref(textures),
+                                     ii,
+                                     numWorkers));
+    }
+
+    // This thread does its share too
+    map->textures = loadTextures(textures, 0, numWorkers);
+    for (auto& worker : workers)
+    {
+        std::vector<std::unique_ptr<SpriteT> > sprites = worker.get();
+        for (auto& sprite : sprites)
+        {
+            map->textures.push_back(std::move(sprite));
+        }
+    }
+
+    return map;
+}
+
+//===========================================================================//
+std::vector<std::unique_ptr<SpriteT> > MapLoader::loadTextures(
+        const std::vector<std::string>& textures,
+        size_t start,
+        size_t step)
+{
+    std::vector<std::unique_ptr<SpriteT> > sprites;
+    for (size_t ii = start; ii < textures.size(); ii += step)
+    {
+        sprites.push_back(std::unique_ptr<SpriteT>(new SpriteT(
+                core::path::join(core::DATA_PATH, textures[ii]))));
+    }
+    return sprites;
+}
+}
+}
@@ -19,61 +19,150 @@
  * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
  * IN THE SOFTWARE.
  */
+#include <nyra/core/ThreadPool.h>
 #include <nyra/game/NavMesh.h>
 
-namespace nyra
+namespace
 {
-namespace game
+// Tiles per side of a cluster in the hierarchical graph
+static const size_t CLUSTER_SIZE = 16;
+
+// The cache is dropped when it grows past this many paths
+static const size_t MAX_CACHED_PATHS = 4096;
+
+nyra::core::ThreadPool& getPool()
 {
-NavMesh::NavMesh(const TileMapT& map,
-                 const std::unordered_set<size_t>& collision)
+    static nyra::core::ThreadPool pool;
+    return pool;
+}
+
+nyra::math::GridGraph makeGrid(const nyra::game::TileMapT& map,
+                               const std::unordered_set<size_t>& collision)
 {
-    const math::Vector2U& size = map.getNumTiles();
+    const nyra::math::Vector2U& size = map.getNumTiles();
+    nyra::math::GridGraph grid(size.x, size.y);
     for (size_t y = 0; y < size.y; ++y)
     {
         for (size_t x = 0; x < size.x; ++x)
         {
-            if (collision.find(map.getTile(x, y)) == collision.end())
-            {
-                addTile(map, collision, x, y, 1, -1);
-                addTile(map, collision, x, y, 1, 0);
-                addTile(map, collision, x, y, 1, 1);
-                addTile(map, collision, x, y, 0, 1);
-            }
+            grid.setWalkable(
+                    x, y, collision.find(map.getTile(x, y)) == collision.end());
         }
     }
-    mEvent = [](const math::Vector2F& v1,
-                const math::Vector2F& v2)->double
+    return grid;
+}
+}
+
+namespace nyra
+{
+namespace game
+{
+NavMesh::NavMesh(const TileMapT& map,
+                 const std::unordered_set<size_t>& collision) :
+    mGraph(makeGrid(map, collision), CLUSTER_SIZE),
+    mSearches(getPool().getNumThreads() + 1),
+    mVersion(0)
+{
+}
+
+math::PathResults<math::Vector2F> NavMesh::getPath(
+        const math::Vector2F& start,
+        const math::Vector2F& end) const
+{
+    // The last search is kept for single queries so they never share
+    // scratch memory with a batch running on the pool.
+    return findPath(start, end, mSearches.back());
+}
+
+std::vector<math::PathResults<math::Vector2F> > NavMesh::getPaths(
+        const std::vector<std::pair<math::Vector2F,
+                                    math::Vector2F> >& queries) const
+{
+    std::vector<math::PathResults<math::Vector2F> > results(queries.size());
+    getPool().parallelFor(queries.size(), [&](size_t index, size_t thread)
     {
-        static const double diag = math::Vector2F(1, 1).length();
-        const int32_t x = std::abs(static_cast<int32_t>(v1.x) -
-                                   static_cast<int32_t>(v2.x));
-        const int32_t y = std::abs(static_cast<int32_t>(v1.y) -
-                                   static_cast<int32_t>(v2.y));
-        const int32_t max = std::max(x, y);
-        const int32_t min = std::min(x, y);
-        return diag * min + (max - min);
-    };
+        results[index] = findPath(queries[index].first,
+                                  queries[index].second,
+                                  mSearches[thread]);
+    });
+    return results;
 }
 
-void NavMesh::addTile(const TileMapT& map,
-                      const std::unordered_set<size_t>& collision,
-                      size_t x, size_t y,
-                      int32_t dx, int32_t dy)
+math::PathResults<math::Vector2F> NavMesh::findPath(
+        const math::Vector2F& start,
+        const math::Vector2F& end,
+        math::HierarchicalGraph::Search& search) const
 {
-    const int32_t targetX = x + dx;
-    const int32_t targetY = y + dy;
-    if (targetX >= 0 && targetY >= 0 &&
-        static_cast<size_t>(targetX) < map.getNumTiles().x &&
-        static_cast<size_t>(targetY) < map.getNumTiles().y)
+    math::PathResults<math::Vector2F> results;
+    size_t startIndex = 0;
+    size_t endIndex = 0;
+    if (!getIndex(start, startIndex) || !getIndex(end, endIndex))
+    {
+        return results;
+    }
+
+    const uint64_t key = (static_cast<uint64_t>(startIndex) << 32) | endIndex;
     {
-        if (collision.find(map.getTile(targetX, targetY)) == collision.end())
+        std::lock_guard<std::mutex> lock(mCacheMutex);
+        const auto iter = mCache.find(key);
+        if (iter != mCache.end())
         {
-            const math::Vector2F tile(x, y);
-            const math::Vector2F target(targetX, targetY);
-            mGraph.addEdge(tile, target);
+            return iter->second;
         }
     }
+
+    const math::PathResults<size_t> path =
+            mGraph.getPath(startIndex, endIndex, search);
+    const math::GridGraph& grid = mGraph.getGrid();
+    results.distance = path.distance;
+    results.path.reserve(path.path.size());
+    for (size_t index : path.path)
+    {
+        results.path.push_back(math::Vector2F(
+                index % grid.getWidth(), index / grid.getWidth()));
+    }
+
+    std::lock_guard<std::mutex> lock(mCacheMutex);
+    if (mCache.size() >= MAX_CACHED_PATHS)
+    {
+        mCache.clear();
+    }
+    mCache[key] = results;
+    return results;
+}
+
+void NavMesh::setWalkable(const math::Vector2F& tile, bool walkable)
+{
+    size_t index = 0;
+    if (getIndex(tile, index))
+    {
+        const size_t width = mGraph.getGrid().getWidth();
+        mGraph.setWalkable(index % width, index / width, walkable);
+        mGraph.update();
+        ++mVersion;
+
+        std::lock_guard<std::mutex> lock(mCacheMutex);
+        mCache.clear();
+    }
+}
+
+bool NavMesh::getIndex(const math::Vector2F& tile, size_t& index) const
+{
+    if (tile.x < 0.0f || tile.y < 0.0f)
+    {
+        return false;
+    }
+
+    const size_t x = static_cast<size_t>(tile.x);
+    const size_t y = static_cast<size_t>(tile.y);
+    const math::GridGraph& grid = mGraph.getGrid();
+    if (x >= grid.getWidth() || y >= grid.getHeight())
+    {
+        return false;
+    }
+
+    index = grid.getIndex(x, y);
+    return true;
 }
 }
 }
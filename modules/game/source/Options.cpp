@@ -42,7 +42,21 @@ GraphicsOptions::GraphicsOptions() :
 //===========================================================================//
 GameOptions::GameOptions() :
     startingMap("empty.json"),
-    inputMap("empty.json")
+    inputMap("empty.json"),
+    simulationRate(60.0),
+    maxSimulationSteps(5),
+    threadedRendering(false),
+    showProfiler(false),
+    seed(0)
+{
+}
+
+//===========================================================================//
+PhysicsOptions::PhysicsOptions() :
+    allowSleeping(true),
+    subSteps(1),
+    velocityIterations(8),
+    positionIterations(3)
 {
 }
 }
@@ -79,11 +79,12 @@ void Physics::addBoxCollision(const math::Vector2F& size,
 }
 
 //===========================================================================//
-void Physics::render(graphics::RenderTarget& target)
+void Physics::render(graphics::RenderTarget& target,
+                     const math::Transform2D& parent)
 {
     for (size_t ii = 0; ii < mCollision.size(); ++ii)
     {
-        mCollision[ii]->updateTransform(mTransform);
+        mCollision[ii]->updateTransform(parent);
         mCollision[ii]->render(target);
     }
 }
@@ -103,6 +104,22 @@ void Physics::update()
     }
 }
 
+//===========================================================================//
+void Physics::setActive(bool active)
+{
+    if (mTrigger.get())
+    {
+        mTrigger->setActive(active);
+    }
+
+    if (mBody.get())
+    {
+        // Start from rest whenever the body comes back
+        mBody->setVelocity(math::Vector2F());
+        mBody->setActive(active);
+    }
+}
+
 //===========================================================================//
 void Physics::setOnEnter(const std::string& functionName)
 {
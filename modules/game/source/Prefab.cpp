@@ -0,0 +1,496 @@
+/*
+ * Copyright (c) 2018 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <nyra/game/Prefab.h>
+#include <nyra/core/Path.h>
+#include <nyra/core/String.h>
+
+namespace
+{
+//===========================================================================//
+static std::unordered_map<std::string,
+        std::unique_ptr<nyra::game::Prefab>> registry;
+static std::mutex registryMutex;
+
+//===========================================================================//
+nyra::math::Vector2F parseVector(const nyra::json::Document::Node& tree,
+                                 const std::string& x,
+                                 const std::string& y)
+{
+    return nyra::math::Vector2F(
+            nyra::core::str::toType<double>(tree[x].get()),
+            nyra::core::str::toType<double>(tree[y].get()));
+}
+
+//===========================================================================//
+void parsePhysics(const nyra::json::Document::Node& map,
+                  nyra::game::Prefab::Physics& physics)
+{
+    const std::string stype = map["type"].get();
+
+    if (stype == "dynamic")
+    {
+        physics.type = nyra::physics::DYNAMIC;
+    }
+    else if (stype == "character")
+    {
+        physics.type = nyra::physics::CHARACTER;
+    }
+
+    // TODO: Expose mask names to a serial interface
+    // 00001 Player collision   0x01
+    // 00010 Enemy collision    0x02
+    // 10000 Rigid collision    0x04
+    if (map.has("mask"))
+    {
+        physics.mask = 0;
+        const std::vector<std::string> maskNames =
+                nyra::core::str::split(map["mask"].get(), ",");
+
+        for (const std::string& name : maskNames)
+        {
+            if (name == "player")
+            {
+                physics.mask |= 0x01;
+            }
+            else if (name == "enemy")
+            {
+                physics.mask |= 0x02;
+            }
+            else if (name == "rigid")
+            {
+                physics.mask |= 0x04;
+            }
+        }
+    }
+
+    if (map.has("onEnter"))
+    {
+        physics.onEnter = map["onEnter"].get();
+    }
+
+    if (map.has("onExit"))
+    {
+        physics.onExit = map["onExit"].get();
+    }
+
+    if (map.has("circle"))
+    {
+        const auto& circle = map["circle"];
+        physics.hasCircle = true;
+        physics.radius = nyra::core::str::toType<double>(
+                circle["radius"].get());
+
+        if (circle.has("offset"))
+        {
+            physics.circleOffset = parseVector(circle["offset"], "x", "y");
+        }
+    }
+
+    if (map.has("box"))
+    {
+        const auto& box = map["box"];
+        physics.hasBox = true;
+        physics.boxSize = parseVector(box["size"], "x", "y");
+
+        if (box.has("offset"))
+        {
+            physics.boxOffset = parseVector(box["offset"], "x", "y");
+        }
+    }
+}
+
+//===========================================================================//
+void parseWidgets(const nyra::json::Document::Node& map,
+                  std::vector<nyra::game::Prefab::Widget>& widgets)
+{
+    if (!map.has("widget"))
+    {
+        return;
+    }
+
+    for (size_t ii = 0; ii < map["widget"].loopSize(); ++ii)
+    {
+        const auto& wMap = map["widget"][ii];
+        widgets.push_back(nyra::game::Prefab::Widget());
+        nyra::game::Prefab::Widget& widget = widgets.back();
+        widget.type = wMap["type"].get();
+        widget.name = wMap["name"].get();
+
+        if (wMap.has("text"))
+        {
+            widget.text = wMap["text"].get();
+        }
+
+        if (wMap.has("size"))
+        {
+            widget.hasSize = true;
+            widget.size = parseVector(wMap["size"], "width", "height");
+        }
+
+        if (wMap.has("position"))
+        {
+            widget.hasPosition = true;
+            widget.position = parseVector(wMap["position"], "x", "y");
+        }
+
+        if (wMap.has("activated"))
+        {
+            widget.activated = wMap["activated"].get();
+        }
+
+        parseWidgets(wMap, widget.children);
+    }
+}
+
+//===========================================================================//
+nyra::game::Prefab::TileMap parseTileMap(
+        const nyra::json::Document::Node& map)
+{
+    nyra::game::Prefab::TileMap tileMap(nyra::math::Vector2U(
+            map["tiles"][0].loopSize(),
+            map["tiles"].loopSize()));
+
+    tileMap.filename = map["filename"].get();
+    tileMap.tileSize.x = nyra::core::str::toType<size_t>(
+            map["tile_size"]["width"].get());
+    tileMap.tileSize.y = nyra::core::str::toType<size_t>(
+            map["tile_size"]["height"].get());
+
+    for (size_t row = 0; row < tileMap.tiles.getNumRows(); ++row)
+    {
+        for (size_t col = 0; col < tileMap.tiles.getNumCols(); ++col)
+        {
+            tileMap.tiles(col, row) = nyra::core::str::toType<size_t>(
+                    map["tiles"][row][col].get());
+        }
+    }
+
+    if (map.has("collision"))
+    {
+        tileMap.hasCollision = true;
+        for (size_t ii = 0; ii < map["collision"].loopSize(); ++ii)
+        {
+            tileMap.collision.insert(nyra::core::str::toType<size_t>(
+                    map["collision"][ii].get()));
+        }
+    }
+
+    return tileMap;
+}
+
+//===========================================================================//
+void parseSprite(const nyra::json::Document::Node& map,
+                 nyra::game::Prefab::Sprite& sprite)
+{
+    const std::string filename = map["filename"].get();
+
+    if (filename.empty())
+    {
+        return;
+    }
+
+    // This mirrors game::Sprite::initialize so the sprite file only needs
+    // to be read once.
+    const nyra::json::Document tree = nyra::core::read<nyra::json::Document>(
+            nyra::core::path::join(nyra::core::DATA_PATH,
+                                   "sprites/" + filename));
+    sprite.filename = tree["filename"].get();
+
+    if (tree.has("pivot"))
+    {
+        sprite.pivot = parseVector(tree["pivot"], "x", "y");
+    }
+
+    if (tree.has("frames"))
+    {
+        sprite.frames.x = nyra::core::str::toType<float>(
+                tree["frames"]["x"].get());
+        sprite.frames.y = nyra::core::str::toType<float>(
+                tree["frames"]["y"].get());
+    }
+}
+
+//===========================================================================//
+nyra::game::Prefab::Animation parseAnimation(
+        const nyra::json::Document::Node& map)
+{
+    nyra::game::Prefab::Animation anim;
+    anim.name = map["name"].get();
+    anim.start = nyra::core::str::toType<size_t>(map["start"].get());
+    anim.end = nyra::core::str::toType<size_t>(map["end"].get());
+    anim.duration = nyra::core::str::toType<double>(map["duration"].get());
+    anim.playType = nyra::anim::Animation::LOOP;
+
+    if (map.has("type"))
+    {
+        const std::string type = map["type"].get();
+        if (type == "ping_pong")
+        {
+            anim.playType = nyra::anim::Animation::PING_PONG;
+        }
+        else if (type == "once")
+        {
+            anim.playType = nyra::anim::Animation::ONCE;
+        }
+        else if (type == "loop")
+        {
+            anim.playType = nyra::anim::Animation::LOOP;
+        }
+        else
+        {
+            throw std::runtime_error("Unknown animation type: " + type);
+        }
+    }
+
+    return anim;
+}
+}
+
+namespace nyra
+{
+namespace game
+{
+//===========================================================================//
+Prefab::Physics::Physics() :
+    type(physics::STATIC),
+    mask(0x01 | 0x02 | 0x04),
+    hasCircle(false),
+    radius(0.0),
+    hasBox(false)
+{
+}
+
+//===========================================================================//
+Prefab::Widget::Widget() :
+    hasSize(false),
+    hasPosition(false)
+{
+}
+
+//===========================================================================//
+Prefab::TileMap::TileMap(const math::Vector2U& mapSize) :
+    tiles(mapSize),
+    hasCollision(false)
+{
+}
+
+//===========================================================================//
+Prefab::Sprite::Sprite() :
+    pivot(0.5, 0.5),
+    frames(1, 1)
+{
+}
+
+//===========================================================================//
+Prefab::Prefab() :
+    hasScript(false),
+    hasPhysics(false),
+    hasTrigger(false),
+    hasGui(false),
+    hasSprite(false),
+    hasCamera(false),
+    hasAnimation(false),
+    hasLayer(false),
+    layer(0)
+{
+}
+
+//===========================================================================//
+Prefab::Prefab(const json::Document& tree) :
+    hasScript(tree.has("script")),
+    hasPhysics(tree.has("physics")),
+    hasTrigger(tree.has("trigger")),
+    hasGui(tree.has("gui")),
+    hasSprite(tree.has("sprite")),
+    hasCamera(tree.has("camera")),
+    hasAnimation(tree.has("animation")),
+    hasLayer(tree.has("layer")),
+    layer(0)
+{
+    if (hasScript)
+    {
+        const auto& map = tree["script"];
+        script.filename = map["filename"].get();
+        script.className = map["class"].get();
+
+        if (map.has("update"))
+        {
+            script.update = map["update"].get();
+        }
+
+        if (map.has("initialize"))
+        {
+            script.initialize = map["initialize"].get();
+        }
+
+        if (map.has("reset"))
+        {
+            script.reset = map["reset"].get();
+        }
+    }
+
+    if (hasPhysics)
+    {
+        parsePhysics(tree["physics"], physics);
+    }
+
+    if (hasTrigger)
+    {
+        parsePhysics(tree["trigger"], trigger);
+    }
+
+    if (hasGui)
+    {
+        parseWidgets(tree["gui"], widgets);
+    }
+
+    if (tree.has("tile_map"))
+    {
+        for (size_t ii = 0; ii < tree["tile_map"].loopSize(); ++ii)
+        {
+            tileMaps.push_back(parseTileMap(tree["tile_map"][ii]));
+        }
+    }
+
+    if (hasSprite)
+    {
+        if (tree["sprite"].loopSize() > 1)
+        {
+            throw std::runtime_error(
+                    "TODO: Cannot support more than 1 "
+                    "sprite on an actor.");
+        }
+
+        parseSprite(tree["sprite"][0], sprite);
+    }
+
+    if (hasAnimation)
+    {
+        const auto& map = tree["animation"];
+
+        // TODO: Support different frames for each animation
+        animationFrames.x = core::str::toType<size_t>(
+                map["frames"]["cols"].get());
+        animationFrames.y = core::str::toType<size_t>(
+                map["frames"]["rows"].get());
+
+        for (size_t ii = 0; ii < map["anims"].loopSize(); ++ii)
+        {
+            animations.push_back(parseAnimation(map["anims"][ii]));
+        }
+
+        if (map.has("initial"))
+        {
+            initialAnimation = map["initial"].get();
+        }
+    }
+
+    if (hasLayer)
+    {
+        layer = core::str::toType<int32_t>(tree["layer"].get());
+    }
+}
+
+//===========================================================================//
+const Prefab& Prefab::get(const std::string& filename)
+{
+    {
+        std::lock_guard<std::mutex> lock(registryMutex);
+        const auto iter = registry.find(filename);
+        if (iter != registry.end())
+        {
+            return *iter->second;
+        }
+    }
+
+    // Parse outside of the lock so loader threads do not wait on each other
+    const json::Document tree = core::read<json::Document>(
+            core::path::join(core::DATA_PATH, "actors/" + filename));
+    return add(filename, new Prefab(tree));
+}
+
+//===========================================================================//
+const Prefab& Prefab::add(const std::string& filename, Prefab* prefab)
+{
+    std::unique_ptr<Prefab> ptr(prefab);
+    std::lock_guard<std::mutex> lock(registryMutex);
+    return *registry.insert(std::make_pair(
+            filename, std::move(ptr))).first->second;
+}
+
+//===========================================================================//
+bool Prefab::has(const std::string& filename)
+{
+    std::lock_guard<std::mutex> lock(registryMutex);
+    return registry.find(filename) != registry.end();
+}
+
+//===========================================================================//
+void Prefab::clear()
+{
+    std::lock_guard<std::mutex> lock(registryMutex);
+    registry.clear();
+}
+
+//===========================================================================//
+std::vector<std::string> Prefab::getTextures() const
+{
+    std::vector<std::string> textures;
+
+    if (!sprite.filename.empty())
+    {
+        textures.push_back("textures/" + sprite.filename);
+    }
+
+    for (const TileMap& tileMap : tileMaps)
+    {
+        textures.push_back("textures/" + tileMap.filename);
+    }
+
+    const Physics* const bodies[] = {hasPhysics ? &physics : nullptr,
+                                     hasTrigger ? &trigger : nullptr};
+    const std::string names[] = {"collision", "trigger"};
+    for (size_t ii = 0; ii < 2; ++ii)
+    {
+        if (!bodies[ii])
+        {
+            continue;
+        }
+
+        if (bodies[ii]->hasCircle)
+        {
+            textures.push_back("textures/" + names[ii] + "_circle.png");
+        }
+
+        if (bodies[ii]->hasBox)
+        {
+            textures.push_back("textures/" + names[ii] + "_box.png");
+        }
+    }
+
+    return textures;
+}
+}
+}
@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) 2018 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#include <algorithm>
+#include <iomanip>
+#include <map>
+#include <sstream>
+#include <nyra/game/ProfilerOverlay.h>
+#include <nyra/core/Profiler.h>
+
+namespace
+{
+//===========================================================================//
+static const uint64_t REFRESH_TIME = 1000000000;
+
+//===========================================================================//
+struct ScopeStats
+{
+    ScopeStats() :
+        count(0),
+        total(0),
+        max(0)
+    {
+    }
+
+    size_t count;
+    uint64_t total;
+    uint64_t max;
+};
+}
+
+namespace nyra
+{
+namespace game
+{
+//===========================================================================//
+ProfilerOverlay::ProfilerOverlay(const input::Mouse& mouse) :
+    mGui(mouse),
+    mLastRefresh(0)
+{
+    mLabel = Gui::addWidget("label", "", "profiler", mGui.get());
+    mLabel->setPosition(math::Vector2F(10.0f, 10.0f));
+    mLabel->setSize(math::Vector2F(640.0f, 480.0f));
+}
+
+//===========================================================================//
+void ProfilerOverlay::render(graphics::RenderTarget& target)
+{
+    if (core::Profiler::now() - mLastRefresh >= REFRESH_TIME)
+    {
+        refresh();
+    }
+    mGui.render(target);
+}
+
+//===========================================================================//
+void ProfilerOverlay::refresh()
+{
+    const uint64_t now = core::Profiler::now();
+    const uint64_t since = now > REFRESH_TIME ? now - REFRESH_TIME : 0;
+
+    std::map<std::string, ScopeStats> scopes;
+    for (const core::ProfileSample& sample :
+            core::Profiler::getSamples(since))
+    {
+        ScopeStats& stats = scopes[sample.name];
+        const uint64_t duration = sample.end - sample.start;
+        ++stats.count;
+        stats.total += duration;
+        stats.max = std::max(stats.max, duration);
+    }
+
+    std::vector<std::pair<std::string, ScopeStats> > sorted(
+            scopes.begin(), scopes.end());
+    std::sort(sorted.begin(), sorted.end(),
+              [](const std::pair<std::string, ScopeStats>& a,
+                 const std::pair<std::string, ScopeStats>& b)
+              {
+                  return a.second.total > b.second.total;
+              });
+
+    std::ostringstream text;
+    text << std::fixed << std::setprecision(2);
+    for (const auto& scope : sorted)
+    {
+        const ScopeStats& stats = scope.second;
+        text << std::left << std::setw(32) << scope.first
+             << std::right
+             << " avg " << std::setw(7)
+             << stats.total / 1000000.0 / stats.count << " ms"
+             << " max " << std::setw(7) << stats.max / 1000000.0 << " ms"
+             << " x" << stats.count << "\n";
+    }
+
+    mLabel->setText(text.str());
+    mLastRefresh = now;
+}
+}
+}
@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) 2018 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#include <stdexcept>
+#include <nyra/game/Replay.h>
+
+namespace nyra
+{
+namespace game
+{
+//===========================================================================//
+Replay::State::State() :
+    isPressed(false),
+    isDown(false),
+    isReleased(false),
+    value(0.0f)
+{
+}
+
+//===========================================================================//
+Replay::State::State(bool isPressed,
+                     bool isDown,
+                     bool isReleased,
+                     float value) :
+    isPressed(isPressed),
+    isDown(isDown),
+    isReleased(isReleased),
+    value(value)
+{
+}
+
+//===========================================================================//
+Replay::Replay() :
+    mSeed(0),
+    mSimulationRate(0.0),
+    mNumFrames(0),
+    mChecksum(0)
+{
+}
+
+//===========================================================================//
+Replay::Replay(uint32_t seed,
+               const std::string& map,
+               double simulationRate,
+               const std::vector<std::string>& inputs) :
+    mSeed(seed),
+    mMap(map),
+    mSimulationRate(simulationRate),
+    mInputs(inputs),
+    mNumFrames(0),
+    mChecksum(0)
+{
+}
+
+//===========================================================================//
+void Replay::addFrame(const std::vector<State>& states)
+{
+    if (states.size() != mInputs.size())
+    {
+        throw std::runtime_error(
+                "Replay frame has the wrong number of inputs");
+    }
+
+    mStates.insert(mStates.end(), states.begin(), states.end());
+    ++mNumFrames;
+}
+
+//===========================================================================//
+void Replay::validate() const
+{
+    // Divide rather than multiply so a corrupt step count cannot overflow
+    const bool sized = mInputs.empty() ?
+            mStates.empty() :
+            mStates.size() % mInputs.size() == 0 &&
+            mStates.size() / mInputs.size() == mNumFrames;
+    if (!sized)
+    {
+        throw std::runtime_error(
+                "Replay steps do not match the recorded inputs");
+    }
+
+    if (!(mSimulationRate > 0.0))
+    {
+        throw std::runtime_error("Replay simulation rate must be positive");
+    }
+}
+
+//===========================================================================//
+void Replay::addMapChange(size_t frame, const std::string& map)
+{
+    mMapChanges.push_back(std::make_pair(static_cast<uint64_t>(frame), map));
+}
+}
+}
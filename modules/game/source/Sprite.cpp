@@ -55,6 +55,11 @@ void Sprite::initialize(const std::string& filename,
     }
 
     mSprite.setPivot(pivot);
+
+    // Mirrored so the layout can be read without touching the inner
+    // sprite, which only render moves.
+    setSize(mSprite.getSize());
+    setPivot(pivot);
 }
 
 //===========================================================================//
@@ -3,6 +3,7 @@
 %include "../../math/swig/math.i"
 %include "../../gui/swig/gui.i"
 %include "std_vector.i"
+%include "stdint.i"
 
 %{
     #include "nyra/win/Window.h"
@@ -11,6 +12,7 @@
     #include "nyra/game/Types.h"
     #include "nyra/physics/Body.h"
     #include "nyra/game/Actor.h"
+    #include "nyra/game/FlowField.h"
     #include "nyra/input/Mouse.h"
     #include "nyra/input/Keyboard.h"
     #include "nyra/game/Input.h"
@@ -29,6 +31,8 @@
 %ignore getNavMesh;
 %ignore Input(const nyra::win::Window& window,
               const std::string& filename);
+%ignore Input(const std::string& filename);
+%ignore hasWindow;
 %ignore TileMap(const std::string& spritePathname,
                 const mem::Buffer2D<size_t>& tiles,
                 const math::Vector2U tileSize);
@@ -40,13 +44,42 @@
 %ignore addCamera;
 %ignore addGUI;
 %ignore Map(const game::Input& input,
-            const graphics::RenderTarget& target);
+            const graphics::RenderTarget& target,
+            double simulationRate,
+            const PhysicsOptions& physics);
+%ignore snapshot;
+%ignore acquireSnapshot;
+%ignore interpolate;
+%ignore renderGui;
+%ignore renderCollision;
+%ignore nyra::game::Map::load;
+%ignore spawnActor(const Prefab& prefab,
+                   const std::string& name,
+                   bool initalize);
 %ignore getMouse;
+%ignore getNames;
+%ignore record;
+%ignore play;
+%ignore getChecksum;
 %ignore getPhysics;
 %ignore updatePhysics;
 %ignore addCircleCollision;
 %ignore addBody;
 %ignore renderCollision;
+%ignore queryRect;
+%ignore queryRadius;
+%ignore queryPairs;
+%ignore reservePool(const Prefab& prefab,
+                   size_t count);
+%ignore nyra::game::Actor::reset;
+%ignore getPrefab;
+%ignore setPrefab;
+
+%ignore nyra::game::FlowField::FlowField;
+%newobject nyra::game::Actor::create_flow_field;
+%rename(has_path) nyra::game::FlowField::hasPath;
+%rename(get_distance) nyra::game::FlowField::getDistance;
+%rename(get_next) nyra::game::FlowField::getNext;
 
 %rename(is_down) isDown;
 %rename(is_pressed) isPressed;
@@ -57,12 +90,13 @@
 %include "nyra/game/Actor.h"
 %include "nyra/game/Input.h"
 %include "nyra/game/Map.h"
-%include "nyra/graphics/TileMap.h"
+%include "nyra/game/FlowField.h"
+%include "nyra/graphics/sfml/TileMap.h"
 %include "nyra/math/PathResults.h"
 
-%template(TileMap2D) nyra::graphics::TileMap<nyra::graphics::sfml::Sprite>;
 %template(VectorVector2D) std::vector<nyra::math::Vector2F>;
 %template(PathResultsTileMap) nyra::math::PathResults<nyra::math::Vector2F>;
+%template(ActorList) std::vector<nyra::game::Actor*>;
 
 %extend nyra::game::Actor
 {    
@@ -103,8 +137,8 @@
     
     const nyra::math::Vector2U& _getTileSize() const
     {
-         return reinterpret_cast<const nyra::graphics::TileMap<
-                nyra::graphics::sfml::Sprite>&>($self->getRenderable()).getTileSize();
+         return reinterpret_cast<const nyra::game::TileMapT&>(
+                $self->getRenderable()).getTileSize();
     }
     
     void move(const nyra::math::Vector2F& amount)
@@ -119,6 +153,11 @@
         return $self->getNavMesh().getPath(start, end);
     }
     
+    nyra::game::FlowField* create_flow_field() const
+    {
+        return new nyra::game::FlowField($self->getNavMesh());
+    }
+    
     PyObject* _getScript() const
     {
         const nyra::script::Object& object = $self->getScript();
@@ -153,10 +192,68 @@
                         filename, name, true);
         return actor;
     }
+
+    static void _reservePool(const std::string& filename,
+                             size_t count)
+    {
+        nyra::game::Map::getMap().reservePool(filename, count);
+    }
+
+    static bool _hasGame()
+    {
+        return nyra::game::Game::hasGame();
+    }
+
+    static uint32_t _getSeed()
+    {
+        return nyra::game::Game::getGame().getSeed();
+    }
+
+    static void _preload(const std::string& filename)
+    {
+        nyra::game::Game::getGame().preloadMap(filename);
+    }
+
+    static void _change(const std::string& filename)
+    {
+        nyra::game::Game::getGame().changeMap(filename);
+    }
+
+    static std::vector<nyra::game::Actor*> _queryRect(
+            const nyra::math::Vector2F& min,
+            const nyra::math::Vector2F& max,
+            uint32_t groups)
+    {
+        return nyra::game::Map::getMap().queryRect(min, max, groups);
+    }
+
+    static std::vector<nyra::game::Actor*> _queryRadius(
+            const nyra::math::Vector2F& center,
+            float radius,
+            uint32_t groups)
+    {
+        return nyra::game::Map::getMap().queryRadius(center, radius, groups);
+    }
+
+    // Pairs come back flattened as first, second, first, second...
+    static std::vector<nyra::game::Actor*> _queryPairs(uint32_t groupsA,
+                                                       uint32_t groupsB)
+    {
+        std::vector<nyra::game::Actor*> actors;
+        const auto pairs =
+                nyra::game::Map::getMap().queryPairs(groupsA, groupsB);
+        for (const auto& pair : pairs)
+        {
+            actors.push_back(pair.first);
+            actors.push_back(pair.second);
+        }
+        return actors;
+    }
 }
 
 %pythoncode
 %{
+import random as _random
 import nyra.game
 from collections import namedtuple
 
@@ -169,6 +266,21 @@ def get_actor(name):
     actor = nyra.game.map._getActor(name)
     return actor._get_script()
 
+ALL_GROUPS = 0xFFFFFFFF
+
+def query_rect(min, max, groups=ALL_GROUPS):
+    return [actor._get_script()
+            for actor in nyra.game.map._queryRect(min, max, groups)]
+
+def query_radius(center, radius, groups=ALL_GROUPS):
+    return [actor._get_script()
+            for actor in nyra.game.map._queryRadius(center, radius, groups)]
+
+def query_pairs(groups_a=ALL_GROUPS, groups_b=ALL_GROUPS):
+    actors = [actor._get_script()
+              for actor in nyra.game.map._queryPairs(groups_a, groups_b)]
+    return list(zip(actors[0::2], actors[1::2]))
+
 def spawn(filename,
           name='',
           position=None,
@@ -190,10 +302,24 @@ Actor.size = property(Actor._getSize)
 Actor.tile_size = property(Actor._getTileSize)
 Actor.animation = property(Actor.getAnimation, Actor.playAnimation)
 Actor.velocity = property(Actor._getVelocity, Actor._setVelocity)
+Actor.query_groups = property(Actor.getQueryGroups, Actor.setQueryGroups)
+FlowField.goal = property(FlowField.getGoal, FlowField.setGoal)
 Actor._get_script = _get_script
 Actor.widgets = Actor.getWidget
 map = Map
 map.spawn = spawn
+map.reserve_pool = map._reservePool
 map.get_actor = get_actor
+map.query_rect = query_rect
+map.query_radius = query_radius
+map.query_pairs = query_pairs
+map.preload = map._preload
+map.change = map._change
+
 input = Input
+
+# Replays depend on scripts making the same random choices. The editor
+# runs scripts without a game so there is no session seed to use.
+if map._hasGame():
+    _random.seed(map._getSeed())
 %}
\ No newline at end of file
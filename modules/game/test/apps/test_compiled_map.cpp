@@ -0,0 +1,271 @@
+/*
+ * Copyright (c) 2018 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <nyra/test/Test.h>
+#include <nyra/game/CompiledMap.h>
+#include <nyra/game/MapData.h>
+#include <nyra/core/Path.h>
+
+namespace
+{
+//===========================================================================//
+const std::string PATHNAME = "test_compiled_map.nmap";
+
+//===========================================================================//
+std::string getMap()
+{
+    return nyra::core::path::join(nyra::core::DATA_PATH,
+                                  "maps/test_compiled_map.json");
+}
+
+//===========================================================================//
+std::vector<char> readFile(const std::string& pathname)
+{
+    std::ifstream stream(pathname.c_str(), std::ifstream::binary);
+    return std::vector<char>(std::istreambuf_iterator<char>(stream),
+                             std::istreambuf_iterator<char>());
+}
+
+//===========================================================================//
+void writeFile(const std::vector<char>& buffer, const std::string& pathname)
+{
+    std::ofstream stream(pathname.c_str(), std::ofstream::binary);
+    stream.write(buffer.data(), buffer.size());
+}
+
+//===========================================================================//
+void expectEqual(const nyra::game::Prefab::Physics& expected,
+                 const nyra::game::Prefab::Physics& physics)
+{
+    EXPECT_EQ(expected.type, physics.type);
+    EXPECT_EQ(expected.mask, physics.mask);
+    EXPECT_EQ(expected.hasCircle, physics.hasCircle);
+    EXPECT_EQ(expected.radius, physics.radius);
+    EXPECT_EQ(expected.circleOffset, physics.circleOffset);
+    EXPECT_EQ(expected.hasBox, physics.hasBox);
+    EXPECT_EQ(expected.boxSize, physics.boxSize);
+    EXPECT_EQ(expected.boxOffset, physics.boxOffset);
+    EXPECT_EQ(expected.onEnter, physics.onEnter);
+    EXPECT_EQ(expected.onExit, physics.onExit);
+}
+
+//===========================================================================//
+void expectEqual(const std::vector<nyra::game::Prefab::Widget>& expected,
+                 const std::vector<nyra::game::Prefab::Widget>& widgets)
+{
+    ASSERT_EQ(expected.size(), widgets.size());
+    for (size_t ii = 0; ii < expected.size(); ++ii)
+    {
+        EXPECT_EQ(expected[ii].type, widgets[ii].type);
+        EXPECT_EQ(expected[ii].name, widgets[ii].name);
+        EXPECT_EQ(expected[ii].text, widgets[ii].text);
+        EXPECT_EQ(expected[ii].hasSize, widgets[ii].hasSize);
+        EXPECT_EQ(expected[ii].size, widgets[ii].size);
+        EXPECT_EQ(expected[ii].hasPosition, widgets[ii].hasPosition);
+        EXPECT_EQ(expected[ii].position, widgets[ii].position);
+        EXPECT_EQ(expected[ii].activated, widgets[ii].activated);
+        expectEqual(expected[ii].children, widgets[ii].children);
+    }
+}
+
+//===========================================================================//
+void expectEqual(const nyra::game::Prefab& expected,
+                 const nyra::game::Prefab& prefab)
+{
+    EXPECT_EQ(expected.hasScript, prefab.hasScript);
+    EXPECT_EQ(expected.script.filename, prefab.script.filename);
+    EXPECT_EQ(expected.script.className, prefab.script.className);
+    EXPECT_EQ(expected.script.update, prefab.script.update);
+    EXPECT_EQ(expected.script.initialize, prefab.script.initialize);
+    EXPECT_EQ(expected.script.reset, prefab.script.reset);
+
+    EXPECT_EQ(expected.hasPhysics, prefab.hasPhysics);
+    expectEqual(expected.physics, prefab.physics);
+    EXPECT_EQ(expected.hasTrigger, prefab.hasTrigger);
+    expectEqual(expected.trigger, prefab.trigger);
+
+    EXPECT_EQ(expected.hasGui, prefab.hasGui);
+    expectEqual(expected.widgets, prefab.widgets);
+
+    ASSERT_EQ(expected.tileMaps.size(), prefab.tileMaps.size());
+    for (size_t ii = 0; ii < expected.tileMaps.size(); ++ii)
+    {
+        const auto& expectedMap = expected.tileMaps[ii];
+        const auto& tileMap = prefab.tileMaps[ii];
+        EXPECT_EQ(expectedMap.filename, tileMap.filename);
+        EXPECT_EQ(expectedMap.tileSize, tileMap.tileSize);
+        ASSERT_EQ(expectedMap.tiles.getSize(), tileMap.tiles.getSize());
+        for (size_t jj = 0; jj < tileMap.tiles.getSize().product(); ++jj)
+        {
+            EXPECT_EQ(expectedMap.tiles(jj), tileMap.tiles(jj));
+        }
+        EXPECT_EQ(expectedMap.hasCollision, tileMap.hasCollision);
+        EXPECT_EQ(expectedMap.collision, tileMap.collision);
+    }
+
+    EXPECT_EQ(expected.hasSprite, prefab.hasSprite);
+    EXPECT_EQ(expected.sprite.filename, prefab.sprite.filename);
+    EXPECT_EQ(expected.sprite.pivot, prefab.sprite.pivot);
+    EXPECT_EQ(expected.sprite.frames, prefab.sprite.frames);
+
+    EXPECT_EQ(expected.hasCamera, prefab.hasCamera);
+
+    EXPECT_EQ(expected.hasAnimation, prefab.hasAnimation);
+    EXPECT_EQ(expected.animationFrames, prefab.animationFrames);
+    ASSERT_EQ(expected.animations.size(), prefab.animations.size());
+    for (size_t ii = 0; ii < expected.animations.size(); ++ii)
+    {
+        EXPECT_EQ(expected.animations[ii].name, prefab.animations[ii].name);
+        EXPECT_EQ(expected.animations[ii].start,
+                  prefab.animations[ii].start);
+        EXPECT_EQ(expected.animations[ii].end, prefab.animations[ii].end);
+        EXPECT_EQ(expected.animations[ii].duration,
+                  prefab.animations[ii].duration);
+        EXPECT_EQ(expected.animations[ii].playType,
+                  prefab.animations[ii].playType);
+    }
+    EXPECT_EQ(expected.initialAnimation, prefab.initialAnimation);
+
+    EXPECT_EQ(expected.hasLayer, prefab.hasLayer);
+    EXPECT_EQ(expected.layer, prefab.layer);
+}
+}
+
+namespace nyra
+{
+namespace game
+{
+//===========================================================================//
+TEST(CompiledMap, MatchesJSON)
+{
+    Prefab::clear();
+    MapData expected;
+    core::read(getMap(), expected);
+
+    // Hold onto copies since clearing the registry frees the originals
+    std::vector<Prefab> expectedPrefabs;
+    for (const ActorPlacement& actor : expected.actors)
+    {
+        expectedPrefabs.push_back(*actor.prefab);
+    }
+
+    compileMap(getMap(), PATHNAME);
+    Prefab::clear();
+
+    MapData data;
+    core::read(PATHNAME, data);
+
+    ASSERT_EQ(expected.actors.size(), data.actors.size());
+    for (size_t ii = 0; ii < expected.actors.size(); ++ii)
+    {
+        EXPECT_EQ(expected.actors[ii].name, data.actors[ii].name);
+        EXPECT_EQ(expected.actors[ii].hasPosition,
+                  data.actors[ii].hasPosition);
+        EXPECT_EQ(expected.actors[ii].position, data.actors[ii].position);
+        EXPECT_EQ(expected.actors[ii].variables, data.actors[ii].variables);
+        expectEqual(expectedPrefabs[ii], *data.actors[ii].prefab);
+    }
+
+    // Actors that share a prefab still share it
+    EXPECT_EQ(data.actors[1].prefab, data.actors[2].prefab);
+    EXPECT_EQ(expected.textures, data.textures);
+    ASSERT_EQ(static_cast<size_t>(4), data.textures.size());
+    EXPECT_EQ("textures/test_compiled_map_tiles.png", data.textures[0]);
+    EXPECT_EQ("textures/test_compiled_map_player.png", data.textures[1]);
+
+    Prefab::clear();
+    std::remove(PATHNAME.c_str());
+}
+
+//===========================================================================//
+TEST(CompiledMap, Replace)
+{
+    Prefab::clear();
+    compileMap(getMap(), PATHNAME);
+    Prefab::clear();
+    const std::vector<char> original = readFile(PATHNAME);
+
+    // Compiling again moves a whole new file over the old one
+    compileMap(getMap(), PATHNAME);
+    Prefab::clear();
+    EXPECT_FALSE(core::path::exists(PATHNAME + ".tmp"));
+    EXPECT_EQ(original.size(), readFile(PATHNAME).size());
+    MapData data;
+    core::read(PATHNAME, data);
+    EXPECT_FALSE(data.actors.empty());
+    Prefab::clear();
+
+    // A file that cannot be written throws and leaves nothing behind
+    const std::string missing = "missing_directory/" + PATHNAME;
+    EXPECT_THROW(compileMap(getMap(), missing), std::runtime_error);
+    Prefab::clear();
+    EXPECT_FALSE(core::path::exists(missing));
+    EXPECT_FALSE(core::path::exists(missing + ".tmp"));
+
+    std::remove(PATHNAME.c_str());
+}
+
+//===========================================================================//
+TEST(CompiledMap, Corrupt)
+{
+    Prefab::clear();
+    compileMap(getMap(), PATHNAME);
+    Prefab::clear();
+    const std::vector<char> original = readFile(PATHNAME);
+
+    // Overwrite every word past the header with a huge count. Reading must
+    // either still work or throw, never allocate the count or overflow.
+    const std::string corruptPathname = "test_compiled_map_corrupt.nmap";
+    const uint32_t huge = 0xFFFFFFF0;
+    for (size_t ii = 80; ii + sizeof(huge) <= original.size(); ++ii)
+    {
+        std::vector<char> buffer = original;
+        std::memcpy(&buffer[ii], &huge, sizeof(huge));
+        writeFile(buffer, corruptPathname);
+
+        try
+        {
+            MapData data;
+            core::read(corruptPathname, data);
+        }
+        catch (const std::runtime_error&)
+        {
+        }
+        Prefab::clear();
+    }
+
+    // The header is checked before anything is read
+    std::vector<char> truncated(original.begin(), original.begin() + 40);
+    writeFile(truncated, corruptPathname);
+    MapData data;
+    EXPECT_THROW(core::read(corruptPathname, data), std::runtime_error);
+
+    std::remove(corruptPathname.c_str());
+    std::remove(PATHNAME.c_str());
+}
+}
+}
+
+NYRA_TEST()
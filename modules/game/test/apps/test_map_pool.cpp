@@ -0,0 +1,168 @@
+/*
+ * Copyright (c) 2018 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#include <cstdlib>
+#include <new>
+#include <stdexcept>
+#include <nyra/test/Test.h>
+#include <nyra/game/Map.h>
+#include <nyra/game/Types.h>
+
+namespace
+{
+//===========================================================================//
+const std::string PREFAB = "test_map_pool.json";
+const std::string PLAIN_PREFAB = "test_map_pool_plain.json";
+const double DELTA = 1.0 / 60.0;
+size_t allocations = 0;
+
+//===========================================================================//
+nyra::script::VariablePtr getVariable(nyra::game::Actor& actor,
+                                      const std::string& name)
+{
+    return actor.getScript().variable(name);
+}
+}
+
+//===========================================================================//
+void* operator new(size_t size)
+{
+    ++allocations;
+    void* ptr = std::malloc(size);
+    if (!ptr)
+    {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+//===========================================================================//
+void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+//===========================================================================//
+void operator delete(void* ptr, size_t) noexcept
+{
+    std::free(ptr);
+}
+
+namespace nyra
+{
+namespace game
+{
+TEST(Map, PoolReset)
+{
+    WindowT window("test_map_pool", math::Vector2U(64, 64));
+    Input input(window, "empty.json");
+    RenderTargetT target(window);
+    Map map(input, target, 60.0, PhysicsOptions());
+    map.reservePool(PREFAB, 1);
+
+    Actor& actor = map.spawnActor(PREFAB, "pooled", true);
+    map.update(DELTA);
+    EXPECT_EQ(1, getVariable(actor, "initializes")->get<int64_t>());
+
+    // Change everything a script could leave behind
+    actor.setPosition(math::Vector2F(10.0f, 20.0f));
+    actor.setRotation(45.0f);
+    actor.setLayer(7);
+    actor.setQueryGroups(4);
+    getVariable(actor, "hits")->set<int64_t>(3);
+
+    map.destroyActor(&actor);
+    map.update(DELTA);
+    EXPECT_THROW(Map::getActor("pooled"), std::out_of_range);
+
+    // The only pooled actor has to come back, in its spawned state
+    Actor& respawned = map.spawnActor(PREFAB, "pooled", true);
+    EXPECT_EQ(&actor, &respawned);
+    EXPECT_EQ(math::Vector2F(), respawned.getPosition());
+    EXPECT_EQ(0.0f, respawned.getRotation());
+    EXPECT_EQ(2, respawned.getLayer());
+    EXPECT_EQ(1u, respawned.getQueryGroups());
+    EXPECT_EQ(0, getVariable(respawned, "hits")->get<int64_t>());
+    EXPECT_EQ(2, getVariable(respawned, "initializes")->get<int64_t>());
+}
+
+TEST(Map, PoolWaitsForRender)
+{
+    WindowT window("test_map_pool", math::Vector2U(64, 64));
+    Input input(window, "empty.json");
+    RenderTargetT target(window);
+    Map map(input, target, 60.0, PhysicsOptions());
+    map.reservePool(PREFAB, 1);
+
+    Actor& actor = map.spawnActor(PREFAB, "pooled", true);
+    map.update(DELTA);
+
+    // Render holds a snapshot that still draws the actor
+    map.acquireSnapshot();
+    map.destroyActor(&actor);
+    map.update(DELTA);
+
+    // So it must not be reused yet
+    Actor& other = map.spawnActor(PREFAB, "other", true);
+    EXPECT_NE(&actor, &other);
+
+    // Once render moves past it, it is back in the pool
+    map.acquireSnapshot();
+    map.update(DELTA);
+    Actor& respawned = map.spawnActor(PREFAB, "pooled", true);
+    EXPECT_EQ(&actor, &respawned);
+}
+
+TEST(Map, PoolAllocations)
+{
+    WindowT window("test_map_pool", math::Vector2U(64, 64));
+    Input input(window, "empty.json");
+    RenderTargetT target(window);
+    Map map(input, target, 60.0, PhysicsOptions());
+    map.reservePool(PLAIN_PREFAB, 1);
+
+    // Long enough that the name does not fit in the string itself
+    const std::string name = "a pooled actor with a name on the heap";
+
+    // The first cycles size the actor lists and the name entry
+    for (size_t ii = 0; ii < 2; ++ii)
+    {
+        map.destroyActor(&map.spawnActor(PLAIN_PREFAB, name, true));
+        map.update(DELTA);
+        map.update(DELTA);
+    }
+
+    // After that a named spawn and destroy from a warm pool is free
+    allocations = 0;
+    Actor& actor = map.spawnActor(PLAIN_PREFAB, name, true);
+    map.destroyActor(&actor);
+    EXPECT_EQ(static_cast<size_t>(0), allocations);
+
+    map.update(DELTA);
+    EXPECT_THROW(Map::getActor(name), std::out_of_range);
+    Actor& respawned = map.spawnActor(PLAIN_PREFAB, name, true);
+    EXPECT_EQ(&actor, &respawned);
+    EXPECT_EQ(&respawned, &Map::getActor(name));
+}
+}
+}
+
+NYRA_TEST()
@@ -0,0 +1,169 @@
+/*
+ * Copyright (c) 2018 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#include <cstdio>
+#include <stdexcept>
+#include <nyra/test/Test.h>
+#include <nyra/game/Game.h>
+#include <nyra/game/Input.h>
+#include <nyra/game/Replay.h>
+
+namespace
+{
+//===========================================================================//
+const std::string PATHNAME = "test_replay.nrep";
+const std::string INPUT_MAP = "test_replay.json";
+const std::string MAP = "empty.json";
+
+//===========================================================================//
+nyra::game::Replay makeReplay()
+{
+    typedef nyra::game::Replay::State State;
+
+    // Inputs are recorded sorted by name
+    const std::vector<std::string> inputs = {"jump", "look"};
+    nyra::game::Replay replay(1234, MAP, 60.0, inputs);
+    replay.addFrame({State(true, true, false, 1.0f),
+                     State(false, false, false, 0.25f)});
+    replay.addFrame({State(false, true, false, 1.0f),
+                     State(false, false, false, -3.5f)});
+    replay.addFrame({State(false, false, true, 0.0f),
+                     State(false, false, false, 0.0f)});
+    replay.addMapChange(2, MAP);
+    return replay;
+}
+
+//===========================================================================//
+void expectEqual(const nyra::game::Replay& expected,
+                 const nyra::game::Replay& replay)
+{
+    EXPECT_EQ(expected.getSeed(), replay.getSeed());
+    EXPECT_EQ(expected.getMap(), replay.getMap());
+    EXPECT_EQ(expected.getSimulationRate(), replay.getSimulationRate());
+    EXPECT_EQ(expected.getInputs(), replay.getInputs());
+    EXPECT_EQ(expected.getMapChanges(), replay.getMapChanges());
+    EXPECT_EQ(expected.getChecksum(), replay.getChecksum());
+    ASSERT_EQ(expected.getNumFrames(), replay.getNumFrames());
+
+    const size_t numStates =
+            expected.getNumFrames() * expected.getInputs().size();
+    for (size_t ii = 0; ii < numStates; ++ii)
+    {
+        const auto& state = replay.getFrame(0)[ii];
+        const auto& expectedState = expected.getFrame(0)[ii];
+        EXPECT_EQ(expectedState.isPressed, state.isPressed);
+        EXPECT_EQ(expectedState.isDown, state.isDown);
+        EXPECT_EQ(expectedState.isReleased, state.isReleased);
+        EXPECT_EQ(expectedState.value, state.value);
+    }
+}
+
+//===========================================================================//
+void runReplay(const nyra::game::Replay& replay)
+{
+    nyra::core::write(replay, PATHNAME, nyra::core::BINARY);
+    nyra::game::Options options;
+    options.game.inputMap = INPUT_MAP;
+    options.game.playReplay = PATHNAME;
+    nyra::game::Game game(options);
+    game.run();
+}
+}
+
+namespace nyra
+{
+namespace game
+{
+//===========================================================================//
+TEST(Replay, RoundTrip)
+{
+    Replay expected = makeReplay();
+    expected.setChecksum(0x0123456789ABCDEFULL);
+    core::write(expected, PATHNAME, core::BINARY);
+
+    Replay replay;
+    core::read(PATHNAME, replay, core::BINARY);
+    replay.validate();
+    expectEqual(expected, replay);
+
+    std::remove(PATHNAME.c_str());
+}
+
+//===========================================================================//
+TEST(Replay, Validate)
+{
+    EXPECT_NO_THROW(makeReplay().validate());
+
+    // Nothing was recorded at a zero rate
+    Replay rate(1234, MAP, 0.0, {"jump", "look"});
+    EXPECT_THROW(rate.validate(), std::runtime_error);
+
+    // Frames must carry every input
+    Replay replay = makeReplay();
+    EXPECT_THROW(replay.addFrame({Replay::State()}), std::runtime_error);
+}
+
+//===========================================================================//
+TEST(Replay, RecordPlay)
+{
+    Input input(INPUT_MAP);
+    const Replay expected = makeReplay();
+    ASSERT_EQ(input.getNames(), expected.getInputs());
+
+    // Every step played is what is read back and recorded
+    Replay replay(expected.getSeed(), MAP, expected.getSimulationRate(),
+                  input.getNames());
+    for (size_t ii = 0; ii < expected.getNumFrames(); ++ii)
+    {
+        input.play(expected, ii);
+        const Replay::State* states = expected.getFrame(ii);
+        EXPECT_EQ(states[0].isPressed, Input::isPressed("jump"));
+        EXPECT_EQ(states[0].isDown, Input::isDown("jump"));
+        EXPECT_EQ(states[0].isReleased, Input::isReleased("jump"));
+        EXPECT_EQ(states[0].value, Input::getValue("jump"));
+        EXPECT_EQ(states[1].value, Input::getValue("look"));
+        input.record(replay);
+    }
+
+    replay.addMapChange(2, MAP);
+    expectEqual(expected, replay);
+}
+
+//===========================================================================//
+TEST(Replay, Checksum)
+{
+    // An empty map always sums to zero
+    Replay replay = makeReplay();
+    EXPECT_NO_THROW(runReplay(replay));
+
+    replay.setChecksum(1);
+    EXPECT_THROW(runReplay(replay), std::runtime_error);
+
+    // Inputs missing from the input map are rejected before playing
+    Replay unknown(1234, MAP, 60.0, {"jump", "look", "shoot"});
+    EXPECT_THROW(runReplay(unknown), std::runtime_error);
+
+    std::remove(PATHNAME.c_str());
+}
+}
+}
+
+NYRA_TEST()
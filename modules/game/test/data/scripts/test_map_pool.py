@@ -0,0 +1,14 @@
+import nyra.game
+
+
+class PoolActor(nyra.game.Actor):
+    def __init__(self):
+        nyra.game.Actor.__init__(self)
+        self.hits = 0
+        self.initializes = 0
+
+    def init(self):
+        self.initializes += 1
+
+    def reset(self):
+        self.hits = 0
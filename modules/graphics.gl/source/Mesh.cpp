@@ -55,13 +55,10 @@ void Mesh::initialize(const std::string& pathname)
 void Mesh::initialize(const std::vector<math::Vector3F>& vertices,
                       const std::vector<size_t>& indices)
 {
-    std::vector<GLfloat> glVerts(vertices.size() * 3);
-    for (size_t ii = 0, jj = 0; ii < vertices.size(); ++ii, jj += 3)
-    {
-        glVerts[jj] = vertices[ii].x;
-        glVerts[jj + 1] = vertices[ii].y;
-        glVerts[jj + 2] = vertices[ii].z;
-    }
+    // Vector3F is three packed floats so the vertices can be uploaded
+    // without repacking them.
+    static_assert(sizeof(math::Vector3F) == 3 * sizeof(GLfloat),
+                  "Vector3F must match the vertex layout");
 
     std::vector<GLuint> glIndices(indices.size());
     for (size_t ii = 0; ii < indices.size(); ++ii)
@@ -78,8 +75,8 @@ void Mesh::initialize(const std::vector<math::Vector3F>& vertices,
     glBindVertexArray(mVectorArrayObject);
 
     glBindBuffer(GL_ARRAY_BUFFER, mVectorBufferObject);
-    glBufferData(GL_ARRAY_BUFFER, glVerts.size() * sizeof(GLfloat),
-                 glVerts.data(), GL_STATIC_DRAW);
+    glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(math::Vector3F),
+                 vertices.data(), GL_STATIC_DRAW);
 
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mElementBufferObject);
     glBufferData(GL_ELEMENT_ARRAY_BUFFER, glIndices.size() * sizeof(GLuint),
@@ -102,6 +102,16 @@ public:
      */
     void flush() override;
 
+    /*
+     *  \func setActive
+     *  \brief Activates or deactivates the OpenGL context on the calling
+     *         thread. A context can only be active on one thread at a
+     *         time, so deactivate it before rendering from another thread.
+     *
+     *  \param active True to activate the context.
+     */
+    void setActive(bool active);
+
     /*
      *  \func getPixels
      *  \brief Gets the pixels of the underlying target. In general this
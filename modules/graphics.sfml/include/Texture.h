@@ -22,7 +22,11 @@
 #ifndef __NYRA_GRAPHICS_SFML_TEXTURE_H__
 #define __NYRA_GRAPHICS_SFML_TEXTURE_H__
 
+#include <memory>
+#include <mutex>
 #include <SFML/Graphics.hpp>
+#include <nyra/math/Vector2.h>
+#include <nyra/mem/SharedResource.h>
 
 namespace nyra
 {
@@ -33,30 +37,57 @@ namespace sfml
 /*
  *  \class Texture
  *  \brief Wraps an SFML texture so it can be constructed with a pathname.
+ *         The file is decoded right away but only sent to the graphics
+ *         card the first time it is drawn, so textures can be loaded on
+ *         any thread and without a display.
  */
 class Texture
 {
 public:
     /*
      *  \func Constructor
-     *  \brief Creates an SFML texture.
+     *  \brief Decodes the image file.
      */
     Texture(const std::string& pathname);
 
     /*
      *  \func get
-     *  \brief  Gets the SFML texture.
+     *  \brief Gets the SFML texture. The first call uploads it, so only
+     *         call this from the thread that draws.
      *
      *  \return The SFML texture.
      */
-    const sf::Texture& get() const
+    const sf::Texture& get() const;
+
+    /*
+     *  \func getSize
+     *  \brief Gets the size of the image without uploading it.
+     *
+     *  \return The size in pixels.
+     */
+    const math::Vector2U& getSize() const
     {
-        return mTexture;
+        return mSize;
     }
 
 private:
-    sf::Texture mTexture;
+    // Creating an sf::Texture creates a graphics context, so it is not
+    // made until it is needed.
+    mutable sf::Image mImage;
+    mutable std::unique_ptr<sf::Texture> mTexture;
+    mutable std::once_flag mUploaded;
+    math::Vector2U mSize;
 };
+
+/*
+ *  \func getTextureResource
+ *  \brief Gets the texture cache shared by every SFML sprite and tile map.
+ *         Keeping a texture alive for one of them, such as while a map
+ *         is preloaded, keeps it loaded for all of them.
+ *
+ *  \return The shared texture cache.
+ */
+mem::SharedResource<Texture>& getTextureResource();
 }
 }
 }
@@ -0,0 +1,152 @@
+/*
+ * Copyright (c) 2018 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#ifndef __NYRA_GRAPHICS_SFML_TILE_MAP_H__
+#define __NYRA_GRAPHICS_SFML_TILE_MAP_H__
+
+#include <memory>
+#include <vector>
+#include <SFML/Graphics.hpp>
+#include <nyra/graphics/Renderable.h>
+#include <nyra/graphics/sfml/Texture.h>
+#include <nyra/math/Transform.h>
+#include <nyra/math/Vector2.h>
+#include <nyra/mem/Buffer2D.h>
+
+namespace nyra
+{
+namespace graphics
+{
+namespace sfml
+{
+/*
+ *  \class TileMap
+ *  \brief Renders tiles in square chunks. Each chunk is a single vertex
+ *         array drawn in one call. Only chunks inside the current view are
+ *         drawn. Chunk geometry is built the first time the chunk is seen
+ *         and dropped after it has been out of view for a while, so a
+ *         large map only costs its tile indices.
+ */
+class TileMap : public Renderable<math::Transform2D>
+{
+public:
+    /*
+     *  \var CHUNK_SIZE
+     *  \brief The width and height of a chunk in tiles
+     */
+    static const size_t CHUNK_SIZE = 32;
+
+    /*
+     *  \func Constructor
+     *  \brief Creates a tilemap
+     *
+     *  \param spritePathname The pathname for the base sprite map
+     *  \param tiles The frame index for each tile
+     *  \param tileSize The size of each tile in pixels.
+     */
+    TileMap(const std::string& spritePathname,
+            const mem::Buffer2D<size_t>& tiles,
+            const math::Vector2U tileSize);
+
+    /*
+     *  \func render
+     *  \brief Renders the chunks that overlap the target's view
+     *
+     *  \param target The target to render to
+     */
+    void render(graphics::RenderTarget& target) override;
+
+    /*
+     *  \func getTileSize
+     *  \brief Gets the size of individual tiles
+     *
+     *  \return The tile size
+     */
+    const math::Vector2U& getTileSize() const
+    {
+        return mTileSize;
+    }
+
+    /*
+     *  \func getTile
+     *  \brief Gets the frame index of a tile
+     *
+     *  \param x The column
+     *  \param y The row
+     *  \return The frame index
+     */
+    size_t getTile(size_t x, size_t y) const
+    {
+        return mTiles(x, y);
+    }
+
+    /*
+     *  \func setTile
+     *  \brief Changes the frame index of a tile. Its chunk is rebuilt the
+     *         next time it is drawn.
+     *
+     *  \param x The column
+     *  \param y The row
+     *  \param tile The frame index
+     */
+    void setTile(size_t x, size_t y, size_t tile);
+
+    /*
+     *  \func getNumTiles
+     *  \brief Gets the number of tiles in each direction
+     *
+     *  \return The map size in tiles
+     */
+    const math::Vector2U& getNumTiles() const
+    {
+        return mTiles.getSize();
+    }
+
+    /*
+     *  \func getNumDrawnChunks
+     *  \brief Gets the number of chunks drawn by the last render
+     *
+     *  \return The number of chunks
+     */
+    size_t getNumDrawnChunks() const
+    {
+        return mNumDrawn;
+    }
+
+private:
+    void buildChunk(size_t chunk);
+
+    std::shared_ptr<Texture> mTexture;
+    mem::Buffer2D<uint32_t> mTiles;
+    const math::Vector2U mTileSize;
+    math::Vector2U mTilesInImage;
+    const math::Vector2U mNumChunks;
+    std::vector<std::unique_ptr<sf::VertexArray> > mChunks;
+    std::vector<size_t> mLastDrawn;
+    std::vector<size_t> mResident;
+    size_t mFrame;
+    size_t mNumDrawn;
+};
+}
+}
+}
+
+#endif
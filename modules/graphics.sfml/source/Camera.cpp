@@ -29,10 +29,11 @@ namespace
 //===========================================================================//
 nyra::math::Vector2F getTargetSize(const nyra::graphics::RenderTarget& target)
 {
-    const sf::RenderTarget& sfTarget(dynamic_cast
-            <const nyra::graphics::sfml::RenderTarget&>(target).get());
-    const sf::View& view(sfTarget.getDefaultView());
-    return nyra::math::Vector2F(view.getSize().x, view.getSize().y);
+    // The default view covers the whole target, so any target can size
+    // the camera, including ones that do not draw
+    const nyra::math::Vector2U size = target.getSize();
+    return nyra::math::Vector2F(static_cast<float>(size.x),
+                                static_cast<float>(size.y));
 }
 }
 
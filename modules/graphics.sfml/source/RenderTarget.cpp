@@ -20,6 +20,7 @@
  * IN THE SOFTWARE.
  */
 #include <nyra/graphics/sfml/RenderTarget.h>
+#include <nyra/core/Profiler.h>
 
 namespace nyra
 {
@@ -94,6 +95,7 @@ void RenderTarget::clear(const img::Color& color)
 //===========================================================================//
 void RenderTarget::flush()
 {
+    NYRA_PROFILE_SCOPE("RenderTarget::flush");
     mTexture->display();
 
     if (mWindow.get())
@@ -103,6 +105,16 @@ void RenderTarget::flush()
     }
 }
 
+//===========================================================================//
+void RenderTarget::setActive(bool active)
+{
+    mTexture->setActive(active);
+    if (mWindow.get())
+    {
+        mWindow->setActive(active);
+    }
+}
+
 //===========================================================================//
 img::Image RenderTarget::getPixels() const
 {
@@ -20,15 +20,8 @@
  * IN THE SOFTWARE.
  */
 #include <nyra/graphics/sfml/Sprite.h>
-#include <nyra/mem/SharedResource.h>
 #include <nyra/graphics/sfml/RenderTarget.h>
 
-namespace
-{
-//===========================================================================//
-static nyra::mem::SharedResource<nyra::graphics::sfml::Texture> resource;
-}
-
 namespace nyra
 {
 namespace graphics
@@ -45,16 +38,19 @@ Sprite::Sprite(const std::string& texture)
 void Sprite::load(const std::string& texture)
 {
     mSprite.reset(new sf::Sprite());
-    mTexture = resource[texture];
-    mSprite->setTexture(mTexture->get());
-    setFrame(math::Vector2U(),
-             math::Vector2U(mTexture->get().getSize().x,
-                            mTexture->get().getSize().y));
+    mTexture = getTextureResource()[texture];
+    setFrame(math::Vector2U(), mTexture->getSize());
 }
 
 //===========================================================================//
 void Sprite::render(graphics::RenderTarget& target)
 {
+    // The texture is only uploaded once something draws it
+    if (!mSprite->getTexture())
+    {
+        mSprite->setTexture(mTexture->get());
+    }
+
     const math::Matrix3x3& m = getMatrix();
     sf::Transform transform(m(0, 0), m(0, 1), m(0, 2),
                             m(1, 0), m(1, 1), m(1, 2),
@@ -30,7 +30,29 @@ namespace sfml
 //===========================================================================//
 Texture::Texture(const std::string& pathname)
 {
-    mTexture.loadFromFile(pathname);
+    mImage.loadFromFile(pathname);
+    mSize = math::Vector2U(mImage.getSize().x, mImage.getSize().y);
+}
+
+//===========================================================================//
+const sf::Texture& Texture::get() const
+{
+    std::call_once(mUploaded, [this]()
+    {
+        mTexture.reset(new sf::Texture());
+        mTexture->loadFromImage(mImage);
+
+        // The pixels live on the graphics card from here on
+        mImage = sf::Image();
+    });
+    return *mTexture;
+}
+
+//===========================================================================//
+mem::SharedResource<Texture>& getTextureResource()
+{
+    static mem::SharedResource<Texture> resource;
+    return resource;
 }
 }
 }
@@ -0,0 +1,204 @@
+/*
+ * Copyright (c) 2018 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#include <algorithm>
+#include <cmath>
+#include <nyra/graphics/sfml/TileMap.h>
+#include <nyra/graphics/sfml/RenderTarget.h>
+
+namespace
+{
+// Chunk geometry that has not been drawn for this many frames is freed
+static const size_t EVICT_FRAMES = 120;
+}
+
+namespace nyra
+{
+namespace graphics
+{
+namespace sfml
+{
+//===========================================================================//
+const size_t TileMap::CHUNK_SIZE;
+
+//===========================================================================//
+TileMap::TileMap(const std::string& spritePathname,
+                 const mem::Buffer2D<size_t>& tiles,
+                 const math::Vector2U tileSize) :
+    mTexture(getTextureResource()[spritePathname]),
+    mTiles(tiles.getSize()),
+    mTileSize(tileSize),
+    mNumChunks((tiles.getSize().x + CHUNK_SIZE - 1) / CHUNK_SIZE,
+               (tiles.getSize().y + CHUNK_SIZE - 1) / CHUNK_SIZE),
+    mChunks(mNumChunks.product()),
+    mLastDrawn(mNumChunks.product(), 0),
+    mFrame(0),
+    mNumDrawn(0)
+{
+    for (size_t ii = 0; ii < tiles.getSize().product(); ++ii)
+    {
+        mTiles(ii) = static_cast<uint32_t>(tiles(ii));
+    }
+
+    const math::Vector2U& textureSize = mTexture->getSize();
+    mTilesInImage = math::Vector2U(
+            std::max<size_t>(textureSize.x / mTileSize.x, 1),
+            std::max<size_t>(textureSize.y / mTileSize.y, 1));
+    // Tiles hang down and right from the map position, like the per
+    // tile sprites did
+    setPivot(math::Vector2F(0.0f, 0.0f));
+    setSize(tileSize * tiles.getSize());
+}
+
+//===========================================================================//
+void TileMap::setTile(size_t x, size_t y, size_t tile)
+{
+    mTiles(x, y) = static_cast<uint32_t>(tile);
+
+    // Chunks that are not built yet will pick up the change when they are
+    const size_t chunk = (y / CHUNK_SIZE) * mNumChunks.x + x / CHUNK_SIZE;
+    if (mChunks[chunk])
+    {
+        buildChunk(chunk);
+    }
+}
+
+//===========================================================================//
+void TileMap::buildChunk(size_t chunk)
+{
+    const size_t startX = (chunk % mNumChunks.x) * CHUNK_SIZE;
+    const size_t startY = (chunk / mNumChunks.x) * CHUNK_SIZE;
+    const size_t endX = std::min<size_t>(startX + CHUNK_SIZE,
+                                         mTiles.getNumCols());
+    const size_t endY = std::min<size_t>(startY + CHUNK_SIZE,
+                                         mTiles.getNumRows());
+    const float width = static_cast<float>(mTileSize.x);
+    const float height = static_cast<float>(mTileSize.y);
+
+    std::unique_ptr<sf::VertexArray> vertices(new sf::VertexArray(
+            sf::Quads, (endX - startX) * (endY - startY) * 4));
+    size_t vertex = 0;
+    for (size_t row = startY; row < endY; ++row)
+    {
+        for (size_t col = startX; col < endX; ++col)
+        {
+            const float left = col * width;
+            const float top = row * height;
+            const float u = (mTiles(col, row) % mTilesInImage.x) * width;
+            const float v = (mTiles(col, row) / mTilesInImage.x) * height;
+
+            sf::Vertex* quad = &(*vertices)[vertex];
+            quad[0].position = sf::Vector2f(left, top);
+            quad[1].position = sf::Vector2f(left + width, top);
+            quad[2].position = sf::Vector2f(left + width, top + height);
+            quad[3].position = sf::Vector2f(left, top + height);
+            quad[0].texCoords = sf::Vector2f(u, v);
+            quad[1].texCoords = sf::Vector2f(u + width, v);
+            quad[2].texCoords = sf::Vector2f(u + width, v + height);
+            quad[3].texCoords = sf::Vector2f(u, v + height);
+            vertex += 4;
+        }
+    }
+
+    mChunks[chunk] = std::move(vertices);
+}
+
+//===========================================================================//
+void TileMap::render(graphics::RenderTarget& target)
+{
+    ++mFrame;
+    mNumDrawn = 0;
+
+    sf::RenderTarget& sfTarget = dynamic_cast<
+            graphics::sfml::RenderTarget&>(target).get();
+    const math::Matrix3x3& m = getMatrix();
+    sf::RenderStates states;
+    states.transform = sf::Transform(m(0, 0), m(0, 1), m(0, 2),
+                                     m(1, 0), m(1, 1), m(1, 2),
+                                     m(2, 0), m(2, 1), m(2, 2));
+    states.texture = &mTexture->get();
+
+    // Take the corners of the view back into tile map pixels. The view
+    // can be rotated, so the box around all four corners is used.
+    const sf::Transform toLocal = states.transform.getInverse() *
+            sfTarget.getView().getInverseTransform();
+    const sf::Vector2f corners[] = {
+            toLocal.transformPoint(-1.0f, -1.0f),
+            toLocal.transformPoint(1.0f, -1.0f),
+            toLocal.transformPoint(1.0f, 1.0f),
+            toLocal.transformPoint(-1.0f, 1.0f)};
+    float minX = corners[0].x;
+    float minY = corners[0].y;
+    float maxX = corners[0].x;
+    float maxY = corners[0].y;
+    for (const sf::Vector2f& corner : corners)
+    {
+        minX = std::min(minX, corner.x);
+        minY = std::min(minY, corner.y);
+        maxX = std::max(maxX, corner.x);
+        maxY = std::max(maxY, corner.y);
+    }
+
+    const float chunkWidth = static_cast<float>(CHUNK_SIZE * mTileSize.x);
+    const float chunkHeight = static_cast<float>(CHUNK_SIZE * mTileSize.y);
+    const float firstX = std::max(std::floor(minX / chunkWidth), 0.0f);
+    const float firstY = std::max(std::floor(minY / chunkHeight), 0.0f);
+    const float lastX = std::min(std::floor(maxX / chunkWidth),
+                                 static_cast<float>(mNumChunks.x) - 1.0f);
+    const float lastY = std::min(std::floor(maxY / chunkHeight),
+                                 static_cast<float>(mNumChunks.y) - 1.0f);
+
+    for (float y = firstY; y <= lastY; ++y)
+    {
+        for (float x = firstX; x <= lastX; ++x)
+        {
+            const size_t chunk = static_cast<size_t>(y) * mNumChunks.x +
+                                 static_cast<size_t>(x);
+            if (!mChunks[chunk])
+            {
+                buildChunk(chunk);
+                mResident.push_back(chunk);
+            }
+
+            sfTarget.draw(*mChunks[chunk], states);
+            mLastDrawn[chunk] = mFrame;
+            ++mNumDrawn;
+        }
+    }
+
+    // Free the geometry of chunks that have been off screen for a while
+    for (size_t ii = 0; ii < mResident.size();)
+    {
+        const size_t chunk = mResident[ii];
+        if (mFrame - mLastDrawn[chunk] <= EVICT_FRAMES)
+        {
+            ++ii;
+            continue;
+        }
+
+        mChunks[chunk].reset();
+        mResident[ii] = mResident.back();
+        mResident.pop_back();
+    }
+}
+}
+}
+}
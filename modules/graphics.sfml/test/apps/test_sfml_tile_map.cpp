@@ -23,6 +23,7 @@
 #include <nyra/graphics/sfml/RenderTarget.h>
 #include <nyra/graphics/sfml/Sprite.h>
 #include <nyra/graphics/TileMap.h>
+#include <nyra/graphics/sfml/TileMap.h>
 #include <nyra/core/Path.h>
 #include <nyra/img/Color.h>
 #include <nyra/test/Image.h>
@@ -56,6 +57,61 @@ TEST(SFMLTileMap, Rect)
     EXPECT_TRUE(test::compareImage(
             target.getPixels(), "test_tile_map.png"));
 }
+
+TEST(SFMLTileMap, Chunked)
+{
+    RenderTarget target(math::Vector2U(512, 512));
+
+    mem::Buffer2D<size_t> tiles({{0, 1, 2, 3, 3, 2, 1, 0},
+                                 {3, 2, 1, 0, 0, 1, 2, 3},
+                                 {0, 0, 0, 0, 0, 0, 0, 0},
+                                 {1, 1, 1, 1, 1, 1, 1, 1},
+                                 {2, 2, 2, 2, 2, 2, 2, 2}});
+    const std::string pathname = core::path::join(
+            core::DATA_PATH, "textures/test_frame_animation.png");
+
+    // This should look exactly like the sprite per tile version
+    const math::Vector2U tileSize(64, 128);
+    sfml::TileMap tileMap(pathname, tiles, tileSize);
+    EXPECT_EQ(tileSize, tileMap.getTileSize());
+    EXPECT_EQ(tiles.getSize(), tileMap.getNumTiles());
+    EXPECT_EQ(static_cast<size_t>(3), tileMap.getTile(3, 0));
+
+    target.clear(img::Color::GRAY);
+    tileMap.render(target);
+    target.flush();
+    EXPECT_EQ(static_cast<size_t>(1), tileMap.getNumDrawnChunks());
+    EXPECT_TRUE(test::compareImage(
+            target.getPixels(), "test_tile_map.png"));
+}
+
+TEST(SFMLTileMap, Culling)
+{
+    RenderTarget target(math::Vector2U(256, 256));
+
+    // 4x4 chunks of 8x8 pixel tiles. The view covers one chunk.
+    const size_t numTiles = sfml::TileMap::CHUNK_SIZE * 4;
+    const mem::Buffer2D<size_t> tiles(math::Vector2U(numTiles, numTiles));
+    const std::string pathname = core::path::join(
+            core::DATA_PATH, "textures/test_frame_animation.png");
+    sfml::TileMap tileMap(pathname, tiles, math::Vector2U(8, 8));
+
+    target.clear(img::Color::GRAY);
+    tileMap.render(target);
+    EXPECT_EQ(static_cast<size_t>(1), tileMap.getNumDrawnChunks());
+
+    // Moving the map half a chunk up and left puts four chunks in view
+    tileMap.setPosition(math::Vector2F(-128.0f, -128.0f));
+    tileMap.updateTransform(math::Transform2D());
+    tileMap.render(target);
+    EXPECT_EQ(static_cast<size_t>(4), tileMap.getNumDrawnChunks());
+
+    // Entirely off screen
+    tileMap.setPosition(math::Vector2F(1024.0f, 0.0f));
+    tileMap.updateTransform(math::Transform2D());
+    tileMap.render(target);
+    EXPECT_EQ(static_cast<size_t>(0), tileMap.getNumDrawnChunks());
+}
 }
 }
 }
@@ -23,8 +23,9 @@
 #define __NYRA_GRAPHICS_FBX_H__
 
 #include <string>
+#include <vector>
 #include <nyra/math/Vector3.h>
-#include <nyra/xml/XML.h>
+#include <nyra/xml/Parser.h>
 
 namespace nyra
 {
@@ -39,7 +40,8 @@ class Collada
 public:
     /*
      *  \func Constructor
-     *  \brief Reads and parses the file.
+     *  \brief Reads and parses the first mesh in the file. The file is
+     *         streamed so only the vertices and indices are kept.
      *
      *  \param pathname The Collada file on disk.
      */
@@ -68,8 +70,9 @@ public:
     }
 
 private:
-    void initializeVerts(const mem::Tree<xml::Element>& tree);
+    void readMesh(xml::Parser& parser);
 
+    void readTriangles(xml::Parser& parser);
 
     std::vector<math::Vector3F> mVerts;
     std::vector<size_t> mIndices;
@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) 2018 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#ifndef __NYRA_GRAPHICS_NULL_RENDER_TARGET_H__
+#define __NYRA_GRAPHICS_NULL_RENDER_TARGET_H__
+
+#include <nyra/graphics/RenderTarget.h>
+
+namespace nyra
+{
+namespace graphics
+{
+/*
+ *  \class NullRenderTarget
+ *  \brief A render target that draws nothing and needs no window or
+ *         graphics context. It only keeps a size, so code that builds
+ *         from a target can run without a display.
+ */
+class NullRenderTarget : public RenderTarget
+{
+public:
+    /*
+     *  \func Constructor
+     *  \brief Sets up a target of a given size.
+     *
+     *  \param size The size of the render target.
+     */
+    NullRenderTarget(const math::Vector2U& size);
+
+    /*
+     *  \func Constructor
+     *  \brief Sets up a target the size of a window.
+     *
+     *  \param window The window to take the size from.
+     */
+    NullRenderTarget(win::Window& window);
+
+    /*
+     *  \func initialize
+     *  \brief Sets the size of the target.
+     *
+     *  \param size The size of the render target.
+     */
+    void initialize(const math::Vector2U& size) override;
+
+    /*
+     *  \func initialize
+     *  \brief Sets the size of the target to the size of a window.
+     *
+     *  \param window The window to take the size from.
+     */
+    void initialize(win::Window& window) override;
+
+    /*
+     *  \func getSize
+     *  \brief Get the size of the render target.
+     *
+     *  \return The size of the render target
+     */
+    math::Vector2U getSize() const override;
+
+    /*
+     *  \func resize
+     *  \brief Sets the size of a render target.
+     *
+     *  \param size The desired size
+     */
+    void resize(const math::Vector2U& size) override;
+
+    /*
+     *  \func clear
+     *  \brief Does nothing, there is nothing to clear.
+     *
+     *  \param color Unused
+     */
+    void clear(const img::Color& color) override;
+
+    /*
+     *  \func flush
+     *  \brief Does nothing, there is nothing to present.
+     */
+    void flush() override;
+
+    /*
+     *  \func getPixels
+     *  \brief Gets a blank image the size of the target.
+     *
+     *  \return The image representing the render target.
+     */
+    img::Image getPixels() const override;
+
+private:
+    math::Vector2U mSize;
+};
+}
+}
+
+#endif
@@ -19,111 +19,200 @@
  * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
  * IN THE SOFTWARE.
  */
-#include <iostream>
-#include <nyra/core/String.h>
+#include <algorithm>
+#include <stdexcept>
+#include <unordered_map>
 #include <nyra/graphics/Collada.h>
+#include <nyra/core/String.h>
 
 namespace
 {
-struct Source
+//===========================================================================//
+std::string getAttribute(const nyra::xml::Parser& parser,
+                         const std::string& name)
 {
-    Source() = default;
-
-    Source(const nyra::mem::Tree<nyra::xml::Element>& floatArray,
-           const nyra::mem::Tree<nyra::xml::Element>& accessor)
+    nyra::xml::Span value;
+    if (!parser.getAttribute(name, value))
     {
-        data = nyra::core::str::split(floatArray.get().text);
-        id = accessor.get().attributes.at("source");
+        throw std::runtime_error("Collada " + parser.getName().str() +
+                                 " is missing the " + name + " attribute");
+    }
+    return value.str();
+}
+
+//===========================================================================//
+bool isEnd(const nyra::xml::Parser& parser, size_t depth)
+{
+    return parser.getEvent() == nyra::xml::Parser::END_ELEMENT &&
+            parser.getDepth() == depth;
+}
 
-        for (size_t ii = 0; ii < accessor["param"].loopSize(); ++ii)
+//===========================================================================//
+template <typename T>
+void readList(nyra::xml::Parser& parser, std::vector<T>& values)
+{
+    // Numbers go straight from the file into the buffer
+    const size_t depth = parser.getDepth();
+    while (parser.next(), !isEnd(parser, depth))
+    {
+        if (parser.getEvent() == nyra::xml::Parser::TEXT ||
+            parser.getEvent() == nyra::xml::Parser::CDATA)
         {
-            params.push_back(
-                    accessor["param"][ii].get().attributes.at("name"));
+            nyra::xml::parseList(parser.getText(), values);
         }
-
     }
+}
 
-    std::vector<std::string> data;
-    std::vector<std::string> params;
-    std::string id;
-};
-
-struct Input
+//===========================================================================//
+void readSource(nyra::xml::Parser& parser, std::vector<float>& data)
 {
-public:
-    Input(const nyra::mem::Tree<nyra::xml::Element>& input)
+    const size_t depth = parser.getDepth();
+    while (parser.next(), !isEnd(parser, depth))
     {
-        semantic = input.get().attributes.at("semantic");
-        source = input.get().attributes.at("source");
-        offset = nyra::core::str::toType<size_t>(
-                input.get().attributes.at("offset"));
+        if (parser.getEvent() == nyra::xml::Parser::START_ELEMENT &&
+            parser.getName() == "float_array")
+        {
+            readList(parser, data);
+        }
     }
+}
 
-    std::string semantic;
-    std::string source;
-    size_t offset;
-};
+//===========================================================================//
+std::string readVertices(nyra::xml::Parser& parser)
+{
+    std::string positions;
+    const size_t depth = parser.getDepth();
+    while (parser.next(), !isEnd(parser, depth))
+    {
+        if (parser.getEvent() == nyra::xml::Parser::START_ELEMENT &&
+            parser.getName() == "input" &&
+            getAttribute(parser, "semantic") == "POSITION")
+        {
+            positions = getAttribute(parser, "source");
+        }
+    }
+    return positions;
+}
 }
 
 namespace nyra
 {
 namespace graphics
 {
+//===========================================================================//
 Collada::Collada(const std::string& pathname)
 {
-    xml::XML collada = core::read<xml::XML>(pathname);
+    xml::Parser parser(pathname);
+    bool inGeometries = false;
 
-    const mem::Tree<xml::Element>& mesh =
-            collada["COLLADA"]
-                   ["library_geometries"]
-                   ["geometry"]
-                   ["mesh"];
+    while (parser.next() != xml::Parser::END_DOCUMENT)
+    {
+        if (parser.getName() == "library_geometries")
+        {
+            inGeometries = parser.getEvent() == xml::Parser::START_ELEMENT;
+        }
+        else if (inGeometries &&
+                 parser.getEvent() == xml::Parser::START_ELEMENT &&
+                 parser.getName() == "mesh")
+        {
+            readMesh(parser);
+            return;
+        }
+    }
 
-    initializeVerts(mesh);
+    throw std::runtime_error("Collada file has no mesh: " + pathname);
 }
 
-void Collada::initializeVerts(const mem::Tree<xml::Element>& tree)
+//===========================================================================//
+void Collada::readMesh(xml::Parser& parser)
 {
-    const mem::Tree<xml::Element>& source = tree["source"];
-    std::unordered_map<std::string, Source> sources;
-    for (size_t ii = 0; ii < source.loopSize(); ++ii)
+    std::unordered_map<std::string, std::vector<float> > sources;
+    std::string positions;
+
+    const size_t depth = parser.getDepth();
+    while (parser.next(), !isEnd(parser, depth))
     {
-        sources["#" + source[ii].get().attributes.at("id")] = Source(
-                source[ii]["float_array"],
-                source[ii]["technique_common"]["accessor"]);
-    }
+        if (parser.getEvent() != xml::Parser::START_ELEMENT)
+        {
+            continue;
+        }
 
-    // Save off the vertices
-    const Source& sourceVerts =
-            sources[tree["vertices"]["input"].get().attributes.at("source")];
+        if (parser.getName() == "source")
+        {
+            readSource(parser, sources["#" + getAttribute(parser, "id")]);
+        }
+        else if (parser.getName() == "vertices")
+        {
+            positions = readVertices(parser);
+        }
+        else if (parser.getName() == "triangles")
+        {
+            readTriangles(parser);
+        }
+        else
+        {
+            parser.skipElement();
+        }
+    }
 
-    for (size_t ii = 0; ii < sourceVerts.data.size(); ii += 3)
+    const auto source = sources.find(positions);
+    if (source == sources.end())
     {
-        mVerts.push_back(math::Vector3F(
-                core::str::toType<float>(sourceVerts.data[ii]),
-                core::str::toType<float>(sourceVerts.data[ii + 1]),
-                core::str::toType<float>(sourceVerts.data[ii + 2])));
+        throw std::runtime_error("Collada mesh has no vertex positions");
     }
-    std::vector<Input> inputs;
 
-    for (size_t ii = 0; ii < tree["triangles"]["input"].size(); ++ii)
+    const std::vector<float>& data = source->second;
+    mVerts.reserve(data.size() / 3);
+    for (size_t ii = 0; ii + 2 < data.size(); ii += 3)
     {
-        inputs.push_back(Input(tree["triangles"]["input"][ii]));
+        mVerts.push_back(math::Vector3F(data[ii], data[ii + 1], data[ii + 2]));
     }
+}
 
-    std::vector<std::string> triangles =
-            core::str::split(tree["triangles"]["p"].get().text);
+//===========================================================================//
+void Collada::readTriangles(xml::Parser& parser)
+{
+    std::vector<size_t> indices;
+    size_t stride = 1;
+    size_t vertexOffset = 0;
+    bool hasVertex = false;
 
-    size_t subIndex = 0;
-    for (const std::string& index : triangles)
+    const size_t depth = parser.getDepth();
+    while (parser.next(), !isEnd(parser, depth))
     {
-        if (inputs[subIndex].semantic == "VERTEX")
+        if (parser.getEvent() != xml::Parser::START_ELEMENT)
         {
-            mIndices.push_back(core::str::toType<size_t>(index));
+            continue;
         }
 
-        ++subIndex;
-        subIndex %= inputs.size();
+        if (parser.getName() == "input")
+        {
+            const size_t offset = core::str::toType<size_t>(
+                    getAttribute(parser, "offset"));
+            stride = std::max(stride, offset + 1);
+
+            if (getAttribute(parser, "semantic") == "VERTEX")
+            {
+                vertexOffset = offset;
+                hasVertex = true;
+            }
+        }
+        else if (parser.getName() == "p")
+        {
+            readList(parser, indices);
+        }
+    }
+
+    if (!hasVertex)
+    {
+        throw std::runtime_error("Collada triangles have no VERTEX input");
+    }
+
+    // Each vertex of a triangle has one index per input offset
+    mIndices.reserve(mIndices.size() + indices.size() / stride);
+    for (size_t ii = vertexOffset; ii < indices.size(); ii += stride)
+    {
+        mIndices.push_back(indices[ii]);
     }
 }
 }
@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) 2018 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#include <nyra/graphics/NullRenderTarget.h>
+
+namespace nyra
+{
+namespace graphics
+{
+//===========================================================================//
+NullRenderTarget::NullRenderTarget(const math::Vector2U& size)
+{
+    initialize(size);
+}
+
+//===========================================================================//
+NullRenderTarget::NullRenderTarget(win::Window& window)
+{
+    initialize(window);
+}
+
+//===========================================================================//
+void NullRenderTarget::initialize(const math::Vector2U& size)
+{
+    resize(size);
+}
+
+//===========================================================================//
+void NullRenderTarget::initialize(win::Window& window)
+{
+    resize(window.getSize());
+}
+
+//===========================================================================//
+math::Vector2U NullRenderTarget::getSize() const
+{
+    return mSize;
+}
+
+//===========================================================================//
+void NullRenderTarget::resize(const math::Vector2U& size)
+{
+    mSize = size;
+}
+
+//===========================================================================//
+void NullRenderTarget::clear(const img::Color& color)
+{
+}
+
+//===========================================================================//
+void NullRenderTarget::flush()
+{
+}
+
+//===========================================================================//
+img::Image NullRenderTarget::getPixels() const
+{
+    return img::Image(mSize);
+}
+}
+}
@@ -0,0 +1,50 @@
+/*
+ * Copyright (c) 2018 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#ifndef __NYRA_INPUT_NULL_KEYBOARD_H__
+#define __NYRA_INPUT_NULL_KEYBOARD_H__
+
+#include <nyra/input/Keyboard.h>
+
+namespace nyra
+{
+namespace input
+{
+/*
+ *  \class NullKeyboard
+ *  \brief A keyboard that never has a key pressed. Used where there is no
+ *         window to read a device from.
+ */
+class NullKeyboard : public Keyboard
+{
+public:
+    /*
+     *  \func update
+     *  \brief Does nothing, the state never changes.
+     */
+    void update() override
+    {
+    }
+};
+}
+}
+
+#endif
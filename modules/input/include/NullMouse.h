@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) 2018 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#ifndef __NYRA_INPUT_NULL_MOUSE_H__
+#define __NYRA_INPUT_NULL_MOUSE_H__
+
+#include <nyra/input/Mouse.h>
+
+namespace nyra
+{
+namespace input
+{
+/*
+ *  \class NullMouse
+ *  \brief A mouse that is never moved or pressed. Used where there is no
+ *         window to read a device from.
+ */
+class NullMouse : public Mouse
+{
+public:
+    /*
+     *  \func update
+     *  \brief Does nothing, the state never changes.
+     */
+    void update() override
+    {
+    }
+
+    /*
+     *  \func getPosition
+     *  \brief Gets the position of the mouse, which is always zero.
+     */
+    math::Vector2F getPosition() const override
+    {
+        return math::Vector2F();
+    }
+
+    /*
+     *  \func getDelta
+     *  \brief Gets the change in position, which is always zero.
+     */
+    math::Vector2F getDelta() const override
+    {
+        return math::Vector2F();
+    }
+
+    /*
+     *  \func getScroll
+     *  \brief Gets the change in scroll, which is always zero.
+     */
+    float getScroll() const override
+    {
+        return 0.0f;
+    }
+};
+}
+}
+
+#endif
@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) 2018 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#ifndef __NYRA_JSON_DOCUMENT_H__
+#define __NYRA_JSON_DOCUMENT_H__
+
+#include <nyra/mem/FlatTree.h>
+#include <nyra/core/Archive.h>
+
+namespace nyra
+{
+namespace json
+{
+/*
+ *  \type Document
+ *  \brief A read only JSON document. This is laid out the same way as
+ *         JSON, but is stored in a flat tree so loading a file does not
+ *         allocate a node at a time. Use JSON if the tree needs to be
+ *         edited or written back out.
+ */
+class Document : public mem::FlatTree<std::string>
+{
+public:
+    /*
+     *  \func Constructor
+     *  \brief Creates an empty document.
+     */
+    Document() = default;
+
+    /*
+     *  \func Constructor
+     *  \brief Reads a document from a pathname
+     *
+     *  \param pathname The json file on disk.
+     */
+    Document(const std::string& pathname);
+};
+}
+
+namespace core
+{
+/*
+ *  \func read
+ *  \brief Reads a JSON document from disk.
+ *
+ *  \param pathname The file to read
+ *  \param [OUTPUT] The document to load into
+ *  \param type The archive type is ignored. It will always read JSON.
+ */
+template <>
+void read<json::Document>(const std::string& pathname,
+                          json::Document& tree,
+                          core::ArchiveType type);
+}
+}
+
+#endif
@@ -0,0 +1,294 @@
+/*
+ * Copyright (c) 2018 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#ifndef __NYRA_JSON_LAZY_DOCUMENT_H__
+#define __NYRA_JSON_LAZY_DOCUMENT_H__
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+#include <stdint.h>
+#include <nyra/json/Parser.h>
+
+namespace nyra
+{
+namespace core
+{
+class MappedFile;
+}
+
+namespace json
+{
+class LazyDocument;
+
+/*
+ *  \class LazyValue
+ *  \brief A handle to a value within a LazyDocument. Nothing is decoded
+ *         until it is asked for. This has the same read interface as a
+ *         const mem::Tree<std::string> so parsing code can work with
+ *         either. Handles are only valid while the document is alive.
+ */
+class LazyValue
+{
+public:
+    /*
+     *  \func Index operator
+     *  \brief Finds a member of an object.
+     *
+     *  \param index The member name
+     *  \return The value
+     *  \throw If this is not an object or the member does not exist.
+     */
+    LazyValue operator[](const std::string& index) const;
+
+    /*
+     *  \func Index operator
+     *  \brief Gets an array item. As with Tree, 0 returns this value if
+     *         it is not an array. This walks the array so prefer getItems
+     *         when visiting every item.
+     *
+     *  \param index The item
+     *  \return The value
+     *  \throw If the index is out of bounds.
+     */
+    LazyValue operator[](size_t index) const;
+
+    /*
+     *  \func get
+     *  \brief Decodes the value. Strings are unescaped, numbers and
+     *         literals are returned as they are written and objects and
+     *         arrays are empty, the same as json::JSON.
+     *
+     *  \return The value
+     */
+    std::string get() const;
+
+    /*
+     *  \func getRaw
+     *  \brief Gets the value exactly as it is written in the document
+     *         without copying. For strings this is between the quotes.
+     *
+     *  \return The characters of the value
+     */
+    Span getRaw() const;
+
+    /*
+     *  \func has
+     *  \brief Returns true if this is an object with the member.
+     *
+     *  \param index The member name
+     *  \return true if the member exists.
+     */
+    bool has(const std::string& index) const;
+
+    /*
+     *  \func keys
+     *  \brief Gets the member names of an object.
+     *
+     *  \return The names in document order
+     */
+    std::vector<std::string> keys() const;
+
+    /*
+     *  \func getItems
+     *  \brief Gets every item of an array in a single walk.
+     *
+     *  \return The items. This is empty if this is not an array.
+     */
+    std::vector<LazyValue> getItems() const;
+
+    /*
+     *  \func size
+     *  \brief Gets the number of array items.
+     *
+     *  \return The number of items or 0 if this is not an array.
+     */
+    size_t size() const;
+
+    /*
+     *  \func loopSize
+     *  \brief Gets the size of the array. If this is not an array this
+     *         returns 1 so a single value can be looped over.
+     *
+     *  \return The size of the array.
+     */
+    size_t loopSize() const
+    {
+        return std::max<size_t>(size(), 1);
+    }
+
+    /*
+     *  \func isObject
+     *  \brief Returns true if the value is an object.
+     */
+    bool isObject() const;
+
+    /*
+     *  \func isArray
+     *  \brief Returns true if the value is an array.
+     */
+    bool isArray() const;
+
+    /*
+     *  \func isString
+     *  \brief Returns true if the value is a string.
+     */
+    bool isString() const;
+
+    /*
+     *  \func getOffset
+     *  \brief Gets the byte offset of the value within the document.
+     *
+     *  \return The offset
+     */
+    size_t getOffset() const
+    {
+        return mStart;
+    }
+
+private:
+    friend class LazyDocument;
+
+    LazyValue(const LazyDocument* document,
+              uint32_t start,
+              uint32_t token) :
+        mDocument(document),
+        mStart(start),
+        mToken(token)
+    {
+    }
+
+    bool find(const std::string& index, LazyValue& value) const;
+
+    const LazyDocument* mDocument;
+
+    // The first character of the value and the first structural token at
+    // or after it. For objects, arrays and strings this is the opening
+    // character. For numbers and literals this is what comes after them.
+    uint32_t mStart;
+    uint32_t mToken;
+};
+
+/*
+ *  \class LazyDocument
+ *  \brief A JSON document that is indexed instead of parsed. A single
+ *         pass records where every bracket, colon, comma and string quote
+ *         is and pairs up the brackets. Values are found by skipping
+ *         between those positions and are only decoded when accessed, so
+ *         opening a large file costs little more than reading it once.
+ */
+class LazyDocument
+{
+public:
+    /*
+     *  \func Constructor
+     *  \brief Maps a file into memory and indexes it.
+     *
+     *  \param pathname The json file on disk
+     *  \throw If the brackets or strings do not match up.
+     */
+    LazyDocument(const std::string& pathname);
+
+    /*
+     *  \func Constructor
+     *  \brief Indexes a document owned by the caller. The memory must
+     *         outlive the document.
+     *
+     *  \param data The document
+     *  \param size The number of bytes
+     */
+    LazyDocument(const char* data, size_t size);
+
+    /*
+     *  \func Destructor
+     *  \brief Unmaps the file.
+     */
+    ~LazyDocument();
+
+    /*
+     *  \func getRoot
+     *  \brief Gets the top level value.
+     *
+     *  \return The root
+     */
+    LazyValue getRoot() const;
+
+    /*
+     *  \func Index operator
+     *  \brief Finds a member of the root object.
+     */
+    LazyValue operator[](const std::string& index) const
+    {
+        return getRoot()[index];
+    }
+
+    /*
+     *  \func has
+     *  \brief Returns true if the root object has the member.
+     */
+    bool has(const std::string& index) const
+    {
+        return getRoot().has(index);
+    }
+
+    /*
+     *  \func getNumTokens
+     *  \brief Gets the number of structural characters in the index.
+     *
+     *  \return The number of tokens
+     */
+    size_t getNumTokens() const
+    {
+        return mTokens.size();
+    }
+
+private:
+    friend class LazyValue;
+
+    LazyDocument(const LazyDocument&) = delete;
+    LazyDocument& operator=(const LazyDocument&) = delete;
+
+    void buildIndex();
+
+    void scan(size_t begin, size_t end, bool& inString, bool& escaped);
+
+    char at(uint32_t token) const
+    {
+        return mData[mTokens[token]];
+    }
+
+    // Gets the value that starts after a '[', ':' or ',' token
+    LazyValue valueAfter(uint32_t token) const;
+
+    // Gets the token following a value
+    uint32_t skip(const LazyValue& value) const;
+
+    std::unique_ptr<core::MappedFile> mFile;
+    const char* mData;
+    size_t mSize;
+    std::vector<uint32_t> mTokens;
+    std::vector<uint32_t> mMatch;
+};
+}
+}
+
+#endif
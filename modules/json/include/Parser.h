@@ -0,0 +1,199 @@
+/*
+ * Copyright (c) 2018 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#ifndef __NYRA_JSON_PARSER_H__
+#define __NYRA_JSON_PARSER_H__
+
+#include <string>
+#include <stdint.h>
+#include <nyra/core/String.h>
+
+namespace nyra
+{
+namespace json
+{
+/*
+ *  \class Span
+ *  \brief A run of characters owned by someone else. The parser hands
+ *         these out so keys, strings and numbers do not need to be copied
+ *         unless the handler wants to keep them.
+ */
+typedef core::str::Token Span;
+
+/*
+ *  \func toDouble
+ *  \brief Converts a number span to a double. Unlike core::str::toType
+ *         the whole span must be the number.
+ *
+ *  \param span The number
+ *  \return The value
+ *  \throw If the span is not a number
+ */
+double toDouble(const Span& span);
+
+/*
+ *  \func toInt
+ *  \brief Converts a number span to an integer. Unlike core::str::toType
+ *         the whole span must be the integer.
+ *
+ *  \param span The number
+ *  \return The value
+ *  \throw If the span is not an integer or it overflows
+ */
+int64_t toInt(const Span& span);
+
+/*
+ *  \class Handler
+ *  \brief Receives the parts of a JSON document in order as they are
+ *         parsed. Spans are only valid for the duration of the call.
+ *         Every function does nothing by default so a handler only needs
+ *         to override what it is interested in.
+ */
+class Handler
+{
+public:
+    /*
+     *  \func Destructor
+     *  \brief Necessary for inheritance.
+     */
+    virtual ~Handler() = default;
+
+    /*
+     *  \func onObjectBegin
+     *  \brief Called on '{'.
+     */
+    virtual void onObjectBegin()
+    {
+    }
+
+    /*
+     *  \func onObjectEnd
+     *  \brief Called on '}'.
+     */
+    virtual void onObjectEnd()
+    {
+    }
+
+    /*
+     *  \func onArrayBegin
+     *  \brief Called on '['.
+     */
+    virtual void onArrayBegin()
+    {
+    }
+
+    /*
+     *  \func onArrayEnd
+     *  \brief Called on ']'.
+     */
+    virtual void onArrayEnd()
+    {
+    }
+
+    /*
+     *  \func onKey
+     *  \brief Called for each member name within an object. The value
+     *         follows.
+     *
+     *  \param key The unescaped name
+     */
+    virtual void onKey(const Span& )
+    {
+    }
+
+    /*
+     *  \func onString
+     *  \brief Called for a string value.
+     *
+     *  \param value The unescaped string
+     */
+    virtual void onString(const Span& )
+    {
+    }
+
+    /*
+     *  \func onNumber
+     *  \brief Called for a number value. The span is the number exactly as
+     *         it appears in the document.
+     *
+     *  \param value The number token
+     */
+    virtual void onNumber(const Span& )
+    {
+    }
+
+    /*
+     *  \func onBool
+     *  \brief Called for true and false.
+     *
+     *  \param value The value
+     */
+    virtual void onBool(bool )
+    {
+    }
+
+    /*
+     *  \func onNull
+     *  \brief Called for null.
+     */
+    virtual void onNull()
+    {
+    }
+};
+
+/*
+ *  \func parse
+ *  \brief Parses a JSON document in a single pass. Strings without escape
+ *         sequences are handed to the handler straight out of the buffer.
+ *
+ *  \param data The document
+ *  \param size The number of bytes in the document
+ *  \param handler The handler to call
+ *  \throw If the document is not valid JSON. The message has the line
+ *         and column.
+ */
+void parse(const char* data, size_t size, Handler& handler);
+
+/*
+ *  \func parse
+ *  \brief Parses a JSON document held in a string.
+ *
+ *  \param document The document
+ *  \param handler The handler to call
+ */
+inline void parse(const std::string& document, Handler& handler)
+{
+    parse(document.data(), document.size(), handler);
+}
+
+/*
+ *  \func parseFile
+ *  \brief Maps a file into memory and parses it. Nothing is read into
+ *         memory up front so this works for files of any size.
+ *
+ *  \param pathname The file to parse
+ *  \param handler The handler to call
+ */
+void parseFile(const std::string& pathname, Handler& handler);
+}
+}
+
+#endif
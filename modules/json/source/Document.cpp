@@ -0,0 +1,162 @@
+/*
+ * Copyright (c) 2018 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#include <nyra/json/Document.h>
+#include <nyra/json/Parser.h>
+
+namespace
+{
+//===========================================================================//
+class DocumentBuilder : public nyra::json::Handler
+{
+public:
+    DocumentBuilder(nyra::mem::FlatTree<std::string>& tree) :
+        mTree(tree)
+    {
+    }
+
+    void onObjectBegin() override
+    {
+        push(false);
+    }
+
+    void onObjectEnd() override
+    {
+        pop();
+    }
+
+    void onArrayBegin() override
+    {
+        push(true);
+    }
+
+    void onArrayEnd() override
+    {
+        pop();
+    }
+
+    void onKey(const nyra::json::Span& key) override
+    {
+        mKey.assign(key.data, key.size);
+    }
+
+    void onString(const nyra::json::Span& value) override
+    {
+        setValue(value);
+    }
+
+    void onNumber(const nyra::json::Span& value) override
+    {
+        setValue(value);
+    }
+
+    void onBool(bool value) override
+    {
+        setValue(value ? nyra::json::Span("true", 4) :
+                         nyra::json::Span("false", 5));
+    }
+
+    void onNull() override
+    {
+        setValue(nyra::json::Span("null", 4));
+    }
+
+private:
+    // The root is always open, everything else is opened as an array item
+    // or an object member depending on what it is inside of.
+    bool open()
+    {
+        if (mArrays.empty())
+        {
+            return false;
+        }
+
+        if (mArrays.back())
+        {
+            mTree.openItem();
+        }
+        else
+        {
+            mTree.open(mKey);
+        }
+        return true;
+    }
+
+    void push(bool isArray)
+    {
+        if (open())
+        {
+            mTree.setValue(std::string());
+        }
+        mArrays.push_back(isArray);
+    }
+
+    void pop()
+    {
+        mArrays.pop_back();
+        if (!mArrays.empty())
+        {
+            mTree.close();
+        }
+    }
+
+    void setValue(const nyra::json::Span& value)
+    {
+        const bool opened = open();
+        mTree.setValue(value.str());
+        if (opened)
+        {
+            mTree.close();
+        }
+    }
+
+    nyra::mem::FlatTree<std::string>& mTree;
+    std::vector<bool> mArrays;
+    std::string mKey;
+};
+}
+
+namespace nyra
+{
+namespace json
+{
+//===========================================================================//
+Document::Document(const std::string& pathname)
+{
+    core::read(pathname, *this);
+}
+}
+
+namespace core
+{
+//===========================================================================//
+template <>
+void read<json::Document>(const std::string& pathname,
+                          json::Document& tree,
+                          core::ArchiveType)
+{
+    tree.clear();
+    DocumentBuilder builder(tree);
+    json::parseFile(pathname, builder);
+    tree.finish();
+}
+}
+}
@@ -24,6 +24,7 @@
 #include <boost/property_tree/ptree.hpp>
 #include <boost/property_tree/json_parser.hpp>
 #include <nyra/json/JSON.h>
+#include <nyra/json/Parser.h>
 
 
 using namespace boost::property_tree;
@@ -31,46 +32,102 @@ using namespace boost::property_tree;
 namespace
 {
 //===========================================================================//
-void readTree(const ptree& boostTree,
-              nyra::mem::Tree<std::string>& tree)
+class TreeBuilder : public nyra::json::Handler
 {
-    if (!boostTree.data().empty())
+public:
+    TreeBuilder(nyra::mem::Tree<std::string>& tree) :
+        mRoot(tree)
     {
-        tree = boostTree.data();
     }
 
-    std::unordered_map<std::string, std::vector<ptree::const_iterator> > posMap;
-    for (ptree::const_iterator pos = boostTree.begin(); pos != boostTree.end(); ++pos)
+    void onObjectBegin() override
     {
-        posMap[pos->first].push_back(pos);
+        push(false);
     }
 
-    for (auto iter = posMap.begin(); iter != posMap.end(); ++iter)
+    void onObjectEnd() override
     {
-        if (iter->second.size() == 1)
-        {
-            const ptree& newBoostTree = iter->second[0]->second;
+        mStack.pop_back();
+    }
 
-            // If the name is empty, then this is a single list item
-            if (iter->first.empty())
-            {
-                tree[0] = "";
-                readTree(newBoostTree, tree[0]);
-            }
+    void onArrayBegin() override
+    {
+        push(true);
+    }
+
+    void onArrayEnd() override
+    {
+        mStack.pop_back();
+    }
+
+    void onKey(const nyra::json::Span& key) override
+    {
+        mKey.assign(key.data, key.size);
+    }
+
+    void onString(const nyra::json::Span& value) override
+    {
+        next() = value.str();
+    }
+
+    void onNumber(const nyra::json::Span& value) override
+    {
+        next() = value.str();
+    }
+
+    void onBool(bool value) override
+    {
+        next() = std::string(value ? "true" : "false");
+    }
 
-            tree[iter->first] = "";
-            readTree(newBoostTree, tree[iter->first]);
+    void onNull() override
+    {
+        next() = std::string("null");
+    }
+
+private:
+    struct Frame
+    {
+        nyra::mem::Tree<std::string>* node;
+        bool isArray;
+        size_t index;
+    };
+
+    // Gets the node the next value is written to. Array items are
+    // indexed and object members are keyed.
+    nyra::mem::Tree<std::string>& next()
+    {
+        if (mStack.empty())
+        {
+            return mRoot;
         }
-        else
+
+        Frame& frame = mStack.back();
+        if (frame.isArray)
         {
-            for (size_t ii = 0; ii < iter->second.size(); ++ii)
-            {
-                tree[ii] = "";
-                readTree(iter->second[ii]->second, tree[ii]);
-            }
+            return (*frame.node)[frame.index++];
         }
+        return (*frame.node)[mKey];
+    }
+
+    void push(bool isArray)
+    {
+        nyra::mem::Tree<std::string>& node = next();
+
+        // Nested nodes must be set before they can have children
+        if (!mStack.empty())
+        {
+            node = std::string();
+        }
+
+        Frame frame = {&node, isArray, 0};
+        mStack.push_back(frame);
     }
-}
+
+    nyra::mem::Tree<std::string>& mRoot;
+    std::vector<Frame> mStack;
+    std::string mKey;
+};
 
 //===========================================================================//
 void writeTree(const nyra::mem::Tree<std::string>& tree,
@@ -152,9 +209,8 @@ void read<json::JSON>(const std::string& pathname,
                       json::JSON& tree,
                       core::ArchiveType)
 {
-    ptree boostTree;
-    read_json(pathname, boostTree);
-    readTree(boostTree, tree);
+    TreeBuilder builder(tree);
+    json::parseFile(pathname, builder);
 }
 }
 }
@@ -0,0 +1,579 @@
+/*
+ * Copyright (c) 2018 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <nyra/json/LazyDocument.h>
+#include <nyra/core/MappedFile.h>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+namespace
+{
+//===========================================================================//
+bool isWhitespace(char c)
+{
+    return c == ' ' || c == '\n' || c == '\r' || c == '\t';
+}
+
+//===========================================================================//
+bool isStructural(char c)
+{
+    return c == '{' || c == '}' || c == '[' || c == ']' ||
+            c == ':' || c == ',';
+}
+
+//===========================================================================//
+void malformed()
+{
+    throw std::runtime_error("Malformed JSON document");
+}
+
+//===========================================================================//
+class StringDecoder : public nyra::json::Handler
+{
+public:
+    void onString(const nyra::json::Span& value) override
+    {
+        result.assign(value.data, value.size);
+    }
+
+    std::string result;
+};
+
+//===========================================================================//
+// Decodes the characters between a pair of quotes. The quotes are still
+// in the document on either side of the span, so escaped strings are
+// handed back to the parser as a complete string token.
+std::string decode(const nyra::json::Span& raw)
+{
+    if (!std::memchr(raw.data, '\\', raw.size))
+    {
+        return raw.str();
+    }
+
+    StringDecoder decoder;
+    nyra::json::parse(raw.data - 1, raw.size + 2, decoder);
+    return decoder.result;
+}
+
+#ifdef __SSE2__
+//===========================================================================//
+uint32_t countTrailingZeros(uint32_t bits)
+{
+#if defined(__GNUC__)
+    return __builtin_ctz(bits);
+#else
+    uint32_t count = 0;
+    while (!(bits & 1))
+    {
+        bits >>= 1;
+        ++count;
+    }
+    return count;
+#endif
+}
+#endif
+}
+
+namespace nyra
+{
+namespace json
+{
+//===========================================================================//
+LazyDocument::LazyDocument(const std::string& pathname) :
+    mFile(new core::MappedFile(pathname)),
+    mData(reinterpret_cast<const char*>(mFile->getData())),
+    mSize(mFile->getSize())
+{
+    buildIndex();
+}
+
+//===========================================================================//
+LazyDocument::LazyDocument(const char* data, size_t size) :
+    mData(data),
+    mSize(size)
+{
+    buildIndex();
+}
+
+//===========================================================================//
+LazyDocument::~LazyDocument()
+{
+}
+
+//===========================================================================//
+void LazyDocument::buildIndex()
+{
+    if (mSize > std::numeric_limits<uint32_t>::max())
+    {
+        throw std::runtime_error("JSON document is too large to index");
+    }
+
+    // Roughly one token every eight bytes for typical documents
+    mTokens.clear();
+    mTokens.reserve(mSize / 8);
+
+    bool inString = false;
+    bool escaped = false;
+    size_t pos = 0;
+
+#ifdef __SSE2__
+    const __m128i quote = _mm_set1_epi8('"');
+    const __m128i backslash = _mm_set1_epi8('\\');
+    const __m128i lower = _mm_set1_epi8(0x20);
+    const __m128i openBracket = _mm_set1_epi8('{');
+    const __m128i closeBracket = _mm_set1_epi8('}');
+    const __m128i colon = _mm_set1_epi8(':');
+    const __m128i comma = _mm_set1_epi8(',');
+
+    for (; pos + 16 <= mSize; pos += 16)
+    {
+        const __m128i block = _mm_loadu_si128(
+                reinterpret_cast<const __m128i*>(mData + pos));
+        const uint32_t quotes = _mm_movemask_epi8(
+                _mm_cmpeq_epi8(block, quote));
+
+        // Escapes are rare, so any block touching one is handled a byte at
+        // a time rather than tracking backslash runs across lanes.
+        if (escaped || _mm_movemask_epi8(_mm_cmpeq_epi8(block, backslash)))
+        {
+            scan(pos, pos + 16, inString, escaped);
+            continue;
+        }
+
+        // Long strings such as card text skip straight through
+        if (inString && !quotes)
+        {
+            continue;
+        }
+
+        // '[' and ']' are '{' and '}' without the 0x20 bit
+        const __m128i folded = _mm_or_si128(block, lower);
+        const uint32_t structural = _mm_movemask_epi8(_mm_or_si128(
+                _mm_or_si128(_mm_cmpeq_epi8(folded, openBracket),
+                             _mm_cmpeq_epi8(folded, closeBracket)),
+                _mm_or_si128(_mm_cmpeq_epi8(block, colon),
+                             _mm_cmpeq_epi8(block, comma))));
+
+        uint32_t bits = quotes | structural;
+        while (bits)
+        {
+            const uint32_t bit = countTrailingZeros(bits);
+            bits &= bits - 1;
+
+            if (quotes & (1u << bit))
+            {
+                mTokens.push_back(static_cast<uint32_t>(pos + bit));
+                inString = !inString;
+            }
+            else if (!inString)
+            {
+                mTokens.push_back(static_cast<uint32_t>(pos + bit));
+            }
+        }
+    }
+#endif
+
+    scan(pos, mSize, inString, escaped);
+
+    if (inString)
+    {
+        throw std::runtime_error("Unterminated string in JSON document");
+    }
+
+    // Pair up the brackets so whole objects and arrays can be skipped
+    mMatch.assign(mTokens.size(), 0);
+    std::vector<uint32_t> stack;
+    for (uint32_t ii = 0; ii < mTokens.size(); ++ii)
+    {
+        const char c = at(ii);
+        if (c == '{' || c == '[')
+        {
+            stack.push_back(ii);
+        }
+        else if (c == '}' || c == ']')
+        {
+            if (stack.empty() || at(stack.back()) != (c == '}' ? '{' : '['))
+            {
+                throw std::runtime_error(
+                        "Mismatched bracket in JSON document at byte " +
+                        std::to_string(mTokens[ii]));
+            }
+            mMatch[stack.back()] = ii;
+            stack.pop_back();
+        }
+    }
+
+    if (!stack.empty())
+    {
+        throw std::runtime_error("Unclosed bracket in JSON document");
+    }
+}
+
+//===========================================================================//
+void LazyDocument::scan(size_t begin,
+                        size_t end,
+                        bool& inString,
+                        bool& escaped)
+{
+    for (size_t pos = begin; pos < end; ++pos)
+    {
+        const char c = mData[pos];
+        if (inString)
+        {
+            if (escaped)
+            {
+                escaped = false;
+            }
+            else if (c == '\\')
+            {
+                escaped = true;
+            }
+            else if (c == '"')
+            {
+                mTokens.push_back(static_cast<uint32_t>(pos));
+                inString = false;
+            }
+        }
+        else if (c == '"')
+        {
+            mTokens.push_back(static_cast<uint32_t>(pos));
+            inString = true;
+        }
+        else if (isStructural(c))
+        {
+            mTokens.push_back(static_cast<uint32_t>(pos));
+        }
+    }
+}
+
+//===========================================================================//
+LazyValue LazyDocument::getRoot() const
+{
+    size_t start = 0;
+    if (mSize >= 3 && std::memcmp(mData, "\xEF\xBB\xBF", 3) == 0)
+    {
+        start = 3;
+    }
+    while (start < mSize && isWhitespace(mData[start]))
+    {
+        ++start;
+    }
+
+    if (start == mSize)
+    {
+        throw std::runtime_error("Empty JSON document");
+    }
+    return LazyValue(this, static_cast<uint32_t>(start), 0);
+}
+
+//===========================================================================//
+LazyValue LazyDocument::valueAfter(uint32_t token) const
+{
+    size_t start = mTokens[token] + 1;
+    while (start < mSize && isWhitespace(mData[start]))
+    {
+        ++start;
+    }
+
+    if (start == mSize)
+    {
+        malformed();
+    }
+    return LazyValue(this, static_cast<uint32_t>(start), token + 1);
+}
+
+//===========================================================================//
+uint32_t LazyDocument::skip(const LazyValue& value) const
+{
+    uint32_t next = value.mToken;
+    switch (mData[value.mStart])
+    {
+    case '{':
+    case '[':
+        next = mMatch[value.mToken] + 1;
+        break;
+    case '"':
+        next = value.mToken + 2;
+        break;
+    }
+
+    if (next >= mTokens.size())
+    {
+        malformed();
+    }
+    return next;
+}
+
+//===========================================================================//
+LazyValue LazyValue::operator[](const std::string& index) const
+{
+    LazyValue value(*this);
+    if (!find(index, value))
+    {
+        throw std::runtime_error("Node: " + index + " does not exist.");
+    }
+    return value;
+}
+
+//===========================================================================//
+LazyValue LazyValue::operator[](size_t index) const
+{
+    if (!isArray())
+    {
+        if (index == 0)
+        {
+            return *this;
+        }
+    }
+    else
+    {
+        const LazyDocument& doc = *mDocument;
+        LazyValue item = doc.valueAfter(mToken);
+        if (doc.mData[item.mStart] != ']')
+        {
+            for (size_t ii = 0; ; ++ii)
+            {
+                if (ii == index)
+                {
+                    return item;
+                }
+
+                const uint32_t next = doc.skip(item);
+                if (doc.at(next) != ',')
+                {
+                    break;
+                }
+                item = doc.valueAfter(next);
+            }
+        }
+    }
+
+    throw std::runtime_error(
+            "Index " + std::to_string(index) + " is out of bounds");
+}
+
+//===========================================================================//
+bool LazyValue::find(const std::string& index, LazyValue& value) const
+{
+    if (!isObject())
+    {
+        return false;
+    }
+
+    const LazyDocument& doc = *mDocument;
+    if (doc.mData[doc.valueAfter(mToken).mStart] == '}')
+    {
+        return false;
+    }
+
+    uint32_t key = mToken + 1;
+    while (true)
+    {
+        // A member is an opening quote, a closing quote and a colon
+        if (key + 2 >= doc.mTokens.size() ||
+            doc.at(key) != '"' || doc.at(key + 2) != ':')
+        {
+            malformed();
+        }
+
+        const Span name(doc.mData + doc.mTokens[key] + 1,
+                        doc.mTokens[key + 1] - doc.mTokens[key] - 1);
+        const LazyValue member = doc.valueAfter(key + 2);
+
+        if (name == index ||
+            (std::memchr(name.data, '\\', name.size) &&
+             decode(name) == index))
+        {
+            value = member;
+            return true;
+        }
+
+        const uint32_t next = doc.skip(member);
+        if (doc.at(next) != ',')
+        {
+            return false;
+        }
+        key = next + 1;
+    }
+}
+
+//===========================================================================//
+bool LazyValue::has(const std::string& index) const
+{
+    LazyValue value(*this);
+    return find(index, value);
+}
+
+//===========================================================================//
+std::vector<std::string> LazyValue::keys() const
+{
+    std::vector<std::string> keys;
+    if (!isObject())
+    {
+        return keys;
+    }
+
+    const LazyDocument& doc = *mDocument;
+    if (doc.mData[doc.valueAfter(mToken).mStart] == '}')
+    {
+        return keys;
+    }
+
+    uint32_t key = mToken + 1;
+    while (true)
+    {
+        if (key + 2 >= doc.mTokens.size() ||
+            doc.at(key) != '"' || doc.at(key + 2) != ':')
+        {
+            malformed();
+        }
+
+        keys.push_back(decode(Span(
+                doc.mData + doc.mTokens[key] + 1,
+                doc.mTokens[key + 1] - doc.mTokens[key] - 1)));
+
+        const uint32_t next = doc.skip(doc.valueAfter(key + 2));
+        if (doc.at(next) != ',')
+        {
+            return keys;
+        }
+        key = next + 1;
+    }
+}
+
+//===========================================================================//
+std::vector<LazyValue> LazyValue::getItems() const
+{
+    std::vector<LazyValue> items;
+    if (!isArray())
+    {
+        return items;
+    }
+
+    const LazyDocument& doc = *mDocument;
+    LazyValue item = doc.valueAfter(mToken);
+    if (doc.mData[item.mStart] == ']')
+    {
+        return items;
+    }
+
+    while (true)
+    {
+        items.push_back(item);
+        const uint32_t next = doc.skip(item);
+        if (doc.at(next) != ',')
+        {
+            return items;
+        }
+        item = doc.valueAfter(next);
+    }
+}
+
+//===========================================================================//
+size_t LazyValue::size() const
+{
+    if (!isArray())
+    {
+        return 0;
+    }
+
+    const LazyDocument& doc = *mDocument;
+    LazyValue item = doc.valueAfter(mToken);
+    if (doc.mData[item.mStart] == ']')
+    {
+        return 0;
+    }
+
+    size_t count = 1;
+    for (uint32_t next = doc.skip(item);
+         doc.at(next) == ',';
+         next = doc.skip(item))
+    {
+        item = doc.valueAfter(next);
+        ++count;
+    }
+    return count;
+}
+
+//===========================================================================//
+std::string LazyValue::get() const
+{
+    switch (mDocument->mData[mStart])
+    {
+    case '{':
+    case '[':
+        return "";
+    case '"':
+        return decode(getRaw());
+    default:
+        return getRaw().str();
+    }
+}
+
+//===========================================================================//
+Span LazyValue::getRaw() const
+{
+    const LazyDocument& doc = *mDocument;
+    const char* begin = doc.mData + mStart;
+
+    switch (*begin)
+    {
+    case '{':
+    case '[':
+        return Span(begin, doc.mTokens[doc.mMatch[mToken]] - mStart + 1);
+    case '"':
+        return Span(begin + 1, doc.mTokens[mToken + 1] - mStart - 1);
+    }
+
+    // Numbers and literals run up to the next token or the end
+    size_t end = mToken < doc.mTokens.size() ?
+            doc.mTokens[mToken] : doc.mSize;
+    while (end > mStart && isWhitespace(doc.mData[end - 1]))
+    {
+        --end;
+    }
+    return Span(begin, end - mStart);
+}
+
+//===========================================================================//
+bool LazyValue::isObject() const
+{
+    return mDocument->mData[mStart] == '{';
+}
+
+//===========================================================================//
+bool LazyValue::isArray() const
+{
+    return mDocument->mData[mStart] == '[';
+}
+
+//===========================================================================//
+bool LazyValue::isString() const
+{
+    return mDocument->mData[mStart] == '"';
+}
+}
+}
@@ -0,0 +1,576 @@
+/*
+ * Copyright (c) 2018 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#include <cerrno>
+#include <cstdlib>
+#include <limits>
+#include <stdexcept>
+#include <nyra/json/Parser.h>
+#include <nyra/core/MappedFile.h>
+
+namespace
+{
+//===========================================================================//
+// Deep enough for any real document while keeping a malicious one from
+// blowing the stack.
+static const size_t MAX_DEPTH = 512;
+
+//===========================================================================//
+class Parser
+{
+public:
+    Parser(const char* data, size_t size, nyra::json::Handler& handler) :
+        mBegin(data),
+        mPos(data),
+        mEnd(data + size),
+        mHandler(handler)
+    {
+    }
+
+    void parse()
+    {
+        // Skip a UTF-8 byte order mark
+        if (mEnd - mPos >= 3 &&
+            static_cast<uint8_t>(mPos[0]) == 0xEF &&
+            static_cast<uint8_t>(mPos[1]) == 0xBB &&
+            static_cast<uint8_t>(mPos[2]) == 0xBF)
+        {
+            mPos += 3;
+        }
+
+        skipWhitespace();
+        parseValue(0);
+        skipWhitespace();
+
+        if (mPos != mEnd)
+        {
+            error("Unexpected data after the document");
+        }
+    }
+
+private:
+    void parseValue(size_t depth)
+    {
+        if (depth > MAX_DEPTH)
+        {
+            error("Document is nested too deeply");
+        }
+
+        if (mPos == mEnd)
+        {
+            error("Unexpected end of document");
+        }
+
+        switch (*mPos)
+        {
+        case '{':
+            parseObject(depth);
+            break;
+        case '[':
+            parseArray(depth);
+            break;
+        case '"':
+            mHandler.onString(parseString());
+            break;
+        case 't':
+            parseLiteral("true");
+            mHandler.onBool(true);
+            break;
+        case 'f':
+            parseLiteral("false");
+            mHandler.onBool(false);
+            break;
+        case 'n':
+            parseLiteral("null");
+            mHandler.onNull();
+            break;
+        default:
+            mHandler.onNumber(parseNumber());
+            break;
+        }
+    }
+
+    void parseObject(size_t depth)
+    {
+        ++mPos;
+        mHandler.onObjectBegin();
+        skipWhitespace();
+
+        if (peek() == '}')
+        {
+            ++mPos;
+            mHandler.onObjectEnd();
+            return;
+        }
+
+        while (true)
+        {
+            if (peek() != '"')
+            {
+                error("Expected a member name");
+            }
+            mHandler.onKey(parseString());
+
+            skipWhitespace();
+            expect(':');
+            skipWhitespace();
+            parseValue(depth + 1);
+            skipWhitespace();
+
+            if (peek() == ',')
+            {
+                ++mPos;
+                skipWhitespace();
+            }
+            else if (peek() == '}')
+            {
+                ++mPos;
+                break;
+            }
+            else
+            {
+                error("Expected ',' or '}'");
+            }
+        }
+
+        mHandler.onObjectEnd();
+    }
+
+    void parseArray(size_t depth)
+    {
+        ++mPos;
+        mHandler.onArrayBegin();
+        skipWhitespace();
+
+        if (peek() == ']')
+        {
+            ++mPos;
+            mHandler.onArrayEnd();
+            return;
+        }
+
+        while (true)
+        {
+            parseValue(depth + 1);
+            skipWhitespace();
+
+            if (peek() == ',')
+            {
+                ++mPos;
+                skipWhitespace();
+            }
+            else if (peek() == ']')
+            {
+                ++mPos;
+                break;
+            }
+            else
+            {
+                error("Expected ',' or ']'");
+            }
+        }
+
+        mHandler.onArrayEnd();
+    }
+
+    nyra::json::Span parseString()
+    {
+        ++mPos;
+        const char* start = mPos;
+
+        // Fast path, most strings have nothing to unescape so they can be
+        // handed out straight from the document.
+        while (mPos != mEnd)
+        {
+            const char c = *mPos;
+            if (c == '"')
+            {
+                return nyra::json::Span(start, (mPos++) - start);
+            }
+            if (c == '\\')
+            {
+                break;
+            }
+            if (static_cast<uint8_t>(c) < 0x20)
+            {
+                error("Control character in string");
+            }
+            ++mPos;
+        }
+
+        if (mPos == mEnd)
+        {
+            error("Unterminated string");
+        }
+
+        mScratch.assign(start, mPos);
+        while (mPos != mEnd)
+        {
+            const char c = *mPos++;
+            if (c == '"')
+            {
+                return nyra::json::Span(mScratch.data(), mScratch.size());
+            }
+
+            if (c != '\\')
+            {
+                if (static_cast<uint8_t>(c) < 0x20)
+                {
+                    --mPos;
+                    error("Control character in string");
+                }
+                mScratch.push_back(c);
+                continue;
+            }
+
+            if (mPos == mEnd)
+            {
+                break;
+            }
+
+            switch (*mPos++)
+            {
+            case '"':
+                mScratch.push_back('"');
+                break;
+            case '\\':
+                mScratch.push_back('\\');
+                break;
+            case '/':
+                mScratch.push_back('/');
+                break;
+            case 'b':
+                mScratch.push_back('\b');
+                break;
+            case 'f':
+                mScratch.push_back('\f');
+                break;
+            case 'n':
+                mScratch.push_back('\n');
+                break;
+            case 'r':
+                mScratch.push_back('\r');
+                break;
+            case 't':
+                mScratch.push_back('\t');
+                break;
+            case 'u':
+                parseUnicode();
+                break;
+            default:
+                --mPos;
+                error("Invalid escape sequence");
+            }
+        }
+
+        error("Unterminated string");
+        return nyra::json::Span();
+    }
+
+    void parseUnicode()
+    {
+        uint32_t code = parseHex();
+
+        // Surrogate pairs are written as two escapes
+        if (code >= 0xD800 && code <= 0xDBFF)
+        {
+            if (mEnd - mPos < 6 || mPos[0] != '\\' || mPos[1] != 'u')
+            {
+                error("Missing low surrogate");
+            }
+            mPos += 2;
+
+            const uint32_t low = parseHex();
+            if (low < 0xDC00 || low > 0xDFFF)
+            {
+                error("Invalid low surrogate");
+            }
+            code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+        }
+        else if (code >= 0xDC00 && code <= 0xDFFF)
+        {
+            error("Unexpected low surrogate");
+        }
+
+        if (code < 0x80)
+        {
+            mScratch.push_back(static_cast<char>(code));
+        }
+        else if (code < 0x800)
+        {
+            mScratch.push_back(static_cast<char>(0xC0 | (code >> 6)));
+            mScratch.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+        }
+        else if (code < 0x10000)
+        {
+            mScratch.push_back(static_cast<char>(0xE0 | (code >> 12)));
+            mScratch.push_back(
+                    static_cast<char>(0x80 | ((code >> 6) & 0x3F)));
+            mScratch.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+        }
+        else
+        {
+            mScratch.push_back(static_cast<char>(0xF0 | (code >> 18)));
+            mScratch.push_back(
+                    static_cast<char>(0x80 | ((code >> 12) & 0x3F)));
+            mScratch.push_back(
+                    static_cast<char>(0x80 | ((code >> 6) & 0x3F)));
+            mScratch.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+        }
+    }
+
+    uint32_t parseHex()
+    {
+        if (mEnd - mPos < 4)
+        {
+            error("Incomplete unicode escape");
+        }
+
+        uint32_t code = 0;
+        for (size_t ii = 0; ii < 4; ++ii)
+        {
+            const char c = *mPos;
+            code <<= 4;
+            if (c >= '0' && c <= '9')
+            {
+                code |= c - '0';
+            }
+            else if (c >= 'a' && c <= 'f')
+            {
+                code |= c - 'a' + 10;
+            }
+            else if (c >= 'A' && c <= 'F')
+            {
+                code |= c - 'A' + 10;
+            }
+            else
+            {
+                error("Invalid unicode escape");
+            }
+            ++mPos;
+        }
+        return code;
+    }
+
+    nyra::json::Span parseNumber()
+    {
+        const char* start = mPos;
+
+        if (peek() == '-')
+        {
+            ++mPos;
+        }
+
+        if (peek() == '0')
+        {
+            ++mPos;
+        }
+        else if (!skipDigits())
+        {
+            error("Unexpected character");
+        }
+
+        if (peek() == '.')
+        {
+            ++mPos;
+            if (!skipDigits())
+            {
+                error("Expected a digit after the decimal point");
+            }
+        }
+
+        if (peek() == 'e' || peek() == 'E')
+        {
+            ++mPos;
+            if (peek() == '+' || peek() == '-')
+            {
+                ++mPos;
+            }
+            if (!skipDigits())
+            {
+                error("Expected a digit in the exponent");
+            }
+        }
+
+        return nyra::json::Span(start, mPos - start);
+    }
+
+    bool skipDigits()
+    {
+        const char* start = mPos;
+        while (mPos != mEnd && *mPos >= '0' && *mPos <= '9')
+        {
+            ++mPos;
+        }
+        return mPos != start;
+    }
+
+    void parseLiteral(const char* literal)
+    {
+        const size_t size = std::strlen(literal);
+        if (static_cast<size_t>(mEnd - mPos) < size ||
+            std::memcmp(mPos, literal, size) != 0)
+        {
+            error("Unexpected character");
+        }
+        mPos += size;
+    }
+
+    void skipWhitespace()
+    {
+        while (mPos != mEnd &&
+               (*mPos == ' ' || *mPos == '\n' ||
+                *mPos == '\r' || *mPos == '\t'))
+        {
+            ++mPos;
+        }
+    }
+
+    char peek() const
+    {
+        return mPos == mEnd ? '\0' : *mPos;
+    }
+
+    void expect(char c)
+    {
+        if (peek() != c)
+        {
+            error(std::string("Expected '") + c + "'");
+        }
+        ++mPos;
+    }
+
+    void error(const std::string& message) const
+    {
+        // Lines are only counted when something goes wrong
+        size_t line = 1;
+        const char* lineStart = mBegin;
+        for (const char* pos = mBegin; pos < mPos && pos < mEnd; ++pos)
+        {
+            if (*pos == '\n')
+            {
+                ++line;
+                lineStart = pos + 1;
+            }
+        }
+
+        throw std::runtime_error(
+                "JSON parse error at line " + std::to_string(line) +
+                " column " + std::to_string(mPos - lineStart + 1) +
+                ": " + message);
+    }
+
+    const char* const mBegin;
+    const char* mPos;
+    const char* const mEnd;
+    nyra::json::Handler& mHandler;
+    std::string mScratch;
+};
+}
+
+namespace nyra
+{
+namespace json
+{
+//===========================================================================//
+double toDouble(const Span& span)
+{
+    // strtod needs a terminated string. Number tokens are short so they
+    // are copied to the stack rather than allocated.
+    char buffer[64];
+    if (span.size == 0 || span.size >= sizeof(buffer))
+    {
+        throw std::runtime_error("Unable to convert number: " + span.str());
+    }
+    std::memcpy(buffer, span.data, span.size);
+    buffer[span.size] = '\0';
+
+    char* end = nullptr;
+    const double value = std::strtod(buffer, &end);
+    if (end != buffer + span.size)
+    {
+        throw std::runtime_error("Unable to convert number: " + span.str());
+    }
+    return value;
+}
+
+//===========================================================================//
+int64_t toInt(const Span& span)
+{
+    const char* pos = span.data;
+    const char* end = span.data + span.size;
+    const bool negative = pos != end && *pos == '-';
+    if (negative)
+    {
+        ++pos;
+    }
+
+    if (pos == end)
+    {
+        throw std::runtime_error("Unable to convert number: " + span.str());
+    }
+
+    // Accumulate as a negative value so INT64_MIN fits
+    int64_t value = 0;
+    const int64_t min = std::numeric_limits<int64_t>::min();
+    for (; pos != end; ++pos)
+    {
+        if (*pos < '0' || *pos > '9')
+        {
+            throw std::runtime_error("Unable to convert number: " +
+                                     span.str());
+        }
+
+        const int64_t digit = *pos - '0';
+        if (value < (min + digit) / 10)
+        {
+            throw std::runtime_error("Number is out of range: " + span.str());
+        }
+        value = value * 10 - digit;
+    }
+
+    if (!negative)
+    {
+        if (value == min)
+        {
+            throw std::runtime_error("Number is out of range: " + span.str());
+        }
+        value = -value;
+    }
+    return value;
+}
+
+//===========================================================================//
+void parse(const char* data, size_t size, Handler& handler)
+{
+    Parser(data, size, handler).parse();
+}
+
+//===========================================================================//
+void parseFile(const std::string& pathname, Handler& handler)
+{
+    const core::MappedFile file(pathname);
+    parse(reinterpret_cast<const char*>(file.getData()),
+          file.getSize(),
+          handler);
+}
+}
+}
@@ -22,6 +22,7 @@
 #include <algorithm>
 #include <nyra/test/Test.h>
 #include <nyra/json/JSON.h>
+#include <nyra/json/Document.h>
 
 namespace
 {
@@ -164,6 +165,39 @@ TEST(JSON, Stdout)
 
     EXPECT_EQ(expected, results);
 }
+
+TEST(JSON, Document)
+{
+    writeFile();
+    const Document read = core::read<Document>(PATHNAME);
+    std::remove(PATHNAME.c_str());
+
+    EXPECT_FALSE(read.valid());
+    EXPECT_EQ("main text", read["main"]["text"].get());
+    EXPECT_EQ("/home/user/xml.xml", read["main"]["filename"].get());
+    EXPECT_EQ("", read["main"]["small_list"].get());
+    EXPECT_EQ(static_cast<size_t>(1), read["main"]["small_list"].size());
+    EXPECT_EQ("value", read["main"]["small_list"][0].get());
+
+    const auto& modules = read["main"]["modules"]["module"];
+    EXPECT_EQ(static_cast<size_t>(3), modules.size());
+    EXPECT_EQ("opengl", modules[0]["text"].get());
+    EXPECT_EQ("graphics", modules[0]["type"].get());
+    EXPECT_EQ("opengl", modules[1]["text"].get());
+    EXPECT_EQ("window", modules[1]["type"].get());
+    EXPECT_EQ("posix", modules[2]["text"].get());
+    EXPECT_EQ("window", modules[2]["type"].get());
+    EXPECT_EQ("2", read["main"]["debugLevel"].get());
+    EXPECT_EQ(static_cast<size_t>(1), read["main"]["debugLevel"].loopSize());
+    EXPECT_EQ(static_cast<size_t>(3), read["main"]["array"].size());
+    EXPECT_EQ("1", read["main"]["array"][0].get());
+    EXPECT_EQ("2", read["main"]["array"][1].get());
+    EXPECT_EQ("3", read["main"]["array"][2].get());
+
+    EXPECT_TRUE(read["main"].has("modules"));
+    EXPECT_FALSE(read["main"].has("module"));
+    EXPECT_EQ(static_cast<size_t>(6), read["main"].keys().size());
+}
 }
 }
 
@@ -0,0 +1,146 @@
+/*
+ * Copyright (c) 2018 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#include <cstdio>
+#include <fstream>
+#include <nyra/test/Test.h>
+#include <nyra/json/LazyDocument.h>
+#include <nyra/json/Document.h>
+
+namespace
+{
+static const std::string DOCUMENT =
+        "{\n"
+        "    \"name\": \"Beta\",\n"
+        "    \"count\": 302 ,\n"
+        "    \"empty\": {},\n"
+        "    \"none\": [],\n"
+        "    \"cards\": [\n"
+        "        {\"name\": \"Island\", \"types\": [\"Land\"], \"cmc\": 0},\n"
+        "        {\"name\": \"Ancestral \\\"Recall\\\"\", \"cmc\": 1,\n"
+        "         \"flags\": [true, null, -2.5e1]},\n"
+        "        {\"na\\u006de\": \"Black Lotus\", \"text\": \"{T}: Add\"}\n"
+        "    ]\n"
+        "}\n";
+}
+
+namespace nyra
+{
+namespace json
+{
+TEST(LazyDocument, Access)
+{
+    const LazyDocument doc(DOCUMENT.data(), DOCUMENT.size());
+
+    EXPECT_TRUE(doc.getRoot().isObject());
+    EXPECT_EQ("Beta", doc["name"].get());
+    EXPECT_EQ("302", doc["count"].get());
+    EXPECT_EQ(302, toInt(doc["count"].getRaw()));
+    EXPECT_EQ("", doc["empty"].get());
+    EXPECT_TRUE(doc["empty"].keys().empty());
+    EXPECT_EQ(static_cast<size_t>(0), doc["none"].size());
+    EXPECT_EQ(static_cast<size_t>(1), doc["none"].loopSize());
+
+    const LazyValue cards = doc["cards"];
+    EXPECT_TRUE(cards.isArray());
+    EXPECT_EQ(static_cast<size_t>(3), cards.size());
+    EXPECT_EQ(static_cast<size_t>(3), cards.getItems().size());
+
+    EXPECT_EQ("Island", cards[0]["name"].get());
+    EXPECT_EQ("Land", cards[0]["types"][0].get());
+    EXPECT_EQ("0", cards[0]["cmc"].get());
+    EXPECT_EQ("Ancestral \"Recall\"", cards[1]["name"].get());
+    EXPECT_EQ("Ancestral \\\"Recall\\\"", cards[1]["name"].getRaw().str());
+    EXPECT_EQ("true", cards[1]["flags"][0].get());
+    EXPECT_EQ("null", cards[1]["flags"][1].get());
+    EXPECT_DOUBLE_EQ(-25.0, toDouble(cards[1]["flags"][2].getRaw()));
+
+    // Escaped keys are matched after decoding
+    EXPECT_EQ("Black Lotus", cards[2]["name"].get());
+    EXPECT_EQ("{T}: Add", cards[2]["text"].get());
+
+    // A single value can be looped over like a list
+    EXPECT_EQ("Beta", doc["name"][0].get());
+    EXPECT_EQ(static_cast<size_t>(1), doc["name"].loopSize());
+
+    const std::vector<std::string> keys = cards[0].keys();
+    EXPECT_EQ(std::vector<std::string>({"name", "types", "cmc"}), keys);
+
+    EXPECT_TRUE(cards[1].has("flags"));
+    EXPECT_FALSE(cards[0].has("flags"));
+    EXPECT_FALSE(cards.has("name"));
+    EXPECT_THROW(doc["missing"], std::runtime_error);
+    EXPECT_THROW(cards[3], std::runtime_error);
+    EXPECT_THROW(doc["name"][1], std::runtime_error);
+
+    // Offsets can be used to find the value again later
+    EXPECT_EQ('{', DOCUMENT[cards[1].getOffset()]);
+}
+
+TEST(LazyDocument, MatchesDocument)
+{
+    // Long strings with quotes and escapes at every alignment exercise
+    // both the block scan and the byte scan.
+    std::string document = "{\"items\": [";
+    for (size_t ii = 0; ii < 64; ++ii)
+    {
+        document += ii ? ", " : "";
+        document += "{\"text\": \"" + std::string(ii, 'x') +
+                "\\\\\\\"{[,:]}\\\\\", \"id\": " + std::to_string(ii) + "}";
+    }
+    document += "]}";
+
+    const std::string pathname = "json_lazy.json";
+    {
+        std::ofstream stream(pathname);
+        stream << document;
+    }
+
+    const LazyDocument lazy(pathname);
+    const Document parsed(pathname);
+    std::remove(pathname.c_str());
+
+    const std::vector<LazyValue> items = lazy["items"].getItems();
+    ASSERT_EQ(parsed["items"].size(), items.size());
+    for (size_t ii = 0; ii < items.size(); ++ii)
+    {
+        EXPECT_EQ(parsed["items"][ii]["text"].get(), items[ii]["text"].get());
+        EXPECT_EQ(parsed["items"][ii]["id"].get(), items[ii]["id"].get());
+    }
+}
+
+TEST(LazyDocument, Errors)
+{
+    const std::vector<std::string> bad = {
+            "", "  ", "{\"a\": [1, 2}", "{\"a\": 1", "[1]]", "\"open"};
+    for (const std::string& document : bad)
+    {
+        EXPECT_ANY_THROW(
+                LazyDocument(document.data(), document.size()).getRoot());
+    }
+
+    const std::string scalar = " 42 ";
+    EXPECT_EQ("42", LazyDocument(scalar.data(), scalar.size()).getRoot().get());
+}
+}
+}
+
+NYRA_TEST()
@@ -0,0 +1,217 @@
+/*
+ * Copyright (c) 2018 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#include <cstdio>
+#include <fstream>
+#include <nyra/test/Test.h>
+#include <nyra/json/Parser.h>
+
+namespace
+{
+//===========================================================================//
+class Recorder : public nyra::json::Handler
+{
+public:
+    void onObjectBegin() override
+    {
+        events.push_back("{");
+    }
+
+    void onObjectEnd() override
+    {
+        events.push_back("}");
+    }
+
+    void onArrayBegin() override
+    {
+        events.push_back("[");
+    }
+
+    void onArrayEnd() override
+    {
+        events.push_back("]");
+    }
+
+    void onKey(const nyra::json::Span& key) override
+    {
+        events.push_back("key:" + key.str());
+    }
+
+    void onString(const nyra::json::Span& value) override
+    {
+        events.push_back("string:" + value.str());
+    }
+
+    void onNumber(const nyra::json::Span& value) override
+    {
+        events.push_back("number:" + value.str());
+    }
+
+    void onBool(bool value) override
+    {
+        events.push_back(value ? "true" : "false");
+    }
+
+    void onNull() override
+    {
+        events.push_back("null");
+    }
+
+    std::vector<std::string> events;
+};
+
+//===========================================================================//
+std::vector<std::string> record(const std::string& document)
+{
+    Recorder recorder;
+    nyra::json::parse(document, recorder);
+    return recorder.events;
+}
+
+//===========================================================================//
+std::string parseError(const std::string& document)
+{
+    try
+    {
+        record(document);
+    }
+    catch (const std::runtime_error& ex)
+    {
+        return ex.what();
+    }
+    return "";
+}
+}
+
+namespace nyra
+{
+namespace json
+{
+TEST(Parser, Events)
+{
+    const std::vector<std::string> expected = {
+            "{", "key:name", "string:Island",
+            "key:cost", "number:-1.5e3",
+            "key:types", "[", "string:Land", "string:Basic", "]",
+            "key:empty", "{", "}",
+            "key:flags", "[", "true", "false", "null", "]", "}"};
+
+    EXPECT_EQ(expected, record(
+            "{\"name\": \"Island\", \"cost\":-1.5e3,\n"
+            " \"types\" : [\"Land\", \"Basic\"], \"empty\": {},\n"
+            " \"flags\": [true, false, null]}"));
+
+    EXPECT_EQ(std::vector<std::string>({"number:42"}), record(" 42 "));
+    EXPECT_EQ(std::vector<std::string>({"[", "]"}), record("\xEF\xBB\xBF[]"));
+}
+
+TEST(Parser, Escapes)
+{
+    EXPECT_EQ(std::vector<std::string>({"string:a\"b\\c/d\n\te"}),
+              record("\"a\\\"b\\\\c\\/d\\n\\te\""));
+
+    // Two, three and four byte UTF-8 plus a surrogate pair
+    EXPECT_EQ(std::vector<std::string>(
+                {"string:\xC3\xA9\xE2\x82\xAC\xF0\x9F\x98\x80"}),
+              record("\"\\u00e9\\u20AC\\ud83d\\ude00\""));
+
+    // Keys are unescaped as well
+    EXPECT_EQ(std::vector<std::string>({"{", "key:a b", "null", "}"}),
+              record("{\"a\\u0020b\": null}"));
+}
+
+TEST(Parser, Errors)
+{
+    EXPECT_EQ("JSON parse error at line 2 column 5: Expected ':'",
+              parseError("{\"a\": 1,\n\"b\" 2}"));
+    EXPECT_NE("", parseError(""));
+    EXPECT_NE("", parseError("{\"a\": 1"));
+    EXPECT_NE("", parseError("[1, 2,]"));
+    EXPECT_NE("", parseError("{a: 1}"));
+    EXPECT_NE("", parseError("01"));
+    EXPECT_NE("", parseError("1."));
+    EXPECT_NE("", parseError("tru"));
+    EXPECT_NE("", parseError("\"unterminated"));
+    EXPECT_NE("", parseError("\"bad \\q escape\""));
+    EXPECT_NE("", parseError("\"\\ud83d alone\""));
+    EXPECT_NE("", parseError("[1] 2"));
+    EXPECT_NE("", parseError(std::string(1000, '[')));
+}
+
+TEST(Parser, Numbers)
+{
+    EXPECT_DOUBLE_EQ(-1500.0, toDouble(Span("-1.5e3", 6)));
+    EXPECT_DOUBLE_EQ(0.25, toDouble(Span("0.25", 4)));
+    EXPECT_EQ(42, toInt(Span("42", 2)));
+    EXPECT_EQ(-7, toInt(Span("-7", 2)));
+    EXPECT_EQ(std::numeric_limits<int64_t>::max(),
+              toInt(Span("9223372036854775807", 19)));
+    EXPECT_EQ(std::numeric_limits<int64_t>::min(),
+              toInt(Span("-9223372036854775808", 20)));
+
+    EXPECT_THROW(toInt(Span("9223372036854775808", 19)),
+                 std::runtime_error);
+    EXPECT_THROW(toInt(Span("1.5", 3)), std::runtime_error);
+    EXPECT_THROW(toInt(Span("-", 1)), std::runtime_error);
+    EXPECT_THROW(toDouble(Span("1x", 2)), std::runtime_error);
+    EXPECT_THROW(toDouble(Span()), std::runtime_error);
+
+    // Spans point into the source so they convert without a copy
+    const std::string document = "[12, 3.5]";
+    EXPECT_EQ(12, toInt(Span(document.data() + 1, 2)));
+    EXPECT_TRUE(Span(document.data() + 5, 3) == "3.5");
+}
+
+TEST(Parser, File)
+{
+    const std::string pathname = "json_parser_file.json";
+    {
+        std::ofstream stream(pathname);
+        stream << "{\"cards\": [";
+        for (size_t ii = 0; ii < 1000; ++ii)
+        {
+            stream << (ii ? ", " : "") << "{\"power\": " << ii << "}";
+        }
+        stream << "]}";
+    }
+
+    // Streams through the file without building a tree
+    class Sum : public Handler
+    {
+    public:
+        Sum() : total(0) {}
+
+        void onNumber(const Span& value) override
+        {
+            total += toInt(value);
+        }
+
+        int64_t total;
+    } sum;
+
+    parseFile(pathname, sum);
+    std::remove(pathname.c_str());
+    EXPECT_EQ(999 * 1000 / 2, sum.total);
+}
+}
+}
+
+NYRA_TEST()
@@ -0,0 +1,210 @@
+/*
+ * Copyright (c) 2018 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#include <iostream>
+#include <iomanip>
+#include <exception>
+#include <chrono>
+#include <vector>
+#include <string.h>
+#include <gmtl/Vec.h>
+#include <gmtl/VecOps.h>
+#include <gmtl/Matrix.h>
+#include <gmtl/MatrixOps.h>
+#include <nyra/cli/Parser.h>
+#include <nyra/math/Vector3.h>
+#include <nyra/math/Vector4.h>
+#include <nyra/math/Matrix4x4.h>
+
+using namespace nyra;
+
+//===========================================================================//
+template <typename FuncT>
+double benchmark(const std::string& name, size_t iterations, FuncT func)
+{
+    const auto start = std::chrono::steady_clock::now();
+    const double checksum = func(iterations);
+    const auto end = std::chrono::steady_clock::now();
+    const double ms =
+            std::chrono::duration<double, std::milli>(end - start).count();
+
+    // The checksum keeps the optimizer from throwing the work away.
+    std::cout << std::left << std::setw(24) << name
+              << std::right << std::setw(10) << std::fixed
+              << std::setprecision(2) << ms << " ms"
+              << "  (checksum " << checksum << ")\n";
+    return ms;
+}
+
+//===========================================================================//
+template <typename VectorT>
+double addScaleDot(const std::vector<VectorT>& input, size_t iterations)
+{
+    VectorT sum;
+    double ret = 0.0;
+    for (size_t ii = 0; ii < iterations; ++ii)
+    {
+        for (const VectorT& vec : input)
+        {
+            sum += vec;
+            sum *= 0.5f;
+        }
+        ret += gmtl::dot(sum, input[ii % input.size()]);
+    }
+    return ret;
+}
+
+//===========================================================================//
+template <typename VectorT>
+double addScaleDotNyra(const std::vector<VectorT>& input, size_t iterations)
+{
+    VectorT sum;
+    double ret = 0.0;
+    for (size_t ii = 0; ii < iterations; ++ii)
+    {
+        for (const VectorT& vec : input)
+        {
+            sum += vec;
+            sum *= 0.5f;
+        }
+        ret += sum.dot(input[ii % input.size()]);
+    }
+    return ret;
+}
+
+//===========================================================================//
+template <typename MatrixT>
+double multiply(const std::vector<MatrixT>& input, size_t iterations)
+{
+    MatrixT product;
+    double ret = 0.0;
+    for (size_t ii = 0; ii < iterations; ++ii)
+    {
+        for (const MatrixT& matrix : input)
+        {
+            product *= matrix;
+        }
+        ret += product(0, 0);
+        product = input[ii % input.size()];
+    }
+    return ret;
+}
+
+//===========================================================================//
+template <typename VectorT>
+double copy(const std::vector<VectorT>& input, size_t iterations)
+{
+    std::vector<VectorT> output(input.size());
+    for (size_t ii = 0; ii < iterations; ++ii)
+    {
+        std::copy(input.begin(), input.end(), output.begin());
+    }
+    return output.back()[0];
+}
+
+//===========================================================================//
+template <typename MatrixT>
+void fill(MatrixT& matrix, size_t seed)
+{
+    for (size_t ii = 0; ii < 4; ++ii)
+    {
+        for (size_t jj = 0; jj < 4; ++jj)
+        {
+            // Keep the values near identity so products do not overflow.
+            matrix(ii, jj) = (ii == jj ? 1.0f : 0.0f) +
+                    static_cast<float>((seed + ii * 4 + jj) % 7) * 0.01f;
+        }
+    }
+}
+
+//===========================================================================//
+int main(int argc, char** argv)
+{
+    try
+    {
+        cli::Options opt("Compares the math vector and matrix types against "
+                         "the equivalent GMTL operations");
+        opt.add("iterations", "The number of passes over the data. "
+                              "Defaults to 100000.");
+        opt.add("size", "The number of elements in each array. "
+                        "Defaults to 64.");
+        cli::Parser options(opt, argc, argv);
+
+        const size_t iterations = options.isSet("iterations") ?
+                options.get<size_t>("iterations") : 100000;
+        const size_t size = options.isSet("size") ?
+                options.get<size_t>("size") : 64;
+
+        std::vector<gmtl::Vec3f> gmtlVec3(size);
+        std::vector<gmtl::Vec4f> gmtlVec4(size);
+        std::vector<gmtl::Matrix44f> gmtlMatrix(size);
+        std::vector<math::Vector3F> nyraVec3(size);
+        std::vector<math::Vector4F> nyraVec4(size);
+        std::vector<math::Matrix4x4> nyraMatrix(size);
+        for (size_t ii = 0; ii < size; ++ii)
+        {
+            for (size_t jj = 0; jj < 4; ++jj)
+            {
+                const float value = static_cast<float>(ii + jj) * 0.25f;
+                if (jj < 3)
+                {
+                    gmtlVec3[ii][jj] = nyraVec3[ii][jj] = value;
+                }
+                gmtlVec4[ii][jj] = nyraVec4[ii][jj] = value;
+            }
+            fill(gmtlMatrix[ii], ii);
+            gmtlMatrix[ii].setState(gmtl::Matrix44f::FULL);
+            fill(nyraMatrix[ii], ii);
+        }
+
+        std::cout << "sizeof(Vector3F) " << sizeof(math::Vector3F)
+                  << ", sizeof(Vector4F) " << sizeof(math::Vector4F)
+                  << ", sizeof(Matrix4x4) " << sizeof(math::Matrix4x4)
+                  << "\n\n";
+
+        benchmark("gmtl Vec3 add/scale", iterations,
+             [&](size_t count){ return addScaleDot(gmtlVec3, count); });
+        benchmark("nyra Vector3F add/scale", iterations,
+             [&](size_t count){ return addScaleDotNyra(nyraVec3, count); });
+        benchmark("gmtl Vec4 add/scale", iterations,
+             [&](size_t count){ return addScaleDot(gmtlVec4, count); });
+        benchmark("nyra Vector4F add/scale", iterations,
+             [&](size_t count){ return addScaleDotNyra(nyraVec4, count); });
+        benchmark("gmtl Matrix44 multiply", iterations / 4,
+             [&](size_t count){ return multiply(gmtlMatrix, count); });
+        benchmark("nyra Matrix4x4 multiply", iterations / 4,
+             [&](size_t count){ return multiply(nyraMatrix, count); });
+        benchmark("gmtl Vec3 copy", iterations,
+             [&](size_t count){ return copy(gmtlVec3, count); });
+        benchmark("nyra Vector3F copy", iterations,
+             [&](size_t count){ return copy(nyraVec3, count); });
+    }
+    catch (const std::exception& ex)
+    {
+        std::cout << "STD Exception: " << ex.what() << std::endl;
+    }
+    catch (...)
+    {
+        std::cout << "Unknown Exception: System Error!" << std::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,273 @@
+/*
+ * Copyright (c) 2018 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#ifndef __NYRA_MATH_AABB_H__
+#define __NYRA_MATH_AABB_H__
+
+#include <algorithm>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <nyra/math/Vector2.h>
+#include <nyra/math/Vector3.h>
+
+namespace nyra
+{
+namespace math
+{
+/*
+ *  \class AABB
+ *  \brief An axis aligned bounding box. A default constructed box is
+ *         empty, and expanding it by a point makes it contain only that
+ *         point.
+ *
+ *  \tparam VectorT The vector type of the corners. This must be a
+ *          floating point Vector2 or Vector3.
+ */
+template <typename VectorT>
+class AABB
+{
+public:
+    /*
+     *  \func Constructor
+     *  \brief Creates an empty box.
+     */
+    AABB() :
+        min(std::numeric_limits<ElementT>::max()),
+        max(std::numeric_limits<ElementT>::lowest())
+    {
+    }
+
+    /*
+     *  \func Constructor
+     *  \brief Creates a box from two corners.
+     *
+     *  \param min The smallest corner
+     *  \param max The largest corner
+     */
+    AABB(const VectorT& min, const VectorT& max) :
+        min(min),
+        max(max)
+    {
+    }
+
+    /*
+     *  \func Constructor
+     *  \brief Creates the smallest box that contains every point.
+     *
+     *  \param points The points
+     *  \param count The number of points
+     */
+    AABB(const VectorT* points, size_t count) :
+        AABB()
+    {
+        for (size_t ii = 0; ii < count; ++ii)
+        {
+            expand(points[ii]);
+        }
+    }
+
+    /*
+     *  \func isEmpty
+     *  \brief Checks if the box contains nothing.
+     *
+     *  \return True if any axis has a min larger than its max.
+     */
+    bool isEmpty() const
+    {
+        for (size_t ii = 0; ii < SIZE; ++ii)
+        {
+            if (min[ii] > max[ii])
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /*
+     *  \func expand
+     *  \brief Grows the box so it contains a point.
+     *
+     *  \param point The point to contain
+     */
+    void expand(const VectorT& point)
+    {
+        for (size_t ii = 0; ii < SIZE; ++ii)
+        {
+            min[ii] = std::min(min[ii], point[ii]);
+            max[ii] = std::max(max[ii], point[ii]);
+        }
+    }
+
+    /*
+     *  \func expand
+     *  \brief Grows the box so it contains another box.
+     *
+     *  \param other The box to contain
+     */
+    void expand(const AABB<VectorT>& other)
+    {
+        for (size_t ii = 0; ii < SIZE; ++ii)
+        {
+            min[ii] = std::min(min[ii], other.min[ii]);
+            max[ii] = std::max(max[ii], other.max[ii]);
+        }
+    }
+
+    /*
+     *  \func contains
+     *  \brief Checks if a point is inside the box. Points on the edges
+     *         count as inside.
+     *
+     *  \param point The point to check
+     *  \return True if the point is inside
+     */
+    bool contains(const VectorT& point) const
+    {
+        for (size_t ii = 0; ii < SIZE; ++ii)
+        {
+            if (point[ii] < min[ii] || point[ii] > max[ii])
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /*
+     *  \func intersects
+     *  \brief Checks if two boxes overlap. Touching edges count as
+     *         overlapping.
+     *
+     *  \param other The box to check
+     *  \return True if the boxes overlap
+     */
+    bool intersects(const AABB<VectorT>& other) const
+    {
+        for (size_t ii = 0; ii < SIZE; ++ii)
+        {
+            if (other.max[ii] < min[ii] || other.min[ii] > max[ii])
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /*
+     *  \func getCenter
+     *  \brief Gets the center of the box
+     *
+     *  \return The center
+     */
+    VectorT getCenter() const
+    {
+        return (min + max) * 0.5;
+    }
+
+    /*
+     *  \func getSize
+     *  \brief Gets the length of each side of the box
+     *
+     *  \return The size
+     */
+    VectorT getSize() const
+    {
+        return max - min;
+    }
+
+    /*
+     *  \func transform
+     *  \brief Gets the box that contains this box after it is transformed
+     *         by an affine matrix. This uses the matrix directly rather
+     *         than transforming all of the corners.
+     *
+     *  \tparam MatrixT Matrix3x3 for 2D boxes or Matrix4x4 for 3D boxes
+     *  \param matrix The transform
+     *  \return The transformed box
+     */
+    template <typename MatrixT>
+    AABB<VectorT> transform(const MatrixT& matrix) const
+    {
+        if (isEmpty())
+        {
+            return *this;
+        }
+
+        AABB<VectorT> ret;
+        for (size_t ii = 0; ii < SIZE; ++ii)
+        {
+            ret.min[ii] = ret.max[ii] = matrix(ii, SIZE);
+            for (size_t jj = 0; jj < SIZE; ++jj)
+            {
+                const ElementT a = matrix(ii, jj) * min[jj];
+                const ElementT b = matrix(ii, jj) * max[jj];
+                ret.min[ii] += std::min(a, b);
+                ret.max[ii] += std::max(a, b);
+            }
+        }
+        return ret;
+    }
+
+    /*
+     *  \var min
+     *  \brief The smallest corner
+     */
+    VectorT min;
+
+    /*
+     *  \var max
+     *  \brief The largest corner
+     */
+    VectorT max;
+
+private:
+    typedef typename std::remove_reference<
+            decltype(std::declval<VectorT>()[0])>::type ElementT;
+
+    // Vectors are packed with no padding beyond SIMD alignment, which only
+    // applies when the elements already fill it.
+    static const size_t SIZE = sizeof(VectorT) / sizeof(ElementT);
+
+    NYRA_SERIALIZE()
+
+    template<class ArchiveT>
+    void serialize(ArchiveT& archive, const unsigned int version)
+    {
+        archive & BOOST_SERIALIZATION_NVP(min);
+        archive & BOOST_SERIALIZATION_NVP(max);
+    }
+
+    friend std::ostream& operator<<(std::ostream& os,
+                                    const AABB<VectorT>& box)
+    {
+        os << "min: " << box.min << " max: " << box.max;
+        return os;
+    }
+};
+
+typedef AABB<Vector2F> AABB2F;
+typedef AABB<Vector3F> AABB3F;
+}
+}
+
+#endif
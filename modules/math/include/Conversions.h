@@ -63,6 +63,12 @@ inline double radiansToDegrees(double radians)
  */
 inline double normalizeAngle(double value)
 {
+    // Most angles are already in range so skip the division
+    if (value >= 0.0 && value < 360.0)
+    {
+        return value;
+    }
+
     value = fmod(value, 360);
     if (value < 0)
     {
@@ -89,6 +95,97 @@ Vector<TypeT, SizeT> normalizeAngle(Vector<TypeT, SizeT> value)
     return value;
 }
 
+/*
+ *  \func sinCos
+ *  \brief Calculates the sine and cosine of an angle
+ *
+ *  \param degrees The angle in degrees
+ *  \param sine The output sine
+ *  \param cosine The output cosine
+ */
+inline void sinCos(double degrees, float& sine, float& cosine)
+{
+    const double radians = degreesToRadians(degrees);
+    sine = static_cast<float>(sin(radians));
+    cosine = static_cast<float>(cos(radians));
+}
+
+/*
+ *  \func sinCos
+ *  \brief Calculates the sine and cosine of each angle in a vector
+ *
+ *  \tparam TypeT The data type of the vector
+ *  \tparam SizeT The size of the vector
+ *  \param degrees The angles in degrees
+ *  \param sine The output sines
+ *  \param cosine The output cosines
+ */
+template <typename TypeT, size_t SizeT>
+void sinCos(const Vector<TypeT, SizeT>& degrees,
+            Vector<TypeT, SizeT>& sine,
+            Vector<TypeT, SizeT>& cosine)
+{
+    for (size_t ii = 0; ii < SizeT; ++ii)
+    {
+        sinCos(degrees[ii], sine[ii], cosine[ii]);
+    }
+}
+
+/*
+ *  \class SinCos
+ *  \brief Holds the sine and cosine of a rotation so they only need to
+ *         be calculated when the rotation changes.
+ *
+ *  \tparam RotationT float for a single angle or a vector of angles
+ */
+template <typename RotationT>
+struct SinCos
+{
+    /*
+     *  \func Constructor
+     *  \brief Sets up the values for no rotation
+     */
+    SinCos() :
+        sine(0.0f),
+        cosine(1.0f)
+    {
+    }
+
+    /*
+     *  \func Constructor
+     *  \brief Calculates the values for a rotation
+     *
+     *  \param degrees The rotation in degrees
+     */
+    explicit SinCos(const RotationT& degrees)
+    {
+        set(degrees);
+    }
+
+    /*
+     *  \func set
+     *  \brief Recalculates the values for a rotation
+     *
+     *  \param degrees The rotation in degrees
+     */
+    void set(const RotationT& degrees)
+    {
+        sinCos(degrees, sine, cosine);
+    }
+
+    /*
+     *  \var sine
+     *  \brief The sine of the rotation
+     */
+    RotationT sine;
+
+    /*
+     *  \var cosine
+     *  \brief The cosine of the rotation
+     */
+    RotationT cosine;
+};
+
 /*
  *  \func eulerToQuaternion
  *  \brief Converts Euler angles to quaternions
@@ -0,0 +1,149 @@
+/*
+ * Copyright (c) 2018 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#ifndef __NYRA_MATH_FLOW_FIELD_H__
+#define __NYRA_MATH_FLOW_FIELD_H__
+
+#include <vector>
+#include <nyra/math/GridGraph.h>
+
+namespace nyra
+{
+namespace math
+{
+/*
+ *  \class FlowField
+ *  \brief Stores the distance from every cell of a GridGraph to a single
+ *         goal, plus the next step toward it. Any number of agents chasing
+ *         the same goal can then find their next step without searching.
+ */
+class FlowField
+{
+public:
+    /*
+     *  \func Constructor
+     *  \brief Creates a field with no goal. The grid must outlive the field.
+     *
+     *  \param grid The walkable cells
+     */
+    FlowField(const GridGraph& grid);
+
+    /*
+     *  \func getGrid
+     *  \brief Gets the grid the field covers.
+     *
+     *  \return The grid
+     */
+    const GridGraph& getGrid() const
+    {
+        return mGrid;
+    }
+
+    /*
+     *  \func getGoal
+     *  \brief Gets the cell everything flows toward.
+     *
+     *  \return The goal index. This is past the end of the grid if no
+     *          goal has been set.
+     */
+    size_t getGoal() const
+    {
+        return mGoal;
+    }
+
+    /*
+     *  \func setGoal
+     *  \brief Moves the goal. If it moves to a neighboring cell, only the
+     *         cells that get closer to the goal are revisited. Otherwise
+     *         the whole field is rebuilt. Setting the current goal again
+     *         does nothing, so use rebuild after the grid changes.
+     *
+     *  \param goal The new goal index
+     */
+    void setGoal(size_t goal);
+
+    /*
+     *  \func rebuild
+     *  \brief Rebuilds the whole field. Call this after the grid changes.
+     */
+    void rebuild();
+
+    /*
+     *  \func hasPath
+     *  \brief Checks if a cell can reach the goal.
+     *
+     *  \param cell The cell index
+     *  \return True if the goal can be reached
+     */
+    bool hasPath(size_t cell) const
+    {
+        return cell < mCosts.size() && mCosts[cell] != UNREACHABLE;
+    }
+
+    /*
+     *  \func getDistance
+     *  \brief Gets the length of the shortest path to the goal.
+     *
+     *  \param cell The cell index
+     *  \return The distance, or a negative value if there is no path
+     */
+    float getDistance(size_t cell) const
+    {
+        return hasPath(cell) ? mCosts[cell] + mOffset : -1.0f;
+    }
+
+    /*
+     *  \func getNext
+     *  \brief Gets the next cell on the way to the goal.
+     *
+     *  \param cell The cell index
+     *  \return The neighbor to move to. This is the cell itself if it is
+     *          the goal or if there is no path.
+     */
+    size_t getNext(size_t cell) const;
+
+private:
+    struct Entry
+    {
+        float cost;
+        uint32_t index;
+    };
+
+    static const float UNREACHABLE;
+
+    void propagate();
+
+    const GridGraph& mGrid;
+    size_t mGoal;
+
+    // Costs are stored relative to mOffset. When the goal takes one step,
+    // every old path can be extended by that step, so the old costs plus
+    // the step are all valid upper bounds. Bumping the offset applies
+    // that to every cell at once.
+    float mOffset;
+    std::vector<float> mCosts;
+    std::vector<uint8_t> mDirections;
+    std::vector<Entry> mOpen;
+};
+}
+}
+
+#endif
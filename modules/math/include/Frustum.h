@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) 2018 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#ifndef __NYRA_MATH_FRUSTUM_H__
+#define __NYRA_MATH_FRUSTUM_H__
+
+#include <vector>
+#include <nyra/math/AABB.h>
+#include <nyra/math/Vector4.h>
+#include <nyra/math/Matrix4x4.h>
+
+namespace nyra
+{
+namespace math
+{
+/*
+ *  \class Frustum
+ *  \brief The six clipping planes of a camera, used to cull objects that
+ *         cannot be seen. Planes point inward, so a point is visible when
+ *         it is on the positive side of all of them.
+ */
+class Frustum
+{
+public:
+    /*
+     *  \func Constructor
+     *  \brief Creates a frustum that contains everything.
+     */
+    Frustum();
+
+    /*
+     *  \func Constructor
+     *  \brief Extracts the planes from a combined projection and view
+     *         matrix. Clip space is expected to be -w to w on every axis
+     *         as it is in OpenGL.
+     *
+     *  \param viewProjection The projection matrix times the view matrix
+     */
+    Frustum(const Matrix4x4& viewProjection);
+
+    /*
+     *  \func contains
+     *  \brief Checks if a point is inside the frustum.
+     *
+     *  \param point The point in world space
+     *  \return True if the point is inside or on a plane
+     */
+    bool contains(const Vector3F& point) const;
+
+    /*
+     *  \func intersects
+     *  \brief Checks if any part of a box might be inside the frustum.
+     *         This is conservative, so a few boxes near the corners pass
+     *         even though they are outside.
+     *
+     *  \param box The box in world space
+     *  \return False if the box is definitely outside
+     */
+    bool intersects(const AABB3F& box) const;
+
+    /*
+     *  \func cull
+     *  \brief Finds every box that might be visible.
+     *
+     *  \param boxes The boxes to check
+     *  \param count The number of boxes
+     *  \param visible Cleared and then filled with the indices of the
+     *         boxes that pass intersects.
+     */
+    void cull(const AABB3F* boxes,
+              size_t count,
+              std::vector<size_t>& visible) const;
+
+    /*
+     *  \func getPlane
+     *  \brief Gets one of the planes as (a, b, c, d) where
+     *         a*x + b*y + c*z + d is the distance from the plane.
+     *
+     *  \param index The plane index in the order left, right, bottom,
+     *         top, near, far
+     *  \return The normalized plane
+     */
+    const Vector4F& getPlane(size_t index) const
+    {
+        return mPlanes[index];
+    }
+
+private:
+    float distance(size_t plane, const Vector3F& point) const;
+
+    Vector4F mPlanes[6];
+};
+}
+}
+
+#endif
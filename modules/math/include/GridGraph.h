@@ -0,0 +1,234 @@
+/*
+ * Copyright (c) 2018 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#ifndef __NYRA_MATH_GRID_GRAPH_H__
+#define __NYRA_MATH_GRID_GRAPH_H__
+
+#include <stdint.h>
+#include <stddef.h>
+#include <vector>
+#include <nyra/math/PathResults.h>
+
+namespace nyra
+{
+namespace math
+{
+/*
+ *  \class GridGraph
+ *  \brief A graph where every cell of a 2D grid is a node connected to its
+ *         eight neighbors. Walkable cells are stored as a packed bitmap and
+ *         paths are found with A* using an octile heuristic. Nodes are
+ *         referred to by index, which is y * width + x.
+ */
+class GridGraph
+{
+public:
+    /*
+     *  \class Search
+     *  \brief Scratch memory for a path search. Keeping one around between
+     *         searches means nothing needs to be allocated or cleared per
+     *         search. Use one Search per thread.
+     */
+    class Search
+    {
+    public:
+        /*
+         *  \func Constructor
+         *  \brief Creates empty scratch memory. It grows on first use.
+         */
+        Search();
+
+    private:
+        friend class GridGraph;
+
+        struct Node
+        {
+            float total;
+            float heuristic;
+            uint32_t index;
+        };
+
+        // Everything about a node is kept together so a neighbor check
+        // only touches one cache line.
+        struct State
+        {
+            float cost;
+            uint32_t parent;
+            uint32_t visited;
+            uint32_t closed;
+        };
+
+        uint32_t begin(size_t numNodes);
+
+        std::vector<State> mStates;
+        std::vector<Node> mOpen;
+        uint32_t mGeneration;
+    };
+
+    /*
+     *  \func Constructor
+     *  \brief Creates a grid where every cell is blocked.
+     *
+     *  \param width The number of columns
+     *  \param height The number of rows
+     */
+    GridGraph(size_t width,
+              size_t height);
+
+    /*
+     *  \func getWidth
+     *  \brief Gets the number of columns.
+     *
+     *  \return The width of the grid
+     */
+    size_t getWidth() const
+    {
+        return mWidth;
+    }
+
+    /*
+     *  \func getHeight
+     *  \brief Gets the number of rows.
+     *
+     *  \return The height of the grid
+     */
+    size_t getHeight() const
+    {
+        return mHeight;
+    }
+
+    /*
+     *  \func getIndex
+     *  \brief Gets the node index of a cell.
+     *
+     *  \param x The column
+     *  \param y The row
+     *  \return The node index
+     */
+    size_t getIndex(size_t x, size_t y) const
+    {
+        return y * mWidth + x;
+    }
+
+    /*
+     *  \func setWalkable
+     *  \brief Sets if a cell can be walked through.
+     *
+     *  \param x The column
+     *  \param y The row
+     *  \param walkable True if paths can go through the cell
+     */
+    void setWalkable(size_t x, size_t y, bool walkable);
+
+    /*
+     *  \func isWalkable
+     *  \brief Checks if a cell can be walked through. Cells outside of the
+     *         grid are never walkable.
+     *
+     *  \param x The column
+     *  \param y The row
+     *  \return True if the cell is walkable
+     */
+    bool isWalkable(size_t x, size_t y) const
+    {
+        return x < mWidth && y < mHeight && isWalkable(getIndex(x, y));
+    }
+
+    /*
+     *  \func isWalkable
+     *  \brief Checks if a node can be walked through.
+     *
+     *  \param index The node index. This must be inside the grid.
+     *  \return True if the node is walkable
+     */
+    bool isWalkable(size_t index) const
+    {
+        return (mBits[index >> 6] >> (index & 63)) & 1;
+    }
+
+    /*
+     *  \func getPath
+     *  \brief Finds the shortest path between two nodes. Straight moves
+     *         cost 1 and diagonal moves cost the square root of 2. This
+     *         uses scratch memory owned by the graph, so it must not be
+     *         called from more than one thread at a time.
+     *
+     *  \param start The starting node index
+     *  \param end The target node index
+     *  \return The node indices from start to end. The path is empty if
+     *          there is no path.
+     */
+    PathResults<size_t> getPath(size_t start,
+                                size_t end) const
+    {
+        return getPath(start, end, mSearch);
+    }
+
+    /*
+     *  \func getPath
+     *  \brief Finds the shortest path between two nodes using the caller's
+     *         scratch memory. This is safe to call from many threads as
+     *         long as each uses its own Search.
+     *
+     *  \param start The starting node index
+     *  \param end The target node index
+     *  \param search Scratch memory for the search
+     *  \return The node indices from start to end. The path is empty if
+     *          there is no path.
+     */
+    PathResults<size_t> getPath(size_t start,
+                                size_t end,
+                                Search& search) const;
+
+    /*
+     *  \func getPath
+     *  \brief Finds the shortest path between two nodes that stays inside
+     *         a rectangle of cells. Only the nodes in the rectangle are
+     *         searched, which keeps short searches cheap.
+     *
+     *  \param start The starting node index
+     *  \param end The target node index
+     *  \param x0 The first column of the rectangle
+     *  \param y0 The first row of the rectangle
+     *  \param x1 One past the last column of the rectangle
+     *  \param y1 One past the last row of the rectangle
+     *  \param search Scratch memory for the search
+     *  \return The node indices from start to end. The path is empty if
+     *          there is no path inside the rectangle.
+     */
+    PathResults<size_t> getPath(size_t start,
+                                size_t end,
+                                size_t x0,
+                                size_t y0,
+                                size_t x1,
+                                size_t y1,
+                                Search& search) const;
+
+private:
+    size_t mWidth;
+    size_t mHeight;
+    std::vector<uint64_t> mBits;
+    mutable Search mSearch;
+};
+}
+}
+
+#endif
@@ -0,0 +1,284 @@
+/*
+ * Copyright (c) 2018 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#ifndef __NYRA_MATH_HIERARCHICAL_GRAPH_H__
+#define __NYRA_MATH_HIERARCHICAL_GRAPH_H__
+
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <nyra/math/GridGraph.h>
+
+namespace nyra
+{
+namespace math
+{
+/*
+ *  \class HierarchicalGraph
+ *  \brief Hierarchical path finding (HPA*) over a GridGraph. The grid is
+ *         split into square clusters. Entrances between neighboring
+ *         clusters become nodes of a small abstract graph, and the
+ *         shortest distance between every pair of entrances in a cluster
+ *         is computed up front. A query is answered on the abstract graph.
+ *         Each step is then turned back into tiles, and those tile paths
+ *         are cached the first time they are used. The tile path is then
+ *         refined by searching the grid again over short overlapping
+ *         windows of it, which takes out most of the detours toward
+ *         entrances. Queries between the same or neighboring clusters
+ *         search the grid directly in and just around those clusters, so
+ *         short paths do not detour through an entrance.
+ *
+ *         Paths are close to optimal but not guaranteed to be the
+ *         shortest, see getPath. A path is always found if one exists.
+ */
+class HierarchicalGraph
+{
+public:
+    /*
+     *  \class Search
+     *  \brief Scratch memory for a path search. Use one Search per thread.
+     */
+    class Search
+    {
+    public:
+        /*
+         *  \func Constructor
+         *  \brief Creates empty scratch memory. It grows on first use.
+         */
+        Search();
+
+    private:
+        friend class HierarchicalGraph;
+
+        struct Entry
+        {
+            float total;
+            uint32_t index;
+        };
+
+        struct State
+        {
+            float cost;
+            uint32_t parent;
+            uint32_t visited;
+            uint32_t closed;
+        };
+
+        struct Scratch
+        {
+            Scratch();
+
+            uint32_t begin(size_t size);
+
+            std::vector<State> states;
+            std::vector<Entry> open;
+            uint32_t generation;
+        };
+
+        GridGraph::Search mNearby;
+        Scratch mStart;
+        Scratch mEnd;
+        Scratch mRefine;
+        Scratch mAbstract;
+        std::vector<std::pair<uint32_t, float> > mStartEdges;
+        std::vector<std::pair<uint32_t, float> > mEndEdges;
+    };
+
+    /*
+     *  \func Constructor
+     *  \brief Builds the abstract graph for a grid.
+     *
+     *  \param grid The walkable cells. The graph keeps its own copy.
+     *  \param clusterSize The width and height of a cluster in cells
+     */
+    HierarchicalGraph(const GridGraph& grid,
+                      size_t clusterSize = 16);
+
+    /*
+     *  \func getGrid
+     *  \brief Gets the underlying grid.
+     *
+     *  \return The grid
+     */
+    const GridGraph& getGrid() const
+    {
+        return mGrid;
+    }
+
+    /*
+     *  \func getNumNodes
+     *  \brief Gets the number of entrance nodes in the abstract graph.
+     *
+     *  \return The number of nodes
+     */
+    size_t getNumNodes() const;
+
+    /*
+     *  \func setWalkable
+     *  \brief Changes if a cell can be walked through. The clusters around
+     *         the cell are rebuilt the next time update is called.
+     *
+     *  \param x The column
+     *  \param y The row
+     *  \param walkable True if paths can go through the cell
+     */
+    void setWalkable(size_t x, size_t y, bool walkable);
+
+    /*
+     *  \func update
+     *  \brief Rebuilds any clusters that changed since the last update.
+     *         This must be called before searching after any call to
+     *         setWalkable.
+     */
+    void update();
+
+    /*
+     *  \func getPath
+     *  \brief Finds a path between two nodes. This uses scratch memory
+     *         owned by the graph, so it must not be called from more than
+     *         one thread at a time.
+     *
+     *  \param start The starting node index
+     *  \param end The target node index
+     *  \return The node indices from start to end. The path is empty if
+     *          there is no path.
+     */
+    PathResults<size_t> getPath(size_t start,
+                                size_t end) const
+    {
+        return getPath(start, end, mSearch);
+    }
+
+    /*
+     *  \func getPath
+     *  \brief Finds a path between two nodes using the caller's scratch
+     *         memory. This is safe to call from many threads as long as
+     *         each uses its own Search.
+     *
+     *         There is no hard bound on how much longer the path is than
+     *         the one GridGraph::getPath finds. Measured against it, paths
+     *         are under 1% longer on average. The worst seen was 1.08
+     *         times as long on open maps with walls and 16 cell clusters,
+     *         and 1.4 times on dense random mazes with clusters of 2 or 3
+     *         cells, where the only short way around a wall can be outside
+     *         of every window searched.
+     *
+     *  \param start The starting node index
+     *  \param end The target node index
+     *  \param search Scratch memory for the search
+     *  \throw If update has not been called since the grid changed
+     *  \return The node indices from start to end. The path is empty if
+     *          there is no path.
+     */
+    PathResults<size_t> getPath(size_t start,
+                                size_t end,
+                                Search& search) const;
+
+private:
+    enum BorderType
+    {
+        VERTICAL,
+        HORIZONTAL,
+        DIAGONAL,
+        ANTI_DIAGONAL
+    };
+
+    struct Node
+    {
+        uint32_t cell;
+        uint32_t cluster;
+        uint32_t partner;
+        float partnerCost;
+    };
+
+    struct Edge
+    {
+        uint32_t to;
+        float cost;
+    };
+
+    struct Border
+    {
+        BorderType type;
+        uint32_t first;
+        uint32_t second;
+        std::vector<uint32_t> nodes;
+    };
+
+    size_t getCluster(size_t cell) const;
+
+    void getBounds(size_t cluster,
+                   size_t& x0, size_t& y0,
+                   size_t& x1, size_t& y1) const;
+
+    void addBorder(BorderType type, size_t first, size_t second,
+                   const std::vector<size_t>& clusters);
+
+    void buildBorder(Border& border);
+
+    void addTransition(Border& border,
+                       size_t first, size_t second, float cost);
+
+    uint32_t addNode(size_t cell, size_t cluster);
+
+    void buildCluster(size_t cluster);
+
+    void searchCluster(size_t cluster,
+                       size_t cell,
+                       Search::Scratch& scratch) const;
+
+    void appendLocalPath(size_t cluster,
+                         size_t cell,
+                         const Search::Scratch& scratch,
+                         bool towardStart,
+                         std::vector<size_t>& path) const;
+
+    void appendClusterPath(uint32_t from,
+                           uint32_t to,
+                           Search& search,
+                           std::vector<size_t>& path) const;
+
+    void refinePath(std::vector<size_t>& path,
+                    Search& search) const;
+
+    GridGraph mGrid;
+    const size_t mClusterSize;
+    const size_t mClustersX;
+    const size_t mClustersY;
+    std::vector<Node> mNodes;
+    std::vector<std::vector<Edge> > mEdges;
+    std::vector<uint32_t> mFreeNodes;
+    std::vector<Border> mBorders;
+    std::vector<std::vector<uint32_t> > mClusterBorders;
+    std::vector<std::vector<uint32_t> > mClusterNodes;
+    std::vector<bool> mDirty;
+    bool mHasDirty;
+
+    mutable std::vector<std::unordered_map<uint64_t,
+            std::vector<uint32_t> > > mPathCache;
+    mutable std::mutex mCacheMutex;
+    mutable Search mSearch;
+};
+}
+}
+
+#endif
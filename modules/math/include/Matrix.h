@@ -23,8 +23,8 @@
 #define __NYRA_MATH_MATRIX_H__
 
 #include <nyra/math/Vector2.h>
+#include <nyra/math/SIMD.h>
 #include <gmtl/Matrix.h>
-#include <gmtl/MatrixOps.h>
 
 namespace nyra
 {
@@ -34,21 +34,61 @@ namespace math
  *  \class Matrix
  *  \brief A templated matrix class for any type with any size. In general
  *         this should not be used. Instead use the fixed size matrices. By
- *         default this will give you an identity matrix.
+ *         default this will give you an identity matrix. Elements are
+ *         stored row major with no virtual functions so matrices are
+ *         trivially copyable. Rows that fill a SIMD register are 16 byte
+ *         aligned.
  *
  *  \tparam TypeT The data type of each element
  *  \tparam Rows The number of rows
  *  \tparam Cols The number of columns
  */
 template<typename TypeT, size_t Rows, size_t Cols>
-class Matrix
+class alignas(VectorAlignment<TypeT, Cols>::value) Matrix
 {
 public:
     /*
-     *  \func Destructor
-     *  \brief Necessary for correct inheritance
+     *  \func Constructor
+     *  \brief Creates an identity matrix.
      */
-    virtual ~Matrix() = default;
+    Matrix()
+    {
+        for (size_t ii = 0; ii < Rows; ++ii)
+        {
+            for (size_t jj = 0; jj < Cols; ++jj)
+            {
+                mMatrix[ii][jj] = ii == jj ? 1 : 0;
+            }
+        }
+    }
+
+    /*
+     *  \func Constructor
+     *  \brief Creates a matrix from every element in row major order. This
+     *         is constexpr so fixed size matrices can be built at compile
+     *         time.
+     *
+     *  \param value The first element
+     *  \param values The remaining elements
+     */
+    template <typename... ValuesT>
+    constexpr Matrix(TypeT value, ValuesT... values) :
+        mMatrix{value, static_cast<TypeT>(values)...}
+    {
+        static_assert(sizeof...(ValuesT) + 1 == Rows * Cols,
+                      "Every element of the matrix must be given");
+    }
+
+    /*
+     *  \func Constructor
+     *  \brief Copies a GMTL matrix.
+     *
+     *  \param matrix The GMTL matrix to copy
+     */
+    explicit Matrix(const gmtl::Matrix<TypeT, Rows, Cols>& matrix)
+    {
+        setNative(matrix);
+    }
 
     /*
      *  \func getSize
@@ -70,9 +110,20 @@ public:
      */
     bool operator==(const Matrix<TypeT, Rows, Cols>& other) const
     {
-        return gmtl::isEqual(mMatrix,
-                             other.mMatrix,
-                             static_cast<TypeT>(0.0001));
+        const TypeT epsilon = static_cast<TypeT>(0.0001);
+        for (size_t ii = 0; ii < Rows; ++ii)
+        {
+            for (size_t jj = 0; jj < Cols; ++jj)
+            {
+                const TypeT lhs = mMatrix[ii][jj];
+                const TypeT rhs = other.mMatrix[ii][jj];
+                if ((lhs > rhs ? lhs - rhs : rhs - lhs) > epsilon)
+                {
+                    return false;
+                }
+            }
+        }
+        return true;
     }
 
     /*
@@ -95,7 +146,7 @@ public:
      *  \param col The desired column
      *  \return The element
      */
-    const TypeT& operator()(size_t row, size_t col) const
+    constexpr const TypeT& operator()(size_t row, size_t col) const
     {
         return mMatrix[row][col];
     }
@@ -110,24 +161,24 @@ public:
      */
     TypeT& operator()(size_t row, size_t col)
     {
-        mMatrix.setState(gmtl::Matrix<TypeT, Rows, Cols>::FULL);
         return mMatrix[row][col];
     }
 
     /*
      *  \func Multiply Assign
-     *  \brief Multiplies a matrix in this matrix
+     *  \brief Multiplies a matrix in this matrix. This is this * other.
      *
-     *  \tparam OtherRows The number of rows in the other matrix
-     *  \tparam OtherCols The number of columns in the other matrix
      *  \param other The matrix to multiple
      *  \return The updated matrix
      */
-    template <size_t OtherRows, size_t OtherCols>
     Matrix<TypeT, Rows, Cols>& operator*=(
-            const Matrix<TypeT, OtherRows, OtherCols>& other)
+            const Matrix<TypeT, Cols, Cols>& other)
     {
-        mMatrix *= other.mMatrix;
+        Matrix<TypeT, Rows, Cols> product;
+        MatrixOps<TypeT, Rows, Cols>::multiply(mMatrix[0],
+                                               other.mMatrix[0],
+                                               product.mMatrix[0]);
+        *this = product;
         return *this;
     }
 
@@ -150,24 +201,41 @@ public:
 
     /*
      *  \func getNative
-     *  \brief Returns the GMTL object
+     *  \brief Gets a copy of the matrix as a GMTL object. Matrices no
+     *         longer store a GMTL matrix so this cannot be modified in
+     *         place. Use setNative to write one back.
      *
      *  \return The GMTL object
      */
-    const gmtl::Matrix<TypeT, Rows, Cols>& getNative() const
+    gmtl::Matrix<TypeT, Rows, Cols> getNative() const
     {
-        return mMatrix;
+        gmtl::Matrix<TypeT, Rows, Cols> ret;
+        for (size_t ii = 0; ii < Rows; ++ii)
+        {
+            for (size_t jj = 0; jj < Cols; ++jj)
+            {
+                ret(ii, jj) = mMatrix[ii][jj];
+            }
+        }
+        ret.setState(gmtl::Matrix<TypeT, Rows, Cols>::FULL);
+        return ret;
     }
 
     /*
-     *  \func getNative
-     *  \brief Returns the GMTL object
+     *  \func setNative
+     *  \brief Copies the values of a GMTL object into the matrix
      *
-     *  \return The GMTL object
+     *  \param matrix The GMTL object
      */
-    gmtl::Matrix<TypeT, Rows, Cols>& getNative()
+    void setNative(const gmtl::Matrix<TypeT, Rows, Cols>& matrix)
     {
-        return mMatrix;
+        for (size_t ii = 0; ii < Rows; ++ii)
+        {
+            for (size_t jj = 0; jj < Cols; ++jj)
+            {
+                mMatrix[ii][jj] = matrix(ii, jj);
+            }
+        }
     }
 
 private:
@@ -180,7 +248,7 @@ private:
         {
             for (size_t jj = 0; jj < Cols; ++jj)
             {
-                archive & BOOST_SERIALIZATION_NVP((*this)(ii, jj));
+                archive & BOOST_SERIALIZATION_NVP(mMatrix[ii][jj]);
             }
         }
     }
@@ -222,7 +290,10 @@ private:
     }
 
 protected:
-    gmtl::Matrix<TypeT, Rows, Cols> mMatrix;
+    template <typename OtherT, size_t OtherRows, size_t OtherCols>
+    friend class Matrix;
+
+    TypeT mMatrix[Rows][Cols];
 };
 }
 }
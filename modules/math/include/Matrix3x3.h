@@ -24,6 +24,7 @@
 
 #include <nyra/math/Matrix.h>
 #include <nyra/math/Vector2.h>
+#include <nyra/math/Conversions.h>
 
 namespace nyra
 {
@@ -56,9 +57,14 @@ public:
      *  \param a32 row 3 column 2
      *  \param a33 row 3 column 3
      */
-    Matrix3x3(float a11, float a12, float a13,
-              float a21, float a22, float a23,
-              float a31, float a32, float a33);
+    constexpr Matrix3x3(float a11, float a12, float a13,
+                        float a21, float a22, float a23,
+                        float a31, float a32, float a33) :
+        Matrix<float, 3, 3>(a11, a12, a13,
+                            a21, a22, a23,
+                            a31, a32, a33)
+    {
+    }
 
     /*
      *  \func Constructor
@@ -82,6 +88,61 @@ public:
                    const Vector2F& scale,
                    float rotation,
                    const Vector2F& pivot);
+
+    /*
+     *  \func transform
+     *  \brief Creates a transform matrix from smaller pieces using a
+     *         rotation that already has its sine and cosine calculated.
+     *         Note that this destroys the current matrix.
+     *
+     *  \param position The position of the object
+     *  \param scale The scale of the object
+     *  \param rotation The sine and cosine of the rotation
+     *  \param pivot The pivot point of the object
+     */
+    void transform(const Vector2F& position,
+                   const Vector2F& scale,
+                   const SinCos<float>& rotation,
+                   const Vector2F& pivot);
+
+    /*
+     *  \func compose
+     *  \brief Sets this matrix to parent * local. Both matrices must be
+     *         affine, which is always true for matrices built by
+     *         transform, so the bottom row is skipped.
+     *
+     *  \param parent The parent matrix
+     *  \param local The child matrix
+     */
+    void compose(const Matrix3x3& parent, const Matrix3x3& local);
+
+    /*
+     *  \func identity
+     *  \brief Creates an identity matrix at compile time
+     *
+     *  \return The identity matrix
+     */
+    static constexpr Matrix3x3 identity()
+    {
+        return Matrix3x3(1.0f, 0.0f, 0.0f,
+                         0.0f, 1.0f, 0.0f,
+                         0.0f, 0.0f, 1.0f);
+    }
+
+    /*
+     *  \func translation
+     *  \brief Creates a translation matrix at compile time
+     *
+     *  \param x The distance along x
+     *  \param y The distance along y
+     *  \return The translation matrix
+     */
+    static constexpr Matrix3x3 translation(float x, float y)
+    {
+        return Matrix3x3(1.0f, 0.0f, x,
+                         0.0f, 1.0f, y,
+                         0.0f, 0.0f, 1.0f);
+    }
 };
 }
 }
@@ -24,6 +24,7 @@
 
 #include <nyra/math/Matrix.h>
 #include <nyra/math/Vector3.h>
+#include <nyra/math/Conversions.h>
 
 namespace nyra
 {
@@ -63,10 +64,16 @@ public:
      *  \param a43 row 4 column 3
      *  \param a44 row 4 column 4
      */
-    Matrix4x4(float a11, float a12, float a13, float a14,
-              float a21, float a22, float a23, float a24,
-              float a31, float a32, float a33, float a34,
-              float a41, float a42, float a43, float a44);
+    constexpr Matrix4x4(float a11, float a12, float a13, float a14,
+                        float a21, float a22, float a23, float a24,
+                        float a31, float a32, float a33, float a34,
+                        float a41, float a42, float a43, float a44) :
+        Matrix<float, 4, 4>(a11, a12, a13, a14,
+                            a21, a22, a23, a24,
+                            a31, a32, a33, a34,
+                            a41, a42, a43, a44)
+    {
+    }
 
     /*
      *  \func Constructor
@@ -90,6 +97,62 @@ public:
                    const Vector3F& scale,
                    const Vector3F& rotation,
                    const Vector3F& pivot);
+
+    /*
+     *  \func transform
+     *  \brief Creates a transform matrix from smaller pieces using Euler
+     *         angles that already have their sines and cosines calculated.
+     *         Note that this destroys the current matrix.
+     *
+     *  \param position The position of the object
+     *  \param scale The scale of the object
+     *  \param rotation The sines and cosines of the x, y, and z rotations
+     *  \param pivot The pivot point of the object
+     */
+    void transform(const Vector3F& position,
+                   const Vector3F& scale,
+                   const SinCos<Vector3F>& rotation,
+                   const Vector3F& pivot);
+
+    /*
+     *  \func compose
+     *  \brief Sets this matrix to parent * local.
+     *
+     *  \param parent The parent matrix
+     *  \param local The child matrix
+     */
+    void compose(const Matrix4x4& parent, const Matrix4x4& local);
+
+    /*
+     *  \func identity
+     *  \brief Creates an identity matrix at compile time
+     *
+     *  \return The identity matrix
+     */
+    static constexpr Matrix4x4 identity()
+    {
+        return Matrix4x4(1.0f, 0.0f, 0.0f, 0.0f,
+                         0.0f, 1.0f, 0.0f, 0.0f,
+                         0.0f, 0.0f, 1.0f, 0.0f,
+                         0.0f, 0.0f, 0.0f, 1.0f);
+    }
+
+    /*
+     *  \func translation
+     *  \brief Creates a translation matrix at compile time
+     *
+     *  \param x The distance along x
+     *  \param y The distance along y
+     *  \param z The distance along z
+     *  \return The translation matrix
+     */
+    static constexpr Matrix4x4 translation(float x, float y, float z)
+    {
+        return Matrix4x4(1.0f, 0.0f, 0.0f, x,
+                         0.0f, 1.0f, 0.0f, y,
+                         0.0f, 0.0f, 1.0f, z,
+                         0.0f, 0.0f, 0.0f, 1.0f);
+    }
 };
 }
 }
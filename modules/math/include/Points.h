@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2018 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#ifndef __NYRA_MATH_POINTS_H__
+#define __NYRA_MATH_POINTS_H__
+
+#include <vector>
+#include <nyra/math/Vector2.h>
+#include <nyra/math/Vector3.h>
+#include <nyra/math/Matrix3x3.h>
+#include <nyra/math/Matrix4x4.h>
+
+namespace nyra
+{
+namespace math
+{
+/*
+ *  \func transformPoints
+ *  \brief Transforms a batch of 3D points by an affine matrix. The bottom
+ *         row of the matrix is ignored, so each point is treated as
+ *         (x, y, z, 1) with no perspective divide. Points are processed
+ *         four at a time with SSE, and large batches are split across a
+ *         thread pool.
+ *
+ *  \param matrix The transform matrix
+ *  \param input The points to transform
+ *  \param output Where to write the results. This can be the same as
+ *         input, but the ranges must not otherwise overlap.
+ *  \param count The number of points
+ */
+void transformPoints(const Matrix4x4& matrix,
+                     const Vector3F* input,
+                     Vector3F* output,
+                     size_t count);
+
+/*
+ *  \func transformPoints
+ *  \brief Transforms a batch of 2D points by an affine matrix. The bottom
+ *         row of the matrix is ignored, so each point is treated as
+ *         (x, y, 1).
+ *
+ *  \param matrix The transform matrix
+ *  \param input The points to transform
+ *  \param output Where to write the results. This can be the same as
+ *         input, but the ranges must not otherwise overlap.
+ *  \param count The number of points
+ */
+void transformPoints(const Matrix3x3& matrix,
+                     const Vector2F* input,
+                     Vector2F* output,
+                     size_t count);
+
+/*
+ *  \func transformPoints
+ *  \brief Transforms a vector of 3D points by an affine matrix.
+ *
+ *  \param matrix The transform matrix
+ *  \param points The points to transform
+ *  \return The transformed points
+ */
+std::vector<Vector3F> transformPoints(const Matrix4x4& matrix,
+                                      const std::vector<Vector3F>& points);
+
+/*
+ *  \func transformPoints
+ *  \brief Transforms a vector of 2D points by an affine matrix.
+ *
+ *  \param matrix The transform matrix
+ *  \param points The points to transform
+ *  \return The transformed points
+ */
+std::vector<Vector2F> transformPoints(const Matrix3x3& matrix,
+                                      const std::vector<Vector2F>& points);
+}
+}
+
+#endif
@@ -0,0 +1,305 @@
+/*
+ * Copyright (c) 2018 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#ifndef __NYRA_MATH_SIMD_H__
+#define __NYRA_MATH_SIMD_H__
+
+#include <stddef.h>
+
+#ifdef __SSE__
+#include <xmmintrin.h>
+#endif
+
+namespace nyra
+{
+namespace math
+{
+/*
+ *  \class VectorOps
+ *  \brief Element wise kernels used by Vector. The generic version is a
+ *         plain loop over a compile time size, which the compiler is free
+ *         to unroll and vectorize. Four wide floats are specialized to use
+ *         SSE directly.
+ *
+ *  \tparam TypeT The data type of each element
+ *  \tparam SizeT The number of elements
+ */
+template <typename TypeT, size_t SizeT>
+struct VectorOps
+{
+    static void add(TypeT* lhs, const TypeT* rhs)
+    {
+        for (size_t ii = 0; ii < SizeT; ++ii)
+        {
+            lhs[ii] += rhs[ii];
+        }
+    }
+
+    static void subtract(TypeT* lhs, const TypeT* rhs)
+    {
+        for (size_t ii = 0; ii < SizeT; ++ii)
+        {
+            lhs[ii] -= rhs[ii];
+        }
+    }
+
+    static void multiply(TypeT* lhs, const TypeT* rhs)
+    {
+        for (size_t ii = 0; ii < SizeT; ++ii)
+        {
+            lhs[ii] *= rhs[ii];
+        }
+    }
+
+    template <typename ScalarT>
+    static void scale(TypeT* lhs, ScalarT value)
+    {
+        for (size_t ii = 0; ii < SizeT; ++ii)
+        {
+            lhs[ii] = static_cast<TypeT>(lhs[ii] * value);
+        }
+    }
+
+    template <typename ScalarT>
+    static void divide(TypeT* lhs, ScalarT value)
+    {
+        for (size_t ii = 0; ii < SizeT; ++ii)
+        {
+            lhs[ii] = static_cast<TypeT>(lhs[ii] / value);
+        }
+    }
+
+    static TypeT dot(const TypeT* lhs, const TypeT* rhs)
+    {
+        TypeT ret = 0;
+        for (size_t ii = 0; ii < SizeT; ++ii)
+        {
+            ret += lhs[ii] * rhs[ii];
+        }
+        return ret;
+    }
+};
+
+/*
+ *  \class VectorOps
+ *  \brief Unrolled version for two elements so the compiler keeps small
+ *         vectors in registers across a loop.
+ */
+template <typename TypeT>
+struct VectorOps<TypeT, 2>
+{
+    static void add(TypeT* lhs, const TypeT* rhs)
+    {
+        lhs[0] += rhs[0];
+        lhs[1] += rhs[1];
+    }
+
+    static void subtract(TypeT* lhs, const TypeT* rhs)
+    {
+        lhs[0] -= rhs[0];
+        lhs[1] -= rhs[1];
+    }
+
+    static void multiply(TypeT* lhs, const TypeT* rhs)
+    {
+        lhs[0] *= rhs[0];
+        lhs[1] *= rhs[1];
+    }
+
+    template <typename ScalarT>
+    static void scale(TypeT* lhs, ScalarT value)
+    {
+        lhs[0] = static_cast<TypeT>(lhs[0] * value);
+        lhs[1] = static_cast<TypeT>(lhs[1] * value);
+    }
+
+    template <typename ScalarT>
+    static void divide(TypeT* lhs, ScalarT value)
+    {
+        lhs[0] = static_cast<TypeT>(lhs[0] / value);
+        lhs[1] = static_cast<TypeT>(lhs[1] / value);
+    }
+
+    static TypeT dot(const TypeT* lhs, const TypeT* rhs)
+    {
+        return lhs[0] * rhs[0] + lhs[1] * rhs[1];
+    }
+};
+
+/*
+ *  \class VectorOps
+ *  \brief Unrolled version for three elements. Vector3F stays 12 bytes
+ *         so vertex arrays remain packed, and splitting each SSE load and
+ *         store into a pair plus a single float benchmarked slower than
+ *         letting the compiler keep the elements in registers.
+ */
+template <typename TypeT>
+struct VectorOps<TypeT, 3>
+{
+    static void add(TypeT* lhs, const TypeT* rhs)
+    {
+        lhs[0] += rhs[0];
+        lhs[1] += rhs[1];
+        lhs[2] += rhs[2];
+    }
+
+    static void subtract(TypeT* lhs, const TypeT* rhs)
+    {
+        lhs[0] -= rhs[0];
+        lhs[1] -= rhs[1];
+        lhs[2] -= rhs[2];
+    }
+
+    static void multiply(TypeT* lhs, const TypeT* rhs)
+    {
+        lhs[0] *= rhs[0];
+        lhs[1] *= rhs[1];
+        lhs[2] *= rhs[2];
+    }
+
+    template <typename ScalarT>
+    static void scale(TypeT* lhs, ScalarT value)
+    {
+        lhs[0] = static_cast<TypeT>(lhs[0] * value);
+        lhs[1] = static_cast<TypeT>(lhs[1] * value);
+        lhs[2] = static_cast<TypeT>(lhs[2] * value);
+    }
+
+    template <typename ScalarT>
+    static void divide(TypeT* lhs, ScalarT value)
+    {
+        lhs[0] = static_cast<TypeT>(lhs[0] / value);
+        lhs[1] = static_cast<TypeT>(lhs[1] / value);
+        lhs[2] = static_cast<TypeT>(lhs[2] / value);
+    }
+
+    static TypeT dot(const TypeT* lhs, const TypeT* rhs)
+    {
+        return lhs[0] * rhs[0] + lhs[1] * rhs[1] + lhs[2] * rhs[2];
+    }
+};
+
+/*
+ *  \class MatrixOps
+ *  \brief Matrix kernels used by Matrix. Matrices are stored row major.
+ *
+ *  \tparam TypeT The data type of each element
+ *  \tparam Rows The number of rows in the left hand side
+ *  \tparam Cols The number of columns in the left hand side. The right
+ *          hand side is always Cols x Cols.
+ */
+template <typename TypeT, size_t Rows, size_t Cols>
+struct MatrixOps
+{
+    static void multiply(const TypeT* lhs, const TypeT* rhs, TypeT* out)
+    {
+        for (size_t ii = 0; ii < Rows; ++ii)
+        {
+            for (size_t jj = 0; jj < Cols; ++jj)
+            {
+                TypeT sum = 0;
+                for (size_t kk = 0; kk < Cols; ++kk)
+                {
+                    sum += lhs[ii * Cols + kk] * rhs[kk * Cols + jj];
+                }
+                out[ii * Cols + jj] = sum;
+            }
+        }
+    }
+};
+
+#ifdef __SSE__
+/*
+ *  \class VectorOps
+ *  \brief SSE version for four floats. The pointers must be 16 byte
+ *         aligned, which Vector guarantees for this size.
+ */
+template <>
+struct VectorOps<float, 4>
+{
+    static void add(float* lhs, const float* rhs)
+    {
+        _mm_store_ps(lhs, _mm_add_ps(_mm_load_ps(lhs), _mm_load_ps(rhs)));
+    }
+
+    static void subtract(float* lhs, const float* rhs)
+    {
+        _mm_store_ps(lhs, _mm_sub_ps(_mm_load_ps(lhs), _mm_load_ps(rhs)));
+    }
+
+    static void multiply(float* lhs, const float* rhs)
+    {
+        _mm_store_ps(lhs, _mm_mul_ps(_mm_load_ps(lhs), _mm_load_ps(rhs)));
+    }
+
+    static void scale(float* lhs, float value)
+    {
+        _mm_store_ps(lhs, _mm_mul_ps(_mm_load_ps(lhs), _mm_set1_ps(value)));
+    }
+
+    static void divide(float* lhs, float value)
+    {
+        _mm_store_ps(lhs, _mm_div_ps(_mm_load_ps(lhs), _mm_set1_ps(value)));
+    }
+
+    static float dot(const float* lhs, const float* rhs)
+    {
+        const __m128 product = _mm_mul_ps(_mm_load_ps(lhs),
+                                          _mm_load_ps(rhs));
+        const __m128 swapped = _mm_shuffle_ps(product, product,
+                                              _MM_SHUFFLE(2, 3, 0, 1));
+        const __m128 pairs = _mm_add_ps(product, swapped);
+        const __m128 high = _mm_movehl_ps(pairs, pairs);
+        return _mm_cvtss_f32(_mm_add_ss(pairs, high));
+    }
+};
+
+/*
+ *  \class MatrixOps
+ *  \brief SSE version for 4x4 floats. Each output row is the sum of the
+ *         right hand rows scaled by the matching left hand element.
+ */
+template <>
+struct MatrixOps<float, 4, 4>
+{
+    static void multiply(const float* lhs, const float* rhs, float* out)
+    {
+        const __m128 row0 = _mm_load_ps(rhs);
+        const __m128 row1 = _mm_load_ps(rhs + 4);
+        const __m128 row2 = _mm_load_ps(rhs + 8);
+        const __m128 row3 = _mm_load_ps(rhs + 12);
+
+        for (size_t ii = 0; ii < 4; ++ii)
+        {
+            const float* row = lhs + ii * 4;
+            __m128 sum = _mm_mul_ps(_mm_set1_ps(row[0]), row0);
+            sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(row[1]), row1));
+            sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(row[2]), row2));
+            sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(row[3]), row3));
+            _mm_store_ps(out + ii * 4, sum);
+        }
+    }
+};
+#endif
+}
+}
+
+#endif
@@ -0,0 +1,188 @@
+/*
+ * Copyright (c) 2018 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#ifndef __NYRA_MATH_SPATIAL_HASH_H__
+#define __NYRA_MATH_SPATIAL_HASH_H__
+
+#include <stdint.h>
+#include <stddef.h>
+#include <utility>
+#include <vector>
+
+namespace nyra
+{
+namespace math
+{
+/*
+ *  \class SpatialHash
+ *  \brief A uniform grid of buckets for finding boxes near an area or near
+ *         each other. The index is meant to be cleared and refilled every
+ *         step. Queries only look at the cells they touch, so their cost
+ *         grows with the number of nearby boxes rather than the total.
+ *
+ *         Boxes carry a set of group bits that queries can filter on.
+ *         Queries share scratch memory, so they must not run on more than
+ *         one thread at a time.
+ */
+class SpatialHash
+{
+public:
+    /*
+     *  \var ALL_GROUPS
+     *  \brief Group bits that match every box
+     */
+    static const uint32_t ALL_GROUPS = 0xFFFFFFFF;
+
+    /*
+     *  \func Constructor
+     *  \brief Creates an empty index.
+     *
+     *  \param cellSize The width and height of a grid cell. This works
+     *         best when it is a bit larger than a typical box.
+     */
+    explicit SpatialHash(float cellSize);
+
+    /*
+     *  \func clear
+     *  \brief Removes every box.
+     */
+    void clear();
+
+    /*
+     *  \func insert
+     *  \brief Adds a box.
+     *
+     *  \param id The value returned by queries for this box
+     *  \param minX The left edge
+     *  \param minY The top edge
+     *  \param maxX The right edge
+     *  \param maxY The bottom edge
+     *  \param groups The group bits of the box
+     */
+    void insert(uint32_t id,
+                float minX, float minY,
+                float maxX, float maxY,
+                uint32_t groups = 1);
+
+    /*
+     *  \func getSize
+     *  \brief Gets the number of boxes.
+     *
+     *  \return The number of boxes
+     */
+    size_t getSize() const
+    {
+        return mItems.size();
+    }
+
+    /*
+     *  \func queryRect
+     *  \brief Finds the boxes that overlap a rectangle.
+     *
+     *  \param minX The left edge
+     *  \param minY The top edge
+     *  \param maxX The right edge
+     *  \param maxY The bottom edge
+     *  \param results Gets the ids of the boxes. It is not cleared first.
+     *  \param groups Only boxes with one of these bits are returned
+     */
+    void queryRect(float minX, float minY,
+                   float maxX, float maxY,
+                   std::vector<uint32_t>& results,
+                   uint32_t groups = ALL_GROUPS) const;
+
+    /*
+     *  \func queryRadius
+     *  \brief Finds the boxes that overlap a circle.
+     *
+     *  \param x The center x
+     *  \param y The center y
+     *  \param radius The radius
+     *  \param results Gets the ids of the boxes. It is not cleared first.
+     *  \param groups Only boxes with one of these bits are returned
+     */
+    void queryRadius(float x, float y, float radius,
+                     std::vector<uint32_t>& results,
+                     uint32_t groups = ALL_GROUPS) const;
+
+    /*
+     *  \func queryPairs
+     *  \brief Finds every pair of overlapping boxes where one box is in
+     *         groupsA and the other is in groupsB. Each pair is reported
+     *         once.
+     *
+     *  \param groupsA The group bits of the first box in a pair
+     *  \param groupsB The group bits of the second box in a pair
+     *  \param results Gets the id pairs. The first id is always from a box
+     *         in groupsA. It is not cleared first.
+     */
+    void queryPairs(uint32_t groupsA,
+                    uint32_t groupsB,
+                    std::vector<std::pair<uint32_t, uint32_t> >& results) const;
+
+private:
+    struct Item
+    {
+        float minX;
+        float minY;
+        float maxX;
+        float maxY;
+        uint32_t id;
+        uint32_t groups;
+    };
+
+    struct Entry
+    {
+        int32_t x;
+        int32_t y;
+        uint32_t item;
+    };
+
+    int32_t getCell(float value) const;
+
+    size_t getBucket(int32_t x, int32_t y) const;
+
+    void build() const;
+
+    void search(float minX, float minY,
+                float maxX, float maxY,
+                uint32_t groups,
+                const float* circle,
+                std::vector<uint32_t>& results) const;
+
+    const float mCellSize;
+    std::vector<Item> mItems;
+
+    // Entries are sorted by bucket. A bucket's entries run from
+    // mBuckets[bucket] to mBuckets[bucket + 1].
+    mutable std::vector<Entry> mCells;
+    mutable std::vector<Entry> mEntries;
+    mutable std::vector<uint32_t> mBuckets;
+    mutable bool mBuilt;
+
+    // Stops a box that covers several cells from being returned twice
+    mutable std::vector<uint32_t> mMarks;
+    mutable uint32_t mMark;
+};
+}
+}
+
+#endif
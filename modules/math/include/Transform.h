@@ -62,7 +62,8 @@ public:
         mPivot(0.5f),
         mRotation(0.0f),
         mDirty(true),
-        mRebuildMatrix(true)
+        mRebuildMatrix(true),
+        mRebuildSinCos(false)
     {
     }
 
@@ -230,7 +231,7 @@ public:
     void setRotation(RotationT rotation)
     {
         mRotation = normalizeAngle(rotation);
-        setDirty();
+        setRotationDirty();
     }
 
     /*
@@ -311,16 +312,24 @@ public:
     {
         if (mRebuildMatrix)
         {
+            // Sine and cosine are only recalculated when the rotation
+            // changes, not when the object moves or scales.
+            if (mRebuildSinCos)
+            {
+                mSinCos.set(mRotation);
+                mRebuildSinCos = false;
+            }
+
             mLocal.transform(mPosition,
                              mScale,
-                             mRotation,
+                             mSinCos,
                              mPivot * (mSize * -1.0f));
         }
 
         // We could optimize out this matrix transform but you can get into
         // strange situations where it you optimize it out by accident if you
         // change the parent to a stable matrix.
-        mGlobal = mLocal * parent.mGlobal;
+        mGlobal.compose(parent.mGlobal, mLocal);
         mRebuildMatrix = false;
     }
 
@@ -332,6 +341,12 @@ protected:
         mRebuildMatrix = true;
     }
 
+    void setRotationDirty()
+    {
+        mRebuildSinCos = true;
+        setDirty();
+    }
+
     NYRA_SERIALIZE()
 
     template<class ArchiveT>
@@ -348,6 +363,7 @@ protected:
         // Force the dirty flag
         mDirty = true;
         archive & mDirty;
+        mRebuildSinCos = true;
     }
 
     friend std::ostream& operator<<(std::ostream& os,
@@ -372,8 +388,10 @@ protected:
     RotationT mRotation;
     MatrixT mLocal;
     MatrixT mGlobal;
+    SinCos<RotationT> mSinCos;
     bool mDirty;
     bool mRebuildMatrix;
+    bool mRebuildSinCos;
 };
 
 /*
@@ -441,7 +459,7 @@ public:
     void setYaw(float yaw)
     {
         mRotation.y = normalizeAngle(yaw);
-        setDirty();
+        setRotationDirty();
     }
 
     /*
@@ -453,7 +471,7 @@ public:
     void setPitch(float pitch)
     {
         mRotation.x = normalizeAngle(pitch);
-        setDirty();
+        setRotationDirty();
     }
 
     /*
@@ -465,7 +483,7 @@ public:
     void setRoll(float roll)
     {
         mRotation.z = normalizeAngle(roll);
-        setDirty();
+        setRotationDirty();
     }
 };
 }
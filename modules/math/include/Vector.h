@@ -23,50 +23,162 @@
 #define __NYRA_MATH_VECTOR_H__
 
 #include <stddef.h>
+#include <stdint.h>
+#include <cmath>
+#include <ostream>
+#include <type_traits>
 #include <gmtl/Vec.h>
-#include <gmtl/VecOps.h>
+#include <nyra/math/SIMD.h>
 #include <nyra/core/Archive.h>
 
 namespace nyra
 {
 namespace math
 {
+/*
+ *  \class VectorData
+ *  \brief The storage behind a Vector. Two, three, and four element
+ *         vectors get named x, y, z, and w members so the derived vector
+ *         types can expose them without reference members. Larger vectors
+ *         are a plain array.
+ *
+ *  \tparam TypeT The data type for elements.
+ *  \tparam SizeT The number of elements.
+ */
+template <typename TypeT, size_t SizeT>
+struct VectorData
+{
+    TypeT* data()
+    {
+        return mData;
+    }
+
+    const TypeT* data() const
+    {
+        return mData;
+    }
+
+protected:
+    TypeT mData[SizeT];
+};
+
+template <typename TypeT>
+struct VectorData<TypeT, 2>
+{
+    TypeT* data()
+    {
+        return &x;
+    }
+
+    const TypeT* data() const
+    {
+        return &x;
+    }
+
+    TypeT x;
+    TypeT y;
+};
+
+template <typename TypeT>
+struct VectorData<TypeT, 3>
+{
+    TypeT* data()
+    {
+        return &x;
+    }
+
+    const TypeT* data() const
+    {
+        return &x;
+    }
+
+    TypeT x;
+    TypeT y;
+    TypeT z;
+};
+
+template <typename TypeT>
+struct VectorData<TypeT, 4>
+{
+    TypeT* data()
+    {
+        return &x;
+    }
+
+    const TypeT* data() const
+    {
+        return &x;
+    }
+
+    TypeT x;
+    TypeT y;
+    TypeT z;
+    TypeT w;
+};
+
+/*
+ *  \class VectorAlignment
+ *  \brief Vectors that fill whole 16 byte SIMD registers are aligned to
+ *         16 bytes. Everything else keeps its natural alignment so arrays
+ *         of Vector3F stay tightly packed for vertex buffers.
+ */
+template <typename TypeT, size_t SizeT>
+struct VectorAlignment
+{
+    static const size_t value =
+            (sizeof(TypeT) * SizeT) % 16 == 0 ? 16 : alignof(TypeT);
+};
+
 /*
  *  \class Vector
- *  \brief A two dimensional vector. This can be used for 2D position or scale.
- *         Common types are typenamed for easier use.
+ *  \brief A fixed size vector of any type. This has no virtual functions
+ *         and is trivially copyable, so arrays of vectors can be copied
+ *         with memcpy and handed directly to SIMD code or the GPU.
  *
  *  \tparam TypeT The data type for elements.
+ *  \tparam SizeT The number of elements.
  */
 template <typename TypeT, size_t SizeT>
-class Vector
+class alignas(VectorAlignment<TypeT, SizeT>::value) Vector :
+        public VectorData<TypeT, SizeT>
 {
 public:
     /*
-     *  \func Constructor
-     *  \brief Sets up a zero'd vector
+     *  \type ScalarT
+     *  \brief The type used when scaling by a double. Floating point
+     *         vectors scale in their own precision instead of promoting
+     *         every element to double. Integer vectors still scale through
+     *         double so fractional values behave as they always have.
      */
-    Vector() = default;
+    typedef typename std::conditional<std::is_floating_point<TypeT>::value,
+                                      TypeT,
+                                      double>::type ScalarT;
 
     /*
      *  \func Constructor
-     *  \brief Constructs a vector from another vector. This can be used
-     *         to copy from 3rd party vectors.
-     *
-     *  \tparam VectorT The vector type to copy from. This must have public
-     *          x and y members.
-     *  \param vector The vector to copy.
+     *  \brief Sets up a zero'd vector
      */
-    Vector(const Vector<TypeT, SizeT>& vector) :
-        mVec(vector.mVec)
+    Vector()
     {
+        for (size_t ii = 0; ii < SizeT; ++ii)
+        {
+            (*this)[ii] = 0;
+        }
     }
 
     /*
-     *  \func Destructor
-     *  \brief Necessary for inheritance
+     *  \func Constructor
+     *  \brief Copies a GMTL vector.
+     *
+     *  \param vector The GMTL vector to copy.
      */
-    virtual ~Vector() = default;
+    explicit Vector(const gmtl::Vec<TypeT, SizeT>& vector)
+    {
+        for (size_t ii = 0; ii < SizeT; ++ii)
+        {
+            (*this)[ii] = vector[ii];
+        }
+    }
 
     /*
      *  \func Equality Operator
@@ -77,7 +189,14 @@ public:
      */
     bool operator==(const Vector<TypeT, SizeT>& other) const
     {
-        return mVec == other.mVec;
+        for (size_t ii = 0; ii < SizeT; ++ii)
+        {
+            if ((*this)[ii] != other[ii])
+            {
+                return false;
+            }
+        }
+        return true;
     }
 
     /*
@@ -101,7 +220,7 @@ public:
      */
     Vector<TypeT, SizeT>& operator+=(const Vector<TypeT, SizeT>& other)
     {
-        mVec += other.mVec;
+        VectorOps<TypeT, SizeT>::add(this->data(), other.data());
         return *this;
     }
 
@@ -114,7 +233,7 @@ public:
      */
     Vector<TypeT, SizeT>& operator-=(const Vector<TypeT, SizeT>& other)
     {
-        mVec -= other.mVec;
+        VectorOps<TypeT, SizeT>::subtract(this->data(), other.data());
         return *this;
     }
 
@@ -127,7 +246,8 @@ public:
      */
     Vector<TypeT, SizeT>& operator*=(double value)
     {
-        mVec *= value;
+        VectorOps<TypeT, SizeT>::scale(this->data(),
+                                       static_cast<ScalarT>(value));
         return *this;
     }
 
@@ -140,10 +260,7 @@ public:
      */
     Vector<TypeT, SizeT>& operator*=(const Vector<TypeT, SizeT>& value)
     {
-        for (size_t ii = 0; ii < SizeT; ++ii)
-        {
-            (*this)[ii] *= value[ii];
-        }
+        VectorOps<TypeT, SizeT>::multiply(this->data(), value.data());
         return *this;
     }
 
@@ -156,7 +273,8 @@ public:
      */
     Vector<TypeT, SizeT>& operator/=(double value)
     {
-        mVec /= value;
+        VectorOps<TypeT, SizeT>::divide(this->data(),
+                                        static_cast<ScalarT>(value));
         return *this;
     }
 
@@ -267,7 +385,7 @@ public:
      */
     const TypeT& operator[](size_t index) const
     {
-        return mVec[index];
+        return this->data()[index];
     }
 
     /*
@@ -279,7 +397,7 @@ public:
      */
     TypeT& operator[](size_t index)
     {
-        return mVec[index];
+        return this->data()[index];
     }
 
     /*
@@ -293,7 +411,7 @@ public:
         TypeT ret = 0;
         for (size_t ii = 0; ii < SizeT; ++ii)
         {
-            ret += mVec[ii];
+            ret += (*this)[ii];
         }
         return ret;
     }
@@ -306,10 +424,10 @@ public:
      */
     TypeT product() const
     {
-        TypeT ret = mVec[0];
+        TypeT ret = (*this)[0];
         for (size_t ii = 1; ii < SizeT; ++ii)
         {
-            ret *= mVec[ii];
+            ret *= (*this)[ii];
         }
         return ret;
     }
@@ -322,7 +440,7 @@ public:
      */
     TypeT sumSquares() const
     {
-        return gmtl::lengthSquared(mVec);
+        return VectorOps<TypeT, SizeT>::dot(this->data(), this->data());
     }
 
     /*
@@ -335,7 +453,7 @@ public:
      */
     double length() const
     {
-        return gmtl::length(mVec);
+        return std::sqrt(lengthSquared());
     }
 
     /*
@@ -348,7 +466,7 @@ public:
      */
     double lengthSquared() const
     {
-        return gmtl::lengthSquared(mVec);
+        return sumSquares();
     }
 
     /*
@@ -357,9 +475,10 @@ public:
      */
     void normalize()
     {
-        if (length() >  0.0)
+        const double len = length();
+        if (len >  0.0)
         {
-            gmtl::normalize(mVec);
+            (*this) /= len;
         }
     }
 
@@ -371,29 +490,24 @@ public:
      */
     double dot(const Vector<TypeT, SizeT>& other) const
     {
-        return gmtl::dot(mVec, other.mVec);
+        return VectorOps<TypeT, SizeT>::dot(this->data(), other.data());
     }
 
     /*
      *  \func getNative
-     *  \brief Get the underlying GMTL vector
+     *  \brief Gets a copy of the vector as a GMTL vector. Vectors no longer
+     *         store a GMTL vector so this cannot be modified in place.
      *
      *  \return The GMTL vector
      */
-    const gmtl::Vec<TypeT, SizeT>& getNative() const
+    gmtl::Vec<TypeT, SizeT> getNative() const
     {
-        return mVec;
-    }
-
-    /*
-     *  \func getNative
-     *  \brief Get the underlying GMTL vector
-     *
-     *  \return The GMTL vector
-     */
-    gmtl::Vec<TypeT, SizeT>& getNative()
-    {
-        return mVec;
+        gmtl::Vec<TypeT, SizeT> ret;
+        for (size_t ii = 0; ii < SizeT; ++ii)
+        {
+            ret[ii] = (*this)[ii];
+        }
+        return ret;
     }
 
     /*
@@ -415,7 +529,7 @@ private:
     {
         for (size_t ii = 0; ii < SizeT; ++ii)
         {
-            archive & BOOST_SERIALIZATION_NVP(mVec[ii]);
+            archive & BOOST_SERIALIZATION_NVP((*this)[ii]);
         }
     }
 
@@ -432,9 +546,6 @@ private:
         }
         return os;
     }
-
-protected:
-    gmtl::Vec<TypeT, SizeT> mVec;
 };
 }
 }
@@ -44,11 +44,7 @@ public:
      *  \func Constructor
      *  \brief Creates a default Vector2
      */
-    Vector2() :
-        x(this->mVec[0]),
-        y(this->mVec[1])
-    {
-    }
+    Vector2() = default;
 
     /*
      *  \func Constructor
@@ -92,47 +88,19 @@ public:
         y = static_cast<TypeT>(vector[1]);
     }
 
-    /*
-     *  \func Constructor
-     *  \brief Creates a Vector2 from another Vector of the same type. This is
-     *         necessary because the templated version does not replace the default.
-     *
-     *  \param vector The vector to copy
-     */
-    Vector2(const Vector2<TypeT>& vector) :
-        Vector2()
-    {
-        x = vector.x;
-        y = vector.y;
-    }
-
-    /*
-     *  \func Assignment Operator
-     *  \brief Assigns one vector to another
-     *
-     *  \param other The vector to assign
-     *  \return The assigned vector
-     */
-    Vector2<TypeT>& operator=(const Vector2<TypeT>& other)
-    {
-        x = other.x;
-        y = other.y;
-        return *this;
-    }
-
     /*
      *  \var x
      *  \brief The x axis. By convention this can also mean either
      *         columns or width.
      */
-    TypeT& x;
+    using VectorData<TypeT, 2>::x;
 
     /*
      *  \var y
      *  \brief The y axis. By convention this can also mean either
      *         rows or height.
      */
-    TypeT& y;
+    using VectorData<TypeT, 2>::y;
 
 private:
     friend std::ostream& operator<<(std::ostream& os,
@@ -43,12 +43,7 @@ public:
      *  \func Constructor
      *  \brief Creates a default Vector3
      */
-    Vector3() :
-        x(this->mVec[0]),
-        y(this->mVec[1]),
-        z(this->mVec[2])
-    {
-    }
+    Vector3() = default;
 
     /*
      *  \func Constructor
@@ -96,53 +91,23 @@ public:
         z = static_cast<TypeT>(vector[2]);
     }
 
-    /*
-     *  \func Constructor
-     *  \brief Creates a Vector3 from another Vector of the same type. This is
-     *         necessary because the templated version does not replace the default.
-     *
-     *  \param vector The vector to copy
-     */
-    Vector3(const Vector3<TypeT>& vector) :
-        Vector3()
-    {
-        x = vector.x;
-        y = vector.y;
-        z = vector.z;
-    }
-
-    /*
-     *  \func Assignment Operator
-     *  \brief Assigns one vector to another
-     *
-     *  \param other The vector to assign
-     *  \return The assigned vector
-     */
-    Vector3<TypeT>& operator=(const Vector3<TypeT>& other)
-    {
-        x = other.x;
-        y = other.y;
-        z = other.z;
-        return *this;
-    }
-
     /*
      *  \var x
      *  \brief The x axis.
      */
-    TypeT& x;
+    using VectorData<TypeT, 3>::x;
 
     /*
      *  \var y
      *  \brief The y axis.
      */
-    TypeT& y;
+    using VectorData<TypeT, 3>::y;
 
     /*
      *  \var z
      *  \brief The z axis.
      */
-    TypeT& z;
+    using VectorData<TypeT, 3>::z;
 
 private:
     friend std::ostream& operator<<(std::ostream& os,
@@ -0,0 +1,141 @@
+/*
+ * Copyright (c) 2018 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#ifndef __NYRA_MATH_VECTOR_4_H__
+#define __NYRA_MATH_VECTOR_4_H__
+
+#include <nyra/math/Vector.h>
+
+namespace nyra
+{
+namespace math
+{
+/*
+ *  \class Vector4
+ *  \brief A four dimensional vector. This is mostly useful for homogeneous
+ *         coordinates and colors. Four float vectors are 16 byte aligned
+ *         and use SSE for their arithmetic. Common types are typenamed for
+ *         easier use.
+ *
+ *  \tparam TypeT The data type for elements.
+ */
+template <typename TypeT>
+class Vector4 : public Vector<TypeT, 4>
+{
+public:
+    /*
+     *  \func Constructor
+     *  \brief Creates a default Vector4
+     */
+    Vector4() = default;
+
+    /*
+     *  \func Constructor
+     *  \brief Sets up a vector with a single value set to every element.
+     *
+     *  \param value The desired starting value.
+     */
+    Vector4(const TypeT& value) :
+        Vector4()
+    {
+        x = value;
+        y = value;
+        z = value;
+        w = value;
+    }
+
+    /*
+     *  \func Constructor
+     *  \brief Creates a Vector4 from x, y, z, and w values
+     *
+     *  \param x The desired x value
+     *  \param y The desired y value
+     *  \param z The desired z value
+     *  \param w The desired w value
+     */
+    Vector4(const TypeT& x, const TypeT& y, const TypeT& z, const TypeT& w) :
+        Vector4()
+    {
+        this->x = x;
+        this->y = y;
+        this->z = z;
+        this->w = w;
+    }
+
+    /*
+     *  \func Constructor
+     *  \brief Creates a Vector4 from a Vector base object
+     *
+     *  \tparam OtherT The data type of the other vector
+     *  \param vector The vector to copy
+     */
+    template <typename OtherT>
+    Vector4(const Vector<OtherT, 4>& vector) :
+        Vector4()
+    {
+        x = static_cast<TypeT>(vector[0]);
+        y = static_cast<TypeT>(vector[1]);
+        z = static_cast<TypeT>(vector[2]);
+        w = static_cast<TypeT>(vector[3]);
+    }
+
+    /*
+     *  \var x
+     *  \brief The x axis.
+     */
+    using VectorData<TypeT, 4>::x;
+
+    /*
+     *  \var y
+     *  \brief The y axis.
+     */
+    using VectorData<TypeT, 4>::y;
+
+    /*
+     *  \var z
+     *  \brief The z axis.
+     */
+    using VectorData<TypeT, 4>::z;
+
+    /*
+     *  \var w
+     *  \brief The w axis.
+     */
+    using VectorData<TypeT, 4>::w;
+
+private:
+    friend std::ostream& operator<<(std::ostream& os,
+                                    const Vector4<TypeT>& vector)
+    {
+        os << "x=" << vector.x << " y=" << vector.y << " z=" << vector.z
+           << " w=" << vector.w;
+        return os;
+    }
+};
+
+typedef Vector4<float> Vector4F;
+typedef Vector4<int32_t> Vector4I;
+typedef Vector4<uint32_t> Vector4U;
+typedef Vector4<double> Vector4D;
+}
+}
+
+#endif
@@ -0,0 +1,193 @@
+/*
+ * Copyright (c) 2018 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#include <algorithm>
+#include <limits>
+#include <nyra/math/FlowField.h>
+
+namespace
+{
+//===========================================================================//
+static const float SQRT_2 = 1.41421356f;
+// Each direction is followed by its opposite
+static const int32_t DX[] = {1, -1, 0, 0, 1, -1, 1, -1};
+static const int32_t DY[] = {0, 0, 1, -1, 1, -1, -1, 1};
+static const float COST[] = {1.0f, 1.0f, 1.0f, 1.0f,
+                             SQRT_2, SQRT_2, SQRT_2, SQRT_2};
+
+// Cells at the goal or without a path have no direction
+static const uint8_t NONE = 8;
+
+// Keeps rounding noise from counting as a shorter path
+static const float EPSILON = 0.0001f;
+
+// Rebuild from scratch once the offset is large enough to cost precision
+static const float MAX_OFFSET = 4096.0f;
+}
+
+namespace nyra
+{
+namespace math
+{
+//===========================================================================//
+const float FlowField::UNREACHABLE = std::numeric_limits<float>::max();
+
+//===========================================================================//
+FlowField::FlowField(const GridGraph& grid) :
+    mGrid(grid),
+    mGoal(grid.getWidth() * grid.getHeight()),
+    mOffset(0.0f),
+    mCosts(grid.getWidth() * grid.getHeight(), UNREACHABLE),
+    mDirections(grid.getWidth() * grid.getHeight(), NONE)
+{
+}
+
+//===========================================================================//
+void FlowField::setGoal(size_t goal)
+{
+    // Callers set the goal every tick and it rarely moves
+    if (goal == mGoal)
+    {
+        return;
+    }
+
+    const size_t width = mGrid.getWidth();
+    if (goal >= mCosts.size() || !hasPath(goal))
+    {
+        mGoal = goal;
+        rebuild();
+        return;
+    }
+
+    const size_t dx = goal % width > mGoal % width ?
+            goal % width - mGoal % width : mGoal % width - goal % width;
+    const size_t dy = goal / width > mGoal / width ?
+            goal / width - mGoal / width : mGoal / width - goal / width;
+    if (dx > 1 || dy > 1 || mOffset > MAX_OFFSET)
+    {
+        mGoal = goal;
+        rebuild();
+        return;
+    }
+
+    // The old goal now steps onto the new one. Everything else keeps its
+    // direction unless it gets closer, and those cells are found by
+    // spreading out from the new goal.
+    for (uint8_t dir = 0; dir < 8; ++dir)
+    {
+        if (mGoal % width + DX[dir] == goal % width &&
+            mGoal / width + DY[dir] == goal / width)
+        {
+            mDirections[mGoal] = dir;
+        }
+    }
+    mOffset += (dx + dy == 2) ? SQRT_2 : 1.0f;
+    mGoal = goal;
+    mCosts[goal] = -mOffset;
+    mDirections[goal] = NONE;
+    mOpen.clear();
+    const Entry entry = {mCosts[goal], static_cast<uint32_t>(goal)};
+    mOpen.push_back(entry);
+    propagate();
+}
+
+//===========================================================================//
+void FlowField::rebuild()
+{
+    mOffset = 0.0f;
+    std::fill(mCosts.begin(), mCosts.end(), UNREACHABLE);
+    std::fill(mDirections.begin(), mDirections.end(), NONE);
+    mOpen.clear();
+
+    if (mGoal < mCosts.size() && mGrid.isWalkable(mGoal))
+    {
+        mCosts[mGoal] = 0.0f;
+        const Entry entry = {0.0f, static_cast<uint32_t>(mGoal)};
+        mOpen.push_back(entry);
+        propagate();
+    }
+}
+
+//===========================================================================//
+size_t FlowField::getNext(size_t cell) const
+{
+    if (cell >= mDirections.size() || mDirections[cell] == NONE)
+    {
+        return cell;
+    }
+
+    const uint8_t dir = mDirections[cell];
+    return (cell / mGrid.getWidth() + DY[dir]) * mGrid.getWidth() +
+           cell % mGrid.getWidth() + DX[dir];
+}
+
+//===========================================================================//
+void FlowField::propagate()
+{
+    const size_t width = mGrid.getWidth();
+    const size_t height = mGrid.getHeight();
+    const auto compare = [](const Entry& a, const Entry& b)
+    {
+        return a.cost > b.cost;
+    };
+
+    while (!mOpen.empty())
+    {
+        std::pop_heap(mOpen.begin(), mOpen.end(), compare);
+        const Entry current = mOpen.back();
+        mOpen.pop_back();
+
+        // Skip copies left behind when a cell was improved again
+        if (current.cost > mCosts[current.index])
+        {
+            continue;
+        }
+
+        const size_t x = current.index % width;
+        const size_t y = current.index / width;
+        for (uint8_t dir = 0; dir < 8; ++dir)
+        {
+            const size_t nextX = x + DX[dir];
+            const size_t nextY = y + DY[dir];
+            if (nextX >= width || nextY >= height)
+            {
+                continue;
+            }
+
+            const size_t next = nextY * width + nextX;
+            const float cost = current.cost + COST[dir];
+            if (!mGrid.isWalkable(next) || cost >= mCosts[next] - EPSILON)
+            {
+                continue;
+            }
+
+            // Flipping the low bit gives the opposite direction, which
+            // points back at the current cell.
+            mCosts[next] = cost;
+            mDirections[next] = dir ^ 1;
+            const Entry entry = {cost, static_cast<uint32_t>(next)};
+            mOpen.push_back(entry);
+            std::push_heap(mOpen.begin(), mOpen.end(), compare);
+        }
+    }
+}
+}
+}
@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) 2018 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#include <cmath>
+#include <nyra/math/Frustum.h>
+
+namespace nyra
+{
+namespace math
+{
+//===========================================================================//
+Frustum::Frustum()
+{
+    // A zero normal with a positive offset is in front of every point
+    for (size_t ii = 0; ii < 6; ++ii)
+    {
+        mPlanes[ii] = Vector4F(0.0f, 0.0f, 0.0f, 1.0f);
+    }
+}
+
+//===========================================================================//
+Frustum::Frustum(const Matrix4x4& viewProjection)
+{
+    // Each clip plane is the last row plus or minus one of the others.
+    for (size_t ii = 0; ii < 3; ++ii)
+    {
+        for (size_t jj = 0; jj < 4; ++jj)
+        {
+            const float w = viewProjection(3, jj);
+            const float value = viewProjection(ii, jj);
+            mPlanes[ii * 2][jj] = w + value;
+            mPlanes[ii * 2 + 1][jj] = w - value;
+        }
+    }
+
+    for (size_t ii = 0; ii < 6; ++ii)
+    {
+        Vector4F& plane = mPlanes[ii];
+        const float length = std::sqrt(plane.x * plane.x +
+                                       plane.y * plane.y +
+                                       plane.z * plane.z);
+        if (length > 0.0f)
+        {
+            plane /= length;
+        }
+    }
+}
+
+//===========================================================================//
+float Frustum::distance(size_t plane, const Vector3F& point) const
+{
+    const Vector4F& p = mPlanes[plane];
+    return p.x * point.x + p.y * point.y + p.z * point.z + p.w;
+}
+
+//===========================================================================//
+bool Frustum::contains(const Vector3F& point) const
+{
+    for (size_t ii = 0; ii < 6; ++ii)
+    {
+        if (distance(ii, point) < 0.0f)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+//===========================================================================//
+bool Frustum::intersects(const AABB3F& box) const
+{
+    for (size_t ii = 0; ii < 6; ++ii)
+    {
+        // Only the corner furthest along the plane normal matters. If that
+        // one is behind the plane the whole box is.
+        const Vector4F& plane = mPlanes[ii];
+        const Vector3F corner(plane.x >= 0.0f ? box.max.x : box.min.x,
+                              plane.y >= 0.0f ? box.max.y : box.min.y,
+                              plane.z >= 0.0f ? box.max.z : box.min.z);
+        if (distance(ii, corner) < 0.0f)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+//===========================================================================//
+void Frustum::cull(const AABB3F* boxes,
+                   size_t count,
+                   std::vector<size_t>& visible) const
+{
+    visible.clear();
+    for (size_t ii = 0; ii < count; ++ii)
+    {
+        if (intersects(boxes[ii]))
+        {
+            visible.push_back(ii);
+        }
+    }
+}
+}
+}
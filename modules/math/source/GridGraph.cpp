@@ -0,0 +1,231 @@
+/*
+ * Copyright (c) 2018 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#include <algorithm>
+#include <cmath>
+#include <nyra/math/GridGraph.h>
+
+namespace
+{
+//===========================================================================//
+static const float SQRT_2 = 1.41421356f;
+static const int32_t DX[] = {1, -1, 0, 0, 1, 1, -1, -1};
+static const int32_t DY[] = {0, 0, 1, -1, 1, -1, 1, -1};
+static const float COST[] = {1.0f, 1.0f, 1.0f, 1.0f,
+                             SQRT_2, SQRT_2, SQRT_2, SQRT_2};
+
+//===========================================================================//
+inline float octile(size_t x1, size_t y1, size_t x2, size_t y2)
+{
+    const float dx = x1 > x2 ? x1 - x2 : x2 - x1;
+    const float dy = y1 > y2 ? y1 - y2 : y2 - y1;
+    return dx + dy + (SQRT_2 - 2.0f) * std::min(dx, dy);
+}
+}
+
+namespace nyra
+{
+namespace math
+{
+//===========================================================================//
+GridGraph::Search::Search() :
+    mGeneration(0)
+{
+}
+
+//===========================================================================//
+uint32_t GridGraph::Search::begin(size_t numNodes)
+{
+    if (mStates.size() != numNodes)
+    {
+        const State empty = {0.0f, 0, 0, 0};
+        mStates.assign(numNodes, empty);
+        mGeneration = 0;
+    }
+
+    // Stamps from older searches are ignored, so nothing needs clearing
+    // until the counter wraps around.
+    ++mGeneration;
+    if (mGeneration == 0)
+    {
+        for (State& state : mStates)
+        {
+            state.visited = 0;
+            state.closed = 0;
+        }
+        mGeneration = 1;
+    }
+
+    mOpen.clear();
+    return mGeneration;
+}
+
+//===========================================================================//
+GridGraph::GridGraph(size_t width,
+                     size_t height) :
+    mWidth(width),
+    mHeight(height),
+    mBits((width * height + 63) / 64, 0)
+{
+}
+
+//===========================================================================//
+void GridGraph::setWalkable(size_t x, size_t y, bool walkable)
+{
+    const size_t index = getIndex(x, y);
+    const uint64_t mask = static_cast<uint64_t>(1) << (index & 63);
+    if (walkable)
+    {
+        mBits[index >> 6] |= mask;
+    }
+    else
+    {
+        mBits[index >> 6] &= ~mask;
+    }
+}
+
+//===========================================================================//
+PathResults<size_t> GridGraph::getPath(size_t start,
+                                       size_t end,
+                                       Search& search) const
+{
+    return getPath(start, end, 0, 0, mWidth, mHeight, search);
+}
+
+//===========================================================================//
+PathResults<size_t> GridGraph::getPath(size_t start,
+                                       size_t end,
+                                       size_t x0,
+                                       size_t y0,
+                                       size_t x1,
+                                       size_t y1,
+                                       Search& search) const
+{
+    PathResults<size_t> results;
+    const size_t numNodes = mWidth * mHeight;
+    x1 = std::min(x1, mWidth);
+    y1 = std::min(y1, mHeight);
+    const auto inside = [&](size_t index)
+    {
+        const size_t x = index % mWidth;
+        const size_t y = index / mWidth;
+        return x >= x0 && x < x1 && y >= y0 && y < y1;
+    };
+
+    if (start >= numNodes || end >= numNodes ||
+        !isWalkable(start) || !isWalkable(end) ||
+        !inside(start) || !inside(end))
+    {
+        return results;
+    }
+
+    const uint32_t generation = search.begin(numNodes);
+    Search::State* const states = &search.mStates[0];
+    std::vector<Search::Node>& open = search.mOpen;
+
+    // Lowest total first. Ties go to the node closest to the goal.
+    const auto compare = [](const Search::Node& a, const Search::Node& b)
+    {
+        return a.total > b.total ||
+               (a.total == b.total && a.heuristic > b.heuristic);
+    };
+
+    const size_t endX = end % mWidth;
+    const size_t endY = end / mWidth;
+
+    states[start].cost = 0.0f;
+    states[start].parent = start;
+    states[start].visited = generation;
+    const float startHeuristic = octile(start % mWidth, start / mWidth,
+                                        endX, endY);
+    Search::Node first = {startHeuristic, startHeuristic,
+                          static_cast<uint32_t>(start)};
+    open.push_back(first);
+
+    while (!open.empty())
+    {
+        std::pop_heap(open.begin(), open.end(), compare);
+        const uint32_t current = open.back().index;
+        open.pop_back();
+
+        // The heap can hold stale copies of a node that was since reached
+        // more cheaply. Only the first one off the heap counts.
+        Search::State& state = states[current];
+        if (state.closed == generation)
+        {
+            continue;
+        }
+        state.closed = generation;
+
+        if (current == end)
+        {
+            for (uint32_t node = current; ; node = states[node].parent)
+            {
+                results.path.push_back(node);
+                if (states[node].parent == node)
+                {
+                    break;
+                }
+            }
+            std::reverse(results.path.begin(), results.path.end());
+            results.distance = state.cost;
+            return results;
+        }
+
+        const size_t x = current % mWidth;
+        const size_t y = current / mWidth;
+        for (size_t dir = 0; dir < 8; ++dir)
+        {
+            const size_t nextX = x + DX[dir];
+            const size_t nextY = y + DY[dir];
+
+            // Stepping off the left or top wraps around to a huge value
+            if (nextX < x0 || nextX >= x1 || nextY < y0 || nextY >= y1)
+            {
+                continue;
+            }
+
+            const uint32_t next = nextY * mWidth + nextX;
+            Search::State& nextState = states[next];
+            if (!isWalkable(next) || nextState.closed == generation)
+            {
+                continue;
+            }
+
+            const float nextCost = state.cost + COST[dir];
+            if (nextState.visited != generation || nextCost < nextState.cost)
+            {
+                nextState.visited = generation;
+                nextState.cost = nextCost;
+                nextState.parent = current;
+
+                const float heuristic = octile(nextX, nextY, endX, endY);
+                Search::Node node = {nextCost + heuristic, heuristic, next};
+                open.push_back(node);
+                std::push_heap(open.begin(), open.end(), compare);
+            }
+        }
+    }
+
+    return results;
+}
+}
+}
@@ -0,0 +1,899 @@
+/*
+ * Copyright (c) 2018 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#include <algorithm>
+#include <stdexcept>
+#include <nyra/math/HierarchicalGraph.h>
+
+namespace
+{
+//===========================================================================//
+static const float SQRT_2 = 1.41421356f;
+static const int32_t DX[] = {1, -1, 0, 0, 1, 1, -1, -1};
+static const int32_t DY[] = {0, 0, 1, -1, 1, -1, 1, -1};
+static const float COST[] = {1.0f, 1.0f, 1.0f, 1.0f,
+                             SQRT_2, SQRT_2, SQRT_2, SQRT_2};
+
+// Runs of open cells along a border at least this long get an entrance at
+// each end instead of one in the middle.
+static const size_t LONG_ENTRANCE = 6;
+
+//===========================================================================//
+inline float octile(size_t x1, size_t y1, size_t x2, size_t y2)
+{
+    const float dx = x1 > x2 ? x1 - x2 : x2 - x1;
+    const float dy = y1 > y2 ? y1 - y2 : y2 - y1;
+    return dx + dy + (SQRT_2 - 2.0f) * std::min(dx, dy);
+}
+
+//===========================================================================//
+inline float stepCost(size_t from, size_t to, size_t width)
+{
+    return from % width != to % width && from / width != to / width ?
+            SQRT_2 : 1.0f;
+}
+
+//===========================================================================//
+inline uint64_t makeKey(uint32_t a, uint32_t b)
+{
+    return (static_cast<uint64_t>(a) << 32) | b;
+}
+}
+
+namespace nyra
+{
+namespace math
+{
+//===========================================================================//
+HierarchicalGraph::Search::Scratch::Scratch() :
+    generation(0)
+{
+}
+
+//===========================================================================//
+uint32_t HierarchicalGraph::Search::Scratch::begin(size_t size)
+{
+    if (states.size() < size)
+    {
+        const State empty = {0.0f, 0, 0, 0};
+        states.assign(size, empty);
+        generation = 0;
+    }
+
+    ++generation;
+    if (generation == 0)
+    {
+        for (State& state : states)
+        {
+            state.visited = 0;
+            state.closed = 0;
+        }
+        generation = 1;
+    }
+
+    open.clear();
+    return generation;
+}
+
+//===========================================================================//
+HierarchicalGraph::Search::Search()
+{
+}
+
+//===========================================================================//
+HierarchicalGraph::HierarchicalGraph(const GridGraph& grid,
+                                     size_t clusterSize) :
+    mGrid(grid),
+    mClusterSize(std::max<size_t>(clusterSize, 2)),
+    mClustersX((grid.getWidth() + mClusterSize - 1) / mClusterSize),
+    mClustersY((grid.getHeight() + mClusterSize - 1) / mClusterSize),
+    mClusterBorders(mClustersX * mClustersY),
+    mClusterNodes(mClustersX * mClustersY),
+    mDirty(mClustersX * mClustersY, true),
+    mHasDirty(true),
+    mPathCache(mClustersX * mClustersY)
+{
+    for (size_t y = 0; y < mClustersY; ++y)
+    {
+        for (size_t x = 0; x < mClustersX; ++x)
+        {
+            const size_t cluster = y * mClustersX + x;
+            const size_t right = cluster + 1;
+            const size_t below = cluster + mClustersX;
+
+            if (x + 1 < mClustersX)
+            {
+                addBorder(VERTICAL, cluster, right,
+                          std::vector<size_t>{cluster, right});
+            }
+
+            if (y + 1 < mClustersY)
+            {
+                addBorder(HORIZONTAL, cluster, below,
+                          std::vector<size_t>{cluster, below});
+            }
+
+            // A diagonal step across a cluster corner depends on the two
+            // cells beside it, so all four clusters share these borders.
+            if (x + 1 < mClustersX && y + 1 < mClustersY)
+            {
+                const std::vector<size_t> corner{
+                        cluster, right, below, below + 1};
+                addBorder(DIAGONAL, cluster, below + 1, corner);
+                addBorder(ANTI_DIAGONAL, right, below, corner);
+            }
+        }
+    }
+
+    update();
+}
+
+//===========================================================================//
+size_t HierarchicalGraph::getNumNodes() const
+{
+    return mNodes.size() - mFreeNodes.size();
+}
+
+//===========================================================================//
+size_t HierarchicalGraph::getCluster(size_t cell) const
+{
+    const size_t x = cell % mGrid.getWidth();
+    const size_t y = cell / mGrid.getWidth();
+    return (y / mClusterSize) * mClustersX + (x / mClusterSize);
+}
+
+//===========================================================================//
+void HierarchicalGraph::getBounds(size_t cluster,
+                                  size_t& x0, size_t& y0,
+                                  size_t& x1, size_t& y1) const
+{
+    x0 = (cluster % mClustersX) * mClusterSize;
+    y0 = (cluster / mClustersX) * mClusterSize;
+    x1 = std::min(x0 + mClusterSize, mGrid.getWidth());
+    y1 = std::min(y0 + mClusterSize, mGrid.getHeight());
+}
+
+//===========================================================================//
+void HierarchicalGraph::addBorder(BorderType type,
+                                  size_t first,
+                                  size_t second,
+                                  const std::vector<size_t>& clusters)
+{
+    Border border;
+    border.type = type;
+    border.first = first;
+    border.second = second;
+    mBorders.push_back(border);
+
+    for (size_t cluster : clusters)
+    {
+        mClusterBorders[cluster].push_back(mBorders.size() - 1);
+    }
+}
+
+//===========================================================================//
+uint32_t HierarchicalGraph::addNode(size_t cell, size_t cluster)
+{
+    const Node node = {static_cast<uint32_t>(cell),
+                       static_cast<uint32_t>(cluster),
+                       0, 0.0f};
+    if (!mFreeNodes.empty())
+    {
+        const uint32_t index = mFreeNodes.back();
+        mFreeNodes.pop_back();
+        mNodes[index] = node;
+        return index;
+    }
+
+    mNodes.push_back(node);
+    mEdges.push_back(std::vector<Edge>());
+    return mNodes.size() - 1;
+}
+
+//===========================================================================//
+void HierarchicalGraph::addTransition(Border& border,
+                                      size_t first,
+                                      size_t second,
+                                      float cost)
+{
+    const uint32_t a = addNode(first, border.first);
+    const uint32_t b = addNode(second, border.second);
+    mNodes[a].partner = b;
+    mNodes[a].partnerCost = cost;
+    mNodes[b].partner = a;
+    mNodes[b].partnerCost = cost;
+    border.nodes.push_back(a);
+    border.nodes.push_back(b);
+}
+
+//===========================================================================//
+void HierarchicalGraph::buildBorder(Border& border)
+{
+    for (uint32_t node : border.nodes)
+    {
+        mEdges[node].clear();
+        mFreeNodes.push_back(node);
+    }
+    border.nodes.clear();
+
+    size_t x0, y0, x1, y1;
+    getBounds(border.first, x0, y0, x1, y1);
+    const size_t width = mGrid.getWidth();
+
+    if (border.type == DIAGONAL || border.type == ANTI_DIAGONAL)
+    {
+        // The corner shared by the four clusters. Only a step that cuts
+        // between two blocked cells needs its own entrance. Any other way
+        // across goes through one of the side borders.
+        const size_t cornerY = y1;
+        size_t ax, bx;
+        if (border.type == DIAGONAL)
+        {
+            // From the top left cluster to the bottom right one
+            ax = x1 - 1;
+            bx = x1;
+        }
+        else
+        {
+            // From the top right cluster to the bottom left one
+            ax = x0;
+            bx = x0 - 1;
+        }
+
+        if (mGrid.isWalkable(ax, cornerY - 1) &&
+            mGrid.isWalkable(bx, cornerY) &&
+            !mGrid.isWalkable(bx, cornerY - 1) &&
+            !mGrid.isWalkable(ax, cornerY))
+        {
+            addTransition(border, mGrid.getIndex(ax, cornerY - 1),
+                          mGrid.getIndex(bx, cornerY), SQRT_2);
+        }
+        return;
+    }
+
+    // Walk along the border. 'inside' is the last row or column of the
+    // first cluster and 'outside' is the first one of the second.
+    const bool vertical = border.type == VERTICAL;
+    const size_t length = vertical ? y1 - y0 : x1 - x0;
+    const auto inside = [&](size_t i)
+    {
+        return vertical ? (y0 + i) * width + x1 - 1 :
+                          (y1 - 1) * width + x0 + i;
+    };
+    const auto outside = [&](size_t i)
+    {
+        return vertical ? (y0 + i) * width + x1 :
+                          y1 * width + x0 + i;
+    };
+    const auto open = [&](size_t i)
+    {
+        return mGrid.isWalkable(inside(i)) && mGrid.isWalkable(outside(i));
+    };
+
+    size_t runStart = 0;
+    bool inRun = false;
+    for (size_t i = 0; i <= length; ++i)
+    {
+        if (i < length && open(i))
+        {
+            if (!inRun)
+            {
+                runStart = i;
+                inRun = true;
+            }
+            continue;
+        }
+
+        if (inRun)
+        {
+            const size_t runEnd = i - 1;
+            if (runEnd - runStart + 1 >= LONG_ENTRANCE)
+            {
+                addTransition(border, inside(runStart),
+                              outside(runStart), 1.0f);
+                addTransition(border, inside(runEnd),
+                              outside(runEnd), 1.0f);
+            }
+            else
+            {
+                const size_t middle = (runStart + runEnd) / 2;
+                addTransition(border, inside(middle),
+                              outside(middle), 1.0f);
+            }
+            inRun = false;
+        }
+
+        // Diagonal steps across the border between two blocked cells
+        if (i + 1 < length)
+        {
+            const bool in0 = mGrid.isWalkable(inside(i));
+            const bool in1 = mGrid.isWalkable(inside(i + 1));
+            const bool out0 = mGrid.isWalkable(outside(i));
+            const bool out1 = mGrid.isWalkable(outside(i + 1));
+            if (in0 && out1 && !in1 && !out0)
+            {
+                addTransition(border, inside(i), outside(i + 1), SQRT_2);
+            }
+            if (in1 && out0 && !in0 && !out1)
+            {
+                addTransition(border, inside(i + 1), outside(i), SQRT_2);
+            }
+        }
+    }
+}
+
+//===========================================================================//
+void HierarchicalGraph::buildCluster(size_t cluster)
+{
+    std::vector<uint32_t>& nodes = mClusterNodes[cluster];
+    nodes.clear();
+    for (uint32_t border : mClusterBorders[cluster])
+    {
+        for (uint32_t node : mBorders[border].nodes)
+        {
+            if (mNodes[node].cluster == cluster)
+            {
+                nodes.push_back(node);
+            }
+        }
+    }
+
+    for (uint32_t node : nodes)
+    {
+        mEdges[node].clear();
+    }
+
+    Search::Scratch& scratch = mSearch.mRefine;
+    size_t x0, y0, x1, y1;
+    getBounds(cluster, x0, y0, x1, y1);
+    const size_t width = mGrid.getWidth();
+    const size_t clusterWidth = x1 - x0;
+
+    for (uint32_t node : nodes)
+    {
+        searchCluster(cluster, mNodes[node].cell, scratch);
+        for (uint32_t other : nodes)
+        {
+            const size_t cell = mNodes[other].cell;
+            const size_t local = (cell / width - y0) * clusterWidth +
+                                 (cell % width - x0);
+            if (other != node &&
+                scratch.states[local].closed == scratch.generation)
+            {
+                const Edge edge = {other, scratch.states[local].cost};
+                mEdges[node].push_back(edge);
+            }
+        }
+    }
+
+    mPathCache[cluster].clear();
+}
+
+//===========================================================================//
+void HierarchicalGraph::searchCluster(size_t cluster,
+                                      size_t cell,
+                                      Search::Scratch& scratch) const
+{
+    size_t x0, y0, x1, y1;
+    getBounds(cluster, x0, y0, x1, y1);
+    const size_t width = mGrid.getWidth();
+    const size_t clusterWidth = x1 - x0;
+    const size_t clusterHeight = y1 - y0;
+
+    const uint32_t generation = scratch.begin(mClusterSize * mClusterSize);
+    Search::State* const states = &scratch.states[0];
+    std::vector<Search::Entry>& open = scratch.open;
+    const auto compare = [](const Search::Entry& a, const Search::Entry& b)
+    {
+        return a.total > b.total;
+    };
+
+    // Every cell in the cluster is wanted, so this is a plain Dijkstra
+    // over cluster local indices.
+    const uint32_t start = (cell / width - y0) * clusterWidth +
+                           (cell % width - x0);
+    states[start].cost = 0.0f;
+    states[start].parent = start;
+    states[start].visited = generation;
+    const Search::Entry first = {0.0f, start};
+    open.push_back(first);
+
+    while (!open.empty())
+    {
+        std::pop_heap(open.begin(), open.end(), compare);
+        const uint32_t current = open.back().index;
+        open.pop_back();
+
+        Search::State& state = states[current];
+        if (state.closed == generation)
+        {
+            continue;
+        }
+        state.closed = generation;
+
+        const size_t x = current % clusterWidth;
+        const size_t y = current / clusterWidth;
+        for (size_t dir = 0; dir < 8; ++dir)
+        {
+            const size_t nextX = x + DX[dir];
+            const size_t nextY = y + DY[dir];
+            if (nextX >= clusterWidth || nextY >= clusterHeight)
+            {
+                continue;
+            }
+
+            const uint32_t next = nextY * clusterWidth + nextX;
+            Search::State& nextState = states[next];
+            if (nextState.closed == generation ||
+                !mGrid.isWalkable((y0 + nextY) * width + x0 + nextX))
+            {
+                continue;
+            }
+
+            const float nextCost = state.cost + COST[dir];
+            if (nextState.visited != generation || nextCost < nextState.cost)
+            {
+                nextState.visited = generation;
+                nextState.cost = nextCost;
+                nextState.parent = current;
+                const Search::Entry entry = {nextCost, next};
+                open.push_back(entry);
+                std::push_heap(open.begin(), open.end(), compare);
+            }
+        }
+    }
+}
+
+//===========================================================================//
+void HierarchicalGraph::appendLocalPath(size_t cluster,
+                                        size_t cell,
+                                        const Search::Scratch& scratch,
+                                        bool towardStart,
+                                        std::vector<size_t>& path) const
+{
+    // Follows the parents left by searchCluster from the cell back to
+    // where that search started.
+    size_t x0, y0, x1, y1;
+    getBounds(cluster, x0, y0, x1, y1);
+    const size_t width = mGrid.getWidth();
+    const size_t clusterWidth = x1 - x0;
+
+    const size_t begin = path.size();
+    uint32_t local = (cell / width - y0) * clusterWidth + (cell % width - x0);
+    while (true)
+    {
+        path.push_back((y0 + local / clusterWidth) * width +
+                       x0 + local % clusterWidth);
+        if (scratch.states[local].parent == local)
+        {
+            break;
+        }
+        local = scratch.states[local].parent;
+    }
+
+    if (!towardStart)
+    {
+        std::reverse(path.begin() + begin, path.end());
+    }
+}
+
+//===========================================================================//
+void HierarchicalGraph::appendClusterPath(uint32_t from,
+                                          uint32_t to,
+                                          Search& search,
+                                          std::vector<size_t>& path) const
+{
+    const size_t cluster = mNodes[from].cluster;
+    const bool reverse = from > to;
+    const uint64_t key = reverse ? makeKey(to, from) : makeKey(from, to);
+
+    // Paths are stored from the lower node to the higher one and are
+    // only worked out the first time a search goes that way.
+    std::vector<uint32_t> cells;
+    {
+        std::lock_guard<std::mutex> lock(mCacheMutex);
+        const auto iter = mPathCache[cluster].find(key);
+        if (iter != mPathCache[cluster].end())
+        {
+            cells = iter->second;
+        }
+    }
+
+    if (cells.empty())
+    {
+        const uint32_t low = reverse ? to : from;
+        const uint32_t high = reverse ? from : to;
+        std::vector<size_t> local;
+        searchCluster(cluster, mNodes[low].cell, search.mRefine);
+        appendLocalPath(cluster, mNodes[high].cell, search.mRefine,
+                        false, local);
+        cells.assign(local.begin(), local.end());
+
+        std::lock_guard<std::mutex> lock(mCacheMutex);
+        mPathCache[cluster][key] = cells;
+    }
+
+    if (reverse)
+    {
+        path.insert(path.end(), cells.rbegin(), cells.rend());
+    }
+    else
+    {
+        path.insert(path.end(), cells.begin(), cells.end());
+    }
+}
+
+//===========================================================================//
+void HierarchicalGraph::refinePath(std::vector<size_t>& path,
+                                   Search& search) const
+{
+    // Entrances sit at fixed spots on each border, so the abstract path
+    // can bend out of its way to reach them. Each window of the path is
+    // searched again on the grid, in the box around it, and replaced if
+    // that is shorter. Windows overlap by half so a detour that crosses
+    // the end of one window is still caught by the next.
+    const size_t width = mGrid.getWidth();
+    const size_t window = mClusterSize * 2;
+    const size_t margin = mClusterSize / 2 + 1;
+    size_t begin = 0;
+    while (begin + 1 < path.size())
+    {
+        size_t end = std::min(begin + window, path.size() - 1);
+
+        float cost = 0.0f;
+        size_t x0 = path[begin] % width;
+        size_t y0 = path[begin] / width;
+        size_t x1 = x0;
+        size_t y1 = y0;
+        for (size_t ii = begin + 1; ii <= end; ++ii)
+        {
+            cost += stepCost(path[ii - 1], path[ii], width);
+            x0 = std::min(x0, path[ii] % width);
+            y0 = std::min(y0, path[ii] / width);
+            x1 = std::max(x1, path[ii] % width);
+            y1 = std::max(y1, path[ii] / width);
+        }
+
+        // Nothing is shorter than the straight line, so a window that
+        // already matches it is left without a search. Small float
+        // differences are ignored so equal paths are not swapped.
+        if (cost > octile(path[begin] % width, path[begin] / width,
+                          path[end] % width, path[end] / width) + 1e-3f)
+        {
+            const PathResults<size_t> shorter = mGrid.getPath(
+                    path[begin], path[end],
+                    x0 > margin ? x0 - margin : 0,
+                    y0 > margin ? y0 - margin : 0,
+                    x1 + 1 + margin,
+                    y1 + 1 + margin,
+                    search.mNearby);
+
+            // The window always has a path, the one being refined. If the
+            // path loops back on itself the new one can be a single cell.
+            if (shorter.distance < cost - 1e-3f)
+            {
+                path.erase(path.begin() + begin + 1,
+                           path.begin() + end + 1);
+                path.insert(path.begin() + begin + 1,
+                            shorter.path.begin() + 1,
+                            shorter.path.end());
+                end = begin + shorter.path.size() - 1;
+            }
+        }
+
+        if (end + 1 == path.size())
+        {
+            break;
+        }
+        begin += std::max<size_t>((end - begin) / 2, 1);
+    }
+}
+
+//===========================================================================//
+void HierarchicalGraph::setWalkable(size_t x, size_t y, bool walkable)
+{
+    if (mGrid.isWalkable(x, y) == walkable)
+    {
+        return;
+    }
+
+    mGrid.setWalkable(x, y, walkable);
+    mDirty[(y / mClusterSize) * mClustersX + x / mClusterSize] = true;
+    mHasDirty = true;
+}
+
+//===========================================================================//
+void HierarchicalGraph::update()
+{
+    if (!mHasDirty)
+    {
+        return;
+    }
+
+    // Every border of a changed cluster is redone, which also changes the
+    // entrances of the clusters on the other side.
+    std::vector<bool> borders(mBorders.size(), false);
+    std::vector<bool> clusters(mDirty.size(), false);
+    for (size_t cluster = 0; cluster < mDirty.size(); ++cluster)
+    {
+        if (!mDirty[cluster])
+        {
+            continue;
+        }
+
+        clusters[cluster] = true;
+        for (uint32_t border : mClusterBorders[cluster])
+        {
+            borders[border] = true;
+        }
+    }
+
+    for (size_t border = 0; border < mBorders.size(); ++border)
+    {
+        if (borders[border])
+        {
+            buildBorder(mBorders[border]);
+            clusters[mBorders[border].first] = true;
+            clusters[mBorders[border].second] = true;
+        }
+    }
+
+    for (size_t cluster = 0; cluster < clusters.size(); ++cluster)
+    {
+        if (clusters[cluster])
+        {
+            buildCluster(cluster);
+        }
+    }
+
+    mDirty.assign(mDirty.size(), false);
+    mHasDirty = false;
+}
+
+//===========================================================================//
+PathResults<size_t> HierarchicalGraph::getPath(size_t start,
+                                               size_t end,
+                                               Search& search) const
+{
+    if (mHasDirty)
+    {
+        throw std::runtime_error(
+                "HierarchicalGraph::update must be called before searching");
+    }
+
+    PathResults<size_t> results;
+    const size_t width = mGrid.getWidth();
+    const size_t numCells = width * mGrid.getHeight();
+    if (start >= numCells || end >= numCells ||
+        !mGrid.isWalkable(start) || !mGrid.isWalkable(end))
+    {
+        return results;
+    }
+
+    const size_t startCluster = getCluster(start);
+    const size_t endCluster = getCluster(end);
+    size_t x0, y0, x1, y1;
+
+    // Going through the entrances can detour a long way around a border
+    // that is only a few tiles away. When the clusters touch, search the
+    // grid inside them instead and only fall back to the abstract graph
+    // if the path has to leave them. A small margin past the clusters
+    // lets the path step around obstacles sitting on their edge.
+    const size_t startClusterX = startCluster % mClustersX;
+    const size_t startClusterY = startCluster / mClustersX;
+    const size_t endClusterX = endCluster % mClustersX;
+    const size_t endClusterY = endCluster / mClustersX;
+    const size_t minX = std::min(startClusterX, endClusterX);
+    const size_t minY = std::min(startClusterY, endClusterY);
+    const size_t maxX = std::max(startClusterX, endClusterX);
+    const size_t maxY = std::max(startClusterY, endClusterY);
+    if (maxX - minX <= 1 && maxY - minY <= 1)
+    {
+        const size_t margin = mClusterSize / 4 + 1;
+        const size_t x0 = minX * mClusterSize;
+        const size_t y0 = minY * mClusterSize;
+        results = mGrid.getPath(start, end,
+                                x0 > margin ? x0 - margin : 0,
+                                y0 > margin ? y0 - margin : 0,
+                                (maxX + 1) * mClusterSize + margin,
+                                (maxY + 1) * mClusterSize + margin,
+                                search.mNearby);
+        if (!results.path.empty())
+        {
+            return results;
+        }
+    }
+
+    // Hook the start into its cluster's entrances
+    searchCluster(startCluster, start, search.mStart);
+    getBounds(startCluster, x0, y0, x1, y1);
+    const auto localIndex = [&](size_t cell)
+    {
+        return (cell / width - y0) * (x1 - x0) + (cell % width - x0);
+    };
+
+    search.mStartEdges.clear();
+    for (uint32_t node : mClusterNodes[startCluster])
+    {
+        const Search::State& state =
+                search.mStart.states[localIndex(mNodes[node].cell)];
+        if (state.closed == search.mStart.generation)
+        {
+            search.mStartEdges.push_back(std::make_pair(node, state.cost));
+        }
+    }
+
+    searchCluster(endCluster, end, search.mEnd);
+    getBounds(endCluster, x0, y0, x1, y1);
+    search.mEndEdges.clear();
+    for (uint32_t node : mClusterNodes[endCluster])
+    {
+        const Search::State& state =
+                search.mEnd.states[localIndex(mNodes[node].cell)];
+        if (state.closed == search.mEnd.generation)
+        {
+            search.mEndEdges.push_back(std::make_pair(node, state.cost));
+        }
+    }
+
+    if (search.mStartEdges.empty() || search.mEndEdges.empty())
+    {
+        return results;
+    }
+
+    // A* over the entrances. The start and goal are appended as two extra
+    // nodes past the end of the real ones.
+    const uint32_t startNode = mNodes.size();
+    const uint32_t endNode = startNode + 1;
+    Search::Scratch& scratch = search.mAbstract;
+    const uint32_t generation = scratch.begin(mNodes.size() + 2);
+    Search::State* const states = &scratch.states[0];
+    std::vector<Search::Entry>& open = scratch.open;
+    const auto compare = [](const Search::Entry& a, const Search::Entry& b)
+    {
+        return a.total > b.total;
+    };
+
+    const size_t endX = end % width;
+    const size_t endY = end / width;
+    const auto relax = [&](uint32_t from, uint32_t to, float cost)
+    {
+        Search::State& next = states[to];
+        if (next.closed == generation)
+        {
+            return;
+        }
+
+        const float nextCost = states[from].cost + cost;
+        if (next.visited != generation || nextCost < next.cost)
+        {
+            next.visited = generation;
+            next.cost = nextCost;
+            next.parent = from;
+            const size_t cell = to == endNode ? end : mNodes[to].cell;
+            const Search::Entry entry = {
+                    nextCost + octile(cell % width, cell / width, endX, endY),
+                    to};
+            open.push_back(entry);
+            std::push_heap(open.begin(), open.end(), compare);
+        }
+    };
+
+    states[startNode].cost = 0.0f;
+    states[startNode].parent = startNode;
+    states[startNode].visited = generation;
+    states[startNode].closed = generation;
+    for (const std::pair<uint32_t, float>& edge : search.mStartEdges)
+    {
+        relax(startNode, edge.first, edge.second);
+    }
+
+    bool found = false;
+    while (!open.empty())
+    {
+        std::pop_heap(open.begin(), open.end(), compare);
+        const uint32_t current = open.back().index;
+        open.pop_back();
+
+        Search::State& state = states[current];
+        if (state.closed == generation)
+        {
+            continue;
+        }
+        state.closed = generation;
+
+        if (current == endNode)
+        {
+            found = true;
+            break;
+        }
+
+        for (const Edge& edge : mEdges[current])
+        {
+            relax(current, edge.to, edge.cost);
+        }
+        relax(current, mNodes[current].partner,
+              mNodes[current].partnerCost);
+
+        if (mNodes[current].cluster == endCluster)
+        {
+            for (const std::pair<uint32_t, float>& edge : search.mEndEdges)
+            {
+                if (edge.first == current)
+                {
+                    relax(current, endNode, edge.second);
+                }
+            }
+        }
+    }
+
+    if (!found)
+    {
+        return results;
+    }
+
+    std::vector<uint32_t> nodes;
+    for (uint32_t node = endNode; ; node = states[node].parent)
+    {
+        nodes.push_back(node);
+        if (states[node].parent == node)
+        {
+            break;
+        }
+    }
+    std::reverse(nodes.begin(), nodes.end());
+    results.distance = states[endNode].cost;
+
+    // Turn each abstract step back into cells. Steps inside a cluster use
+    // the cached paths. Steps across a border are a single move.
+    appendLocalPath(startCluster, mNodes[nodes[1]].cell, search.mStart,
+                    false, results.path);
+    for (size_t ii = 1; ii + 2 < nodes.size(); ++ii)
+    {
+        const uint32_t from = nodes[ii];
+        const uint32_t to = nodes[ii + 1];
+        if (mNodes[from].cluster == mNodes[to].cluster)
+        {
+            appendClusterPath(from, to, search, results.path);
+        }
+        else
+        {
+            results.path.push_back(mNodes[to].cell);
+        }
+    }
+    appendLocalPath(endCluster, mNodes[nodes[nodes.size() - 2]].cell,
+                    search.mEnd, true, results.path);
+
+    // Entrances that share a cell leave repeats where the pieces join
+    results.path.erase(std::unique(results.path.begin(), results.path.end()),
+                       results.path.end());
+
+    refinePath(results.path, search);
+    results.distance = 0.0f;
+    for (size_t ii = 1; ii < results.path.size(); ++ii)
+    {
+        results.distance += stepCost(results.path[ii - 1],
+                                     results.path[ii], width);
+    }
+    return results;
+}
+}
+}
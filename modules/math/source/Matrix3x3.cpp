@@ -20,60 +20,75 @@
  * IN THE SOFTWARE.
  */
 #include <nyra/math/Matrix3x3.h>
-#include <nyra/math/Conversions.h>
-#include <gmtl/Generate.h>
 
 namespace nyra
 {
 namespace math
 {
 //===========================================================================//
-Matrix3x3::Matrix3x3(float a11, float a12, float a13,
-                     float a21, float a22, float a23,
-                     float a31, float a32, float a33)
+Matrix3x3::Matrix3x3(const Matrix<float, 3, 3>& other) :
+    Matrix<float, 3, 3>(other)
 {
-    (*this)(0, 0) = a11;
-    (*this)(0, 1) = a12;
-    (*this)(0, 2) = a13;
-
-    (*this)(1, 0) = a21;
-    (*this)(1, 1) = a22;
-    (*this)(1, 2) = a23;
-
-    (*this)(2, 0) = a31;
-    (*this)(2, 1) = a32;
-    (*this)(2, 2) = a33;
 }
 
 //===========================================================================//
-Matrix3x3::Matrix3x3(const Matrix<float, 3, 3>& other)
+void Matrix3x3::transform(const Vector2F& position,
+                          const Vector2F& scale,
+                          float rotation,
+                          const Vector2F& pivot)
 {
-    mMatrix = other.getNative();
+    transform(position, scale, SinCos<float>(rotation), pivot);
 }
 
 //===========================================================================//
 void Matrix3x3::transform(const Vector2F& position,
                           const Vector2F& scale,
-                          float rotation,
+                          const SinCos<float>& rotation,
                           const Vector2F& pivot)
 {
-    // TODO: SFML does this as a single assignment to a 3x3 matrix. I need to
-    //       test what kind of performance gain that gives. I would rather
-    //       not maintain the linear algebra.
-    gmtl::Matrix<float, 3, 3> pivotMatrix;
-    gmtl::setTrans(pivotMatrix, pivot.getNative());
+    // This is translation * rotation * scale * pivot written out as a
+    // single assignment, which is how SFML builds its transforms.
+    const float a = rotation.cosine * scale.x;
+    const float b = -rotation.sine * scale.y;
+    const float c = rotation.sine * scale.x;
+    const float d = rotation.cosine * scale.y;
+
+    mMatrix[0][0] = a;
+    mMatrix[0][1] = b;
+    mMatrix[0][2] = a * pivot.x + b * pivot.y + position.x;
+
+    mMatrix[1][0] = c;
+    mMatrix[1][1] = d;
+    mMatrix[1][2] = c * pivot.x + d * pivot.y + position.y;
 
-    gmtl::Matrix<float, 3, 3> translationMatrix;
-    gmtl::setTrans(translationMatrix, position.getNative());
+    mMatrix[2][0] = 0.0f;
+    mMatrix[2][1] = 0.0f;
+    mMatrix[2][2] = 1.0f;
+}
 
-    gmtl::Matrix<float, 3, 3> scaleMatrix;
-    gmtl::setScale(scaleMatrix, scale.getNative());
+//===========================================================================//
+void Matrix3x3::compose(const Matrix3x3& parent, const Matrix3x3& local)
+{
+    const float (&p)[3][3] = parent.mMatrix;
+    const float (&l)[3][3] = local.mMatrix;
+    float result[2][3];
+    for (size_t ii = 0; ii < 2; ++ii)
+    {
+        result[ii][0] = p[ii][0] * l[0][0] + p[ii][1] * l[1][0];
+        result[ii][1] = p[ii][0] * l[0][1] + p[ii][1] * l[1][1];
+        result[ii][2] = p[ii][0] * l[0][2] + p[ii][1] * l[1][2] + p[ii][2];
+    }
 
-    gmtl::Matrix<float, 3, 3> rotationMatrix;
-    gmtl::EulerAngle<float, gmtl::XYZ> eulerRotation(
-            0.0f, 0.0f, degreesToRadians(rotation));
-    gmtl::setRot(rotationMatrix, eulerRotation);
-    mMatrix = translationMatrix * rotationMatrix * scaleMatrix * pivotMatrix;
+    for (size_t ii = 0; ii < 2; ++ii)
+    {
+        for (size_t jj = 0; jj < 3; ++jj)
+        {
+            mMatrix[ii][jj] = result[ii][jj];
+        }
+    }
+    mMatrix[2][0] = 0.0f;
+    mMatrix[2][1] = 0.0f;
+    mMatrix[2][2] = 1.0f;
 }
 }
 }
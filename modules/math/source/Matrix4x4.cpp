@@ -20,69 +20,69 @@
  * IN THE SOFTWARE.
  */
 #include <nyra/math/Matrix4x4.h>
-#include <nyra/math/Conversions.h>
-#include <gmtl/Generate.h>
 
 namespace nyra
 {
 namespace math
 {
 //===========================================================================//
-Matrix4x4::Matrix4x4(float a11, float a12, float a13, float a14,
-                     float a21, float a22, float a23, float a24,
-                     float a31, float a32, float a33, float a34,
-                     float a41, float a42, float a43, float a44)
+Matrix4x4::Matrix4x4(const Matrix<float, 4, 4>& other) :
+    Matrix<float, 4, 4>(other)
 {
-    (*this)(0, 0) = a11;
-    (*this)(0, 1) = a12;
-    (*this)(0, 2) = a13;
-    (*this)(0, 3) = a14;
-
-    (*this)(1, 0) = a21;
-    (*this)(1, 1) = a22;
-    (*this)(1, 2) = a23;
-    (*this)(1, 3) = a24;
-
-    (*this)(2, 0) = a31;
-    (*this)(2, 1) = a32;
-    (*this)(2, 2) = a33;
-    (*this)(2, 3) = a34;
-
-    (*this)(3, 0) = a41;
-    (*this)(3, 1) = a42;
-    (*this)(3, 2) = a43;
-    (*this)(3, 3) = a44;
 }
 
 //===========================================================================//
-Matrix4x4::Matrix4x4(const Matrix<float, 4, 4>& other)
+void Matrix4x4::transform(const Vector3F& position,
+                          const Vector3F& scale,
+                          const Vector3F& rotation,
+                          const Vector3F& pivot)
 {
-    mMatrix = other.getNative();
+    transform(position, scale, SinCos<Vector3F>(rotation), pivot);
 }
 
 //===========================================================================//
 void Matrix4x4::transform(const Vector3F& position,
                           const Vector3F& scale,
-                          const Vector3F& rotation,
+                          const SinCos<Vector3F>& rotation,
                           const Vector3F& pivot)
 {
-    gmtl::Matrix<float, 4, 4> pivotMatrix;
-    gmtl::setTrans(pivotMatrix, pivot.getNative());
+    const float sx = rotation.sine.x;
+    const float cx = rotation.cosine.x;
+    const float sy = rotation.sine.y;
+    const float cy = rotation.cosine.y;
+    const float sz = rotation.sine.z;
+    const float cz = rotation.cosine.z;
 
-    gmtl::Matrix<float, 4, 4> translationMatrix;
-    gmtl::setTrans(translationMatrix, position.getNative());
+    // XYZ Euler rotation, matching the order GMTL used before
+    const float rotationMatrix[3][3] = {
+            {cy * cz, -cy * sz, sy},
+            {sx * sy * cz + cx * sz, -sx * sy * sz + cx * cz, -sx * cy},
+            {-cx * sy * cz + sx * sz, cx * sy * sz + sx * cz, cx * cy}};
 
-    gmtl::Matrix<float, 4, 4> scaleMatrix;
-    gmtl::setScale(scaleMatrix, scale.getNative());
+    // This is translation * rotation * scale * pivot written out directly
+    for (size_t ii = 0; ii < 3; ++ii)
+    {
+        float translation = position[ii];
+        for (size_t jj = 0; jj < 3; ++jj)
+        {
+            mMatrix[ii][jj] = rotationMatrix[ii][jj] * scale[jj];
+            translation += mMatrix[ii][jj] * pivot[jj];
+        }
+        mMatrix[ii][3] = translation;
+    }
 
-    gmtl::Matrix<float, 4, 4> rotationMatrix;
-    gmtl::EulerAngle<float, gmtl::XYZ> eulerRotation(
-            degreesToRadians(rotation.x),
-            degreesToRadians(rotation.y),
-            degreesToRadians(rotation.z));
-    gmtl::setRot(rotationMatrix, eulerRotation);
+    mMatrix[3][0] = 0.0f;
+    mMatrix[3][1] = 0.0f;
+    mMatrix[3][2] = 0.0f;
+    mMatrix[3][3] = 1.0f;
+}
 
-    mMatrix = translationMatrix * rotationMatrix * scaleMatrix * pivotMatrix;
+//===========================================================================//
+void Matrix4x4::compose(const Matrix4x4& parent, const Matrix4x4& local)
+{
+    Matrix<float, 4, 4> result(parent);
+    result *= local;
+    Matrix<float, 4, 4>::operator=(result);
 }
 }
 }
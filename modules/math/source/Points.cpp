@@ -0,0 +1,247 @@
+/*
+ * Copyright (c) 2018 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#include <algorithm>
+#include <nyra/math/Points.h>
+#include <nyra/core/ThreadPool.h>
+
+#ifdef __SSE__
+#include <xmmintrin.h>
+#endif
+
+namespace
+{
+// Batches smaller than this are not worth waking the pool for
+static const size_t PARALLEL_THRESHOLD = 1 << 16;
+
+// The number of points each pool task transforms. This is a multiple of
+// four so only the last chunk has a scalar tail.
+static const size_t CHUNK_SIZE = 1 << 13;
+
+nyra::core::ThreadPool& getPool()
+{
+    static nyra::core::ThreadPool pool;
+    return pool;
+}
+
+//===========================================================================//
+void transform3D(const nyra::math::Matrix4x4& matrix,
+                 const float* input,
+                 float* output,
+                 size_t count)
+{
+    size_t ii = 0;
+#ifdef __SSE__
+    const __m128 m00 = _mm_set1_ps(matrix(0, 0));
+    const __m128 m01 = _mm_set1_ps(matrix(0, 1));
+    const __m128 m02 = _mm_set1_ps(matrix(0, 2));
+    const __m128 m03 = _mm_set1_ps(matrix(0, 3));
+    const __m128 m10 = _mm_set1_ps(matrix(1, 0));
+    const __m128 m11 = _mm_set1_ps(matrix(1, 1));
+    const __m128 m12 = _mm_set1_ps(matrix(1, 2));
+    const __m128 m13 = _mm_set1_ps(matrix(1, 3));
+    const __m128 m20 = _mm_set1_ps(matrix(2, 0));
+    const __m128 m21 = _mm_set1_ps(matrix(2, 1));
+    const __m128 m22 = _mm_set1_ps(matrix(2, 2));
+    const __m128 m23 = _mm_set1_ps(matrix(2, 3));
+
+    for (; ii + 4 <= count; ii += 4, input += 12, output += 12)
+    {
+        // Four packed points are x0 y0 z0 x1 | y1 z1 x2 y2 | z2 x3 y3 z3.
+        // Split them into one register per axis.
+        const __m128 a = _mm_loadu_ps(input);
+        const __m128 b = _mm_loadu_ps(input + 4);
+        const __m128 c = _mm_loadu_ps(input + 8);
+
+        const __m128 x = _mm_shuffle_ps(
+                a, _mm_shuffle_ps(b, c, _MM_SHUFFLE(1, 1, 2, 2)),
+                _MM_SHUFFLE(2, 0, 3, 0));
+        const __m128 y = _mm_shuffle_ps(
+                _mm_shuffle_ps(a, b, _MM_SHUFFLE(0, 0, 1, 1)),
+                _mm_shuffle_ps(b, c, _MM_SHUFFLE(2, 2, 3, 3)),
+                _MM_SHUFFLE(2, 0, 2, 0));
+        const __m128 z = _mm_shuffle_ps(
+                _mm_shuffle_ps(a, b, _MM_SHUFFLE(1, 1, 2, 2)),
+                _mm_shuffle_ps(c, c, _MM_SHUFFLE(3, 3, 0, 0)),
+                _MM_SHUFFLE(2, 0, 2, 0));
+
+        const __m128 outX = _mm_add_ps(
+                _mm_add_ps(_mm_mul_ps(m00, x), _mm_mul_ps(m01, y)),
+                _mm_add_ps(_mm_mul_ps(m02, z), m03));
+        const __m128 outY = _mm_add_ps(
+                _mm_add_ps(_mm_mul_ps(m10, x), _mm_mul_ps(m11, y)),
+                _mm_add_ps(_mm_mul_ps(m12, z), m13));
+        const __m128 outZ = _mm_add_ps(
+                _mm_add_ps(_mm_mul_ps(m20, x), _mm_mul_ps(m21, y)),
+                _mm_add_ps(_mm_mul_ps(m22, z), m23));
+
+        // Interleave back into packed points
+        _mm_storeu_ps(output, _mm_shuffle_ps(
+                _mm_shuffle_ps(outX, outY, _MM_SHUFFLE(0, 0, 0, 0)),
+                _mm_shuffle_ps(outZ, outX, _MM_SHUFFLE(1, 1, 0, 0)),
+                _MM_SHUFFLE(2, 0, 2, 0)));
+        _mm_storeu_ps(output + 4, _mm_shuffle_ps(
+                _mm_shuffle_ps(outY, outZ, _MM_SHUFFLE(1, 1, 1, 1)),
+                _mm_shuffle_ps(outX, outY, _MM_SHUFFLE(2, 2, 2, 2)),
+                _MM_SHUFFLE(2, 0, 2, 0)));
+        _mm_storeu_ps(output + 8, _mm_shuffle_ps(
+                _mm_shuffle_ps(outZ, outX, _MM_SHUFFLE(3, 3, 2, 2)),
+                _mm_shuffle_ps(outY, outZ, _MM_SHUFFLE(3, 3, 3, 3)),
+                _MM_SHUFFLE(2, 0, 2, 0)));
+    }
+#endif
+
+    for (; ii < count; ++ii, input += 3, output += 3)
+    {
+        const float x = input[0];
+        const float y = input[1];
+        const float z = input[2];
+        output[0] = matrix(0, 0) * x + matrix(0, 1) * y +
+                    matrix(0, 2) * z + matrix(0, 3);
+        output[1] = matrix(1, 0) * x + matrix(1, 1) * y +
+                    matrix(1, 2) * z + matrix(1, 3);
+        output[2] = matrix(2, 0) * x + matrix(2, 1) * y +
+                    matrix(2, 2) * z + matrix(2, 3);
+    }
+}
+
+//===========================================================================//
+void transform2D(const nyra::math::Matrix3x3& matrix,
+                 const float* input,
+                 float* output,
+                 size_t count)
+{
+    size_t ii = 0;
+#ifdef __SSE__
+    const __m128 m00 = _mm_set1_ps(matrix(0, 0));
+    const __m128 m01 = _mm_set1_ps(matrix(0, 1));
+    const __m128 m02 = _mm_set1_ps(matrix(0, 2));
+    const __m128 m10 = _mm_set1_ps(matrix(1, 0));
+    const __m128 m11 = _mm_set1_ps(matrix(1, 1));
+    const __m128 m12 = _mm_set1_ps(matrix(1, 2));
+
+    for (; ii + 4 <= count; ii += 4, input += 8, output += 8)
+    {
+        const __m128 a = _mm_loadu_ps(input);
+        const __m128 b = _mm_loadu_ps(input + 4);
+        const __m128 x = _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0));
+        const __m128 y = _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1));
+
+        const __m128 outX = _mm_add_ps(
+                _mm_add_ps(_mm_mul_ps(m00, x), _mm_mul_ps(m01, y)), m02);
+        const __m128 outY = _mm_add_ps(
+                _mm_add_ps(_mm_mul_ps(m10, x), _mm_mul_ps(m11, y)), m12);
+
+        _mm_storeu_ps(output, _mm_unpacklo_ps(outX, outY));
+        _mm_storeu_ps(output + 4, _mm_unpackhi_ps(outX, outY));
+    }
+#endif
+
+    for (; ii < count; ++ii, input += 2, output += 2)
+    {
+        const float x = input[0];
+        const float y = input[1];
+        output[0] = matrix(0, 0) * x + matrix(0, 1) * y + matrix(0, 2);
+        output[1] = matrix(1, 0) * x + matrix(1, 1) * y + matrix(1, 2);
+    }
+}
+
+//===========================================================================//
+template <typename MatrixT, typename FuncT>
+void run(const MatrixT& matrix,
+         const float* input,
+         float* output,
+         size_t count,
+         size_t stride,
+         FuncT func)
+{
+    if (count < PARALLEL_THRESHOLD)
+    {
+        func(matrix, input, output, count);
+        return;
+    }
+
+    const size_t numChunks = (count + CHUNK_SIZE - 1) / CHUNK_SIZE;
+    getPool().parallelFor(numChunks, [&](size_t chunk, size_t)
+    {
+        const size_t start = chunk * CHUNK_SIZE;
+        const size_t size = std::min(CHUNK_SIZE, count - start);
+        func(matrix,
+             input + start * stride,
+             output + start * stride,
+             size);
+    });
+}
+}
+
+namespace nyra
+{
+namespace math
+{
+//===========================================================================//
+void transformPoints(const Matrix4x4& matrix,
+                     const Vector3F* input,
+                     Vector3F* output,
+                     size_t count)
+{
+    static_assert(sizeof(Vector3F) == 3 * sizeof(float),
+                  "Vector3F must be tightly packed");
+    if (count == 0)
+    {
+        return;
+    }
+    run(matrix, input->data(), output->data(), count, 3, transform3D);
+}
+
+//===========================================================================//
+void transformPoints(const Matrix3x3& matrix,
+                     const Vector2F* input,
+                     Vector2F* output,
+                     size_t count)
+{
+    static_assert(sizeof(Vector2F) == 2 * sizeof(float),
+                  "Vector2F must be tightly packed");
+    if (count == 0)
+    {
+        return;
+    }
+    run(matrix, input->data(), output->data(), count, 2, transform2D);
+}
+
+//===========================================================================//
+std::vector<Vector3F> transformPoints(const Matrix4x4& matrix,
+                                      const std::vector<Vector3F>& points)
+{
+    std::vector<Vector3F> ret(points.size());
+    transformPoints(matrix, points.data(), ret.data(), points.size());
+    return ret;
+}
+
+//===========================================================================//
+std::vector<Vector2F> transformPoints(const Matrix3x3& matrix,
+                                      const std::vector<Vector2F>& points)
+{
+    std::vector<Vector2F> ret(points.size());
+    transformPoints(matrix, points.data(), ret.data(), points.size());
+    return ret;
+}
+}
+}
@@ -0,0 +1,302 @@
+/*
+ * Copyright (c) 2018 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#include <algorithm>
+#include <cmath>
+#include <nyra/math/SpatialHash.h>
+
+namespace
+{
+//===========================================================================//
+inline bool overlaps(float minX1, float minY1, float maxX1, float maxY1,
+                     float minX2, float minY2, float maxX2, float maxY2)
+{
+    return minX1 <= maxX2 && minX2 <= maxX1 &&
+           minY1 <= maxY2 && minY2 <= maxY1;
+}
+}
+
+namespace nyra
+{
+namespace math
+{
+//===========================================================================//
+const uint32_t SpatialHash::ALL_GROUPS;
+
+//===========================================================================//
+SpatialHash::SpatialHash(float cellSize) :
+    mCellSize(cellSize),
+    mBuilt(true),
+    mMark(0)
+{
+}
+
+//===========================================================================//
+void SpatialHash::clear()
+{
+    mItems.clear();
+    mBuilt = false;
+}
+
+//===========================================================================//
+void SpatialHash::insert(uint32_t id,
+                         float minX, float minY,
+                         float maxX, float maxY,
+                         uint32_t groups)
+{
+    const Item item = {minX, minY, maxX, maxY, id, groups};
+    mItems.push_back(item);
+    mBuilt = false;
+}
+
+//===========================================================================//
+int32_t SpatialHash::getCell(float value) const
+{
+    return static_cast<int32_t>(std::floor(value / mCellSize));
+}
+
+//===========================================================================//
+size_t SpatialHash::getBucket(int32_t x, int32_t y) const
+{
+    const uint32_t hash = static_cast<uint32_t>(x) * 73856093u ^
+                          static_cast<uint32_t>(y) * 19349663u;
+    return hash & (mBuckets.size() - 2);
+}
+
+//===========================================================================//
+void SpatialHash::build() const
+{
+    if (mBuilt)
+    {
+        return;
+    }
+
+    mCells.clear();
+    for (size_t ii = 0; ii < mItems.size(); ++ii)
+    {
+        const Item& item = mItems[ii];
+        const int32_t endX = getCell(item.maxX);
+        const int32_t endY = getCell(item.maxY);
+        for (int32_t y = getCell(item.minY); y <= endY; ++y)
+        {
+            for (int32_t x = getCell(item.minX); x <= endX; ++x)
+            {
+                const Entry entry = {x, y, static_cast<uint32_t>(ii)};
+                mCells.push_back(entry);
+            }
+        }
+    }
+
+    // At least twice as many buckets as entries, rounded up to a power of
+    // two, plus one for the end offset of the last bucket
+    size_t numBuckets = 16;
+    while (numBuckets < mCells.size() * 2)
+    {
+        numBuckets *= 2;
+    }
+    mBuckets.assign(numBuckets + 1, 0);
+
+    // Counting sort the entries into their buckets
+    for (const Entry& entry : mCells)
+    {
+        ++mBuckets[getBucket(entry.x, entry.y) + 1];
+    }
+    for (size_t ii = 1; ii < mBuckets.size(); ++ii)
+    {
+        mBuckets[ii] += mBuckets[ii - 1];
+    }
+
+    mEntries.resize(mCells.size());
+    std::vector<uint32_t> next(mBuckets.begin(), mBuckets.end() - 1);
+    for (const Entry& entry : mCells)
+    {
+        mEntries[next[getBucket(entry.x, entry.y)]++] = entry;
+    }
+
+    mMarks.assign(mItems.size(), 0);
+    mMark = 0;
+    mBuilt = true;
+}
+
+//===========================================================================//
+void SpatialHash::queryRect(float minX, float minY,
+                            float maxX, float maxY,
+                            std::vector<uint32_t>& results,
+                            uint32_t groups) const
+{
+    search(minX, minY, maxX, maxY, groups, nullptr, results);
+}
+
+//===========================================================================//
+void SpatialHash::queryRadius(float x, float y, float radius,
+                              std::vector<uint32_t>& results,
+                              uint32_t groups) const
+{
+    const float circle[] = {x, y, radius * radius};
+    search(x - radius, y - radius, x + radius, y + radius,
+           groups, circle, results);
+}
+
+//===========================================================================//
+void SpatialHash::search(float minX, float minY,
+                         float maxX, float maxY,
+                         uint32_t groups,
+                         const float* circle,
+                         std::vector<uint32_t>& results) const
+{
+    build();
+    if (mItems.empty())
+    {
+        return;
+    }
+
+    const auto matches = [&](const Item& item)
+    {
+        if ((item.groups & groups) == 0 ||
+            !overlaps(minX, minY, maxX, maxY,
+                      item.minX, item.minY, item.maxX, item.maxY))
+        {
+            return false;
+        }
+
+        // Drop boxes in the corners of the circle's bounds
+        if (circle)
+        {
+            const float dx = circle[0] - std::max(
+                    item.minX, std::min(circle[0], item.maxX));
+            const float dy = circle[1] - std::max(
+                    item.minY, std::min(circle[1], item.maxY));
+            if (dx * dx + dy * dy > circle[2])
+            {
+                return false;
+            }
+        }
+        return true;
+    };
+
+    // A query covering more cells than there are boxes, such as one the
+    // size of the screen or level, is cheaper as a scan over every box.
+    // The count is done in doubles so huge rectangles cannot overflow.
+    const double numCells =
+            (std::floor(maxX / mCellSize) - std::floor(minX / mCellSize) +
+             1.0) *
+            (std::floor(maxY / mCellSize) - std::floor(minY / mCellSize) +
+             1.0);
+    if (numCells > static_cast<double>(mItems.size()))
+    {
+        for (const Item& item : mItems)
+        {
+            if (matches(item))
+            {
+                results.push_back(item.id);
+            }
+        }
+        return;
+    }
+
+    ++mMark;
+    if (mMark == 0)
+    {
+        std::fill(mMarks.begin(), mMarks.end(), 0);
+        mMark = 1;
+    }
+
+    const int32_t endX = getCell(maxX);
+    const int32_t endY = getCell(maxY);
+    for (int32_t y = getCell(minY); y <= endY; ++y)
+    {
+        for (int32_t x = getCell(minX); x <= endX; ++x)
+        {
+            const size_t bucket = getBucket(x, y);
+            for (uint32_t ii = mBuckets[bucket];
+                 ii < mBuckets[bucket + 1]; ++ii)
+            {
+                const Entry& entry = mEntries[ii];
+                if (entry.x != x || entry.y != y ||
+                    mMarks[entry.item] == mMark)
+                {
+                    continue;
+                }
+
+                mMarks[entry.item] = mMark;
+                const Item& item = mItems[entry.item];
+                if (matches(item))
+                {
+                    results.push_back(item.id);
+                }
+            }
+        }
+    }
+}
+
+//===========================================================================//
+void SpatialHash::queryPairs(
+        uint32_t groupsA,
+        uint32_t groupsB,
+        std::vector<std::pair<uint32_t, uint32_t> >& results) const
+{
+    build();
+
+    for (size_t bucket = 0; bucket + 1 < mBuckets.size(); ++bucket)
+    {
+        const uint32_t begin = mBuckets[bucket];
+        const uint32_t end = mBuckets[bucket + 1];
+        for (uint32_t ii = begin; ii < end; ++ii)
+        {
+            const Entry& first = mEntries[ii];
+            const Item& a = mItems[first.item];
+            for (uint32_t jj = ii + 1; jj < end; ++jj)
+            {
+                const Entry& second = mEntries[jj];
+                if (second.x != first.x || second.y != first.y)
+                {
+                    continue;
+                }
+
+                const Item& b = mItems[second.item];
+                const bool forward = (a.groups & groupsA) != 0 &&
+                                     (b.groups & groupsB) != 0;
+                const bool backward = (b.groups & groupsA) != 0 &&
+                                      (a.groups & groupsB) != 0;
+                if ((!forward && !backward) ||
+                    !overlaps(a.minX, a.minY, a.maxX, a.maxY,
+                              b.minX, b.minY, b.maxX, b.maxY))
+                {
+                    continue;
+                }
+
+                // Boxes that share several cells meet in each of them.
+                // Only the cell holding the top left of the overlap
+                // reports the pair.
+                if (getCell(std::max(a.minX, b.minX)) != first.x ||
+                    getCell(std::max(a.minY, b.minY)) != first.y)
+                {
+                    continue;
+                }
+
+                results.push_back(forward ? std::make_pair(a.id, b.id) :
+                                            std::make_pair(b.id, a.id));
+            }
+        }
+    }
+}
+}
+}
@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) 2018 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#include <nyra/math/AABB.h>
+#include <nyra/math/Matrix3x3.h>
+#include <nyra/test/Test.h>
+
+namespace nyra
+{
+namespace math
+{
+TEST(AABB, Expand)
+{
+    AABB2F box;
+    EXPECT_TRUE(box.isEmpty());
+    EXPECT_FALSE(box.contains(Vector2F(0.0f, 0.0f)));
+
+    box.expand(Vector2F(1.0f, 2.0f));
+    EXPECT_FALSE(box.isEmpty());
+    EXPECT_TRUE(box.contains(Vector2F(1.0f, 2.0f)));
+
+    box.expand(Vector2F(-3.0f, 6.0f));
+    EXPECT_EQ(Vector2F(-3.0f, 2.0f), box.min);
+    EXPECT_EQ(Vector2F(1.0f, 6.0f), box.max);
+    EXPECT_EQ(Vector2F(-1.0f, 4.0f), box.getCenter());
+    EXPECT_EQ(Vector2F(4.0f, 4.0f), box.getSize());
+
+    const Vector3F points[] = {Vector3F(1.0f, 5.0f, -2.0f),
+                               Vector3F(-4.0f, 0.0f, 3.0f),
+                               Vector3F(2.0f, 1.0f, 0.0f)};
+    const AABB3F box3(points, 3);
+    EXPECT_EQ(Vector3F(-4.0f, 0.0f, -2.0f), box3.min);
+    EXPECT_EQ(Vector3F(2.0f, 5.0f, 3.0f), box3.max);
+}
+
+TEST(AABB, Intersects)
+{
+    const AABB2F box(Vector2F(0.0f, 0.0f), Vector2F(10.0f, 10.0f));
+    EXPECT_TRUE(box.intersects(
+            AABB2F(Vector2F(5.0f, 5.0f), Vector2F(15.0f, 15.0f))));
+    EXPECT_TRUE(box.intersects(
+            AABB2F(Vector2F(10.0f, 0.0f), Vector2F(12.0f, 1.0f))));
+    EXPECT_FALSE(box.intersects(
+            AABB2F(Vector2F(10.5f, 0.0f), Vector2F(12.0f, 1.0f))));
+    EXPECT_TRUE(box.contains(Vector2F(10.0f, 10.0f)));
+    EXPECT_FALSE(box.contains(Vector2F(-0.1f, 5.0f)));
+}
+
+TEST(AABB, Transform)
+{
+    // Rotate 90 degrees and move by (10, 20)
+    Matrix3x3 matrix;
+    matrix(0, 0) = 0.0f;
+    matrix(0, 1) = -1.0f;
+    matrix(0, 2) = 10.0f;
+    matrix(1, 0) = 1.0f;
+    matrix(1, 1) = 0.0f;
+    matrix(1, 2) = 20.0f;
+
+    const AABB2F box(Vector2F(1.0f, 2.0f), Vector2F(3.0f, 6.0f));
+    const AABB2F results = box.transform(matrix);
+    EXPECT_EQ(Vector2F(4.0f, 21.0f), results.min);
+    EXPECT_EQ(Vector2F(8.0f, 23.0f), results.max);
+}
+
+TEST(AABB, Archive)
+{
+    const AABB3F input(Vector3F(1.0f, 2.0f, 3.0f), Vector3F(4.0f, 5.0f, 6.0f));
+    const AABB3F output = test::archive(input);
+    EXPECT_EQ(input.min, output.min);
+    EXPECT_EQ(input.max, output.max);
+}
+}
+}
+
+NYRA_TEST()
@@ -0,0 +1,150 @@
+/*
+ * Copyright (c) 2018 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#include <cstdlib>
+#include <nyra/math/FlowField.h>
+#include <nyra/test/Test.h>
+#include <nyra/test/GridGraph.h>
+
+namespace
+{
+// Every distance should match a full search and following the field
+// should reach the goal.
+void checkField(const nyra::math::FlowField& field)
+{
+    const nyra::math::GridGraph& grid = field.getGrid();
+    const size_t numCells = grid.getWidth() * grid.getHeight();
+    for (size_t cell = 0; cell < numCells; ++cell)
+    {
+        const nyra::math::PathResults<size_t> expected =
+                grid.getPath(cell, field.getGoal());
+        ASSERT_EQ(!expected.path.empty(), field.hasPath(cell));
+        if (expected.path.empty())
+        {
+            EXPECT_EQ(cell, field.getNext(cell));
+            continue;
+        }
+
+        EXPECT_NEAR(expected.distance, field.getDistance(cell), 0.001);
+        size_t current = cell;
+        for (size_t steps = 0; current != field.getGoal(); ++steps)
+        {
+            ASSERT_LT(steps, numCells);
+            current = field.getNext(current);
+            ASSERT_TRUE(grid.isWalkable(current));
+        }
+    }
+}
+}
+
+namespace nyra
+{
+namespace math
+{
+TEST(FlowField, Goal)
+{
+    const GridGraph grid = test::makeGrid({"......",
+                                           "..##..",
+                                           "...#..",
+                                           "......"});
+    FlowField field(grid);
+    EXPECT_FALSE(field.hasPath(0));
+    EXPECT_EQ(static_cast<size_t>(0), field.getNext(0));
+
+    field.setGoal(grid.getIndex(5, 0));
+    EXPECT_EQ(grid.getIndex(5, 0), field.getNext(grid.getIndex(5, 0)));
+    EXPECT_EQ(grid.getIndex(5, 0), field.getNext(grid.getIndex(4, 0)));
+    EXPECT_FLOAT_EQ(0.0f, field.getDistance(grid.getIndex(5, 0)));
+    EXPECT_FLOAT_EQ(5.0f, field.getDistance(grid.getIndex(0, 0)));
+    EXPECT_FALSE(field.hasPath(grid.getIndex(2, 1)));
+    EXPECT_FLOAT_EQ(-1.0f, field.getDistance(grid.getIndex(2, 1)));
+    checkField(field);
+}
+
+TEST(FlowField, Blocked)
+{
+    const GridGraph grid = test::makeGrid({"..#..",
+                                           "..#..",
+                                           "..#.."});
+    FlowField field(grid);
+    field.setGoal(grid.getIndex(0, 0));
+    EXPECT_FALSE(field.hasPath(grid.getIndex(4, 0)));
+    checkField(field);
+
+    // A blocked goal leaves nothing reachable
+    field.setGoal(grid.getIndex(2, 0));
+    EXPECT_FALSE(field.hasPath(grid.getIndex(0, 0)));
+}
+
+TEST(FlowField, MovingGoal)
+{
+    std::srand(4321);
+    GridGraph grid(24, 16);
+    for (size_t y = 0; y < grid.getHeight(); ++y)
+    {
+        for (size_t x = 0; x < grid.getWidth(); ++x)
+        {
+            grid.setWalkable(x, y, std::rand() % 100 >= 25);
+        }
+    }
+    grid.setWalkable(12, 8, true);
+
+    // Walk the goal around and check the incremental updates against a
+    // full search each time.
+    FlowField field(grid);
+    field.setGoal(grid.getIndex(12, 8));
+    checkField(field);
+    for (size_t ii = 0; ii < 40; ++ii)
+    {
+        const size_t x = field.getGoal() % grid.getWidth() +
+                         std::rand() % 3 - 1;
+        const size_t y = field.getGoal() / grid.getWidth() +
+                         std::rand() % 3 - 1;
+        if (grid.isWalkable(x, y))
+        {
+            field.setGoal(grid.getIndex(x, y));
+            checkField(field);
+        }
+    }
+}
+
+TEST(FlowField, Rebuild)
+{
+    GridGraph grid = test::makeGrid({"...",
+                                     "...",
+                                     "..."});
+    FlowField field(grid);
+    field.setGoal(grid.getIndex(2, 2));
+    EXPECT_FLOAT_EQ(2.0f * 1.41421356f, field.getDistance(0));
+
+    grid.setWalkable(1, 1, false);
+
+    // The same goal does not rebuild, so the old costs are still there
+    field.setGoal(grid.getIndex(2, 2));
+    EXPECT_FLOAT_EQ(2.0f * 1.41421356f, field.getDistance(0));
+
+    field.rebuild();
+    checkField(field);
+}
+}
+}
+
+NYRA_TEST()
@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2018 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#include <nyra/math/Frustum.h>
+#include <nyra/test/Test.h>
+
+namespace
+{
+// An orthographic projection of the box from (-10, -10, -10) to
+// (10, 10, 10) shifted 5 along x
+nyra::math::Matrix4x4 getViewProjection()
+{
+    nyra::math::Matrix4x4 matrix;
+    matrix(0, 0) = 0.1f;
+    matrix(0, 3) = -0.5f;
+    matrix(1, 1) = 0.1f;
+    matrix(2, 2) = 0.1f;
+    return matrix;
+}
+}
+
+namespace nyra
+{
+namespace math
+{
+TEST(Frustum, Default)
+{
+    const Frustum frustum;
+    EXPECT_TRUE(frustum.contains(Vector3F(1.0e6f, -1.0e6f, 0.0f)));
+    EXPECT_TRUE(frustum.intersects(
+            AABB3F(Vector3F(-1.0f), Vector3F(1.0f))));
+}
+
+TEST(Frustum, Contains)
+{
+    const Frustum frustum(getViewProjection());
+    EXPECT_TRUE(frustum.contains(Vector3F(5.0f, 0.0f, 0.0f)));
+    EXPECT_TRUE(frustum.contains(Vector3F(14.0f, 9.0f, -9.0f)));
+    EXPECT_FALSE(frustum.contains(Vector3F(-6.0f, 0.0f, 0.0f)));
+    EXPECT_FALSE(frustum.contains(Vector3F(5.0f, 11.0f, 0.0f)));
+    EXPECT_FALSE(frustum.contains(Vector3F(5.0f, 0.0f, -11.0f)));
+
+    // Planes are normalized so the distance is in world units
+    EXPECT_NEAR(1.0f, frustum.getPlane(0).x, 0.0001f);
+    EXPECT_NEAR(5.0f, frustum.getPlane(0).w, 0.0001f);
+}
+
+TEST(Frustum, Cull)
+{
+    const Frustum frustum(getViewProjection());
+    const AABB3F boxes[] = {
+            AABB3F(Vector3F(0.0f), Vector3F(1.0f)),
+            AABB3F(Vector3F(-20.0f), Vector3F(-12.0f)),
+            AABB3F(Vector3F(14.0f, -1.0f, -1.0f), Vector3F(20.0f, 1.0f, 1.0f)),
+            AABB3F(Vector3F(16.0f, -1.0f, -1.0f), Vector3F(20.0f, 1.0f, 1.0f))};
+
+    std::vector<size_t> visible;
+    frustum.cull(boxes, 4, visible);
+    ASSERT_EQ(static_cast<size_t>(2), visible.size());
+    EXPECT_EQ(static_cast<size_t>(0), visible[0]);
+    EXPECT_EQ(static_cast<size_t>(2), visible[1]);
+}
+}
+}
+
+NYRA_TEST()
@@ -0,0 +1,151 @@
+/*
+ * Copyright (c) 2018 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#include <cmath>
+#include <nyra/math/GridGraph.h>
+#include <nyra/test/Test.h>
+#include <nyra/test/GridGraph.h>
+
+namespace nyra
+{
+namespace math
+{
+TEST(GridGraph, Walkable)
+{
+    GridGraph grid(100, 3);
+    EXPECT_FALSE(grid.isWalkable(70, 1));
+    grid.setWalkable(70, 1, true);
+    EXPECT_TRUE(grid.isWalkable(70, 1));
+    EXPECT_FALSE(grid.isWalkable(71, 1));
+    EXPECT_FALSE(grid.isWalkable(70, 0));
+    EXPECT_FALSE(grid.isWalkable(100, 1));
+    EXPECT_FALSE(grid.isWalkable(70, 3));
+    grid.setWalkable(70, 1, false);
+    EXPECT_FALSE(grid.isWalkable(70, 1));
+}
+
+TEST(GridGraph, Straight)
+{
+    const GridGraph grid = test::makeGrid({".....",
+                                           ".....",
+                                           "....."});
+    const PathResults<size_t> results =
+            grid.getPath(grid.getIndex(0, 1), grid.getIndex(4, 1));
+    ASSERT_EQ(static_cast<size_t>(5), results.path.size());
+    for (size_t ii = 0; ii < results.path.size(); ++ii)
+    {
+        EXPECT_EQ(grid.getIndex(ii, 1), results.path[ii]);
+    }
+    EXPECT_FLOAT_EQ(4.0, results.distance);
+}
+
+TEST(GridGraph, Diagonal)
+{
+    const GridGraph grid = test::makeGrid({"....",
+                                           "....",
+                                           "....",
+                                           "...."});
+    const PathResults<size_t> results =
+            grid.getPath(grid.getIndex(0, 0), grid.getIndex(3, 3));
+    ASSERT_EQ(static_cast<size_t>(4), results.path.size());
+    EXPECT_NEAR(3.0 * std::sqrt(2.0), results.distance, 0.0001);
+}
+
+TEST(GridGraph, Wall)
+{
+    const GridGraph grid = test::makeGrid({"..#..",
+                                           "..#..",
+                                           "..#..",
+                                           "....."});
+    const PathResults<size_t> results =
+            grid.getPath(grid.getIndex(0, 0), grid.getIndex(4, 0));
+    ASSERT_FALSE(results.path.empty());
+    EXPECT_EQ(grid.getIndex(0, 0), results.path.front());
+    EXPECT_EQ(grid.getIndex(4, 0), results.path.back());
+    EXPECT_NEAR(4.0 * std::sqrt(2.0) + 2.0, results.distance, 0.0001);
+
+    for (size_t node : results.path)
+    {
+        EXPECT_TRUE(grid.isWalkable(node));
+    }
+}
+
+TEST(GridGraph, Bounded)
+{
+    const GridGraph grid = test::makeGrid({"..#..",
+                                           "..#..",
+                                           "..#..",
+                                           "....."});
+    GridGraph::Search search;
+    const size_t start = grid.getIndex(0, 0);
+    const size_t end = grid.getIndex(4, 0);
+
+    // The way around the wall is in the last row
+    EXPECT_TRUE(grid.getPath(start, end, 0, 0, 5, 3, search).path.empty());
+    EXPECT_TRUE(grid.getPath(start, end, 1, 0, 5, 4, search).path.empty());
+
+    const PathResults<size_t> results =
+            grid.getPath(start, end, 0, 0, 5, 4, search);
+    EXPECT_NEAR(4.0 * std::sqrt(2.0) + 2.0, results.distance, 0.0001);
+}
+
+TEST(GridGraph, NoPath)
+{
+    const GridGraph grid = test::makeGrid({"..#..",
+                                           "..#..",
+                                           "..#.."});
+    EXPECT_TRUE(grid.getPath(grid.getIndex(0, 0),
+                             grid.getIndex(4, 0)).path.empty());
+    EXPECT_TRUE(grid.getPath(grid.getIndex(0, 0),
+                             grid.getIndex(2, 0)).path.empty());
+    EXPECT_TRUE(grid.getPath(grid.getIndex(0, 0), 100).path.empty());
+}
+
+TEST(GridGraph, SameNode)
+{
+    const GridGraph grid = test::makeGrid({"..."});
+    const PathResults<size_t> results = grid.getPath(1, 1);
+    ASSERT_EQ(static_cast<size_t>(1), results.path.size());
+    EXPECT_EQ(static_cast<size_t>(1), results.path[0]);
+    EXPECT_EQ(0.0, results.distance);
+}
+
+TEST(GridGraph, ReuseSearch)
+{
+    const GridGraph small = test::makeGrid({"...",
+                                            "..."});
+    const GridGraph large = test::makeGrid({".....",
+                                            ".###.",
+                                            "....."});
+    GridGraph::Search search;
+    for (size_t ii = 0; ii < 3; ++ii)
+    {
+        EXPECT_EQ(static_cast<size_t>(3), small.getPath(
+                0, small.getIndex(2, 1), search).path.size());
+        EXPECT_EQ(static_cast<size_t>(5), large.getPath(
+                large.getIndex(0, 1), large.getIndex(4, 1),
+                search).path.size());
+    }
+}
+}
+}
+
+NYRA_TEST()
@@ -0,0 +1,280 @@
+/*
+ * Copyright (c) 2018 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#include <cmath>
+#include <cstdlib>
+#include <stdexcept>
+#include <nyra/math/HierarchicalGraph.h>
+#include <nyra/test/Test.h>
+#include <nyra/test/GridGraph.h>
+
+namespace
+{
+// Checks that every step is to a walkable neighbor and that the steps
+// add up to the reported distance.
+void checkPath(const nyra::math::GridGraph& grid,
+               const nyra::math::PathResults<size_t>& results,
+               size_t start,
+               size_t end)
+{
+    ASSERT_FALSE(results.path.empty());
+    EXPECT_EQ(start, results.path.front());
+    EXPECT_EQ(end, results.path.back());
+
+    double distance = 0.0;
+    for (size_t ii = 0; ii < results.path.size(); ++ii)
+    {
+        EXPECT_TRUE(grid.isWalkable(results.path[ii]));
+        if (ii == 0)
+        {
+            continue;
+        }
+
+        const int dx = std::abs(
+                static_cast<int>(results.path[ii] % grid.getWidth()) -
+                static_cast<int>(results.path[ii - 1] % grid.getWidth()));
+        const int dy = std::abs(
+                static_cast<int>(results.path[ii] / grid.getWidth()) -
+                static_cast<int>(results.path[ii - 1] / grid.getWidth()));
+        ASSERT_LE(dx, 1);
+        ASSERT_LE(dy, 1);
+        ASSERT_NE(0, dx + dy);
+        distance += dx + dy == 2 ? std::sqrt(2.0) : 1.0;
+    }
+    EXPECT_NEAR(distance, results.distance, 0.001);
+}
+}
+
+namespace nyra
+{
+namespace math
+{
+TEST(HierarchicalGraph, SameCluster)
+{
+    const HierarchicalGraph graph(test::makeGrid({"........",
+                                                  "..#.....",
+                                                  "..#.....",
+                                                  "........"}), 8);
+    const GridGraph& grid = graph.getGrid();
+    const size_t start = grid.getIndex(0, 1);
+    const size_t end = grid.getIndex(5, 1);
+    const PathResults<size_t> results = graph.getPath(start, end);
+    checkPath(grid, results, start, end);
+    EXPECT_NEAR(grid.getPath(start, end).distance, results.distance, 0.001);
+}
+
+TEST(HierarchicalGraph, AcrossClusters)
+{
+    const HierarchicalGraph graph(test::makeGrid({"............",
+                                                  "............",
+                                                  "............",
+                                                  "............",
+                                                  "............",
+                                                  "............"}), 3);
+    const GridGraph& grid = graph.getGrid();
+    EXPECT_LT(static_cast<size_t>(0), graph.getNumNodes());
+
+    const size_t start = grid.getIndex(0, 0);
+    const size_t end = grid.getIndex(11, 5);
+    const PathResults<size_t> results = graph.getPath(start, end);
+    checkPath(grid, results, start, end);
+    EXPECT_LE(results.distance, grid.getPath(start, end).distance * 1.2);
+}
+
+TEST(HierarchicalGraph, NearbyClusters)
+{
+    // An open border has entrances only near its ends, so a short trip
+    // straight across should not be routed through them.
+    const HierarchicalGraph graph(
+            test::makeGrid(std::vector<std::string>(32, std::string(32, '.'))),
+            16);
+    const GridGraph& grid = graph.getGrid();
+
+    const size_t start = grid.getIndex(14, 8);
+    const size_t end = grid.getIndex(17, 8);
+    const PathResults<size_t> results = graph.getPath(start, end);
+    checkPath(grid, results, start, end);
+    EXPECT_NEAR(3.0, results.distance, 0.001);
+
+    const size_t corner = grid.getIndex(18, 18);
+    const PathResults<size_t> diagonal = graph.getPath(start, corner);
+    checkPath(grid, diagonal, start, corner);
+    EXPECT_NEAR(grid.getPath(start, corner).distance,
+                diagonal.distance, 0.001);
+}
+
+TEST(HierarchicalGraph, CornerCut)
+{
+    // The only way through is a diagonal step between two walls at the
+    // corner where four clusters meet.
+    const HierarchicalGraph graph(test::makeGrid({"..#.",
+                                                  "..#.",
+                                                  "##..",
+                                                  "...."}), 2);
+    const GridGraph& grid = graph.getGrid();
+    const size_t start = grid.getIndex(0, 0);
+    const size_t end = grid.getIndex(3, 3);
+    checkPath(grid, graph.getPath(start, end), start, end);
+    checkPath(grid, graph.getPath(end, start), end, start);
+}
+
+TEST(HierarchicalGraph, NoPath)
+{
+    const HierarchicalGraph graph(test::makeGrid({"...#....",
+                                                  "...#....",
+                                                  "...#....",
+                                                  "...#...."}), 2);
+    const GridGraph& grid = graph.getGrid();
+    EXPECT_TRUE(graph.getPath(grid.getIndex(0, 0),
+                              grid.getIndex(7, 3)).path.empty());
+    EXPECT_TRUE(graph.getPath(grid.getIndex(0, 0),
+                              grid.getIndex(3, 0)).path.empty());
+    EXPECT_TRUE(graph.getPath(0, 1000).path.empty());
+}
+
+TEST(HierarchicalGraph, Update)
+{
+    HierarchicalGraph graph(test::makeGrid({"...#....",
+                                            "...#....",
+                                            "...#....",
+                                            "...#...."}), 4);
+    const size_t start = graph.getGrid().getIndex(0, 0);
+    const size_t end = graph.getGrid().getIndex(7, 0);
+    const size_t numNodes = graph.getNumNodes();
+    EXPECT_TRUE(graph.getPath(start, end).path.empty());
+
+    graph.setWalkable(3, 2, true);
+    EXPECT_THROW(graph.getPath(start, end), std::runtime_error);
+    graph.update();
+    const PathResults<size_t> results = graph.getPath(start, end);
+    checkPath(graph.getGrid(), results, start, end);
+    EXPECT_NEAR(graph.getGrid().getPath(start, end).distance,
+                results.distance, 0.001);
+
+    graph.setWalkable(3, 2, false);
+    graph.update();
+    EXPECT_TRUE(graph.getPath(start, end).path.empty());
+    EXPECT_EQ(numNodes, graph.getNumNodes());
+}
+
+TEST(HierarchicalGraph, Random)
+{
+    // Every path the full search finds must also be found here, and not
+    // be much longer.
+    std::srand(1234);
+    GridGraph grid(64, 48);
+    for (size_t y = 0; y < grid.getHeight(); ++y)
+    {
+        for (size_t x = 0; x < grid.getWidth(); ++x)
+        {
+            grid.setWalkable(x, y, std::rand() % 100 >= 30);
+        }
+    }
+
+    HierarchicalGraph graph(grid, 8);
+    HierarchicalGraph::Search search;
+    for (size_t ii = 0; ii < 300; ++ii)
+    {
+        // Knock holes in the map now and then to exercise rebuilding
+        if (ii % 50 == 49)
+        {
+            const size_t x = std::rand() % grid.getWidth();
+            const size_t y = std::rand() % grid.getHeight();
+            const bool walkable = !grid.isWalkable(x, y);
+            grid.setWalkable(x, y, walkable);
+            graph.setWalkable(x, y, walkable);
+            graph.update();
+        }
+
+        const size_t start = std::rand() % (grid.getWidth() * grid.getHeight());
+        const size_t end = std::rand() % (grid.getWidth() * grid.getHeight());
+        const PathResults<size_t> expected = grid.getPath(start, end);
+        const PathResults<size_t> results =
+                graph.getPath(start, end, search);
+        ASSERT_EQ(expected.path.empty(), results.path.empty());
+        if (!expected.path.empty())
+        {
+            checkPath(grid, results, start, end);
+            EXPECT_LE(results.distance, expected.distance * 1.5 + 0.001);
+        }
+    }
+}
+
+TEST(HierarchicalGraph, PathLength)
+{
+    // Paths through walls of random length, at every cluster size, should
+    // stay within the bound in the getPath docs and be close on average.
+    std::srand(4321);
+    GridGraph grid(96, 96);
+    for (size_t y = 0; y < grid.getHeight(); ++y)
+    {
+        for (size_t x = 0; x < grid.getWidth(); ++x)
+        {
+            grid.setWalkable(x, y, true);
+        }
+    }
+
+    for (size_t ii = 0; ii < 120; ++ii)
+    {
+        const size_t x = std::rand() % grid.getWidth();
+        const size_t y = std::rand() % grid.getHeight();
+        const size_t length = 3 + std::rand() % 20;
+        const bool horizontal = std::rand() % 2 == 0;
+        for (size_t jj = 0; jj < length; ++jj)
+        {
+            grid.setWalkable(std::min(x + (horizontal ? jj : 0),
+                                      grid.getWidth() - 1),
+                             std::min(y + (horizontal ? 0 : jj),
+                                      grid.getHeight() - 1),
+                             false);
+        }
+    }
+
+    double ratios = 0.0;
+    size_t numPaths = 0;
+    for (size_t clusterSize = 2; clusterSize <= 16; clusterSize += 2)
+    {
+        HierarchicalGraph graph(grid, clusterSize);
+        for (size_t ii = 0; ii < 100; ++ii)
+        {
+            const size_t numCells = grid.getWidth() * grid.getHeight();
+            const size_t start = std::rand() % numCells;
+            const size_t end = std::rand() % numCells;
+            const PathResults<size_t> expected = grid.getPath(start, end);
+            const PathResults<size_t> results = graph.getPath(start, end);
+            ASSERT_EQ(expected.path.empty(), results.path.empty());
+            if (expected.path.empty() || start == end)
+            {
+                continue;
+            }
+
+            checkPath(grid, results, start, end);
+            EXPECT_LE(results.distance, expected.distance * 1.5 + 0.001);
+            ratios += results.distance / expected.distance;
+            ++numPaths;
+        }
+    }
+    EXPECT_LT(ratios / numPaths, 1.02);
+}
+}
+}
+
+NYRA_TEST()
@@ -19,6 +19,8 @@
  * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
  * IN THE SOFTWARE.
  */
+#include <type_traits>
+#include <gmtl/MatrixOps.h>
 #include <nyra/math/Matrix.h>
 #include <nyra/test/Test.h>
 
@@ -77,6 +79,82 @@ TEST(Matrix, Multiply)
     EXPECT_EQ(m1, ans);
 }
 
+TEST(Matrix, Multiply4x4)
+{
+    // Check the SIMD path against a double precision reference
+    Matrix<float, 4, 4> m1;
+    Matrix<float, 4, 4> m2;
+    Matrix<double, 4, 4> r1;
+    Matrix<double, 4, 4> r2;
+    for (size_t ii = 0; ii < 4; ++ii)
+    {
+        for (size_t jj = 0; jj < 4; ++jj)
+        {
+            m1(ii, jj) = r1(ii, jj) = (ii * 4) + jj + 1;
+            m2(ii, jj) = r2(ii, jj) = 16.0 - (ii * 4) - jj;
+        }
+    }
+
+    m1 *= m2;
+    r1 *= r2;
+    for (size_t ii = 0; ii < 4; ++ii)
+    {
+        for (size_t jj = 0; jj < 4; ++jj)
+        {
+            EXPECT_DOUBLE_EQ(r1(ii, jj), m1(ii, jj));
+        }
+    }
+
+    // Multiplying by itself must not read the partially written result
+    Matrix<float, 4, 4> square = m2;
+    square *= square;
+    r2 *= Matrix<double, 4, 4>(r2);
+    EXPECT_DOUBLE_EQ(r2(1, 2), square(1, 2));
+}
+
+TEST(Matrix, Layout)
+{
+    EXPECT_TRUE((std::is_trivially_copyable<Matrix<float, 3, 3> >::value));
+    EXPECT_TRUE((std::is_trivially_copyable<Matrix<float, 4, 4> >::value));
+    EXPECT_EQ(sizeof(float) * 9, sizeof(Matrix<float, 3, 3>));
+    EXPECT_EQ(sizeof(float) * 16, sizeof(Matrix<float, 4, 4>));
+    EXPECT_EQ(static_cast<size_t>(16), alignof(Matrix<float, 4, 4>));
+}
+
+TEST(Matrix, Native)
+{
+    const Matrix<float, 3, 3> matrix = get();
+    const Matrix<float, 3, 3> copy(matrix.getNative());
+    EXPECT_EQ(matrix, copy);
+    EXPECT_EQ(2.0f, matrix.getNative()(0, 1));
+}
+
+TEST(Matrix, NativeInvert)
+{
+    // gmtl picks how to invert from the state of the matrix. If getNative
+    // left it as an identity, invert would hand back the input.
+    Matrix<float, 3, 3> matrix;
+    matrix(0, 0) = 2.0f;
+    matrix(0, 2) = 5.0f;
+    matrix(1, 1) = 4.0f;
+    matrix(1, 2) = -3.0f;
+
+    gmtl::Matrix<float, 3, 3> native = matrix.getNative();
+    gmtl::invert(native);
+    Matrix<float, 3, 3> inverse;
+    inverse.setNative(native);
+
+    Matrix<float, 3, 3> product = matrix;
+    product *= inverse;
+    for (size_t ii = 0; ii < 3; ++ii)
+    {
+        for (size_t jj = 0; jj < 3; ++jj)
+        {
+            EXPECT_NEAR(ii == jj ? 1.0f : 0.0f, product(ii, jj), 1e-6f);
+        }
+    }
+}
+
 TEST(Matrix, Archive)
 {
     Matrix<float, 3, 3> input = get();
@@ -78,6 +78,36 @@ TEST(Matrix3x3, Transform)
     EXPECT_EQ(exAll, all);
 }
 
+TEST(Matrix3x3, Constexpr)
+{
+    constexpr Matrix3x3 identity = Matrix3x3::identity();
+    static_assert(identity(0, 0) == 1.0f && identity(0, 1) == 0.0f,
+                  "Identity should be built at compile time");
+    EXPECT_EQ(Matrix3x3(), identity);
+
+    constexpr Matrix3x3 translation = Matrix3x3::translation(2.0f, 3.0f);
+    static_assert(translation(0, 2) == 2.0f && translation(1, 2) == 3.0f,
+                  "Translation should be built at compile time");
+    Matrix3x3 expected;
+    expected.transform(Vector2F(2.0f, 3.0f), Vector2F(1.0f), 0.0f,
+                       Vector2F());
+    EXPECT_EQ(expected, translation);
+}
+
+TEST(Matrix3x3, Compose)
+{
+    Matrix3x3 parent;
+    parent.transform(Vector2F(5.0f, -2.0f), Vector2F(2.0f, 3.0f), 30.0f,
+                     Vector2F(1.0f, 4.0f));
+    Matrix3x3 local;
+    local.transform(Vector2F(-7.0f, 1.0f), Vector2F(0.5f, 1.5f), 200.0f,
+                    Vector2F(-3.0f, 2.0f));
+
+    Matrix3x3 composed;
+    composed.compose(parent, local);
+    EXPECT_EQ(Matrix3x3(local * parent), composed);
+}
+
 TEST(Matrix3x3, Archive)
 {
     Matrix3x3 input(1.0f, 2.0f, 3.0f,
@@ -83,6 +83,37 @@ TEST(Matrix4x4, Transform)
     EXPECT_EQ(exAll, all);
 }
 
+TEST(Matrix4x4, Constexpr)
+{
+    constexpr Matrix4x4 identity = Matrix4x4::identity();
+    static_assert(identity(3, 3) == 1.0f && identity(3, 0) == 0.0f,
+                  "Identity should be built at compile time");
+    EXPECT_EQ(Matrix4x4(), identity);
+
+    constexpr Matrix4x4 translation =
+            Matrix4x4::translation(2.0f, 3.0f, 4.0f);
+    static_assert(translation(2, 3) == 4.0f,
+                  "Translation should be built at compile time");
+    EXPECT_EQ(Matrix4x4(1.0f, 0.0f, 0.0f, 2.0f,
+                        0.0f, 1.0f, 0.0f, 3.0f,
+                        0.0f, 0.0f, 1.0f, 4.0f,
+                        0.0f, 0.0f, 0.0f, 1.0f), translation);
+}
+
+TEST(Matrix4x4, Compose)
+{
+    Matrix4x4 parent;
+    parent.transform(Vector3F(5.0f, -2.0f, 1.0f),
+                     Vector3F(2.0f, 3.0f, 1.0f),
+                     Vector3F(30.0f, 10.0f, 80.0f),
+                     Vector3F(1.0f, 4.0f, 2.0f));
+    Matrix4x4 local = Matrix4x4::translation(1.0f, 2.0f, 3.0f);
+
+    Matrix4x4 composed;
+    composed.compose(parent, local);
+    EXPECT_EQ(Matrix4x4(local * parent), composed);
+}
+
 TEST(Matrix4x4, Archive)
 {
     Matrix4x4 input(1.0f, 2.0f, 3.0f, 4.0f,
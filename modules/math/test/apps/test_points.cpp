@@ -0,0 +1,122 @@
+/*
+ * Copyright (c) 2018 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#include <cstdlib>
+#include <vector>
+#include <nyra/math/Points.h>
+#include <nyra/test/Test.h>
+
+namespace
+{
+float randomValue()
+{
+    return static_cast<float>(std::rand()) / RAND_MAX * 200.0f - 100.0f;
+}
+
+template <typename MatrixT>
+MatrixT getMatrix(size_t size)
+{
+    MatrixT matrix;
+    for (size_t ii = 0; ii < size; ++ii)
+    {
+        for (size_t jj = 0; jj < size; ++jj)
+        {
+            matrix(ii, jj) = randomValue() / 50.0f;
+        }
+    }
+    return matrix;
+}
+}
+
+namespace nyra
+{
+namespace math
+{
+TEST(Points, Transform3D)
+{
+    const Matrix4x4 matrix = getMatrix<Matrix4x4>(4);
+
+    // Sizes cover an empty batch, the scalar tail, and the threaded path
+    const size_t sizes[] = {0, 1, 7, 1001, (1 << 16) + 3};
+    for (size_t size : sizes)
+    {
+        std::vector<Vector3F> points(size);
+        for (Vector3F& point : points)
+        {
+            point = Vector3F(randomValue(), randomValue(), randomValue());
+        }
+
+        const std::vector<Vector3F> results = transformPoints(matrix, points);
+        ASSERT_EQ(size, results.size());
+        for (size_t ii = 0; ii < size; ++ii)
+        {
+            const Vector3F& p = points[ii];
+            for (size_t jj = 0; jj < 3; ++jj)
+            {
+                const float expected = matrix(jj, 0) * p.x +
+                                       matrix(jj, 1) * p.y +
+                                       matrix(jj, 2) * p.z +
+                                       matrix(jj, 3);
+                ASSERT_NEAR(expected, results[ii][jj], 0.001f);
+            }
+        }
+
+        // In place
+        transformPoints(matrix, points.data(), points.data(), size);
+        EXPECT_EQ(results, points);
+    }
+}
+
+TEST(Points, Transform2D)
+{
+    const Matrix3x3 matrix = getMatrix<Matrix3x3>(3);
+
+    const size_t sizes[] = {0, 3, 9, 1001, (1 << 16) + 1};
+    for (size_t size : sizes)
+    {
+        std::vector<Vector2F> points(size);
+        for (Vector2F& point : points)
+        {
+            point = Vector2F(randomValue(), randomValue());
+        }
+
+        const std::vector<Vector2F> results = transformPoints(matrix, points);
+        ASSERT_EQ(size, results.size());
+        for (size_t ii = 0; ii < size; ++ii)
+        {
+            const Vector2F& p = points[ii];
+            for (size_t jj = 0; jj < 2; ++jj)
+            {
+                const float expected = matrix(jj, 0) * p.x +
+                                       matrix(jj, 1) * p.y +
+                                       matrix(jj, 2);
+                ASSERT_NEAR(expected, results[ii][jj], 0.001f);
+            }
+        }
+
+        transformPoints(matrix, points.data(), points.data(), size);
+        EXPECT_EQ(results, points);
+    }
+}
+}
+}
+
+NYRA_TEST()
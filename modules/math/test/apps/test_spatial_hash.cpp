@@ -0,0 +1,229 @@
+/*
+ * Copyright (c) 2018 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#include <algorithm>
+#include <cstdlib>
+#include <nyra/math/SpatialHash.h>
+#include <nyra/test/Test.h>
+
+namespace
+{
+struct Box
+{
+    float minX;
+    float minY;
+    float maxX;
+    float maxY;
+    uint32_t groups;
+};
+
+float random(float max)
+{
+    return static_cast<float>(std::rand()) / RAND_MAX * max;
+}
+
+bool overlaps(const Box& a, const Box& b)
+{
+    return a.minX <= b.maxX && b.minX <= a.maxX &&
+           a.minY <= b.maxY && b.minY <= a.maxY;
+}
+}
+
+namespace nyra
+{
+namespace math
+{
+TEST(SpatialHash, Rect)
+{
+    SpatialHash hash(10.0f);
+    hash.insert(1, 0.0f, 0.0f, 5.0f, 5.0f);
+    hash.insert(2, 8.0f, 8.0f, 25.0f, 12.0f);
+    hash.insert(3, -30.0f, -30.0f, -20.0f, -20.0f);
+    EXPECT_EQ(static_cast<size_t>(3), hash.getSize());
+
+    std::vector<uint32_t> results;
+    hash.queryRect(4.0f, 4.0f, 9.0f, 9.0f, results);
+    std::sort(results.begin(), results.end());
+    ASSERT_EQ(static_cast<size_t>(2), results.size());
+    EXPECT_EQ(static_cast<uint32_t>(1), results[0]);
+    EXPECT_EQ(static_cast<uint32_t>(2), results[1]);
+
+    // The wide box covers several cells but only comes back once
+    results.clear();
+    hash.queryRect(0.0f, 0.0f, 30.0f, 30.0f, results);
+    EXPECT_EQ(static_cast<size_t>(2), results.size());
+
+    results.clear();
+    hash.queryRect(-25.0f, -25.0f, -24.0f, -24.0f, results);
+    ASSERT_EQ(static_cast<size_t>(1), results.size());
+    EXPECT_EQ(static_cast<uint32_t>(3), results[0]);
+
+    hash.clear();
+    results.clear();
+    hash.queryRect(0.0f, 0.0f, 30.0f, 30.0f, results);
+    EXPECT_TRUE(results.empty());
+}
+
+TEST(SpatialHash, Radius)
+{
+    SpatialHash hash(4.0f);
+    hash.insert(1, 0.0f, 0.0f, 1.0f, 1.0f);
+    hash.insert(2, 3.0f, 3.0f, 4.0f, 4.0f);
+
+    // The second box is inside the bounds of the circle but not the circle
+    std::vector<uint32_t> results;
+    hash.queryRadius(0.0f, 0.0f, 4.0f, results);
+    ASSERT_EQ(static_cast<size_t>(1), results.size());
+    EXPECT_EQ(static_cast<uint32_t>(1), results[0]);
+
+    results.clear();
+    hash.queryRadius(0.0f, 0.0f, 4.3f, results);
+    EXPECT_EQ(static_cast<size_t>(2), results.size());
+}
+
+TEST(SpatialHash, LargeRect)
+{
+    // A query far bigger than the boxes scans them instead of the cells.
+    // The result has to be the same either way.
+    std::srand(7);
+    std::vector<Box> boxes;
+    SpatialHash hash(128.0f);
+    for (uint32_t ii = 0; ii < 200; ++ii)
+    {
+        const float x = random(20000.0f) - 10000.0f;
+        const float y = random(20000.0f) - 10000.0f;
+        const Box box = {x, y, x + random(64.0f), y + random(64.0f),
+                         ii % 2 == 0 ? 2u : 1u};
+        boxes.push_back(box);
+        hash.insert(ii, box.minX, box.minY, box.maxX, box.maxY, box.groups);
+    }
+
+    const Box areas[] = {{-1.0e30f, -1.0e30f, 1.0e30f, 1.0e30f, 0},
+                         {-10000.0f, -10000.0f, 0.0f, 10000.0f, 0},
+                         {-500.0f, -500.0f, 500.0f, 500.0f, 0}};
+    for (const Box& area : areas)
+    {
+        std::vector<uint32_t> results;
+        hash.queryRect(area.minX, area.minY, area.maxX, area.maxY,
+                       results, 2);
+        std::sort(results.begin(), results.end());
+
+        std::vector<uint32_t> expected;
+        for (uint32_t ii = 0; ii < boxes.size(); ++ii)
+        {
+            if ((boxes[ii].groups & 2) && overlaps(area, boxes[ii]))
+            {
+                expected.push_back(ii);
+            }
+        }
+        EXPECT_EQ(expected, results);
+    }
+
+    // The circle still drops the boxes in the corners of its bounds
+    std::vector<uint32_t> results;
+    hash.queryRadius(0.0f, 0.0f, 10000.0f, results);
+    for (uint32_t id : results)
+    {
+        const float x = std::max(boxes[id].minX,
+                                 std::min(0.0f, boxes[id].maxX));
+        const float y = std::max(boxes[id].minY,
+                                 std::min(0.0f, boxes[id].maxY));
+        EXPECT_LE(x * x + y * y, 10000.0f * 10000.0f);
+    }
+    EXPECT_FALSE(results.empty());
+    EXPECT_LT(results.size(), boxes.size());
+}
+
+TEST(SpatialHash, Random)
+{
+    // Compare everything against checking every box
+    std::srand(99);
+    std::vector<Box> boxes;
+    SpatialHash hash(16.0f);
+    for (uint32_t ii = 0; ii < 500; ++ii)
+    {
+        const float x = random(400.0f) - 200.0f;
+        const float y = random(400.0f) - 200.0f;
+        const Box box = {x, y, x + random(30.0f), y + random(30.0f),
+                         ii % 3 == 0 ? 2u : 1u};
+        boxes.push_back(box);
+        hash.insert(ii, box.minX, box.minY, box.maxX, box.maxY, box.groups);
+    }
+
+    for (size_t query = 0; query < 50; ++query)
+    {
+        const float x = random(400.0f) - 200.0f;
+        const float y = random(400.0f) - 200.0f;
+        const Box area = {x, y, x + random(80.0f), y + random(80.0f), 0};
+
+        std::vector<uint32_t> results;
+        hash.queryRect(area.minX, area.minY, area.maxX, area.maxY,
+                       results, 2);
+        std::sort(results.begin(), results.end());
+
+        std::vector<uint32_t> expected;
+        for (uint32_t ii = 0; ii < boxes.size(); ++ii)
+        {
+            if ((boxes[ii].groups & 2) && overlaps(area, boxes[ii]))
+            {
+                expected.push_back(ii);
+            }
+        }
+        EXPECT_EQ(expected, results);
+    }
+
+    std::vector<std::pair<uint32_t, uint32_t> > pairs;
+    hash.queryPairs(2, 1, pairs);
+    std::sort(pairs.begin(), pairs.end());
+
+    std::vector<std::pair<uint32_t, uint32_t> > expected;
+    for (uint32_t ii = 0; ii < boxes.size(); ++ii)
+    {
+        for (uint32_t jj = 0; jj < boxes.size(); ++jj)
+        {
+            if (boxes[ii].groups == 2 && boxes[jj].groups == 1 &&
+                overlaps(boxes[ii], boxes[jj]))
+            {
+                expected.push_back(std::make_pair(ii, jj));
+            }
+        }
+    }
+    std::sort(expected.begin(), expected.end());
+    EXPECT_FALSE(expected.empty());
+    EXPECT_EQ(expected, pairs);
+
+    // Every overlapping pair once
+    pairs.clear();
+    hash.queryPairs(SpatialHash::ALL_GROUPS, SpatialHash::ALL_GROUPS, pairs);
+    size_t count = 0;
+    for (uint32_t ii = 0; ii < boxes.size(); ++ii)
+    {
+        for (uint32_t jj = ii + 1; jj < boxes.size(); ++jj)
+        {
+            count += overlaps(boxes[ii], boxes[jj]) ? 1 : 0;
+        }
+    }
+    EXPECT_EQ(count, pairs.size());
+}
+}
+}
+
+NYRA_TEST()
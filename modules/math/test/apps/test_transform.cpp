@@ -185,6 +185,58 @@ TEST(Transform3D, ScaledSize)
     EXPECT_EQ(math::Vector3F(20.0f, 60.0f, 15.0f), transform.getScaledSize());
 }
 
+TEST(Transform2D, RotationChanges)
+{
+    const Transform2D identity;
+    Transform2D transform;
+    transform.setRotation(90.0f);
+    transform.updateTransform(identity);
+    EXPECT_EQ(Matrix3x3(0.0f, -1.0f, 0.0f,
+                        1.0f, 0.0f, 0.0f,
+                        0.0f, 0.0f, 1.0f), transform.getMatrix());
+
+    // Moving reuses the cached rotation
+    transform.setPosition(Vector2F(3.0f, 4.0f));
+    transform.updateTransform(identity);
+    EXPECT_EQ(Matrix3x3(0.0f, -1.0f, 3.0f,
+                        1.0f, 0.0f, 4.0f,
+                        0.0f, 0.0f, 1.0f), transform.getMatrix());
+
+    transform.rotateBy(90.0f);
+    transform.updateTransform(identity);
+    EXPECT_EQ(Matrix3x3(-1.0f, 0.0f, 3.0f,
+                        0.0f, -1.0f, 4.0f,
+                        0.0f, 0.0f, 1.0f), transform.getMatrix());
+
+    // The parent is applied after the child
+    Transform2D parent;
+    parent.setPosition(Vector2F(10.0f, 20.0f));
+    parent.updateTransform(identity);
+    transform.updateTransform(parent);
+    EXPECT_EQ(Matrix3x3(-1.0f, 0.0f, 13.0f,
+                        0.0f, -1.0f, 24.0f,
+                        0.0f, 0.0f, 1.0f), transform.getMatrix());
+}
+
+TEST(Transform3D, RotationChanges)
+{
+    const Transform3D identity;
+    Transform3D transform;
+    transform.setYaw(90.0f);
+    transform.updateTransform(identity);
+
+    Matrix4x4 expected;
+    expected.transform(Vector3F(), Vector3F(1.0f),
+                       Vector3F(0.0f, 90.0f, 0.0f), Vector3F());
+    EXPECT_EQ(expected, transform.getMatrix());
+
+    transform.setRoll(-90.0f);
+    transform.updateTransform(identity);
+    expected.transform(Vector3F(), Vector3F(1.0f),
+                       Vector3F(0.0f, 90.0f, 270.0f), Vector3F());
+    EXPECT_EQ(expected, transform.getMatrix());
+}
+
 TEST(Transform, DirtyFlag)
 {
     Transform2D transform;
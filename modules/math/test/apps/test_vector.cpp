@@ -19,6 +19,9 @@
  * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
  * IN THE SOFTWARE.
  */
+#include <type_traits>
+#include <vector>
+#include <string.h>
 #include <nyra/math/Vector.h>
 #include <nyra/test/Test.h>
 
@@ -104,6 +107,37 @@ TEST(Vector, Size)
     EXPECT_EQ(static_cast<size_t>(3), vec3.size());
 }
 
+TEST(Vector, Layout)
+{
+    EXPECT_TRUE((std::is_trivially_copyable<Vector<float, 2> >::value));
+    EXPECT_TRUE((std::is_trivially_copyable<Vector<float, 3> >::value));
+    EXPECT_TRUE((std::is_trivially_copyable<Vector<double, 4> >::value));
+    EXPECT_EQ(sizeof(float) * 2, sizeof(Vector<float, 2>));
+    EXPECT_EQ(sizeof(float) * 3, sizeof(Vector<float, 3>));
+    EXPECT_EQ(sizeof(float) * 4, sizeof(Vector<float, 4>));
+    EXPECT_EQ(static_cast<size_t>(16), alignof(Vector<float, 4>));
+
+    // Arrays of vectors are tightly packed and can be copied as bytes
+    std::vector<Vector<float, 3> > input(8);
+    for (size_t ii = 0; ii < input.size(); ++ii)
+    {
+        input[ii][0] = ii;
+        input[ii][1] = ii * 2.0f;
+        input[ii][2] = ii * 3.0f;
+    }
+    std::vector<Vector<float, 3> > output(input.size());
+    memcpy(&output[0], &input[0], input.size() * sizeof(input[0]));
+    EXPECT_EQ(input, output);
+    EXPECT_EQ(8.0f, (&input[0][0])[8 * 3 - 3] + 1.0f);
+}
+
+TEST(Vector, Native)
+{
+    const Vector<float, 2> vec = get2(3.0f, 4.0f);
+    const Vector<float, 2> copy(vec.getNative());
+    EXPECT_EQ(vec, copy);
+}
+
 TEST(Vector, Archive)
 {
     Vector<float, 2> input = get2(1.234f, 5.678);
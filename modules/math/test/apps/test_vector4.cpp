@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2018 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#include <nyra/math/Vector4.h>
+#include <nyra/test/Test.h>
+
+namespace nyra
+{
+namespace math
+{
+TEST(Vector4, Construction)
+{
+    const Vector4F vecF(5.67f, 1.23f, 4.56f, 7.89f);
+    EXPECT_EQ(vecF.x, 5.67f);
+    EXPECT_EQ(vecF.y, 1.23f);
+    EXPECT_EQ(vecF.z, 4.56f);
+    EXPECT_EQ(vecF.w, 7.89f);
+    const Vector4I vecI(-345, 987, 342, 12);
+    EXPECT_EQ(vecI.x, -345);
+    EXPECT_EQ(vecI.y, 987);
+    EXPECT_EQ(vecI.z, 342);
+    EXPECT_EQ(vecI.w, 12);
+    const Vector4F vec(1.5f);
+    EXPECT_EQ(1.5f, vec.x);
+    EXPECT_EQ(1.5f, vec.w);
+    EXPECT_EQ(Vector4F(0.0f), Vector4F());
+}
+
+TEST(Vector4, Arithmetic)
+{
+    Vector4F vec(1.0f, 2.0f, 3.0f, 4.0f);
+    vec += Vector4F(1.0f);
+    EXPECT_EQ(Vector4F(2.0f, 3.0f, 4.0f, 5.0f), vec);
+    vec -= Vector4F(2.0f);
+    EXPECT_EQ(Vector4F(0.0f, 1.0f, 2.0f, 3.0f), vec);
+    vec *= 2.0;
+    EXPECT_EQ(Vector4F(0.0f, 2.0f, 4.0f, 6.0f), vec);
+    vec /= 2.0;
+    EXPECT_EQ(Vector4F(0.0f, 1.0f, 2.0f, 3.0f), vec);
+    vec *= Vector4F(4.0f, 3.0f, 2.0f, 1.0f);
+    EXPECT_EQ(Vector4F(0.0f, 3.0f, 4.0f, 3.0f), vec);
+    EXPECT_FLOAT_EQ(34.0f, vec.sumSquares());
+    EXPECT_DOUBLE_EQ(21.0, vec.dot(Vector4F(1.0f, 2.0f, 3.0f, 1.0f)));
+
+    // Integer vectors still scale through double
+    Vector4I ints(3, 5, 7, 9);
+    ints *= 0.5;
+    EXPECT_EQ(Vector4I(1, 2, 3, 4), ints);
+}
+
+TEST(Vector4, Archive)
+{
+    Vector4F input(1.234f, 5.678, 8.965, 3.21f);
+    Vector4F output =
+            test::archive<Vector4F>(input);
+    EXPECT_EQ(input, output);
+}
+
+TEST(Vector4, Stdout)
+{
+    Vector4F input(1.234f, 5.678, 2.345, 6.789);
+    std::string out = test::stdout(input);
+    EXPECT_EQ(out, "x=1.234 y=5.678 z=2.345 w=6.789");
+}
+}
+}
+
+NYRA_TEST()
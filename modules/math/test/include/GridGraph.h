@@ -0,0 +1,56 @@
+/*
+ * Copyright (c) 2018 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#ifndef __NYRA_TEST_GRID_GRAPH_H__
+#define __NYRA_TEST_GRID_GRAPH_H__
+
+#include <string>
+#include <vector>
+#include <nyra/math/GridGraph.h>
+
+namespace nyra
+{
+namespace test
+{
+/*
+ *  \func makeGrid
+ *  \brief Builds a grid from rows of text. This is used for unittests.
+ *
+ *  \param rows One string per row. '#' is blocked, anything else is
+ *         walkable. Every row must be the same length.
+ *  \return The grid.
+ */
+inline math::GridGraph makeGrid(const std::vector<std::string>& rows)
+{
+    math::GridGraph grid(rows[0].size(), rows.size());
+    for (size_t y = 0; y < rows.size(); ++y)
+    {
+        for (size_t x = 0; x < rows[y].size(); ++x)
+        {
+            grid.setWalkable(x, y, rows[y][x] != '#');
+        }
+    }
+    return grid;
+}
+}
+}
+
+#endif
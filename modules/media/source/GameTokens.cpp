@@ -116,7 +116,7 @@ GameTokens::GameTokens(const std::string& filename) :
 //===========================================================================//
 void GameTokens::initialize(const std::string& filename)
 {
-    const static std::regex REGEX("([(\\[].*?[)\\]])");
+    static const core::Regex REGEX("([(\\[].*?[)\\]])");
     const std::vector<std::string> tokens =
             core::regexMatches(filename, REGEX);
 
@@ -0,0 +1,635 @@
+/*
+ * Copyright (c) 2018 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#ifndef __NYRA_MEM_FLAT_TREE_H__
+#define __NYRA_MEM_FLAT_TREE_H__
+
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace nyra
+{
+namespace mem
+{
+/*
+ *  \class FlatTree
+ *  \brief A read only version of Tree for parsed documents. Every node
+ *         lives in one contiguous array, keys are interned once per tree
+ *         and children are stored as index ranges. Building happens in a
+ *         single pass with open / setValue / close and the whole tree is
+ *         released at once, so there is no per node allocation, reference
+ *         count or child added event.
+ *
+ *  \tparam TypeT The element type.
+ */
+template <typename TypeT>
+class FlatTree
+{
+public:
+    /*
+     *  \class Node
+     *  \brief A node within the tree. This has the same read interface
+     *         as a const Tree so parsing code can work with either.
+     */
+    class Node
+    {
+    public:
+        /*
+         *  \func Index operator
+         *  \brief Gets the child node with a key.
+         *
+         *  \param index The desired node
+         *  \return The node.
+         */
+        const Node& operator[](const std::string& index) const;
+
+        /*
+         *  \func Index operator
+         *  \brief Gets the list node at an index. If you pass in 0 and
+         *         there is no list, it will return itself. This allows
+         *         you to loop over a single element without knowing if it
+         *         really is a list.
+         *
+         *  \param index The desired node
+         *  \return The node.
+         */
+        const Node& operator[](size_t index) const;
+
+        /*
+         *  \func get
+         *  \brief Gets the underlying object.
+         *
+         *  \return The object.
+         */
+        const TypeT& get() const;
+
+        /*
+         *  \func valid
+         *  \brief Returns true if the node has a value
+         *
+         *  \return true if the node is valid and you can call get().
+         */
+        bool valid() const
+        {
+            return mValue != NONE;
+        }
+
+        /*
+         *  \func keys
+         *  \brief Gets a list of keys for this node.
+         *
+         *  \return The list of keys
+         */
+        std::vector<std::string> keys() const;
+
+        /*
+         *  \func size
+         *  \brief Gets the real size of the list.
+         *
+         *  \return The actual size of the list
+         */
+        size_t size() const
+        {
+            return mListSize;
+        }
+
+        /*
+         *  \func loopSize
+         *  \brief Gets the size of the list component. If the size is 0
+         *         this will return 1.
+         *
+         *  \return The size of the list.
+         */
+        size_t loopSize() const
+        {
+            return std::max<size_t>(mListSize, 1);
+        }
+
+        /*
+         *  \func has
+         *  \brief Returns true if the index is a child node
+         *
+         *  \param index The index to check
+         *  \return true If the index is found.
+         */
+        bool has(const std::string& index) const
+        {
+            return find(index) != nullptr;
+        }
+
+    private:
+        friend class FlatTree<TypeT>;
+
+        const Node* find(const std::string& index) const;
+
+        const FlatTree<TypeT>* mTree;
+        uint32_t mValue;
+        uint32_t mMapBegin;
+        uint32_t mMapSize;
+        uint32_t mListBegin;
+        uint32_t mListSize;
+    };
+
+    /*
+     *  \func Constructor
+     *  \brief Creates a tree with an empty root that is open for building.
+     */
+    FlatTree()
+    {
+        clear();
+    }
+
+    /*
+     *  \func Copy Constructor
+     *  \brief Copies the tree and points the nodes at the copy.
+     */
+    FlatTree(const FlatTree<TypeT>& other) :
+        mNodes(other.mNodes),
+        mValues(other.mValues),
+        mEntries(other.mEntries),
+        mChildren(other.mChildren),
+        mKeys(other.mKeys),
+        mKeyIds(other.mKeyIds),
+        mLevels(other.mLevels),
+        mDepth(other.mDepth)
+    {
+        repoint();
+    }
+
+    /*
+     *  \func Move Constructor
+     *  \brief Takes the storage of another tree.
+     */
+    FlatTree(FlatTree<TypeT>&& other) :
+        mNodes(std::move(other.mNodes)),
+        mValues(std::move(other.mValues)),
+        mEntries(std::move(other.mEntries)),
+        mChildren(std::move(other.mChildren)),
+        mKeys(std::move(other.mKeys)),
+        mKeyIds(std::move(other.mKeyIds)),
+        mLevels(std::move(other.mLevels)),
+        mDepth(other.mDepth)
+    {
+        repoint();
+        other.clear();
+    }
+
+    /*
+     *  \func Assignment Operator
+     *  \brief Copies the tree and points the nodes at the copy.
+     */
+    FlatTree<TypeT>& operator=(const FlatTree<TypeT>& other)
+    {
+        if (this != &other)
+        {
+            FlatTree<TypeT> copy(other);
+            *this = std::move(copy);
+        }
+        return *this;
+    }
+
+    /*
+     *  \func Assignment Operator
+     *  \brief Takes the storage of another tree.
+     */
+    FlatTree<TypeT>& operator=(FlatTree<TypeT>&& other)
+    {
+        if (this != &other)
+        {
+            mNodes = std::move(other.mNodes);
+            mValues = std::move(other.mValues);
+            mEntries = std::move(other.mEntries);
+            mChildren = std::move(other.mChildren);
+            mKeys = std::move(other.mKeys);
+            mKeyIds = std::move(other.mKeyIds);
+            mLevels = std::move(other.mLevels);
+            mDepth = other.mDepth;
+            repoint();
+            other.clear();
+        }
+        return *this;
+    }
+
+    /*
+     *  \func getRoot
+     *  \brief Gets the root node.
+     *
+     *  \return The root
+     */
+    const Node& getRoot() const
+    {
+        return mNodes[0];
+    }
+
+    /*
+     *  \func Index operator
+     *  \brief Gets a child of the root.
+     *
+     *  \param index The desired node
+     *  \return The node.
+     */
+    const Node& operator[](const std::string& index) const
+    {
+        return getRoot()[index];
+    }
+
+    /*
+     *  \func Index operator
+     *  \brief Gets a list item of the root.
+     *
+     *  \param index The desired node
+     *  \return The node.
+     */
+    const Node& operator[](size_t index) const
+    {
+        return getRoot()[index];
+    }
+
+    /*
+     *  \func get
+     *  \brief Gets the value of the root.
+     *
+     *  \return The object.
+     */
+    const TypeT& get() const
+    {
+        return getRoot().get();
+    }
+
+    /*
+     *  \func valid
+     *  \brief Returns true if the root has a value.
+     */
+    bool valid() const
+    {
+        return getRoot().valid();
+    }
+
+    /*
+     *  \func keys
+     *  \brief Gets the keys of the root.
+     */
+    std::vector<std::string> keys() const
+    {
+        return getRoot().keys();
+    }
+
+    /*
+     *  \func size
+     *  \brief Gets the list size of the root.
+     */
+    size_t size() const
+    {
+        return getRoot().size();
+    }
+
+    /*
+     *  \func loopSize
+     *  \brief Gets the loop size of the root.
+     */
+    size_t loopSize() const
+    {
+        return getRoot().loopSize();
+    }
+
+    /*
+     *  \func has
+     *  \brief Returns true if the root has a child with this key.
+     */
+    bool has(const std::string& index) const
+    {
+        return getRoot().has(index);
+    }
+
+    /*
+     *  \func open
+     *  \brief Starts a keyed child of the node being built. If the key
+     *         is used twice in the same node the last one wins.
+     *
+     *  \param key The key of the child
+     */
+    void open(const std::string& key)
+    {
+        const uint32_t node = addNode();
+        mLevels[mDepth].map.push_back(Entry(intern(key), node));
+        push(node);
+    }
+
+    /*
+     *  \func openItem
+     *  \brief Starts the next list item of the node being built.
+     */
+    void openItem()
+    {
+        const uint32_t node = addNode();
+        mLevels[mDepth].list.push_back(node);
+        push(node);
+    }
+
+    /*
+     *  \func setValue
+     *  \brief Sets the value of the node being built.
+     *
+     *  \param value The value
+     */
+    void setValue(const TypeT& value)
+    {
+        setValue(TypeT(value));
+    }
+
+    /*
+     *  \func setValue
+     *  \brief Sets the value of the node being built.
+     *
+     *  \param value The value
+     */
+    void setValue(TypeT&& value)
+    {
+        Node& node = mNodes[mLevels[mDepth].node];
+        if (node.mValue == NONE)
+        {
+            node.mValue = static_cast<uint32_t>(mValues.size());
+            mValues.push_back(std::move(value));
+        }
+        else
+        {
+            mValues[node.mValue] = std::move(value);
+        }
+    }
+
+    /*
+     *  \func close
+     *  \brief Finishes the node being built. Its children are written
+     *         out next to each other and it can no longer be changed.
+     *         Closing the root finishes the tree.
+     */
+    void close()
+    {
+        Level& level = mLevels[mDepth];
+        Node& node = mNodes[level.node];
+
+        // Sort by key id so lookups can binary search. The stable sort
+        // keeps the last duplicate at the back of its run.
+        std::stable_sort(level.map.begin(), level.map.end(),
+                         [](const Entry& lhs, const Entry& rhs)
+                         {
+                             return lhs.first < rhs.first;
+                         });
+
+        node.mMapBegin = static_cast<uint32_t>(mEntries.size());
+        for (size_t ii = 0; ii < level.map.size(); ++ii)
+        {
+            if (ii + 1 < level.map.size() &&
+                level.map[ii].first == level.map[ii + 1].first)
+            {
+                continue;
+            }
+            mEntries.push_back(level.map[ii]);
+        }
+        node.mMapSize = static_cast<uint32_t>(mEntries.size()) -
+                node.mMapBegin;
+
+        node.mListBegin = static_cast<uint32_t>(mChildren.size());
+        node.mListSize = static_cast<uint32_t>(level.list.size());
+        mChildren.insert(mChildren.end(),
+                         level.list.begin(), level.list.end());
+
+        level.map.clear();
+        level.list.clear();
+
+        if (mDepth > 0)
+        {
+            --mDepth;
+        }
+    }
+
+    /*
+     *  \func finish
+     *  \brief Closes every open node including the root.
+     */
+    void finish()
+    {
+        while (mDepth > 0)
+        {
+            close();
+        }
+        close();
+    }
+
+    /*
+     *  \func clear
+     *  \brief Releases every node at once and reopens an empty root.
+     *         Capacity is kept so the tree can be reused for the next
+     *         document.
+     */
+    void clear()
+    {
+        mNodes.clear();
+        mValues.clear();
+        mEntries.clear();
+        mChildren.clear();
+        mKeys.clear();
+        mKeyIds.clear();
+        mDepth = 0;
+
+        if (mLevels.empty())
+        {
+            mLevels.resize(1);
+        }
+        for (Level& level : mLevels)
+        {
+            level.map.clear();
+            level.list.clear();
+        }
+        mLevels[0].node = addNode();
+    }
+
+    /*
+     *  \func getNumNodes
+     *  \brief Gets the number of nodes including the root.
+     *
+     *  \return The number of nodes
+     */
+    size_t getNumNodes() const
+    {
+        return mNodes.size();
+    }
+
+private:
+    static const uint32_t NONE = 0xFFFFFFFF;
+
+    typedef std::pair<uint32_t, uint32_t> Entry;
+
+    struct Level
+    {
+        uint32_t node;
+        std::vector<Entry> map;
+        std::vector<uint32_t> list;
+    };
+
+    uint32_t addNode()
+    {
+        Node node;
+        node.mTree = this;
+        node.mValue = NONE;
+        node.mMapBegin = 0;
+        node.mMapSize = 0;
+        node.mListBegin = 0;
+        node.mListSize = 0;
+        mNodes.push_back(node);
+        return static_cast<uint32_t>(mNodes.size() - 1);
+    }
+
+    void push(uint32_t node)
+    {
+        ++mDepth;
+        if (mLevels.size() <= mDepth)
+        {
+            mLevels.resize(mDepth + 1);
+        }
+        mLevels[mDepth].node = node;
+    }
+
+    uint32_t intern(const std::string& key)
+    {
+        const auto iter = mKeyIds.find(key);
+        if (iter != mKeyIds.end())
+        {
+            return iter->second;
+        }
+
+        const uint32_t id = static_cast<uint32_t>(mKeys.size());
+        mKeys.push_back(key);
+        mKeyIds.insert(std::make_pair(key, id));
+        return id;
+    }
+
+    void repoint()
+    {
+        for (Node& node : mNodes)
+        {
+            node.mTree = this;
+        }
+    }
+
+    std::vector<Node> mNodes;
+    std::vector<TypeT> mValues;
+    std::vector<Entry> mEntries;
+    std::vector<uint32_t> mChildren;
+    std::vector<std::string> mKeys;
+    std::unordered_map<std::string, uint32_t> mKeyIds;
+    std::vector<Level> mLevels;
+    size_t mDepth;
+};
+
+template <typename TypeT>
+const uint32_t FlatTree<TypeT>::NONE;
+
+//===========================================================================//
+template <typename TypeT>
+const typename FlatTree<TypeT>::Node*
+FlatTree<TypeT>::Node::find(const std::string& index) const
+{
+    const auto key = mTree->mKeyIds.find(index);
+    if (key == mTree->mKeyIds.end())
+    {
+        return nullptr;
+    }
+
+    const Entry* begin = mTree->mEntries.data() + mMapBegin;
+    const Entry* end = begin + mMapSize;
+    const Entry* entry = std::lower_bound(
+            begin, end, Entry(key->second, 0),
+            [](const Entry& lhs, const Entry& rhs)
+            {
+                return lhs.first < rhs.first;
+            });
+
+    if (entry == end || entry->first != key->second)
+    {
+        return nullptr;
+    }
+    return &mTree->mNodes[entry->second];
+}
+
+//===========================================================================//
+template <typename TypeT>
+const typename FlatTree<TypeT>::Node&
+FlatTree<TypeT>::Node::operator[](const std::string& index) const
+{
+    const Node* node = find(index);
+    if (!node)
+    {
+        throw std::runtime_error("Node: " + index + " does not exist.");
+    }
+    return *node;
+}
+
+//===========================================================================//
+template <typename TypeT>
+const typename FlatTree<TypeT>::Node&
+FlatTree<TypeT>::Node::operator[](size_t index) const
+{
+    if (index == 0 && mListSize == 0)
+    {
+        return *this;
+    }
+
+    if (index >= mListSize)
+    {
+        throw std::runtime_error(
+                "Index " + std::to_string(index) + " is out of bounds");
+    }
+    return mTree->mNodes[mTree->mChildren[mListBegin + index]];
+}
+
+//===========================================================================//
+template <typename TypeT>
+const TypeT& FlatTree<TypeT>::Node::get() const
+{
+    if (mValue == NONE)
+    {
+        throw std::runtime_error("Value has not been initialized");
+    }
+    return mTree->mValues[mValue];
+}
+
+//===========================================================================//
+template <typename TypeT>
+std::vector<std::string> FlatTree<TypeT>::Node::keys() const
+{
+    std::vector<std::string> keys;
+    keys.reserve(mMapSize);
+    for (uint32_t ii = 0; ii < mMapSize; ++ii)
+    {
+        keys.push_back(mTree->mKeys[mTree->mEntries[mMapBegin + ii].first]);
+    }
+    return keys;
+}
+}
+}
+
+#endif
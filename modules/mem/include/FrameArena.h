@@ -0,0 +1,151 @@
+/*
+ * Copyright (c) 2018 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#ifndef __NYRA_MEM_FRAME_ARENA_H__
+#define __NYRA_MEM_FRAME_ARENA_H__
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace nyra
+{
+namespace mem
+{
+/*
+ *  \class FrameArena
+ *  \brief A bump allocator for memory that only lives for one frame.
+ *         Allocating moves a pointer and reset hands everything back at
+ *         once. Blocks are kept across resets so an arena that has seen
+ *         its busiest frame does not allocate again.
+ */
+class FrameArena
+{
+public:
+    /*
+     *  \func Constructor
+     *  \brief Creates an empty arena.
+     *
+     *  \param blockSize The size in bytes of each block. Larger requests
+     *         get a block of their own.
+     */
+    explicit FrameArena(size_t blockSize = 64 * 1024);
+
+    FrameArena(const FrameArena&) = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+
+    /*
+     *  \func allocate
+     *  \brief Gets uninitialized memory that is valid until reset.
+     *
+     *  \param size The number of bytes
+     *  \param alignment The alignment, must be a power of two
+     *  \return The memory
+     */
+    void* allocate(size_t size,
+                   size_t alignment = alignof(std::max_align_t));
+
+    /*
+     *  \func create
+     *  \brief Constructs an object in the arena. Destructors are never
+     *         run, so only trivially destructible types are allowed.
+     *
+     *  \param args The constructor arguments
+     *  \return The object
+     */
+    template <typename TypeT, typename... ArgsT>
+    TypeT* create(ArgsT&&... args)
+    {
+        static_assert(std::is_trivially_destructible<TypeT>::value,
+                      "FrameArena does not run destructors");
+        return new (allocate(sizeof(TypeT), alignof(TypeT)))
+                TypeT(std::forward<ArgsT>(args)...);
+    }
+
+    /*
+     *  \func createArray
+     *  \brief Gets an array of value initialized objects.
+     *
+     *  \param count The number of elements
+     *  \return The first element
+     */
+    template <typename TypeT>
+    TypeT* createArray(size_t count)
+    {
+        static_assert(std::is_trivially_destructible<TypeT>::value,
+                      "FrameArena does not run destructors");
+        TypeT* array = static_cast<TypeT*>(
+                allocate(sizeof(TypeT) * count, alignof(TypeT)));
+        for (size_t ii = 0; ii < count; ++ii)
+        {
+            new (array + ii) TypeT();
+        }
+        return array;
+    }
+
+    /*
+     *  \func reset
+     *  \brief Frees everything allocated since the last reset. Call this
+     *         once per frame.
+     */
+    void reset();
+
+    /*
+     *  \func getUsed
+     *  \brief Gets the number of bytes handed out since the last reset,
+     *         including alignment padding.
+     *
+     *  \return The bytes used
+     */
+    size_t getUsed() const
+    {
+        return mUsed;
+    }
+
+    /*
+     *  \func getCapacity
+     *  \brief Gets the total size of the allocated blocks.
+     *
+     *  \return The capacity in bytes
+     */
+    size_t getCapacity() const;
+
+private:
+    struct Block
+    {
+        std::unique_ptr<uint8_t[]> data;
+        size_t size;
+    };
+
+    const size_t mBlockSize;
+    std::vector<Block> mBlocks;
+    size_t mBlock;
+    size_t mOffset;
+    size_t mUsed;
+};
+}
+}
+
+#endif
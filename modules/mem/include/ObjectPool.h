@@ -0,0 +1,237 @@
+/*
+ * Copyright (c) 2018 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#ifndef __NYRA_MEM_OBJECT_POOL_H__
+#define __NYRA_MEM_OBJECT_POOL_H__
+
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace nyra
+{
+namespace mem
+{
+/*
+ *  \class ObjectPool
+ *  \brief Creates objects out of blocks of preallocated slots. Released
+ *         slots go on a free list and are handed out again by the next
+ *         create, so a pool that has warmed up does not allocate. Objects
+ *         never move once created.
+ *
+ *  \tparam TypeT The pooled object type
+ */
+template <typename TypeT>
+class ObjectPool
+{
+public:
+    /*
+     *  \func Constructor
+     *  \brief Creates an empty pool.
+     *
+     *  \param blockSize The number of objects allocated at a time when
+     *         the pool runs out of free slots.
+     */
+    explicit ObjectPool(size_t blockSize = 64) :
+        mBlockSize(blockSize == 0 ? 1 : blockSize),
+        mFree(nullptr),
+        mSize(0)
+    {
+    }
+
+    ObjectPool(const ObjectPool&) = delete;
+    ObjectPool& operator=(const ObjectPool&) = delete;
+
+    /*
+     *  \func Destructor
+     *  \brief Destroys any objects that were never released.
+     */
+    ~ObjectPool()
+    {
+        clear();
+    }
+
+    /*
+     *  \func create
+     *  \brief Constructs an object in a free slot.
+     *
+     *  \param args The constructor arguments
+     *  \return The object. This stays valid until it is passed to release.
+     */
+    template <typename... ArgsT>
+    TypeT* create(ArgsT&&... args)
+    {
+        if (!mFree)
+        {
+            addBlock(mBlockSize);
+        }
+
+        Slot* slot = mFree;
+        mFree = slot->next;
+
+        try
+        {
+            new (&slot->storage) TypeT(std::forward<ArgsT>(args)...);
+        }
+        catch (...)
+        {
+            slot->next = mFree;
+            mFree = slot;
+            throw;
+        }
+
+        slot->alive = true;
+        ++mSize;
+        return reinterpret_cast<TypeT*>(&slot->storage);
+    }
+
+    /*
+     *  \func release
+     *  \brief Destroys an object and returns its slot to the pool.
+     *
+     *  \param object An object created by this pool. nullptr is ignored.
+     */
+    void release(TypeT* object)
+    {
+        if (!object)
+        {
+            return;
+        }
+
+        // storage is the first member so the object is the slot
+        Slot* slot = reinterpret_cast<Slot*>(object);
+        object->~TypeT();
+        slot->alive = false;
+        slot->next = mFree;
+        mFree = slot;
+        --mSize;
+    }
+
+    /*
+     *  \func reserve
+     *  \brief Makes sure count objects can be alive at once without
+     *         allocating.
+     *
+     *  \param count The number of objects
+     */
+    void reserve(size_t count)
+    {
+        if (count > getCapacity())
+        {
+            addBlock(count - getCapacity());
+        }
+    }
+
+    /*
+     *  \func clear
+     *  \brief Destroys every live object. The memory is kept for reuse.
+     */
+    void clear()
+    {
+        mFree = nullptr;
+        for (size_t ii = mBlocks.size(); ii > 0; --ii)
+        {
+            Block& block = mBlocks[ii - 1];
+            for (size_t jj = block.size; jj > 0; --jj)
+            {
+                Slot& slot = block.slots[jj - 1];
+                if (slot.alive)
+                {
+                    reinterpret_cast<TypeT*>(&slot.storage)->~TypeT();
+                    slot.alive = false;
+                }
+                slot.next = mFree;
+                mFree = &slot;
+            }
+        }
+        mSize = 0;
+    }
+
+    /*
+     *  \func getSize
+     *  \brief Gets the number of live objects
+     *
+     *  \return The number of objects
+     */
+    size_t getSize() const
+    {
+        return mSize;
+    }
+
+    /*
+     *  \func getCapacity
+     *  \brief Gets the number of objects that fit in the allocated blocks
+     *
+     *  \return The number of slots
+     */
+    size_t getCapacity() const
+    {
+        size_t capacity = 0;
+        for (const Block& block : mBlocks)
+        {
+            capacity += block.size;
+        }
+        return capacity;
+    }
+
+private:
+    struct Slot
+    {
+        typename std::aligned_storage<sizeof(TypeT),
+                                      alignof(TypeT)>::type storage;
+        Slot* next;
+        bool alive;
+    };
+
+    struct Block
+    {
+        std::unique_ptr<Slot[]> slots;
+        size_t size;
+    };
+
+    void addBlock(size_t size)
+    {
+        Block block;
+        block.slots.reset(new Slot[size]);
+        block.size = size;
+
+        // Push in reverse so slots are handed out in address order
+        for (size_t ii = size; ii > 0; --ii)
+        {
+            Slot& slot = block.slots[ii - 1];
+            slot.alive = false;
+            slot.next = mFree;
+            mFree = &slot;
+        }
+        mBlocks.push_back(std::move(block));
+    }
+
+    const size_t mBlockSize;
+    std::vector<Block> mBlocks;
+    Slot* mFree;
+    size_t mSize;
+};
+}
+}
+
+#endif
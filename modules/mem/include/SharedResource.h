@@ -24,6 +24,7 @@
 
 #include <unordered_map>
 #include <memory>
+#include <mutex>
 #include <string>
 
 namespace nyra
@@ -34,6 +35,9 @@ namespace mem
  *  \class SharedResource
  *  \brief Creates a resource, primary from disk that can be shared among
  *         objects. The resource is killed when it goes out of scope.
+ *         Resources can be requested from multiple threads. The lock is
+ *         not held while a resource is being created, so different
+ *         resources can load in parallel.
  */
 template <typename ResourceT>
 class SharedResource
@@ -48,21 +52,42 @@ public:
      */
     std::shared_ptr<ResourceT> operator[](const std::string& key)
     {
-        auto resource = mMap.find(key);
-        if (resource != mMap.end() && !resource->second.expired())
         {
-            return resource->second.lock();
+            std::lock_guard<std::mutex> lock(mMutex);
+            std::shared_ptr<ResourceT> shared = find(key);
+            if (shared.get())
+            {
+                return shared;
+            }
         }
-        else
+
+        std::shared_ptr<ResourceT> created(new ResourceT(key));
+
+        // Another thread may have created the same resource while this one
+        // was loading. Prefer the first one so everyone shares it.
+        std::lock_guard<std::mutex> lock(mMutex);
+        std::shared_ptr<ResourceT> shared = find(key);
+        if (shared.get())
         {
-            std::shared_ptr<ResourceT> shared(new ResourceT(key));
-            mMap[key] = shared;
             return shared;
         }
+        mMap[key] = created;
+        return created;
     }
 
 private:
+    std::shared_ptr<ResourceT> find(const std::string& key) const
+    {
+        auto resource = mMap.find(key);
+        if (resource != mMap.end())
+        {
+            return resource->second.lock();
+        }
+        return std::shared_ptr<ResourceT>();
+    }
+
     std::unordered_map<std::string, std::weak_ptr<ResourceT> > mMap;
+    std::mutex mMutex;
 };
 }
 }
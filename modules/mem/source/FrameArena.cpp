@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2018 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#include <algorithm>
+#include <nyra/mem/FrameArena.h>
+
+namespace nyra
+{
+namespace mem
+{
+//===========================================================================//
+FrameArena::FrameArena(size_t blockSize) :
+    mBlockSize(blockSize == 0 ? 1 : blockSize),
+    mBlock(0),
+    mOffset(0),
+    mUsed(0)
+{
+}
+
+//===========================================================================//
+void* FrameArena::allocate(size_t size, size_t alignment)
+{
+    // Blocks that are too small for this request are skipped rather than
+    // split, they are used again after the next reset.
+    while (mBlock < mBlocks.size())
+    {
+        Block& block = mBlocks[mBlock];
+        const uintptr_t start =
+                reinterpret_cast<uintptr_t>(block.data.get());
+        const uintptr_t aligned =
+                (start + mOffset + alignment - 1) & ~(alignment - 1);
+        const size_t end = static_cast<size_t>(aligned - start) + size;
+        if (end <= block.size)
+        {
+            mUsed += end - mOffset;
+            mOffset = end;
+            return reinterpret_cast<void*>(aligned);
+        }
+
+        ++mBlock;
+        mOffset = 0;
+    }
+
+    Block block;
+    block.size = std::max(mBlockSize, size + alignment);
+    block.data.reset(new uint8_t[block.size]);
+    mBlocks.push_back(std::move(block));
+    return allocate(size, alignment);
+}
+
+//===========================================================================//
+void FrameArena::reset()
+{
+    mBlock = 0;
+    mOffset = 0;
+    mUsed = 0;
+}
+
+//===========================================================================//
+size_t FrameArena::getCapacity() const
+{
+    size_t capacity = 0;
+    for (const Block& block : mBlocks)
+    {
+        capacity += block.size;
+    }
+    return capacity;
+}
+}
+}
@@ -0,0 +1,157 @@
+/*
+ * Copyright (c) 2018 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#include <nyra/mem/FlatTree.h>
+#include <nyra/test/Test.h>
+
+namespace
+{
+//===========================================================================//
+void buildTree(nyra::mem::FlatTree<std::string>& tree)
+{
+    tree.setValue("root");
+    tree.open("a");
+    tree.setValue("The letter a");
+    tree.open("b");
+    for (size_t ii = 0; ii < 10; ++ii)
+    {
+        tree.openItem();
+        tree.setValue("Index: " + std::to_string(ii));
+        tree.open("map");
+        tree.setValue("Map: " + std::to_string(ii));
+        tree.close();
+        tree.close();
+    }
+    tree.close();
+    tree.close();
+    tree.open("single");
+    tree.setValue("alone");
+    tree.finish();
+}
+}
+
+namespace nyra
+{
+namespace mem
+{
+TEST(FlatTree, Nodes)
+{
+    FlatTree<std::string> tree;
+    buildTree(tree);
+
+    EXPECT_EQ("root", tree.get());
+    EXPECT_EQ("The letter a", tree["a"].get());
+    EXPECT_EQ(static_cast<size_t>(10), tree["a"]["b"].size());
+    EXPECT_EQ(static_cast<size_t>(10), tree["a"]["b"].loopSize());
+    EXPECT_FALSE(tree["a"]["b"].valid());
+    EXPECT_THROW(tree["a"]["b"].get(), std::runtime_error);
+
+    for (size_t ii = 0; ii < 10; ++ii)
+    {
+        EXPECT_EQ("Index: " + std::to_string(ii),
+                  tree["a"]["b"][ii].get());
+        EXPECT_EQ("Map: " + std::to_string(ii),
+                  tree["a"]["b"][ii]["map"].get());
+    }
+
+    // A single element can be looped over as if it were a list
+    EXPECT_EQ(static_cast<size_t>(0), tree["single"].size());
+    EXPECT_EQ(static_cast<size_t>(1), tree["single"].loopSize());
+    EXPECT_EQ("alone", tree["single"][0].get());
+
+    EXPECT_THROW(tree["a2"], std::runtime_error);
+    EXPECT_THROW(tree["a"]["b"][10], std::runtime_error);
+    EXPECT_THROW(tree["single"][1], std::runtime_error);
+}
+
+TEST(FlatTree, Has)
+{
+    FlatTree<std::string> tree;
+    buildTree(tree);
+
+    EXPECT_TRUE(tree.has("a"));
+    EXPECT_TRUE(tree["a"].has("b"));
+    EXPECT_FALSE(tree.has("b"));
+    EXPECT_FALSE(tree.has("map"));
+    EXPECT_FALSE(tree["a"].has("a"));
+
+    std::vector<std::string> keys = tree.keys();
+    std::sort(keys.begin(), keys.end());
+    ASSERT_EQ(static_cast<size_t>(2), keys.size());
+    EXPECT_EQ("a", keys[0]);
+    EXPECT_EQ("single", keys[1]);
+}
+
+TEST(FlatTree, DuplicateKeys)
+{
+    FlatTree<std::string> tree;
+    tree.open("key");
+    tree.setValue("first");
+    tree.close();
+    tree.open("other");
+    tree.setValue("other");
+    tree.close();
+    tree.open("key");
+    tree.setValue("second");
+    tree.finish();
+
+    EXPECT_EQ("second", tree["key"].get());
+    EXPECT_EQ("other", tree["other"].get());
+    EXPECT_EQ(static_cast<size_t>(2), tree.keys().size());
+}
+
+TEST(FlatTree, CopyAndMove)
+{
+    FlatTree<std::string> tree;
+    buildTree(tree);
+
+    const FlatTree<std::string> copy(tree);
+    FlatTree<std::string> moved(std::move(tree));
+
+    EXPECT_EQ("Map: 3", copy["a"]["b"][3]["map"].get());
+    EXPECT_EQ("Map: 3", moved["a"]["b"][3]["map"].get());
+
+    // The moved from tree is empty but usable
+    EXPECT_FALSE(tree.has("a"));
+    EXPECT_EQ(static_cast<size_t>(1), tree.getNumNodes());
+
+    tree = copy;
+    EXPECT_EQ("alone", tree["single"].get());
+}
+
+TEST(FlatTree, Clear)
+{
+    FlatTree<std::string> tree;
+    buildTree(tree);
+    EXPECT_EQ(static_cast<size_t>(24), tree.getNumNodes());
+
+    tree.clear();
+    EXPECT_EQ(static_cast<size_t>(1), tree.getNumNodes());
+    EXPECT_FALSE(tree.valid());
+    EXPECT_FALSE(tree.has("a"));
+
+    buildTree(tree);
+    EXPECT_EQ("Index: 9", tree["a"]["b"][9].get());
+}
+}
+}
+
+NYRA_TEST()
@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2018 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#include <nyra/test/Test.h>
+#include <nyra/mem/FrameArena.h>
+
+namespace
+{
+struct MockPod
+{
+    double x;
+    char c;
+};
+}
+
+namespace nyra
+{
+namespace mem
+{
+TEST(FrameArena, Allocate)
+{
+    FrameArena arena(256);
+    EXPECT_EQ(static_cast<size_t>(0), arena.getCapacity());
+
+    char* c = arena.create<char>('a');
+    MockPod* pod = arena.create<MockPod>();
+    EXPECT_EQ('a', *c);
+    EXPECT_EQ(static_cast<size_t>(0),
+              reinterpret_cast<uintptr_t>(pod) % alignof(MockPod));
+    pod->x = 1.5;
+    pod->c = 'b';
+
+    uint32_t* array = arena.createArray<uint32_t>(16);
+    for (size_t ii = 0; ii < 16; ++ii)
+    {
+        EXPECT_EQ(static_cast<uint32_t>(0), array[ii]);
+    }
+    EXPECT_EQ(static_cast<size_t>(256), arena.getCapacity());
+    EXPECT_GE(arena.getUsed(), sizeof(MockPod) + 64);
+
+    // Too big for a block
+    uint8_t* big = static_cast<uint8_t*>(arena.allocate(1000, 64));
+    EXPECT_EQ(static_cast<size_t>(0),
+              reinterpret_cast<uintptr_t>(big) % 64);
+    for (size_t ii = 0; ii < 1000; ++ii)
+    {
+        big[ii] = static_cast<uint8_t>(ii);
+    }
+    EXPECT_EQ(1.5, pod->x);
+    EXPECT_EQ('b', pod->c);
+}
+
+TEST(FrameArena, Reset)
+{
+    FrameArena arena(1024);
+    for (size_t frame = 0; frame < 3; ++frame)
+    {
+        for (size_t ii = 0; ii < 100; ++ii)
+        {
+            arena.allocate(48, 16);
+        }
+    }
+    const size_t capacity = arena.getCapacity();
+    EXPECT_GE(capacity, static_cast<size_t>(300 * 48));
+
+    // Once reset the same frames fit without new blocks
+    for (size_t frame = 0; frame < 10; ++frame)
+    {
+        arena.reset();
+        EXPECT_EQ(static_cast<size_t>(0), arena.getUsed());
+        for (size_t ii = 0; ii < 300; ++ii)
+        {
+            arena.allocate(48, 16);
+        }
+        EXPECT_EQ(capacity, arena.getCapacity());
+        EXPECT_EQ(static_cast<size_t>(300 * 48), arena.getUsed());
+    }
+}
+}
+}
+
+
+NYRA_TEST()
@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) 2018 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#include <stdexcept>
+#include <nyra/test/Test.h>
+#include <nyra/mem/ObjectPool.h>
+
+namespace
+{
+class MockObject
+{
+public:
+    MockObject(size_t value, size_t& alive) :
+        value(value),
+        alive(alive)
+    {
+        if (value == 666)
+        {
+            throw std::runtime_error("Bad value");
+        }
+        ++alive;
+    }
+
+    ~MockObject()
+    {
+        --alive;
+    }
+
+    size_t value;
+    size_t& alive;
+};
+}
+
+namespace nyra
+{
+namespace mem
+{
+TEST(ObjectPool, CreateRelease)
+{
+    size_t alive = 0;
+    ObjectPool<MockObject> pool(4);
+    EXPECT_EQ(static_cast<size_t>(0), pool.getCapacity());
+
+    std::vector<MockObject*> objects;
+    for (size_t ii = 0; ii < 10; ++ii)
+    {
+        objects.push_back(pool.create(ii, alive));
+    }
+    EXPECT_EQ(static_cast<size_t>(10), pool.getSize());
+    EXPECT_EQ(static_cast<size_t>(10), alive);
+    EXPECT_EQ(static_cast<size_t>(12), pool.getCapacity());
+
+    // Addresses stay put as the pool grows
+    for (size_t ii = 0; ii < objects.size(); ++ii)
+    {
+        EXPECT_EQ(ii, objects[ii]->value);
+    }
+
+    pool.release(objects[3]);
+    pool.release(objects[7]);
+    pool.release(nullptr);
+    EXPECT_EQ(static_cast<size_t>(8), pool.getSize());
+    EXPECT_EQ(static_cast<size_t>(8), alive);
+
+    // Freed slots are reused before anything new is allocated
+    MockObject* reused1 = pool.create(100, alive);
+    MockObject* reused2 = pool.create(101, alive);
+    EXPECT_EQ(objects[7], reused1);
+    EXPECT_EQ(objects[3], reused2);
+    EXPECT_EQ(static_cast<size_t>(12), pool.getCapacity());
+
+    // A throwing constructor does not lose the slot
+    EXPECT_THROW(pool.create(666, alive), std::runtime_error);
+    EXPECT_EQ(static_cast<size_t>(10), pool.getSize());
+    MockObject* next = pool.create(102, alive);
+    EXPECT_EQ(static_cast<size_t>(12), pool.getCapacity());
+    EXPECT_EQ(static_cast<size_t>(11), alive);
+    pool.release(next);
+
+    pool.clear();
+    EXPECT_EQ(static_cast<size_t>(0), pool.getSize());
+    EXPECT_EQ(static_cast<size_t>(0), alive);
+    EXPECT_EQ(static_cast<size_t>(12), pool.getCapacity());
+}
+
+TEST(ObjectPool, SteadyState)
+{
+    size_t alive = 0;
+    {
+        ObjectPool<MockObject> pool(8);
+        pool.reserve(100);
+        const size_t capacity = pool.getCapacity();
+        EXPECT_EQ(static_cast<size_t>(100), capacity);
+
+        std::vector<MockObject*> objects;
+        for (size_t frame = 0; frame < 50; ++frame)
+        {
+            for (size_t ii = 0; ii < 10; ++ii)
+            {
+                objects.push_back(pool.create(frame, alive));
+            }
+            while (objects.size() > 60)
+            {
+                pool.release(objects.front());
+                objects.erase(objects.begin());
+            }
+            EXPECT_EQ(capacity, pool.getCapacity());
+        }
+        EXPECT_EQ(static_cast<size_t>(60), pool.getSize());
+    }
+
+    // Live objects are destroyed with the pool
+    EXPECT_EQ(static_cast<size_t>(0), alive);
+}
+}
+}
+
+NYRA_TEST()
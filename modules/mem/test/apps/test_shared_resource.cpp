@@ -19,6 +19,7 @@
  * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
  * IN THE SOFTWARE.
  */
+#include <thread>
 #include <nyra/mem/SharedResource.h>
 #include <nyra/test/Test.h>
 
@@ -39,6 +40,15 @@ public:
         numResources -= 1;
     }
 };
+
+class ThreadedResource
+{
+public:
+    ThreadedResource(const std::string&)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+};
 }
 
 namespace nyra
@@ -65,6 +75,31 @@ TEST(SharedResource, Call)
 
     EXPECT_EQ(1, numResources);
 }
+
+TEST(SharedResource, Threads)
+{
+    SharedResource<ThreadedResource> resources;
+    std::vector<std::shared_ptr<ThreadedResource>> results(8);
+    std::vector<std::thread> threads;
+
+    for (size_t ii = 0; ii < results.size(); ++ii)
+    {
+        threads.push_back(std::thread([&resources, &results, ii]()
+        {
+            results[ii] = resources["c"];
+        }));
+    }
+
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+
+    for (size_t ii = 1; ii < results.size(); ++ii)
+    {
+        EXPECT_EQ(results[0].get(), results[ii].get());
+    }
+}
 }
 }
 
@@ -69,23 +69,23 @@ int main(int argc, char** argv)
         std::cout << "Creating directory: " << outDir << "\n";
         core::path::makeDirectory(outDir);
 
-        std::cout << "Loading 5th Edition\n";
-        mtg::Set set(setPathname + "5ed.json");
-        std::cout << "Loading Mirage\n";
-        set.addSet(mtg::Set(setPathname + "mir.json"));
-        std::cout << "Loading Visions\n";
-        set.addSet(mtg::Set(setPathname + "vis.json"));
-        std::cout << "Loading Weatherlight\n";
-        set.addSet(mtg::Set(setPathname + "wth.json"));
-        std::cout << "Loading Tempest\n";
-        set.addSet(mtg::Set(setPathname + "tmp.json"));
-        std::cout << "Loading Stronghold\n";
-        set.addSet(mtg::Set(setPathname + "sth.json"));
-        std::cout << "Loading Exodus\n";
-        set.addSet(mtg::Set(setPathname + "exo.json"));
-
-        const auto& cards = set.getAllCards();
-        std::cout << "Number of cards loaded: " << cards.size() << "\n\n";
+        // Only a few dozen cards are needed, so the sets are indexed by
+        // name and each card is created when it is looked up.
+        std::cout << "Indexing 5th Edition\n";
+        mtg::Set set(setPathname + "5ed.json", mtg::Set::INDEX);
+        std::cout << "Indexing Mirage\n";
+        set.addSet(mtg::Set(setPathname + "mir.json", mtg::Set::INDEX));
+        std::cout << "Indexing Visions\n";
+        set.addSet(mtg::Set(setPathname + "vis.json", mtg::Set::INDEX));
+        std::cout << "Indexing Weatherlight\n";
+        set.addSet(mtg::Set(setPathname + "wth.json", mtg::Set::INDEX));
+        std::cout << "Indexing Tempest\n";
+        set.addSet(mtg::Set(setPathname + "tmp.json", mtg::Set::INDEX));
+        std::cout << "Indexing Stronghold\n";
+        set.addSet(mtg::Set(setPathname + "sth.json", mtg::Set::INDEX));
+        std::cout << "Indexing Exodus\n";
+        set.addSet(mtg::Set(setPathname + "exo.json", mtg::Set::INDEX));
+        std::cout << "\n";
 
         mtg::Proxy proxy;
         size_t totalCards = 0;
@@ -106,24 +106,16 @@ int main(int argc, char** argv)
             }
             name = name.substr(0, name.size() - 1);
 
-            mtg::Card card;
-            for (const auto& c : cards)
-            {
-                if (c.name == name)
-                {
-                    card = c;
-                    std::cout << "=========================================\n";
-                    std::cout << "Found: " << card << "\n";
-                    std::cout << "=========================================\n";
-                    break;
-                }
-            }
-
-            if (card.name.empty())
+            if (!set.hasCard(name))
             {
                 throw std::runtime_error("Could not find card: " + name);
             }
 
+            const mtg::Card& card = set.getCard(name);
+            std::cout << "=========================================\n";
+            std::cout << "Found: " << card << "\n";
+            std::cout << "=========================================\n";
+
             std::string art = "proxies/art/" + name + ".png";
             cleanPathname(art);
             std::cout << "Creating proxy for: " << name << "\n";
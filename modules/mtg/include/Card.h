@@ -27,6 +27,7 @@
 #include <nyra/mtg/Constants.h>
 #include <nyra/core/Archive.h>
 #include <nyra/mem/Tree.h>
+#include <nyra/json/LazyDocument.h>
 
 namespace nyra
 {
@@ -55,6 +56,14 @@ public:
      */
     Card(const mem::Tree<std::string>& tree);
 
+    /*
+     *  \func Constructor
+     *  \brief Creates a card from an entry in an indexed mtg json
+     *
+     *  \param A single card for mtg json
+     */
+    Card(const json::LazyValue& tree);
+
     /*
      *  \fun isType
      *  \brief Returns true if the card has the type.
@@ -169,6 +178,9 @@ public:
     bool isBackside;
 
 private:
+    template <typename TreeT>
+    void parse(const TreeT& tree);
+
     void removeReminderText();
 
     NYRA_SERIALIZE()
@@ -0,0 +1,203 @@
+/*
+ * Copyright (c) 2018 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#ifndef __NYRA_MTG_CARD_DATABASE_H__
+#define __NYRA_MTG_CARD_DATABASE_H__
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include <nyra/core/MappedFile.h>
+#include <nyra/mtg/Card.h>
+
+namespace nyra
+{
+namespace mtg
+{
+/*
+ *  \class CardDatabase
+ *  \brief The cards of an mtg json set compiled into a single binary
+ *         file. The file is memory mapped and used in place, so opening
+ *         it does not parse any text and cards are only unpacked when
+ *         they are asked for. Rarity, flags and EDH colors are stored as
+ *         columns so sets can be filtered without unpacking every card.
+ *
+ *         Layout (native byte order, sections are 8 byte aligned):
+ *             Header
+ *             Strings  - Every string in the set, referenced by offset
+ *             Cards    - CardRecord per card
+ *             Enums    - Mana, supertype and type values for each card
+ *             Subtypes - StringRef per subtype
+ *             Rarity   - One byte per card
+ *             Flags    - One byte per card
+ *             EDH      - One byte per card, a bit per Mana
+ *             Names    - Open addressed hash table of card indices
+ */
+class CardDatabase
+{
+public:
+    /*
+     *  \var VERSION
+     *  \brief The current file version. Bump this whenever the layout or
+     *         the way cards are read from json changes.
+     */
+    static const uint32_t VERSION;
+
+    /*
+     *  \var EXTENSION
+     *  \brief The file extension used for card databases.
+     */
+    static const std::string EXTENSION;
+
+    /*
+     *  \func Constructor
+     *  \brief Maps a card database into memory and validates the header.
+     *
+     *  \param pathname The card database on disk.
+     *  \throw If the file is not a card database or the version is wrong.
+     */
+    CardDatabase(const std::string& pathname);
+
+    /*
+     *  \func open
+     *  \brief Gets the database for an mtg json set. The database sits
+     *         next to the json and is rebuilt whenever the json changes or
+     *         the version is out of date. If it cannot be written the
+     *         database is kept in memory instead.
+     *
+     *  \param jsonPathname The mtg json set
+     *  \return The database
+     */
+    static std::shared_ptr<const CardDatabase> open(
+            const std::string& jsonPathname);
+
+    /*
+     *  \func getNumCards
+     *  \brief Gets the number of cards including backsides.
+     *
+     *  \return The number of cards
+     */
+    size_t getNumCards() const
+    {
+        return mNumCards;
+    }
+
+    /*
+     *  \func getCard
+     *  \brief Unpacks a card.
+     *
+     *  \param index The card index
+     *  \return The card
+     */
+    Card getCard(size_t index) const;
+
+    /*
+     *  \func find
+     *  \brief Looks up a card by name.
+     *
+     *  \param name The card name
+     *  \param [OUTPUT] index The card index if it was found
+     *  \return true if the card exists.
+     */
+    bool find(const std::string& name, size_t& index) const;
+
+    /*
+     *  \func getRarity
+     *  \brief Gets the rarity of a card without unpacking it.
+     *
+     *  \param index The card index
+     *  \return The rarity
+     */
+    Rarity getRarity(size_t index) const
+    {
+        return static_cast<Rarity>(mRarity[index]);
+    }
+
+    /*
+     *  \func isBackside
+     *  \brief Returns true if the card is the backside of another card
+     *         without unpacking it.
+     *
+     *  \param index The card index
+     *  \return true if this is a backside
+     */
+    bool isBackside(size_t index) const;
+
+    /*
+     *  \func getEDHColors
+     *  \brief Gets the EDH colors of a card without unpacking it. Each
+     *         color is the bit 1 << Mana.
+     *
+     *  \param index The card index
+     *  \return The color bits
+     */
+    uint8_t getEDHColors(size_t index) const
+    {
+        return mEDHColors[index];
+    }
+
+    /*
+     *  \func getPathname
+     *  \brief Gets the pathname of the database.
+     *
+     *  \return The pathname
+     */
+    const std::string& getPathname() const
+    {
+        return mPathname;
+    }
+
+private:
+    CardDatabase(std::vector<uint8_t>&& buffer,
+                 const std::string& pathname);
+
+    CardDatabase(const CardDatabase&) = delete;
+    CardDatabase& operator=(const CardDatabase&) = delete;
+
+    void validate();
+
+    std::string toString(uint32_t offset, uint32_t length) const;
+
+    const std::string mPathname;
+    std::unique_ptr<core::MappedFile> mFile;
+    std::vector<uint8_t> mBuffer;
+    const uint8_t* mData;
+    size_t mSize;
+    size_t mNumCards;
+    const uint8_t* mRarity;
+    const uint8_t* mFlags;
+    const uint8_t* mEDHColors;
+};
+
+/*
+ *  \func compileCardDatabase
+ *  \brief Reads an mtg json set and writes it out as a card database.
+ *
+ *  \param jsonPathname The mtg json set
+ *  \param outPathname The card database to write
+ */
+void compileCardDatabase(const std::string& jsonPathname,
+                         const std::string& outPathname);
+}
+}
+
+#endif
@@ -22,7 +22,11 @@
 #ifndef __NYRA_MTG_SET_H__
 #define __NYRA_MTG_SET_H__
 
+#include <memory>
+#include <unordered_map>
+#include <utility>
 #include <nyra/mtg/Card.h>
+#include <nyra/mtg/CardDatabase.h>
 #include <nyra/core/Archive.h>
 
 namespace nyra
@@ -36,6 +40,20 @@ namespace mtg
 class Set
 {
 public:
+    /*
+     *  \enum Load
+     *  \brief How much of a set file is read up front. Both read the set
+     *         through its CardDatabase. PARSE creates every card
+     *         immediately. INDEX leaves the cards in the database and
+     *         creates them the first time they are needed, which is much
+     *         faster when only a few cards are looked up.
+     */
+    enum Load
+    {
+        PARSE,
+        INDEX
+    };
+
     /*
      *  \func Constructor
      *  \brief Creates an empty set.
@@ -47,20 +65,45 @@ public:
      *  \brief Creates a Set from a pathname
      *
      *  \param pathname The set on disk
+     *  \param load Whether to create the cards now or when accessed
      */
-    Set(const std::string& pathname);
+    Set(const std::string& pathname, Load load = PARSE);
 
     /*
      *  \func getAllCards
-     *  \brief Gets a list of all the cards in the set
+     *  \brief Gets a list of all the cards in the set. This creates any
+     *         cards that have only been indexed.
      *
      *  \return The list of cards.
      */
     const std::vector<Card>& getAllCards() const
     {
+        load();
         return mCards;
     }
 
+    /*
+     *  \func hasCard
+     *  \brief Returns true if a card with the name is in the set. This
+     *         does not create the card.
+     *
+     *  \param name The card name
+     *  \return true if the card exists.
+     */
+    bool hasCard(const std::string& name) const;
+
+    /*
+     *  \func getCard
+     *  \brief Gets a card by name. Indexed cards are created the first
+     *         time they are asked for. If more than one set has the card
+     *         the first one added wins.
+     *
+     *  \param name The card name
+     *  \return The card
+     *  \throw If the card is not in the set.
+     */
+    const Card& getCard(const std::string& name) const;
+
     /*
      *  \func addSet
      *  \brief Merges two sets together
@@ -83,7 +126,8 @@ public:
 
     /*
      *  \func filterRarity
-     *  \brief Gets a set of only a certain rarity
+     *  \brief Gets a set of only a certain rarity. Indexed cards are
+     *         matched without being created and stay indexed.
      *
      *  \param rarity The target rarity
      *  \return The filtered set
@@ -108,7 +152,8 @@ public:
 
     /*
      *  \func filterEDHColor
-     *  \brief Gets a set of only a certain color
+     *  \brief Gets a set of only a certain color. Indexed cards are
+     *         matched without being created and stay indexed.
      *
      *  \param color The target color
      *  \return The filtered set
@@ -131,22 +176,38 @@ public:
                         size_t mythics) const;
 
 private:
+    typedef std::pair<const CardDatabase*, size_t> Entry;
+
     Set generateRarity(Rarity rarity,
                        size_t num) const;
 
+    void load() const;
+
+    bool findIndexed(const std::string& name, Entry& entry) const;
+
     NYRA_SERIALIZE()
 
     template<class Archive>
     void serialize(Archive& archive, const unsigned int version)
     {
+        load();
         archive & BOOST_SERIALIZATION_NVP(mCards);
         archive & BOOST_SERIALIZATION_NVP(mBacksides);
     }
 
     friend std::ostream& operator<<(std::ostream& os, const Set& set);
 
-    std::vector<Card> mCards;
-    std::vector<Card> mBacksides;
+    mutable std::vector<Card> mCards;
+    mutable std::vector<Card> mBacksides;
+
+    // Indexed cards stay in their database until they are created
+    std::vector<std::shared_ptr<const CardDatabase> > mDatabases;
+    mutable std::vector<const CardDatabase*> mUnloaded;
+
+    // Filtering only keeps the index of each match. Entries from the same
+    // database are next to each other.
+    mutable std::vector<Entry> mIndexed;
+    mutable std::unordered_map<std::string, Card> mCreated;
 };
 }
 }
@@ -25,8 +25,8 @@
 namespace
 {
 //===========================================================================//
-std::string combineTreeArray(const nyra::mem::Tree<std::string>& tree,
-                             const std::string& name)
+template <typename TreeT>
+std::string combineTreeArray(const TreeT& tree, const std::string& name)
 {
     std::string ret;
     for (size_t ii = 0; ii < tree[name].loopSize(); ++ii)
@@ -59,12 +59,21 @@ Card::Card() :
 
 //===========================================================================//
 Card::Card(const mem::Tree<std::string>& tree) :
-    power(0),
-    toughness(0),
-    loyalty(0),
-    isFlipCard(false),
-    isBackside(false),
-    mEDHColorsSet(false)
+    Card()
+{
+    parse(tree);
+}
+
+//===========================================================================//
+Card::Card(const json::LazyValue& tree) :
+    Card()
+{
+    parse(tree);
+}
+
+//===========================================================================//
+template <typename TreeT>
+void Card::parse(const TreeT& tree)
 {
     name = tree["name"].get();
     cost = stringToMana(tree.has("manaCost") ? tree["manaCost"].get() : "");
@@ -0,0 +1,628 @@
+/*
+ * Copyright (c) 2018 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <unordered_map>
+#include <nyra/mtg/CardDatabase.h>
+#include <nyra/json/LazyDocument.h>
+#include <nyra/core/Path.h>
+#include <nyra/core/String.h>
+
+namespace
+{
+//===========================================================================//
+static const char MAGIC[8] = {'N', 'Y', 'R', 'A', 'C', 'A', 'R', 'D'};
+static const uint32_t SPECIAL_VALUE = 0xFFFFFFFF;
+static const uint8_t FLIP_CARD = 1;
+static const uint8_t BACKSIDE = 2;
+
+//===========================================================================//
+struct StringRef
+{
+    uint32_t offset;
+    uint32_t length;
+};
+
+//===========================================================================//
+struct Header
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t numCards;
+    uint32_t numEnums;
+    uint32_t numSubtypes;
+    uint32_t numNames;
+    uint32_t reserved;
+    int64_t sourceModified;
+    uint64_t sourceSize;
+    uint64_t stringsOffset;
+    uint64_t stringsSize;
+    uint64_t cardsOffset;
+    uint64_t enumsOffset;
+    uint64_t subtypesOffset;
+    uint64_t rarityOffset;
+    uint64_t flagsOffset;
+    uint64_t edhOffset;
+    uint64_t namesOffset;
+};
+
+//===========================================================================//
+struct CardRecord
+{
+    StringRef name;
+    StringRef text;
+    uint32_t firstEnum;
+    uint8_t numCost;
+    uint8_t numSupertypes;
+    uint8_t numTypes;
+    uint8_t numSubtypes;
+    uint32_t firstSubtype;
+    uint32_t power;
+    uint32_t toughness;
+    uint32_t loyalty;
+};
+
+static_assert(sizeof(StringRef) == 8, "Unexpected StringRef padding");
+static_assert(sizeof(Header) == 120, "Unexpected Header padding");
+static_assert(sizeof(CardRecord) == 40, "Unexpected CardRecord padding");
+
+//===========================================================================//
+class StringTable
+{
+public:
+    StringRef add(const std::string& value)
+    {
+        auto iter = mOffsets.find(value);
+        if (iter == mOffsets.end())
+        {
+            iter = mOffsets.insert(std::make_pair(
+                    value, static_cast<uint32_t>(mData.size()))).first;
+            mData += value;
+        }
+
+        StringRef ref;
+        ref.offset = iter->second;
+        ref.length = static_cast<uint32_t>(value.size());
+        return ref;
+    }
+
+    const std::string& getData() const
+    {
+        return mData;
+    }
+
+private:
+    std::unordered_map<std::string, uint32_t> mOffsets;
+    std::string mData;
+};
+
+//===========================================================================//
+class Writer
+{
+public:
+    template <typename T>
+    void put(const T& value)
+    {
+        const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&value);
+        mBuffer.insert(mBuffer.end(), bytes, bytes + sizeof(T));
+    }
+
+    template <typename T>
+    void putVector(const std::vector<T>& values)
+    {
+        const uint8_t* bytes = reinterpret_cast<const uint8_t*>(values.data());
+        mBuffer.insert(mBuffer.end(), bytes, bytes + values.size() * sizeof(T));
+        align();
+    }
+
+    void align()
+    {
+        mBuffer.resize((mBuffer.size() + 7) & ~static_cast<size_t>(7));
+    }
+
+    size_t getSize() const
+    {
+        return mBuffer.size();
+    }
+
+    std::vector<uint8_t>& getBuffer()
+    {
+        return mBuffer;
+    }
+
+private:
+    std::vector<uint8_t> mBuffer;
+};
+
+//===========================================================================//
+uint32_t hashName(const char* data, size_t size)
+{
+    // FNV-1a
+    uint32_t hash = 2166136261u;
+    for (size_t ii = 0; ii < size; ++ii)
+    {
+        hash ^= static_cast<uint8_t>(data[ii]);
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+//===========================================================================//
+uint32_t toRecordValue(size_t value)
+{
+    return value == nyra::mtg::Card::SPECIAL_VALUE ?
+            SPECIAL_VALUE : static_cast<uint32_t>(value);
+}
+
+//===========================================================================//
+size_t fromRecordValue(uint32_t value)
+{
+    return value == SPECIAL_VALUE ?
+            nyra::mtg::Card::SPECIAL_VALUE : static_cast<size_t>(value);
+}
+
+//===========================================================================//
+uint64_t getFileSize(const std::string& pathname)
+{
+    std::ifstream stream(pathname, std::ifstream::binary | std::ifstream::ate);
+    if (!stream.good())
+    {
+        throw std::runtime_error("Failed to open file: " + pathname);
+    }
+    return static_cast<uint64_t>(stream.tellg());
+}
+
+//===========================================================================//
+template <typename T>
+const T* getSection(const uint8_t* data,
+                    size_t size,
+                    uint64_t offset,
+                    size_t count,
+                    const std::string& pathname)
+{
+    if (offset > size || count > (size - offset) / sizeof(T))
+    {
+        throw std::runtime_error("Card database section is out of bounds: " +
+                                 pathname);
+    }
+    return reinterpret_cast<const T*>(data + offset);
+}
+
+//===========================================================================//
+std::vector<uint8_t> buildCardDatabase(const std::string& jsonPathname)
+{
+    const nyra::json::LazyDocument document(jsonPathname);
+    const std::vector<nyra::json::LazyValue> values =
+            document["cards"].getItems();
+
+    StringTable strings;
+    std::vector<CardRecord> cards;
+    std::vector<uint8_t> enums;
+    std::vector<StringRef> subtypes;
+    std::vector<uint8_t> rarity;
+    std::vector<uint8_t> flags;
+    std::vector<uint8_t> edh;
+
+    cards.reserve(values.size());
+    for (const nyra::json::LazyValue& value : values)
+    {
+        const nyra::mtg::Card card(value);
+
+        if (card.cost.size() > 0xFF || card.supertypes.size() > 0xFF ||
+            card.types.size() > 0xFF || card.subtypes.size() > 0xFF)
+        {
+            throw std::runtime_error("Card has too many symbols or types: " +
+                                     card.name);
+        }
+
+        CardRecord record;
+        std::memset(&record, 0, sizeof(record));
+        record.name = strings.add(card.name);
+        record.text = strings.add(card.text);
+        record.firstEnum = enums.size();
+        record.numCost = card.cost.size();
+        record.numSupertypes = card.supertypes.size();
+        record.numTypes = card.types.size();
+        record.numSubtypes = card.subtypes.size();
+        record.firstSubtype = subtypes.size();
+        record.power = toRecordValue(card.power);
+        record.toughness = toRecordValue(card.toughness);
+        record.loyalty = toRecordValue(card.loyalty);
+        cards.push_back(record);
+
+        enums.insert(enums.end(), card.cost.begin(), card.cost.end());
+        enums.insert(enums.end(),
+                     card.supertypes.begin(),
+                     card.supertypes.end());
+        enums.insert(enums.end(), card.types.begin(), card.types.end());
+        for (const std::string& subtype : card.subtypes)
+        {
+            subtypes.push_back(strings.add(subtype));
+        }
+
+        rarity.push_back(card.rarity);
+        flags.push_back((card.isFlipCard ? FLIP_CARD : 0) |
+                        (card.isBackside ? BACKSIDE : 0));
+        uint8_t colors = 0;
+        for (nyra::mtg::Mana mana : card.getEDHColors())
+        {
+            colors |= 1 << mana;
+        }
+        edh.push_back(colors);
+    }
+
+    // Open addressed name table with at most a 50% load. Slots hold the
+    // card index plus one so zero can mean empty. The first card with a
+    // name wins.
+    size_t numNames = 1;
+    while (numNames < cards.size() * 2)
+    {
+        numNames *= 2;
+    }
+    std::vector<uint32_t> names(numNames, 0);
+    for (size_t ii = 0; ii < cards.size(); ++ii)
+    {
+        const char* name = strings.getData().data() + cards[ii].name.offset;
+        const size_t length = cards[ii].name.length;
+        size_t slot = hashName(name, length) & (numNames - 1);
+
+        while (names[slot] != 0)
+        {
+            const StringRef& other = cards[names[slot] - 1].name;
+            if (other.length == length &&
+                std::memcmp(strings.getData().data() + other.offset,
+                            name, length) == 0)
+            {
+                break;
+            }
+            slot = (slot + 1) & (numNames - 1);
+        }
+
+        if (names[slot] == 0)
+        {
+            names[slot] = ii + 1;
+        }
+    }
+
+    Writer file;
+    Header header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = nyra::mtg::CardDatabase::VERSION;
+    header.numCards = cards.size();
+    header.numEnums = enums.size();
+    header.numSubtypes = subtypes.size();
+    header.numNames = names.size();
+    header.sourceModified = nyra::core::path::getModifiedTime(jsonPathname);
+    header.sourceSize = getFileSize(jsonPathname);
+    file.put(header);
+
+    header.stringsOffset = file.getSize();
+    header.stringsSize = strings.getData().size();
+    file.putVector(std::vector<char>(strings.getData().begin(),
+                                     strings.getData().end()));
+    header.cardsOffset = file.getSize();
+    file.putVector(cards);
+    header.enumsOffset = file.getSize();
+    file.putVector(enums);
+    header.subtypesOffset = file.getSize();
+    file.putVector(subtypes);
+    header.rarityOffset = file.getSize();
+    file.putVector(rarity);
+    header.flagsOffset = file.getSize();
+    file.putVector(flags);
+    header.edhOffset = file.getSize();
+    file.putVector(edh);
+    header.namesOffset = file.getSize();
+    file.putVector(names);
+
+    std::memcpy(file.getBuffer().data(), &header, sizeof(header));
+    return std::move(file.getBuffer());
+}
+
+//===========================================================================//
+void writeCardDatabase(const std::vector<uint8_t>& buffer,
+                       const std::string& outPathname)
+{
+    // Write next to the database and move it into place so a database
+    // that is already mapped is never truncated under its reader.
+    const std::string tempPathname = outPathname + ".tmp";
+    {
+        std::ofstream stream(tempPathname, std::ofstream::binary);
+        if (!stream.good())
+        {
+            throw std::runtime_error("Failed to open file: " + tempPathname);
+        }
+        stream.write(reinterpret_cast<const char*>(buffer.data()),
+                     buffer.size());
+        stream.close();
+        if (!stream.good())
+        {
+            std::remove(tempPathname.c_str());
+            throw std::runtime_error("Failed to write file: " + tempPathname);
+        }
+    }
+
+    if (std::rename(tempPathname.c_str(), outPathname.c_str()) != 0)
+    {
+        // Windows will not rename over an existing file
+        std::remove(outPathname.c_str());
+        if (std::rename(tempPathname.c_str(), outPathname.c_str()) != 0)
+        {
+            std::remove(tempPathname.c_str());
+            throw std::runtime_error("Failed to write file: " + outPathname);
+        }
+    }
+}
+}
+
+namespace nyra
+{
+namespace mtg
+{
+//===========================================================================//
+const uint32_t CardDatabase::VERSION = 1;
+const std::string CardDatabase::EXTENSION = ".ncdb";
+
+//===========================================================================//
+CardDatabase::CardDatabase(const std::string& pathname) :
+    mPathname(pathname),
+    mFile(new core::MappedFile(pathname)),
+    mData(mFile->getData()),
+    mSize(mFile->getSize())
+{
+    validate();
+}
+
+//===========================================================================//
+CardDatabase::CardDatabase(std::vector<uint8_t>&& buffer,
+                           const std::string& pathname) :
+    mPathname(pathname),
+    mBuffer(std::move(buffer)),
+    mData(mBuffer.data()),
+    mSize(mBuffer.size())
+{
+    validate();
+}
+
+//===========================================================================//
+void CardDatabase::validate()
+{
+    if (mSize < sizeof(Header))
+    {
+        throw std::runtime_error(
+                "File is too small to be a card database: " + mPathname);
+    }
+
+    const Header& header = *reinterpret_cast<const Header*>(mData);
+    if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0)
+    {
+        throw std::runtime_error("File is not a card database: " + mPathname);
+    }
+
+    if (header.version != VERSION)
+    {
+        throw std::runtime_error(
+                "Card database " + mPathname + " is version " +
+                core::str::toString(header.version) + ", expected " +
+                core::str::toString(VERSION) + ".");
+    }
+
+    // Validate all of the sections up front so they can be used in place
+    getSection<char>(mData, mSize, header.stringsOffset, header.stringsSize,
+                     mPathname);
+    const CardRecord* cards = getSection<CardRecord>(
+            mData, mSize, header.cardsOffset, header.numCards, mPathname);
+    getSection<uint8_t>(mData, mSize, header.enumsOffset, header.numEnums,
+                        mPathname);
+    getSection<StringRef>(mData, mSize, header.subtypesOffset,
+                          header.numSubtypes, mPathname);
+    mRarity = getSection<uint8_t>(mData, mSize, header.rarityOffset,
+                                  header.numCards, mPathname);
+    mFlags = getSection<uint8_t>(mData, mSize, header.flagsOffset,
+                                 header.numCards, mPathname);
+    mEDHColors = getSection<uint8_t>(mData, mSize, header.edhOffset,
+                                     header.numCards, mPathname);
+    getSection<uint32_t>(mData, mSize, header.namesOffset, header.numNames,
+                         mPathname);
+    mNumCards = header.numCards;
+
+    if (header.numNames == 0 || (header.numNames & (header.numNames - 1)))
+    {
+        throw std::runtime_error("Card database name table is corrupt: " +
+                                 mPathname);
+    }
+
+    for (size_t ii = 0; ii < mNumCards; ++ii)
+    {
+        const CardRecord& record = cards[ii];
+        if (static_cast<size_t>(record.firstEnum) + record.numCost +
+                    record.numSupertypes + record.numTypes >
+                    header.numEnums ||
+            static_cast<size_t>(record.firstSubtype) + record.numSubtypes >
+                    header.numSubtypes ||
+            mRarity[ii] >= MAX_RARITY)
+        {
+            throw std::runtime_error("Card database card is corrupt: " +
+                                     mPathname);
+        }
+    }
+}
+
+//===========================================================================//
+std::shared_ptr<const CardDatabase> CardDatabase::open(
+        const std::string& jsonPathname)
+{
+    const std::string extension = core::path::getExtension(jsonPathname, 1);
+    const std::string pathname = jsonPathname.substr(
+            0, jsonPathname.size() - extension.size()) + EXTENSION;
+
+    if (core::path::exists(pathname))
+    {
+        try
+        {
+            std::shared_ptr<const CardDatabase> database(
+                    new CardDatabase(pathname));
+            const Header& header =
+                    *reinterpret_cast<const Header*>(database->mData);
+
+            if (header.sourceModified ==
+                        core::path::getModifiedTime(jsonPathname) &&
+                header.sourceSize == getFileSize(jsonPathname))
+            {
+                return database;
+            }
+        }
+        catch (const std::exception&)
+        {
+            // Fall through and rebuild it
+        }
+    }
+
+    std::vector<uint8_t> buffer = buildCardDatabase(jsonPathname);
+
+    // The cache is only an optimization. If the json lives somewhere
+    // read only the database is kept in memory instead.
+    try
+    {
+        writeCardDatabase(buffer, pathname);
+    }
+    catch (const std::exception&)
+    {
+    }
+
+    return std::shared_ptr<const CardDatabase>(
+            new CardDatabase(std::move(buffer), pathname));
+}
+
+//===========================================================================//
+std::string CardDatabase::toString(uint32_t offset, uint32_t length) const
+{
+    const Header& header = *reinterpret_cast<const Header*>(mData);
+    if (static_cast<size_t>(offset) + length > header.stringsSize)
+    {
+        throw std::runtime_error("Card database string is out of bounds: " +
+                                 mPathname);
+    }
+    return std::string(reinterpret_cast<const char*>(mData) +
+                               header.stringsOffset + offset,
+                       length);
+}
+
+//===========================================================================//
+Card CardDatabase::getCard(size_t index) const
+{
+    if (index >= mNumCards)
+    {
+        throw std::runtime_error("Card database index is out of range: " +
+                                 core::str::toString(index));
+    }
+
+    const Header& header = *reinterpret_cast<const Header*>(mData);
+    const CardRecord& record = reinterpret_cast<const CardRecord*>(
+            mData + header.cardsOffset)[index];
+    const uint8_t* enums = mData + header.enumsOffset + record.firstEnum;
+    const StringRef* subtypes = reinterpret_cast<const StringRef*>(
+            mData + header.subtypesOffset) + record.firstSubtype;
+
+    Card card;
+    card.name = toString(record.name.offset, record.name.length);
+    card.text = toString(record.text.offset, record.text.length);
+    card.rarity = getRarity(index);
+
+    for (size_t ii = 0; ii < record.numCost; ++ii)
+    {
+        card.cost.push_back(static_cast<Mana>(*enums++));
+    }
+    for (size_t ii = 0; ii < record.numSupertypes; ++ii)
+    {
+        card.supertypes.push_back(static_cast<Supertype>(*enums++));
+    }
+    for (size_t ii = 0; ii < record.numTypes; ++ii)
+    {
+        card.types.push_back(static_cast<Type>(*enums++));
+    }
+    for (size_t ii = 0; ii < record.numSubtypes; ++ii)
+    {
+        card.subtypes.push_back(toString(subtypes[ii].offset,
+                                         subtypes[ii].length));
+    }
+
+    card.power = fromRecordValue(record.power);
+    card.toughness = fromRecordValue(record.toughness);
+    card.loyalty = fromRecordValue(record.loyalty);
+    card.isFlipCard = (mFlags[index] & FLIP_CARD) != 0;
+    card.isBackside = (mFlags[index] & BACKSIDE) != 0;
+    return card;
+}
+
+//===========================================================================//
+bool CardDatabase::find(const std::string& name, size_t& index) const
+{
+    const Header& header = *reinterpret_cast<const Header*>(mData);
+    const CardRecord* cards = reinterpret_cast<const CardRecord*>(
+            mData + header.cardsOffset);
+    const uint32_t* names = reinterpret_cast<const uint32_t*>(
+            mData + header.namesOffset);
+    const char* strings = reinterpret_cast<const char*>(mData) +
+            header.stringsOffset;
+    const size_t mask = header.numNames - 1;
+
+    for (size_t slot = hashName(name.data(), name.size()) & mask, probes = 0;
+         names[slot] != 0 && probes < header.numNames;
+         slot = (slot + 1) & mask, ++probes)
+    {
+        const size_t row = names[slot] - 1;
+        if (row >= mNumCards)
+        {
+            return false;
+        }
+
+        const StringRef& ref = cards[row].name;
+        if (ref.length == name.size() &&
+            static_cast<size_t>(ref.offset) + ref.length <=
+                    header.stringsSize &&
+            std::memcmp(strings + ref.offset, name.data(), name.size()) == 0)
+        {
+            index = row;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+//===========================================================================//
+bool CardDatabase::isBackside(size_t index) const
+{
+    return (mFlags[index] & BACKSIDE) != 0;
+}
+
+//===========================================================================//
+void compileCardDatabase(const std::string& jsonPathname,
+                         const std::string& outPathname)
+{
+    writeCardDatabase(buildCardDatabase(jsonPathname), outPathname);
+}
+}
+}
@@ -21,7 +21,6 @@
  */
 #include <iostream>
 #include <nyra/mtg/Set.h>
-#include <nyra/json/JSON.h>
 #include <nyra/core/Random.h>
 
 namespace nyra
@@ -29,25 +28,147 @@ namespace nyra
 namespace mtg
 {
 //===========================================================================//
-Set::Set(const std::string& jsonPathname)
+Set::Set(const std::string& jsonPathname, Load load)
 {
-    json::JSON tree;
-    core::read(jsonPathname, tree);
+    mDatabases.push_back(CardDatabase::open(jsonPathname));
+    mUnloaded.push_back(mDatabases.back().get());
 
-    const auto& cards = tree["cards"];
-    for (size_t ii = 0; ii < cards.loopSize(); ++ii)
+    if (load == PARSE)
     {
-        Card card(cards[ii]);
+        this->load();
+    }
+}
 
-        if (card.isBackside)
+//===========================================================================//
+void Set::load() const
+{
+    for (const CardDatabase* database : mUnloaded)
+    {
+        for (size_t ii = 0; ii < database->getNumCards(); ++ii)
         {
-            mBacksides.push_back(card);
+            if (database->isBackside(ii))
+            {
+                mBacksides.push_back(database->getCard(ii));
+            }
+            else
+            {
+                mCards.push_back(database->getCard(ii));
+            }
         }
-        else
+    }
+    mUnloaded.clear();
+
+    for (const Entry& entry : mIndexed)
+    {
+        mCards.push_back(entry.first->getCard(entry.second));
+    }
+    mIndexed.clear();
+}
+
+//===========================================================================//
+bool Set::findIndexed(const std::string& name, Entry& entry) const
+{
+    // Each database is only searched once
+    const CardDatabase* searched = nullptr;
+    bool found = false;
+    size_t index = 0;
+    for (const Entry& indexed : mIndexed)
+    {
+        if (indexed.first != searched)
+        {
+            searched = indexed.first;
+            found = searched->find(name, index);
+        }
+
+        if (found && indexed.second == index)
+        {
+            entry = indexed;
+            return true;
+        }
+    }
+    return false;
+}
+
+//===========================================================================//
+bool Set::hasCard(const std::string& name) const
+{
+    size_t index;
+    for (const CardDatabase* database : mUnloaded)
+    {
+        if (database->find(name, index))
+        {
+            return true;
+        }
+    }
+
+    Entry entry;
+    if (findIndexed(name, entry))
+    {
+        return true;
+    }
+
+    for (const Card& card : mCards)
+    {
+        if (card.name == name)
+        {
+            return true;
+        }
+    }
+
+    for (const Card& card : mBacksides)
+    {
+        if (card.name == name)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+//===========================================================================//
+const Card& Set::getCard(const std::string& name) const
+{
+    const auto created = mCreated.find(name);
+    if (created != mCreated.end())
+    {
+        return created->second;
+    }
+
+    size_t index;
+    for (const CardDatabase* database : mUnloaded)
+    {
+        if (database->find(name, index))
+        {
+            return mCreated.insert(std::make_pair(
+                    name, database->getCard(index))).first->second;
+        }
+    }
+
+    Entry entry;
+    if (findIndexed(name, entry))
+    {
+        return mCreated.insert(std::make_pair(
+                name, entry.first->getCard(entry.second))).first->second;
+    }
+
+    for (const Card& card : mCards)
+    {
+        if (card.name == name)
         {
-            mCards.push_back(card);
+            return card;
         }
     }
+
+    for (const Card& card : mBacksides)
+    {
+        if (card.name == name)
+        {
+            return card;
+        }
+    }
+
+    throw std::runtime_error("Could not find card: " + name);
 }
 
 //===========================================================================//
@@ -62,6 +183,18 @@ void Set::addSet(const Set& other)
     {
         mBacksides.push_back(card);
     }
+
+    // Indexed cards stay indexed
+    mDatabases.insert(mDatabases.end(),
+                      other.mDatabases.begin(),
+                      other.mDatabases.end());
+    mUnloaded.insert(mUnloaded.end(),
+                     other.mUnloaded.begin(),
+                     other.mUnloaded.end());
+    mIndexed.insert(mIndexed.end(),
+                    other.mIndexed.begin(),
+                    other.mIndexed.end());
+    mCreated.insert(other.mCreated.begin(), other.mCreated.end());
 }
 
 //===========================================================================//
@@ -79,6 +212,33 @@ Set Set::filterRarity(const std::vector<Rarity>& rarity) const
         }
     }
 
+    // Indexed cards are filtered on the database columns and stay
+    // indexed, so nothing is created until it is used.
+    set.mDatabases = mDatabases;
+    for (const CardDatabase* database : mUnloaded)
+    {
+        for (size_t ii = 0; ii < database->getNumCards(); ++ii)
+        {
+            if (!database->isBackside(ii) &&
+                std::find(rarity.begin(),
+                          rarity.end(),
+                          database->getRarity(ii)) != rarity.end())
+            {
+                set.mIndexed.push_back(Entry(database, ii));
+            }
+        }
+    }
+
+    for (const Entry& entry : mIndexed)
+    {
+        if (std::find(rarity.begin(),
+                      rarity.end(),
+                      entry.first->getRarity(entry.second)) != rarity.end())
+        {
+            set.mIndexed.push_back(entry);
+        }
+    }
+
     return set;
 }
 
@@ -121,6 +281,34 @@ Set Set::filterEDHColor(const std::vector<Mana>& colors) const
         }
     }
 
+    // A card matches when all of its colors are in the requested colors
+    uint8_t allowed = 0;
+    for (const Mana& color : colors)
+    {
+        allowed |= 1 << color;
+    }
+
+    set.mDatabases = mDatabases;
+    for (const CardDatabase* database : mUnloaded)
+    {
+        for (size_t ii = 0; ii < database->getNumCards(); ++ii)
+        {
+            if (!database->isBackside(ii) &&
+                (database->getEDHColors(ii) & ~allowed) == 0)
+            {
+                set.mIndexed.push_back(Entry(database, ii));
+            }
+        }
+    }
+
+    for (const Entry& entry : mIndexed)
+    {
+        if ((entry.first->getEDHColors(entry.second) & ~allowed) == 0)
+        {
+            set.mIndexed.push_back(entry);
+        }
+    }
+
     return set;
 }
 
@@ -160,11 +348,21 @@ Set Set::generateRarity(Rarity rarity, size_t num) const
 
     Set set(filterRarity(rarity));
     Set result;
-    rand.changeBounds(0, set.mCards.size() - 1);
+    rand.changeBounds(0, set.mCards.size() + set.mIndexed.size() - 1);
 
+    // Only the drawn cards are created
     for (size_t ii = 0; ii < num; ++ii)
     {
-        result.mCards.push_back(set.mCards[rand()]);
+        const size_t index = rand();
+        if (index < set.mCards.size())
+        {
+            result.mCards.push_back(set.mCards[index]);
+        }
+        else
+        {
+            const Entry& entry = set.mIndexed[index - set.mCards.size()];
+            result.mCards.push_back(entry.first->getCard(entry.second));
+        }
     }
 
     return result;
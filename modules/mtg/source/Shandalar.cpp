@@ -34,7 +34,8 @@ void Shandalar::newGame(const std::vector<std::string>& sets)
     for (const std::string& set : sets)
     {
         std::cout << "Loading set: " << set << "\n";
-        Set thisSet(core::path::join(core::DATA_PATH, "docs/" + set + ".json"));
+        Set thisSet(core::path::join(core::DATA_PATH, "docs/" + set + ".json"),
+                    Set::INDEX);
         mPool.addSet(thisSet);
     }
 
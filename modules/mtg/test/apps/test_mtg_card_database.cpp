@@ -0,0 +1,143 @@
+/*
+ * Copyright (c) 2018 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#include <cstdio>
+#include <fstream>
+#include <nyra/test/Test.h>
+#include <nyra/mtg/CardDatabase.h>
+#include <nyra/json/LazyDocument.h>
+#include <nyra/core/Path.h>
+
+namespace
+{
+//===========================================================================//
+std::string getBeta()
+{
+    return nyra::core::path::join(nyra::core::DATA_PATH, "docs/mtg_beta.json");
+}
+
+//===========================================================================//
+const std::string PATHNAME = "test_card_database.ncdb";
+}
+
+namespace nyra
+{
+namespace mtg
+{
+//===========================================================================//
+TEST(CardDatabase, Compile)
+{
+    compileCardDatabase(getBeta(), PATHNAME);
+    const CardDatabase database(PATHNAME);
+
+    const json::LazyDocument document(getBeta());
+    const std::vector<json::LazyValue> values = document["cards"].getItems();
+    ASSERT_EQ(values.size(), database.getNumCards());
+
+    for (size_t ii = 0; ii < values.size(); ++ii)
+    {
+        const Card expected(values[ii]);
+        const Card card = database.getCard(ii);
+
+        EXPECT_EQ(expected.name, card.name);
+        EXPECT_EQ(expected.cost, card.cost);
+        EXPECT_EQ(expected.text, card.text);
+        EXPECT_EQ(expected.rarity, card.rarity);
+        EXPECT_EQ(expected.supertypes, card.supertypes);
+        EXPECT_EQ(expected.types, card.types);
+        EXPECT_EQ(expected.subtypes, card.subtypes);
+        EXPECT_EQ(expected.power, card.power);
+        EXPECT_EQ(expected.toughness, card.toughness);
+        EXPECT_EQ(expected.loyalty, card.loyalty);
+        EXPECT_EQ(expected.isFlipCard, card.isFlipCard);
+        EXPECT_EQ(expected.isBackside, card.isBackside);
+
+        EXPECT_EQ(expected.rarity, database.getRarity(ii));
+        EXPECT_EQ(expected.isBackside, database.isBackside(ii));
+
+        uint8_t colors = 0;
+        for (Mana mana : expected.getEDHColors())
+        {
+            colors |= 1 << mana;
+        }
+        EXPECT_EQ(colors, database.getEDHColors(ii));
+
+        size_t index = values.size();
+        EXPECT_TRUE(database.find(expected.name, index));
+        EXPECT_EQ(expected.name, database.getCard(index).name);
+    }
+
+    size_t index = 0;
+    EXPECT_FALSE(database.find("Not a card", index));
+    EXPECT_FALSE(database.find("", index));
+    EXPECT_THROW(database.getCard(values.size()), std::runtime_error);
+
+    // Compiling again moves a new file into place while this one is mapped
+    compileCardDatabase(getBeta(), PATHNAME);
+    EXPECT_FALSE(core::path::exists(PATHNAME + ".tmp"));
+    EXPECT_EQ(Card(values[0]).name, database.getCard(0).name);
+    EXPECT_EQ(values.size(), CardDatabase(PATHNAME).getNumCards());
+
+    std::remove(PATHNAME.c_str());
+}
+
+//===========================================================================//
+TEST(CardDatabase, Invalid)
+{
+    std::ofstream(PATHNAME.c_str()) << "This is not a card database";
+    EXPECT_THROW(CardDatabase database(PATHNAME), std::runtime_error);
+    std::remove(PATHNAME.c_str());
+}
+
+//===========================================================================//
+TEST(CardDatabase, Open)
+{
+    const std::string json = "test_card_database.json";
+    const std::string cache = "test_card_database" + CardDatabase::EXTENSION;
+    {
+        std::ifstream in(getBeta().c_str(), std::ifstream::binary);
+        std::ofstream out(json.c_str(), std::ofstream::binary);
+        out << in.rdbuf();
+    }
+
+    const std::shared_ptr<const CardDatabase> built = CardDatabase::open(json);
+    EXPECT_TRUE(core::path::exists(cache));
+    EXPECT_EQ(cache, built->getPathname());
+
+    const std::shared_ptr<const CardDatabase> cached =
+            CardDatabase::open(json);
+    ASSERT_EQ(built->getNumCards(), cached->getNumCards());
+    for (size_t ii = 0; ii < built->getNumCards(); ++ii)
+    {
+        EXPECT_EQ(built->getCard(ii).name, cached->getCard(ii).name);
+    }
+
+    // A stale cache is rebuilt
+    std::ofstream(cache.c_str()) << "Stale";
+    EXPECT_EQ(built->getNumCards(), CardDatabase::open(json)->getNumCards());
+
+    std::remove(cache.c_str());
+    std::remove(json.c_str());
+}
+}
+}
+
+NYRA_TEST()
@@ -42,6 +42,29 @@ TEST(Set, FromJSON)
     EXPECT_EQ(static_cast<size_t>(302), set.getAllCards().size());
 }
 
+//===========================================================================//
+TEST(Set, Index)
+{
+    const Set beta(getBeta());
+    const Set indexed(nyra::core::path::join(
+            nyra::core::DATA_PATH, "docs/mtg_beta.json"), Set::INDEX);
+
+    EXPECT_TRUE(indexed.hasCard("Black Lotus"));
+    EXPECT_FALSE(indexed.hasCard("Not a card"));
+    EXPECT_EQ("Black Lotus", indexed.getCard("Black Lotus").name);
+    EXPECT_EQ(&indexed.getCard("Black Lotus"),
+              &indexed.getCard("Black Lotus"));
+    EXPECT_THROW(indexed.getCard("Not a card"), std::runtime_error);
+
+    // Everything is created once all the cards are asked for
+    EXPECT_EQ(beta.getAllCards(), indexed.getAllCards());
+
+    Set merged(indexed);
+    merged.addSet(Set(nyra::core::path::join(
+            nyra::core::DATA_PATH, "docs/mtg_beta.json"), Set::INDEX));
+    EXPECT_EQ(static_cast<size_t>(604), merged.getAllCards().size());
+}
+
 //===========================================================================//
 TEST(Card, Archive)
 {
@@ -76,6 +99,33 @@ TEST(Set, Filter)
     EXPECT_EQ(static_cast<size_t>(170), commonUncommon.getAllCards().size());
 }
 
+//===========================================================================//
+TEST(Set, FilterIndex)
+{
+    const Set beta(getBeta());
+    const Set indexed(nyra::core::path::join(
+            nyra::core::DATA_PATH, "docs/mtg_beta.json"), Set::INDEX);
+
+    // Filtered indexed sets still look cards up without creating them all
+    const Set rare(indexed.filterRarity(RARE));
+    EXPECT_TRUE(rare.hasCard("Black Lotus"));
+    EXPECT_FALSE(rare.hasCard("Llanowar Elves"));
+    EXPECT_EQ("Black Lotus", rare.getCard("Black Lotus").name);
+    EXPECT_THROW(rare.getCard("Llanowar Elves"), std::runtime_error);
+    EXPECT_EQ(beta.filterRarity(RARE).getAllCards(), rare.getAllCards());
+
+    // Filters can be chained and merged while the cards are indexed
+    Set redRare(indexed.filterRarity(RARE).filterEDHColor(RED));
+    EXPECT_EQ(beta.filterRarity(RARE).filterEDHColor(RED).getAllCards(),
+              redRare.getAllCards());
+    Set merged(indexed.filterEDHColor({RED, BLUE}));
+    merged.addSet(indexed.filterEDHColor(COLORLESS));
+    EXPECT_EQ(static_cast<size_t>(183), merged.getAllCards().size());
+
+    Set booster = indexed.generateBooster(11, 3, 1, 0);
+    EXPECT_EQ(static_cast<size_t>(15), booster.getAllCards().size());
+}
+
 //===========================================================================//
 TEST(Set, Booster)
 {
@@ -102,10 +102,24 @@ public:
      */
     void setVelocity(const math::Vector2F& velocity);
 
+    /*
+     *  \func setActive
+     *  \brief Adds or removes the body from the simulation
+     *
+     *  \param active True to simulate the body
+     */
+    void setActive(bool active) override;
+
 protected:
     void addShape(const b2Shape& shape);
 
 private:
+    friend class World;
+
+    void pushTransform();
+
+    void pullTransform(const b2Vec2& position, float angle);
+
     World& mWorld;
     const double mDensity;
     const double mFriction;
@@ -22,6 +22,7 @@
 #ifndef __NYRA_PHYSICS_BOX_2D_WORLD_H__
 #define __NYRA_PHYSICS_BOX_2D_WORLD_H__
 
+#include <vector>
 #include <Box2D/Box2D.h>
 #include <nyra/physics/World.h>
 #include <nyra/math/Transform.h>
@@ -32,6 +33,8 @@ namespace physics
 {
 namespace box2d
 {
+class Body;
+class Trigger;
 
 /*
  *  \class World
@@ -96,12 +99,92 @@ public:
         return mWorld;
     }
 
+    /*
+     *  \func setAllowSleeping
+     *  \brief Lets bodies that have come to rest drop out of the solver
+     *         until something touches or moves them. Off by default.
+     *
+     *  \param allow True to let bodies sleep
+     */
+    void setAllowSleeping(bool allow);
+
+    /*
+     *  \func setIterations
+     *  \brief Sets how hard the solver works each step. Defaults to 8 and 3.
+     *
+     *  \param velocityIterations The number of velocity iterations
+     *  \param positionIterations The number of position iterations
+     */
+    void setIterations(int32_t velocityIterations,
+                       int32_t positionIterations);
+
+    /*
+     *  \func setSubSteps
+     *  \brief Splits each fixed step into smaller Box2D steps. This helps
+     *         fast bodies that would otherwise pass through thin shapes.
+     *
+     *  \param subSteps The number of steps per update, at least 1
+     */
+    void setSubSteps(size_t subSteps);
+
+    /*
+     *  \func syncTransforms
+     *  \brief Syncs every body with its transform in one pass. Transforms
+     *         that were moved by hand are pushed into Box2D, then bodies
+     *         the solver moved are copied back. Sleeping and static bodies
+     *         are skipped and transforms are only touched when a value
+     *         changed. Every synced transform ends up clean.
+     */
+    void syncTransforms();
+
 private:
+    /*
+     *  \class ContactListener
+     *  \brief Records trigger contacts while the world is stepping
+     */
+    class ContactListener : public b2ContactListener
+    {
+    public:
+        ContactListener(World& world);
+
+        void BeginContact(b2Contact* contact) override;
+
+        void EndContact(b2Contact* contact) override;
+
+    private:
+        World& mWorld;
+    };
+
+    struct BodySync
+    {
+        Body* body;
+        b2Vec2 position;
+        float angle;
+    };
+
+    struct ContactEvent
+    {
+        Trigger* trigger;
+        Body* body;
+        bool enter;
+    };
+
     void updateImpl(double delta) override;
 
+    void addContact(b2Contact* contact, bool enter);
+
+    void dispatchContacts();
+
+    void sendContact(const ContactEvent& event);
+
     b2World mWorld;
-    const int32_t mVelocityIterations;
-    const int32_t mPositionIterations;
+    int32_t mVelocityIterations;
+    int32_t mPositionIterations;
+    size_t mSubSteps;
+    std::vector<ContactEvent> mContacts;
+    std::vector<Body*> mPushed;
+    std::vector<BodySync> mPulled;
+    ContactListener mContactListener;
 };
 }
 }
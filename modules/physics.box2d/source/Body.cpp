@@ -58,6 +58,7 @@ Body::Body(Type type,
     }
 
     bodyDef.position.Set(0.0f, 0.0f);
+    bodyDef.userData = this;
     mBody = mWorld.getWorld().CreateBody(&bodyDef);
 }
 
@@ -110,19 +111,47 @@ void Body::update()
 {
     if (mTransform.isDirty())
     {
-        mBody->SetTransform(b2Vec2(
-                mTransform.getPosition().x * mWorld.PIXELS_TO_METERS,
-                mTransform.getPosition().y * mWorld.PIXELS_TO_METERS),
-                        math::degreesToRadians(mTransform.getRotation()));
+        pushTransform();
     }
-    else
+    else if (mBody->IsAwake() && mBody->GetType() != b2_staticBody)
     {
-        const auto& pos = mBody->GetPosition();
-        mTransform.setPosition(math::Vector2F(
-                pos.x * mWorld.METERS_TO_PIXELS,
-                pos.y * mWorld.METERS_TO_PIXELS));
-        const double rotation = mBody->GetAngle();
-        mTransform.setRotation(math::radiansToDegrees(rotation));
+        // Bodies the solver did not move are left alone
+        pullTransform(mBody->GetPosition(), mBody->GetAngle());
+    }
+}
+
+//===========================================================================//
+void Body::pushTransform()
+{
+    mBody->SetTransform(b2Vec2(
+            mTransform.getPosition().x * mWorld.PIXELS_TO_METERS,
+            mTransform.getPosition().y * mWorld.PIXELS_TO_METERS),
+                    math::degreesToRadians(mTransform.getRotation()));
+
+    // A sleeping body would not notice it was moved
+    if (mBody->GetType() != b2_staticBody)
+    {
+        mBody->SetAwake(true);
+    }
+}
+
+//===========================================================================//
+void Body::pullTransform(const b2Vec2& position, float angle)
+{
+    // Only touch the transform when something changed. Setting it marks
+    // it dirty and forces the matrix to be rebuilt.
+    const math::Vector2F pixels(position.x * mWorld.METERS_TO_PIXELS,
+                                position.y * mWorld.METERS_TO_PIXELS);
+    if (pixels != mTransform.getPosition())
+    {
+        mTransform.setPosition(pixels);
+    }
+
+    const float rotation =
+            static_cast<float>(math::radiansToDegrees(angle));
+    if (rotation != mTransform.getRotation())
+    {
+        mTransform.setRotation(rotation);
     }
 }
 
@@ -141,6 +170,12 @@ void Body::setVelocity(const math::Vector2F& velocity)
             velocity.x * mWorld.PIXELS_TO_METERS,
             velocity.y * mWorld.PIXELS_TO_METERS));
 }
+
+//===========================================================================//
+void Body::setActive(bool active)
+{
+    mBody->SetActive(active);
+}
 }
 }
 }
@@ -23,94 +23,184 @@
 #include <nyra/physics/box2d/Body.h>
 #include <nyra/physics/box2d/Trigger.h>
 
-namespace
+namespace nyra
 {
-class ContactListener : public b2ContactListener
+namespace physics
 {
-public:
-    void BeginContact(b2Contact* contact)
-    {
-        b2Fixture* fixA = contact->GetFixtureA();
-        b2Fixture* fixB = contact->GetFixtureB();
+namespace box2d
+{
+//===========================================================================//
+World::ContactListener::ContactListener(World& world) :
+    mWorld(world)
+{
+}
+
+//===========================================================================//
+void World::ContactListener::BeginContact(b2Contact* contact)
+{
+    mWorld.addContact(contact, true);
+}
+
+//===========================================================================//
+void World::ContactListener::EndContact(b2Contact* contact)
+{
+    mWorld.addContact(contact, false);
+}
+
+//===========================================================================//
+World::World(double pixelsToMeters,
+             double gravity,
+             double fps) :
+    World2D(pixelsToMeters, fps),
+    mWorld(b2Vec2(0.0f, -gravity * PIXELS_TO_METERS)),
+    mVelocityIterations(8),
+    mPositionIterations(3),
+    mSubSteps(1),
+    mContactListener(*this)
+{
+    mWorld.SetContactListener(&mContactListener);
+    mWorld.SetAllowSleeping(false);
+}
+
+//===========================================================================//
+void World::setAllowSleeping(bool allow)
+{
+    mWorld.SetAllowSleeping(allow);
+}
+
+//===========================================================================//
+void World::setIterations(int32_t velocityIterations,
+                          int32_t positionIterations)
+{
+    mVelocityIterations = velocityIterations;
+    mPositionIterations = positionIterations;
+}
+
+//===========================================================================//
+void World::setSubSteps(size_t subSteps)
+{
+    mSubSteps = subSteps == 0 ? 1 : subSteps;
+}
 
-        if (fixA->IsSensor() && !fixB->IsSensor())
+//===========================================================================//
+void World::syncTransforms()
+{
+    // Sort the bodies first so that a transform shared by a body and a
+    // trigger is not pulled into one and then pushed into the other.
+    mPushed.clear();
+    mPulled.clear();
+    for (b2Body* b2body = mWorld.GetBodyList();
+         b2body;
+         b2body = b2body->GetNext())
+    {
+        Body* body = static_cast<Body*>(b2body->GetUserData());
+        if (body->mTransform.isDirty())
         {
-            sendEnterMessage(fixA->GetUserData(), fixB->GetUserData());
+            mPushed.push_back(body);
         }
-        else if (fixB->IsSensor() && !fixA->IsSensor())
+        else if (b2body->IsAwake() &&
+                 b2body->IsActive() &&
+                 b2body->GetType() != b2_staticBody)
         {
-            sendEnterMessage(fixB->GetUserData(), fixA->GetUserData());
+            BodySync sync;
+            sync.body = body;
+            sync.position = b2body->GetPosition();
+            sync.angle = b2body->GetAngle();
+            mPulled.push_back(sync);
         }
     }
 
-    void EndContact(b2Contact* contact)
+    for (Body* body : mPushed)
     {
-        b2Fixture* fixA = contact->GetFixtureA();
-        b2Fixture* fixB = contact->GetFixtureB();
-
-        if (fixA->IsSensor() && !fixB->IsSensor())
-        {
-            sendExitMessage(fixA->GetUserData(), fixB->GetUserData());
-        }
-        else if (fixB->IsSensor() && !fixA->IsSensor())
-        {
-            sendExitMessage(fixB->GetUserData(), fixA->GetUserData());
-        }
+        body->pushTransform();
     }
 
-private:
-    void sendEnterMessage(void* trigger, void* body)
+    for (const BodySync& sync : mPulled)
     {
-        nyra::physics::box2d::Trigger* triggerPtr =
-                dynamic_cast<nyra::physics::box2d::Trigger*>(
-                reinterpret_cast<nyra::physics::box2d::Body*>(
-                        trigger));
-        nyra::physics::box2d::Body* bodyPtr =
-                reinterpret_cast<nyra::physics::box2d::Body*>(
-                        body);
-        triggerPtr->onEnterMessage(*bodyPtr);
+        sync.body->pullTransform(sync.position, sync.angle);
+        sync.body->mTransform.resetDirty();
     }
 
-    void sendExitMessage(void* trigger, void* body)
+    for (Body* body : mPushed)
     {
-        nyra::physics::box2d::Trigger* triggerPtr =
-                dynamic_cast<nyra::physics::box2d::Trigger*>(
-                reinterpret_cast<nyra::physics::box2d::Body*>(
-                        trigger));
-        nyra::physics::box2d::Body* bodyPtr =
-                reinterpret_cast<nyra::physics::box2d::Body*>(
-                        body);
-        triggerPtr->onExitMessage(*bodyPtr);
+        body->mTransform.resetDirty();
     }
-};
 }
 
-namespace nyra
-{
-namespace physics
+//===========================================================================//
+void World::updateImpl(double delta)
 {
-namespace box2d
+    const float step = static_cast<float>(delta / mSubSteps);
+    for (size_t ii = 0; ii < mSubSteps; ++ii)
+    {
+        mWorld.Step(step,
+                    mVelocityIterations,
+                    mPositionIterations);
+    }
+
+    // Callbacks run once Box2D is done so they are free to touch the world
+    dispatchContacts();
+}
+
+//===========================================================================//
+void World::addContact(b2Contact* contact, bool enter)
 {
+    b2Fixture* fixA = contact->GetFixtureA();
+    b2Fixture* fixB = contact->GetFixtureB();
+
+    ContactEvent event;
+    event.enter = enter;
+    if (fixA->IsSensor() && !fixB->IsSensor())
+    {
+        // Only triggers create sensors so the cast is safe
+        event.trigger = static_cast<Trigger*>(
+                static_cast<Body*>(fixA->GetUserData()));
+        event.body = static_cast<Body*>(fixB->GetUserData());
+    }
+    else if (fixB->IsSensor() && !fixA->IsSensor())
+    {
+        event.trigger = static_cast<Trigger*>(
+                static_cast<Body*>(fixB->GetUserData()));
+        event.body = static_cast<Body*>(fixA->GetUserData());
+    }
+    else
+    {
+        return;
+    }
+
+    // Contacts can also end outside of a step, for example when a body is
+    // destroyed. The body will be gone by the next step so send it now.
+    if (mWorld.IsLocked())
+    {
+        mContacts.push_back(event);
+    }
+    else
+    {
+        sendContact(event);
+    }
+}
+
 //===========================================================================//
-World::World(double pixelsToMeters,
-             double gravity,
-             double fps) :
-    World2D(pixelsToMeters, fps),
-    mWorld(b2Vec2(0.0f, -gravity * PIXELS_TO_METERS)),
-    mVelocityIterations(8),
-    mPositionIterations(3)
+void World::dispatchContacts()
 {
-    static ContactListener contactListener;
-    mWorld.SetContactListener(&contactListener);
-    mWorld.SetAllowSleeping(false);
+    for (size_t ii = 0; ii < mContacts.size(); ++ii)
+    {
+        sendContact(mContacts[ii]);
+    }
+    mContacts.clear();
 }
 
 //===========================================================================//
-void World::updateImpl(double delta)
+void World::sendContact(const ContactEvent& event)
 {
-    mWorld.Step(delta,
-                mVelocityIterations,
-                mPositionIterations);
+    if (event.enter)
+    {
+        event.trigger->onEnterMessage(*event.body);
+    }
+    else
+    {
+        event.trigger->onExitMessage(*event.body);
+    }
 }
 
 //===========================================================================//
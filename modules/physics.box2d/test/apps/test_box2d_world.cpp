@@ -0,0 +1,229 @@
+/*
+ * Copyright (c) 2018 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#include <nyra/test/Test.h>
+#include <nyra/physics/box2d/World.h>
+
+namespace
+{
+nyra::physics::box2d::World* lockedWorld = nullptr;
+size_t numLockedCalls = 0;
+size_t numEnterCalls = 0;
+
+void testOnEnter(nyra::physics::Body2D& )
+{
+    if (lockedWorld->getWorld().IsLocked())
+    {
+        ++numLockedCalls;
+    }
+    ++numEnterCalls;
+}
+
+bool isAwake(nyra::physics::box2d::World& world)
+{
+    for (b2Body* body = world.getWorld().GetBodyList();
+         body;
+         body = body->GetNext())
+    {
+        if (body->GetType() != b2_staticBody && body->IsAwake())
+        {
+            return true;
+        }
+    }
+    return false;
+}
+}
+
+namespace nyra
+{
+namespace physics
+{
+namespace box2d
+{
+TEST(World, Sleeping)
+{
+    World world(64.0, 0.0, 60.0);
+    math::Transform2D transform;
+    std::unique_ptr<Body2D> body = world.createBody(
+            DYNAMIC, 1, transform, 1.0, 0.3);
+    body->addCircle(5.0, math::Vector2F());
+    transform.resetDirty();
+
+    // Sleeping is off by default
+    for (size_t ii = 0; ii < 120; ++ii)
+    {
+        world.update(1.0 / 60.0);
+        body->update();
+        transform.resetDirty();
+    }
+    EXPECT_TRUE(isAwake(world));
+
+    world.setAllowSleeping(true);
+    for (size_t ii = 0; ii < 120; ++ii)
+    {
+        world.update(1.0 / 60.0);
+        body->update();
+        transform.resetDirty();
+    }
+    EXPECT_FALSE(isAwake(world));
+
+    // Moving the transform wakes the body back up
+    transform.setPosition(math::Vector2F(100.0f, 0.0f));
+    body->update();
+    transform.resetDirty();
+    EXPECT_TRUE(isAwake(world));
+
+    world.update(1.0 / 60.0);
+    body->update();
+    transform.resetDirty();
+    EXPECT_NEAR(100.0f, transform.getPosition().x, 0.01);
+
+    // Velocity also wakes it
+    world.setIterations(4, 2);
+    for (size_t ii = 0; ii < 120; ++ii)
+    {
+        world.update(1.0 / 60.0);
+        body->update();
+        transform.resetDirty();
+    }
+    EXPECT_FALSE(isAwake(world));
+    body->setVelocity(math::Vector2F(64.0f, 0.0f));
+    EXPECT_TRUE(isAwake(world));
+    world.update(1.0 / 60.0);
+    body->update();
+    transform.resetDirty();
+    EXPECT_LT(100.0f, transform.getPosition().x);
+}
+
+TEST(World, SubSteps)
+{
+    World world(64.0, 0.0, 60.0);
+    world.setSubSteps(4);
+    math::Transform2D transform;
+    std::unique_ptr<Body2D> body = world.createBody(
+            DYNAMIC, 1, transform, 1.0, 0.3);
+    body->setVelocity(math::Vector2F(5.0f, 3.0f));
+    transform.resetDirty();
+
+    for (size_t ii = 0; ii < 60; ++ii)
+    {
+        world.update(1.0 / 60.0);
+        body->update();
+        transform.resetDirty();
+    }
+
+    EXPECT_NEAR(5.0f, transform.getPosition().x, 0.01);
+    EXPECT_NEAR(3.0f, transform.getPosition().y, 0.01);
+}
+
+TEST(World, SyncTransforms)
+{
+    World world(64.0, 10.0, 60.0);
+    math::Transform2D transform;
+    std::unique_ptr<Body2D> body = world.createBody(
+            DYNAMIC, 1, transform, 1.0, 0.3);
+    body->addCircle(5.0, math::Vector2F());
+
+    math::Transform2D staticTransform;
+    staticTransform.setPosition(math::Vector2F(0.0f, -50.0f));
+    std::unique_ptr<Body2D> staticBody = world.createBody(
+            STATIC, 1, staticTransform, 1.0, 0.3);
+    staticBody->addBox(math::Vector2F(1000.0f, 10.0f), math::Vector2F());
+
+    // Dirty transforms are pushed and everything comes out clean
+    world.syncTransforms();
+    EXPECT_FALSE(transform.isDirty());
+    EXPECT_FALSE(staticTransform.isDirty());
+
+    float prevY = transform.getPosition().y;
+    for (size_t ii = 0; ii < 30; ++ii)
+    {
+        world.update(1.0 / 60.0);
+        world.syncTransforms();
+        EXPECT_LT(transform.getPosition().y, prevY);
+        EXPECT_FALSE(transform.isDirty());
+        EXPECT_EQ(-50.0f, staticTransform.getPosition().y);
+        prevY = transform.getPosition().y;
+    }
+
+    // Moving by hand wins over the simulation
+    transform.setPosition(math::Vector2F(200.0f, 0.0f));
+    world.syncTransforms();
+    EXPECT_FALSE(transform.isDirty());
+    EXPECT_EQ(200.0f, transform.getPosition().x);
+    world.update(1.0 / 60.0);
+    world.syncTransforms();
+    EXPECT_NEAR(200.0f, transform.getPosition().x, 0.01);
+    EXPECT_GT(0.0f, transform.getPosition().y);
+
+    // Once asleep nothing gets written
+    world.setAllowSleeping(true);
+    for (size_t ii = 0; ii < 600; ++ii)
+    {
+        world.update(1.0 / 60.0);
+        world.syncTransforms();
+    }
+    EXPECT_FALSE(isAwake(world));
+    world.update(1.0 / 60.0);
+    world.syncTransforms();
+    EXPECT_FALSE(transform.isDirty());
+}
+
+TEST(World, BufferedContacts)
+{
+    World world(64.0, 0.0, 60.0);
+    lockedWorld = &world;
+
+    math::Transform2D triggerTransform;
+    std::unique_ptr<Trigger2D> trigger = world.createTrigger(
+            STATIC, 1, triggerTransform);
+    trigger->addBox(math::Vector2F(10.0f, 10.0f), math::Vector2F());
+    trigger->onEnter = testOnEnter;
+
+    std::vector<std::unique_ptr<math::Transform2D> > transforms;
+    std::vector<std::unique_ptr<Body2D> > bodies;
+    for (size_t ii = 0; ii < 5; ++ii)
+    {
+        transforms.emplace_back(new math::Transform2D());
+        transforms.back()->setPosition(math::Vector2F(
+                -20.0f - 3.0f * ii, 0.0f));
+        bodies.push_back(world.createBody(
+                DYNAMIC, 1, *transforms.back(), 1.0, 0.3));
+        bodies.back()->addCircle(1.0, math::Vector2F());
+        bodies.back()->update();
+        bodies.back()->setVelocity(math::Vector2F(100.0f, 0.0f));
+        transforms.back()->resetDirty();
+    }
+
+    for (size_t ii = 0; ii < 30; ++ii)
+    {
+        world.update(1.0 / 60.0);
+    }
+
+    // Every body went through and every callback ran after the step
+    EXPECT_EQ(static_cast<size_t>(5), numEnterCalls);
+    EXPECT_EQ(static_cast<size_t>(0), numLockedCalls);
+}
+}
+}
+}
+
+NYRA_TEST()
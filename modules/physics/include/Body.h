@@ -123,6 +123,15 @@ public:
     virtual void setVelocity(
             const typename TransformT::Position& velocity) = 0;
 
+    /*
+     *  \func setActive
+     *  \brief Adds or removes the body from the simulation. An inactive
+     *         body does not move or collide but keeps its shapes.
+     *
+     *  \param active True to simulate the body
+     */
+    virtual void setActive(bool active) = 0;
+
     /*
      *  \func getUserData
      *  \brief Returns some user defined pointer.
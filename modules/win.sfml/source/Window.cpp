@@ -20,6 +20,7 @@
  * IN THE SOFTWARE.
  */
 #include <nyra/win/sfml/Window.h>
+#include <nyra/core/Profiler.h>
 
 namespace nyra
 {
@@ -45,6 +46,7 @@ Window::Window(const std::string& name,
 //===========================================================================//
 void Window::update()
 {
+    NYRA_PROFILE_SCOPE("Window::update");
     sf::Event event;
     while (mWindow->pollEvent(event))
     {
@@ -0,0 +1,270 @@
+/*
+ * Copyright (c) 2018 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#ifndef __NYRA_XML_PARSER_H__
+#define __NYRA_XML_PARSER_H__
+
+#include <deque>
+#include <memory>
+#include <string>
+#include <vector>
+#include <nyra/core/String.h>
+
+namespace nyra
+{
+namespace core
+{
+class MappedFile;
+}
+
+namespace xml
+{
+/*
+ *  \class Span
+ *  \brief A run of characters owned by the parser or the document. Names,
+ *         text and attribute values are handed out as spans so nothing
+ *         needs to be copied unless the caller wants to keep it.
+ */
+typedef core::str::Token Span;
+
+/*
+ *  \class Parser
+ *  \brief A pull parser that walks an XML document one event at a time.
+ *         Nothing is built up in memory, names and text point straight
+ *         into the document unless they contain entities that need to be
+ *         replaced. Spans are only valid until the next call to next().
+ *
+ *         Comments, processing instructions and the doctype are skipped.
+ *         Text that is only whitespace is skipped.
+ */
+class Parser
+{
+public:
+    /*
+     *  \enum Event
+     *  \brief The kinds of things found in a document.
+     */
+    enum Event
+    {
+        START_ELEMENT,
+        END_ELEMENT,
+        TEXT,
+        CDATA,
+        END_DOCUMENT
+    };
+
+    /*
+     *  \func Constructor
+     *  \brief Parses a document held in memory. The memory must outlive
+     *         the parser.
+     *
+     *  \param data The document
+     *  \param size The number of bytes in the document
+     */
+    Parser(const char* data, size_t size);
+
+    /*
+     *  \func Constructor
+     *  \brief Maps a file into memory and parses it.
+     *
+     *  \param pathname The file to parse
+     *  \throw If the file cannot be opened
+     */
+    Parser(const std::string& pathname);
+
+    /*
+     *  \func Destructor
+     *  \brief Unmaps the file if there is one.
+     */
+    ~Parser();
+
+    /*
+     *  \func next
+     *  \brief Moves to the next event. A self closing element produces a
+     *         START_ELEMENT followed by an END_ELEMENT.
+     *
+     *  \return The event
+     *  \throw If the document is not well formed. The message has the
+     *         line and column.
+     */
+    Event next();
+
+    /*
+     *  \func skipElement
+     *  \brief Skips everything up to and including the END_ELEMENT that
+     *         matches the current START_ELEMENT.
+     */
+    void skipElement();
+
+    /*
+     *  \func getEvent
+     *  \brief Gets the current event.
+     *
+     *  \return The event
+     */
+    Event getEvent() const
+    {
+        return mEvent;
+    }
+
+    /*
+     *  \func getName
+     *  \brief Gets the element name for START_ELEMENT and END_ELEMENT.
+     *
+     *  \return The name
+     */
+    const Span& getName() const
+    {
+        return mName;
+    }
+
+    /*
+     *  \func getText
+     *  \brief Gets the text for a TEXT event with entities replaced, or
+     *         the contents of a CDATA section. The whitespace is left
+     *         exactly as it is in the document.
+     *
+     *  \return The text
+     */
+    const Span& getText() const
+    {
+        return mText;
+    }
+
+    /*
+     *  \func getDepth
+     *  \brief Gets the number of open elements. This includes the current
+     *         element for both START_ELEMENT and END_ELEMENT so the two
+     *         have the same depth.
+     *
+     *  \return The depth
+     */
+    size_t getDepth() const
+    {
+        return mStack.size() + (mEvent == END_ELEMENT ? 1 : 0);
+    }
+
+    /*
+     *  \func getNumAttributes
+     *  \brief Gets the number of attributes on the current START_ELEMENT.
+     *
+     *  \return The number of attributes
+     */
+    size_t getNumAttributes() const
+    {
+        return mAttributes.size();
+    }
+
+    /*
+     *  \func getAttributeName
+     *  \brief Gets the name of an attribute.
+     *
+     *  \param index The attribute index
+     *  \return The name
+     */
+    const Span& getAttributeName(size_t index) const
+    {
+        return mAttributes[index].name;
+    }
+
+    /*
+     *  \func getAttributeValue
+     *  \brief Gets the value of an attribute with entities replaced.
+     *
+     *  \param index The attribute index
+     *  \return The value
+     */
+    const Span& getAttributeValue(size_t index) const
+    {
+        return mAttributes[index].value;
+    }
+
+    /*
+     *  \func getAttribute
+     *  \brief Looks up an attribute by name.
+     *
+     *  \param name The attribute name
+     *  \param [OUTPUT] value The value if it was found
+     *  \return true if the attribute exists.
+     */
+    bool getAttribute(const std::string& name, Span& value) const;
+
+private:
+    struct Attribute
+    {
+        Span name;
+        Span value;
+    };
+
+    Parser(const Parser&) = delete;
+    Parser& operator=(const Parser&) = delete;
+
+    void parseStartElement();
+    void parseEndElement();
+    Span parseName();
+    Span decode(const char* begin, const char* end, std::string& scratch);
+    bool startsWith(const char* prefix) const;
+    void skipPast(const char* terminator, const char* message);
+    void skipDoctype();
+    void skipWhitespace();
+    void skipByteOrderMark();
+    void error(const std::string& message) const;
+
+    std::unique_ptr<core::MappedFile> mFile;
+    const char* mBegin;
+    const char* mPos;
+    const char* mEnd;
+    Event mEvent;
+    Span mName;
+    Span mText;
+    bool mSelfClosing;
+    std::vector<Span> mStack;
+    std::vector<Attribute> mAttributes;
+    std::string mTextScratch;
+    std::deque<std::string> mValueScratch;
+    size_t mValuesUsed;
+};
+
+/*
+ *  \func parseList
+ *  \brief Parses whitespace separated numbers, such as the contents of a
+ *         Collada float_array, and appends them to a buffer.
+ *
+ *  \param text The numbers
+ *  \param [OUTPUT] values The buffer to append to
+ *  \throw If any of the values is not a number
+ */
+void parseList(const Span& text, std::vector<float>& values);
+
+/*
+ *  \func parseList
+ *  \brief Parses whitespace separated unsigned integers, such as the
+ *         indices of a Collada primitive, and appends them to a buffer.
+ *
+ *  \param text The numbers
+ *  \param [OUTPUT] values The buffer to append to
+ *  \throw If any of the values is not an unsigned integer
+ */
+void parseList(const Span& text, std::vector<size_t>& values);
+}
+}
+
+#endif
@@ -0,0 +1,657 @@
+/*
+ * Copyright (c) 2018 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <stdexcept>
+#include <nyra/xml/Parser.h>
+#include <nyra/core/MappedFile.h>
+
+namespace
+{
+//===========================================================================//
+bool isWhitespace(char c)
+{
+    return c == ' ' || c == '\n' || c == '\r' || c == '\t';
+}
+
+//===========================================================================//
+void appendUTF8(uint32_t code, std::string& out)
+{
+    if (code < 0x80)
+    {
+        out.push_back(static_cast<char>(code));
+    }
+    else if (code < 0x800)
+    {
+        out.push_back(static_cast<char>(0xC0 | (code >> 6)));
+        out.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+    }
+    else if (code < 0x10000)
+    {
+        out.push_back(static_cast<char>(0xE0 | (code >> 12)));
+        out.push_back(static_cast<char>(0x80 | ((code >> 6) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+    }
+    else
+    {
+        out.push_back(static_cast<char>(0xF0 | (code >> 18)));
+        out.push_back(static_cast<char>(0x80 | ((code >> 12) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | ((code >> 6) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+    }
+}
+
+//===========================================================================//
+bool decodeCharacterReference(const char* begin,
+                              const char* end,
+                              std::string& out)
+{
+    // begin points after "&#" and end at the ';'
+    uint32_t base = 10;
+    if (begin != end && (*begin == 'x' || *begin == 'X'))
+    {
+        base = 16;
+        ++begin;
+    }
+
+    if (begin == end || end - begin > 8)
+    {
+        return false;
+    }
+
+    uint32_t code = 0;
+    for (; begin != end; ++begin)
+    {
+        const char c = *begin;
+        uint32_t digit = 0;
+        if (c >= '0' && c <= '9')
+        {
+            digit = c - '0';
+        }
+        else if (base == 16 && c >= 'a' && c <= 'f')
+        {
+            digit = c - 'a' + 10;
+        }
+        else if (base == 16 && c >= 'A' && c <= 'F')
+        {
+            digit = c - 'A' + 10;
+        }
+        else
+        {
+            return false;
+        }
+        code = code * base + digit;
+    }
+
+    if (code == 0 || code > 0x10FFFF || (code >= 0xD800 && code <= 0xDFFF))
+    {
+        return false;
+    }
+
+    appendUTF8(code, out);
+    return true;
+}
+
+//===========================================================================//
+template <typename FuncT>
+void forEachToken(const nyra::xml::Span& text, FuncT func)
+{
+    const char* pos = text.data;
+    const char* const end = text.data + text.size;
+
+    while (true)
+    {
+        while (pos != end && isWhitespace(*pos))
+        {
+            ++pos;
+        }
+
+        if (pos == end)
+        {
+            return;
+        }
+
+        const char* start = pos;
+        while (pos != end && !isWhitespace(*pos))
+        {
+            ++pos;
+        }
+        func(nyra::xml::Span(start, pos - start));
+    }
+}
+}
+
+namespace nyra
+{
+namespace xml
+{
+//===========================================================================//
+Parser::Parser(const char* data, size_t size) :
+    mBegin(data),
+    mPos(data),
+    mEnd(data + size),
+    mEvent(END_DOCUMENT),
+    mSelfClosing(false),
+    mValuesUsed(0)
+{
+    skipByteOrderMark();
+}
+
+//===========================================================================//
+Parser::Parser(const std::string& pathname) :
+    Parser(nullptr, 0)
+{
+    mFile.reset(new core::MappedFile(pathname));
+    mBegin = reinterpret_cast<const char*>(mFile->getData());
+    mPos = mBegin;
+    mEnd = mBegin + mFile->getSize();
+    skipByteOrderMark();
+}
+
+//===========================================================================//
+Parser::~Parser()
+{
+}
+
+//===========================================================================//
+Parser::Event Parser::next()
+{
+    mAttributes.clear();
+    mValuesUsed = 0;
+
+    if (mSelfClosing)
+    {
+        mSelfClosing = false;
+        mName = mStack.back();
+        mStack.pop_back();
+        return mEvent = END_ELEMENT;
+    }
+
+    while (mPos != mEnd)
+    {
+        if (*mPos != '<')
+        {
+            const char* start = mPos;
+            const char* end = static_cast<const char*>(
+                    std::memchr(mPos, '<', mEnd - mPos));
+            if (end == nullptr)
+            {
+                end = mEnd;
+            }
+
+            const char* pos = start;
+            while (pos != end && isWhitespace(*pos))
+            {
+                ++pos;
+            }
+
+            if (pos == end)
+            {
+                mPos = end;
+                continue;
+            }
+
+            if (mStack.empty())
+            {
+                mPos = pos;
+                error("Text outside of an element");
+            }
+
+            mText = decode(start, end, mTextScratch);
+            mPos = end;
+            return mEvent = TEXT;
+        }
+
+        if (startsWith("<!--"))
+        {
+            skipPast("-->", "Unterminated comment");
+        }
+        else if (startsWith("<![CDATA["))
+        {
+            mPos += 9;
+            const char* start = mPos;
+            skipPast("]]>", "Unterminated CDATA section");
+
+            if (mStack.empty())
+            {
+                mPos = start;
+                error("CDATA outside of an element");
+            }
+
+            if (mPos - start > 3)
+            {
+                mText = Span(start, mPos - start - 3);
+                return mEvent = CDATA;
+            }
+        }
+        else if (startsWith("<!"))
+        {
+            skipDoctype();
+        }
+        else if (startsWith("<?"))
+        {
+            skipPast("?>", "Unterminated processing instruction");
+        }
+        else if (startsWith("</"))
+        {
+            parseEndElement();
+            return mEvent = END_ELEMENT;
+        }
+        else
+        {
+            parseStartElement();
+            return mEvent = START_ELEMENT;
+        }
+    }
+
+    if (!mStack.empty())
+    {
+        error("Unexpected end of document, expected </" +
+              mStack.back().str() + ">");
+    }
+
+    return mEvent = END_DOCUMENT;
+}
+
+//===========================================================================//
+void Parser::skipElement()
+{
+    if (mEvent != START_ELEMENT)
+    {
+        throw std::runtime_error(
+                "XML skipElement can only be called on a start element");
+    }
+
+    const size_t depth = getDepth();
+    while (next() != END_DOCUMENT)
+    {
+        if (mEvent == END_ELEMENT && getDepth() == depth)
+        {
+            return;
+        }
+    }
+}
+
+//===========================================================================//
+bool Parser::getAttribute(const std::string& name, Span& value) const
+{
+    for (const Attribute& attribute : mAttributes)
+    {
+        if (attribute.name == name)
+        {
+            value = attribute.value;
+            return true;
+        }
+    }
+    return false;
+}
+
+//===========================================================================//
+void Parser::parseStartElement()
+{
+    ++mPos;
+    mName = parseName();
+
+    while (true)
+    {
+        skipWhitespace();
+
+        if (mPos == mEnd)
+        {
+            error("Unterminated element <" + mName.str() + ">");
+        }
+
+        if (*mPos == '>')
+        {
+            ++mPos;
+            break;
+        }
+
+        if (*mPos == '/')
+        {
+            if (mEnd - mPos < 2 || mPos[1] != '>')
+            {
+                error("Expected '>'");
+            }
+            mPos += 2;
+            mSelfClosing = true;
+            break;
+        }
+
+        Attribute attribute;
+        attribute.name = parseName();
+        skipWhitespace();
+
+        if (mPos == mEnd || *mPos != '=')
+        {
+            error("Expected '='");
+        }
+        ++mPos;
+        skipWhitespace();
+
+        if (mPos == mEnd || (*mPos != '"' && *mPos != '\''))
+        {
+            error("Expected a quoted attribute value");
+        }
+
+        const char* start = mPos + 1;
+        const char* end = static_cast<const char*>(
+                std::memchr(start, *mPos, mEnd - start));
+        if (end == nullptr)
+        {
+            error("Unterminated attribute value");
+        }
+
+        // Decoded values need their own storage since there can be any
+        // number of them. A deque keeps the earlier ones where they are.
+        if (mValuesUsed == mValueScratch.size())
+        {
+            mValueScratch.push_back(std::string());
+        }
+        attribute.value = decode(start, end, mValueScratch[mValuesUsed++]);
+        mAttributes.push_back(attribute);
+        mPos = end + 1;
+    }
+
+    mStack.push_back(mName);
+}
+
+//===========================================================================//
+void Parser::parseEndElement()
+{
+    const char* start = mPos;
+    mPos += 2;
+    const Span name = parseName();
+    skipWhitespace();
+
+    if (mPos == mEnd || *mPos != '>')
+    {
+        error("Expected '>'");
+    }
+    ++mPos;
+
+    if (mStack.empty())
+    {
+        mPos = start;
+        error("Unexpected closing tag </" + name.str() + ">");
+    }
+
+    const Span& open = mStack.back();
+    if (open.size != name.size ||
+        std::memcmp(open.data, name.data, name.size) != 0)
+    {
+        mPos = start;
+        error("Mismatched closing tag </" + name.str() + ">, expected </" +
+              open.str() + ">");
+    }
+
+    mName = name;
+    mStack.pop_back();
+}
+
+//===========================================================================//
+Span Parser::parseName()
+{
+    const char* start = mPos;
+    while (mPos != mEnd)
+    {
+        const char c = *mPos;
+        if (isWhitespace(c) || c == '/' || c == '>' || c == '=' ||
+            c == '<' || c == '"' || c == '\'')
+        {
+            break;
+        }
+        ++mPos;
+    }
+
+    if (mPos == start)
+    {
+        error("Expected a name");
+    }
+    return Span(start, mPos - start);
+}
+
+//===========================================================================//
+Span Parser::decode(const char* begin, const char* end, std::string& scratch)
+{
+    // Fast path, most text has no entities so it can be handed out
+    // straight from the document.
+    const char* amp = static_cast<const char*>(
+            std::memchr(begin, '&', end - begin));
+    if (amp == nullptr)
+    {
+        return Span(begin, end - begin);
+    }
+
+    scratch.assign(begin, amp);
+    const char* pos = amp;
+    while (pos != end)
+    {
+        if (*pos != '&')
+        {
+            scratch.push_back(*pos++);
+            continue;
+        }
+
+        // Unknown or malformed entities are kept as they are
+        const char* semicolon = static_cast<const char*>(
+                std::memchr(pos, ';', std::min<size_t>(end - pos, 12)));
+        if (semicolon == nullptr)
+        {
+            scratch.push_back(*pos++);
+            continue;
+        }
+
+        const Span entity(pos + 1, semicolon - pos - 1);
+        bool known = true;
+        if (entity == "lt")
+        {
+            scratch.push_back('<');
+        }
+        else if (entity == "gt")
+        {
+            scratch.push_back('>');
+        }
+        else if (entity == "amp")
+        {
+            scratch.push_back('&');
+        }
+        else if (entity == "quot")
+        {
+            scratch.push_back('"');
+        }
+        else if (entity == "apos")
+        {
+            scratch.push_back('\'');
+        }
+        else if (entity.size > 1 && entity.data[0] == '#')
+        {
+            known = decodeCharacterReference(
+                    entity.data + 1, semicolon, scratch);
+        }
+        else
+        {
+            known = false;
+        }
+
+        if (known)
+        {
+            pos = semicolon + 1;
+        }
+        else
+        {
+            scratch.push_back(*pos++);
+        }
+    }
+
+    return Span(scratch.data(), scratch.size());
+}
+
+//===========================================================================//
+bool Parser::startsWith(const char* prefix) const
+{
+    const size_t size = std::strlen(prefix);
+    return static_cast<size_t>(mEnd - mPos) >= size &&
+            std::memcmp(mPos, prefix, size) == 0;
+}
+
+//===========================================================================//
+void Parser::skipPast(const char* terminator, const char* message)
+{
+    const size_t size = std::strlen(terminator);
+    for (const char* pos = mPos; mEnd - pos >= static_cast<ptrdiff_t>(size);
+         ++pos)
+    {
+        if (std::memcmp(pos, terminator, size) == 0)
+        {
+            mPos = pos + size;
+            return;
+        }
+    }
+    error(message);
+}
+
+//===========================================================================//
+void Parser::skipDoctype()
+{
+    // The internal subset can hold '>' so brackets need to be tracked
+    size_t brackets = 0;
+    for (const char* pos = mPos + 2; pos != mEnd; ++pos)
+    {
+        if (*pos == '[')
+        {
+            ++brackets;
+        }
+        else if (*pos == ']' && brackets > 0)
+        {
+            --brackets;
+        }
+        else if (*pos == '>' && brackets == 0)
+        {
+            mPos = pos + 1;
+            return;
+        }
+    }
+    error("Unterminated declaration");
+}
+
+//===========================================================================//
+void Parser::skipWhitespace()
+{
+    while (mPos != mEnd && isWhitespace(*mPos))
+    {
+        ++mPos;
+    }
+}
+
+//===========================================================================//
+void Parser::skipByteOrderMark()
+{
+    if (mEnd - mPos >= 3 &&
+        static_cast<uint8_t>(mPos[0]) == 0xEF &&
+        static_cast<uint8_t>(mPos[1]) == 0xBB &&
+        static_cast<uint8_t>(mPos[2]) == 0xBF)
+    {
+        mPos += 3;
+    }
+}
+
+//===========================================================================//
+void Parser::error(const std::string& message) const
+{
+    // Lines are only counted when something goes wrong
+    size_t line = 1;
+    const char* lineStart = mBegin;
+    for (const char* pos = mBegin; pos < mPos && pos < mEnd; ++pos)
+    {
+        if (*pos == '\n')
+        {
+            ++line;
+            lineStart = pos + 1;
+        }
+    }
+
+    throw std::runtime_error(
+            "XML parse error at line " + std::to_string(line) +
+            " column " + std::to_string(mPos - lineStart + 1) +
+            ": " + message);
+}
+
+//===========================================================================//
+void parseList(const Span& text, std::vector<float>& values)
+{
+    forEachToken(text, [&values](const Span& token)
+    {
+        // strtof needs a terminated string. Number tokens are short so
+        // they are copied to the stack rather than allocated.
+        char buffer[64];
+        if (token.size >= sizeof(buffer))
+        {
+            throw std::runtime_error("Unable to convert number: " +
+                                     token.str());
+        }
+        std::memcpy(buffer, token.data, token.size);
+        buffer[token.size] = '\0';
+
+        char* end = nullptr;
+        const float value = std::strtof(buffer, &end);
+        if (end != buffer + token.size)
+        {
+            throw std::runtime_error("Unable to convert number: " +
+                                     token.str());
+        }
+        values.push_back(value);
+    });
+}
+
+//===========================================================================//
+void parseList(const Span& text, std::vector<size_t>& values)
+{
+    forEachToken(text, [&values](const Span& token)
+    {
+        const size_t max = std::numeric_limits<size_t>::max();
+        size_t value = 0;
+        for (size_t ii = 0; ii < token.size; ++ii)
+        {
+            const char c = token.data[ii];
+            if (c < '0' || c > '9')
+            {
+                throw std::runtime_error("Unable to convert number: " +
+                                         token.str());
+            }
+
+            const size_t digit = c - '0';
+            if (value > (max - digit) / 10)
+            {
+                throw std::runtime_error("Number is out of range: " +
+                                         token.str());
+            }
+            value = value * 10 + digit;
+        }
+        values.push_back(value);
+    });
+}
+}
+}
@@ -21,9 +21,12 @@
  */
 #include <fstream>
 #include <iostream>
+#include <memory>
+#include <stdexcept>
 #include <boost/property_tree/ptree.hpp>
 #include <boost/property_tree/xml_parser.hpp>
 #include <nyra/xml/XML.h>
+#include <nyra/xml/Parser.h>
 
 
 using namespace boost::property_tree;
@@ -31,57 +34,146 @@ using namespace boost::property_tree;
 namespace
 {
 //===========================================================================//
-void readTree(const ptree& boostTree,
-              const std::string& nodeName,
-              nyra::mem::Tree<nyra::xml::Element>& tree)
+// Deep enough for any real document while keeping a malicious one from
+// blowing the stack.
+static const size_t MAX_DEPTH = 512;
+
+//===========================================================================//
+struct Node
+{
+    std::string name;
+    std::unique_ptr<nyra::xml::Element> element;
+    std::vector<Node> children;
+};
+
+//===========================================================================//
+void appendText(const nyra::xml::Span& text, std::string& out)
+{
+    // Each run of text is trimmed and its whitespace is collapsed to single
+    // spaces, the same as trim_whitespace in boost::property_tree.
+    const char* pos = text.data;
+    const char* const end = text.data + text.size;
+    bool first = true;
+
+    while (true)
+    {
+        while (pos != end &&
+               (*pos == ' ' || *pos == '\n' || *pos == '\r' || *pos == '\t'))
+        {
+            ++pos;
+        }
+
+        if (pos == end)
+        {
+            return;
+        }
+
+        const char* start = pos;
+        while (pos != end &&
+               *pos != ' ' && *pos != '\n' && *pos != '\r' && *pos != '\t')
+        {
+            ++pos;
+        }
+
+        if (!first)
+        {
+            out.push_back(' ');
+        }
+        out.append(start, pos);
+        first = false;
+    }
+}
+
+//===========================================================================//
+void readNode(nyra::xml::Parser& parser, Node& node)
 {
-    if (!boostTree.data().empty())
+    if (parser.getDepth() > MAX_DEPTH)
     {
-        tree.get().text = boostTree.data();
+        throw std::runtime_error("XML document is nested too deeply");
     }
 
-    std::unordered_map<std::string, std::vector<ptree::const_iterator> > posMap;
-    for (ptree::const_iterator pos = boostTree.begin(); pos != boostTree.end(); ++pos)
+    node.name = parser.getName().str();
+    node.element.reset(new nyra::xml::Element());
+
+    for (size_t ii = 0; ii < parser.getNumAttributes(); ++ii)
     {
-        // Check if we found attributes
-        if (pos->first == "<xmlattr>")
+        if (parser.getAttributeValue(ii).size > 0)
         {
-            for (ptree::const_iterator attr = pos->second.begin();
-                 attr != pos->second.end();
-                 ++attr)
-            {
-                if (!attr->second.data().empty())
-                {
-                    tree.get().attributes[attr->first] = attr->second.data();
-                }
-            }
+            node.element->attributes[parser.getAttributeName(ii).str()] =
+                    parser.getAttributeValue(ii).str();
         }
-        else
+    }
+
+    while (true)
+    {
+        switch (parser.next())
         {
-            posMap[pos->first].push_back(pos);
+        case nyra::xml::Parser::START_ELEMENT:
+            node.children.push_back(Node());
+            readNode(parser, node.children.back());
+            break;
+        case nyra::xml::Parser::TEXT:
+            appendText(parser.getText(), node.element->text);
+            break;
+        case nyra::xml::Parser::CDATA:
+            node.element->text.append(parser.getText().data,
+                                      parser.getText().size);
+            break;
+        default:
+            return;
         }
     }
+}
 
-    for (auto iter = posMap.begin(); iter != posMap.end(); ++iter)
+//===========================================================================//
+void buildTree(std::vector<Node>& nodes,
+               nyra::mem::Tree<nyra::xml::Element>& tree)
+{
+    // Elements that share a name become a list under that name
+    std::unordered_map<std::string, size_t> counts;
+    if (nodes.size() > 1)
     {
-        tree[iter->first] = new nyra::xml::Element();
-        if (iter->second.size() == 1)
+        for (const Node& node : nodes)
         {
-            readTree(iter->second[0]->second,
-                     iter->first, tree[iter->first]);
+            ++counts[node.name];
+        }
+    }
+
+    std::unordered_map<std::string, size_t> indices;
+    for (Node& node : nodes)
+    {
+        if (nodes.size() == 1 || counts[node.name] == 1)
+        {
+            tree[node.name] = node.element.release();
+            buildTree(node.children, tree[node.name]);
         }
         else
         {
-            for (size_t ii = 0; ii < iter->second.size(); ++ii)
+            size_t& index = indices[node.name];
+            if (index == 0)
             {
-                tree[iter->first][ii] = new nyra::xml::Element();
-                readTree(iter->second[ii]->second,
-                         iter->first, tree[iter->first][ii]);
+                tree[node.name] = new nyra::xml::Element();
             }
+            tree[node.name][index] = node.element.release();
+            buildTree(node.children, tree[node.name][index]);
+            ++index;
         }
     }
 }
 
+//===========================================================================//
+void readTree(nyra::xml::Parser& parser,
+              nyra::mem::Tree<nyra::xml::Element>& tree)
+{
+    std::vector<Node> nodes;
+    while (parser.next() != nyra::xml::Parser::END_DOCUMENT)
+    {
+        nodes.push_back(Node());
+        readNode(parser, nodes.back());
+    }
+    buildTree(nodes, tree);
+}
+
 //===========================================================================//
 void writeTree(const nyra::mem::Tree<nyra::xml::Element>& tree,
                ptree& boostTree)
@@ -135,12 +227,8 @@ namespace xml
 //===========================================================================//
 XML::XML(const std::string& xmlString)
 {
-    std::stringstream ss;
-    ss << xmlString;
-
-    ptree boostTree;
-    read_xml(ss, boostTree, xml_parser::trim_whitespace);
-    readTree(boostTree, "", *this);
+    Parser parser(xmlString.data(), xmlString.size());
+    readTree(parser, *this);
 }
 
 //===========================================================================//
@@ -173,9 +261,8 @@ void read<xml::XML>(const std::string& pathname,
                     xml::XML& tree,
                     core::ArchiveType)
 {
-    ptree boostTree;
-    read_xml(pathname, boostTree, xml_parser::trim_whitespace);
-    readTree(boostTree, "", tree);
+    xml::Parser parser(pathname);
+    readTree(parser, tree);
 }
 }
 }
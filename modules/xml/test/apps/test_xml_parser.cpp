@@ -0,0 +1,217 @@
+/*
+ * Copyright (c) 2018 Clyde Stanfield
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#include <cstdio>
+#include <fstream>
+#include <nyra/test/Test.h>
+#include <nyra/xml/Parser.h>
+
+namespace
+{
+//===========================================================================//
+std::vector<std::string> record(nyra::xml::Parser& parser)
+{
+    std::vector<std::string> events;
+    while (true)
+    {
+        switch (parser.next())
+        {
+        case nyra::xml::Parser::START_ELEMENT:
+            events.push_back("<" + parser.getName().str());
+            for (size_t ii = 0; ii < parser.getNumAttributes(); ++ii)
+            {
+                events.push_back(parser.getAttributeName(ii).str() + "=" +
+                                 parser.getAttributeValue(ii).str());
+            }
+            break;
+        case nyra::xml::Parser::END_ELEMENT:
+            events.push_back("</" + parser.getName().str());
+            break;
+        case nyra::xml::Parser::TEXT:
+            events.push_back("text:" + parser.getText().str());
+            break;
+        case nyra::xml::Parser::CDATA:
+            events.push_back("cdata:" + parser.getText().str());
+            break;
+        case nyra::xml::Parser::END_DOCUMENT:
+            return events;
+        }
+    }
+}
+
+//===========================================================================//
+std::vector<std::string> record(const std::string& document)
+{
+    nyra::xml::Parser parser(document.data(), document.size());
+    return record(parser);
+}
+
+//===========================================================================//
+std::string getError(const std::string& document)
+{
+    try
+    {
+        record(document);
+    }
+    catch (const std::exception& ex)
+    {
+        return ex.what();
+    }
+    return "";
+}
+}
+
+namespace nyra
+{
+namespace xml
+{
+//===========================================================================//
+TEST(Parser, Events)
+{
+    const std::vector<std::string> expected = {
+            "<a", "x=1", "y=two", "text:hello ", "<b", "</b",
+            "text: world", "</a"};
+    EXPECT_EQ(expected, record(
+            "<?xml version=\"1.0\"?>\n"
+            "<!DOCTYPE a [<!ELEMENT a ANY>]>\n"
+            "<!-- comment -->\n"
+            "<a x=\"1\" y='two'>hello <b/> world</a>\n"));
+}
+
+//===========================================================================//
+TEST(Parser, Entities)
+{
+    const std::vector<std::string> expected = {
+            "<a", "v=<&>", "text:\"'\xC3\xA9\xE2\x82\xAC &unknown; & x",
+            "</a"};
+    EXPECT_EQ(expected, record(
+            "<a v='&lt;&amp;&gt;'>&quot;&apos;&#233;&#x20AC; "
+            "&unknown; & x</a>"));
+
+    EXPECT_EQ(std::vector<std::string>({"<a", "cdata:<b>&amp;", "</a"}),
+              record("<a><![CDATA[<b>&amp;]]><![CDATA[]]></a>"));
+}
+
+//===========================================================================//
+TEST(Parser, ZeroCopy)
+{
+    const std::string document = "<a name='value'>text</a>";
+    Parser parser(document.data(), document.size());
+
+    EXPECT_EQ(Parser::START_ELEMENT, parser.next());
+    EXPECT_EQ(document.data() + 1, parser.getName().data);
+    Span value;
+    EXPECT_TRUE(parser.getAttribute("name", value));
+    EXPECT_EQ(document.data() + 9, value.data);
+    EXPECT_FALSE(parser.getAttribute("missing", value));
+
+    EXPECT_EQ(Parser::TEXT, parser.next());
+    EXPECT_EQ(document.data() + 16, parser.getText().data);
+}
+
+//===========================================================================//
+TEST(Parser, Depth)
+{
+    const std::string document = "<a><b><c/></b><d>text</d></a>";
+    Parser parser(document.data(), document.size());
+
+    EXPECT_EQ(Parser::START_ELEMENT, parser.next());
+    EXPECT_EQ(static_cast<size_t>(1), parser.getDepth());
+    EXPECT_EQ(Parser::START_ELEMENT, parser.next());
+    EXPECT_EQ(static_cast<size_t>(2), parser.getDepth());
+
+    parser.skipElement();
+    EXPECT_EQ(Parser::END_ELEMENT, parser.getEvent());
+    EXPECT_EQ("b", parser.getName().str());
+    EXPECT_EQ(static_cast<size_t>(2), parser.getDepth());
+
+    EXPECT_EQ(Parser::START_ELEMENT, parser.next());
+    EXPECT_EQ("d", parser.getName().str());
+    EXPECT_EQ(Parser::TEXT, parser.next());
+    EXPECT_EQ(Parser::END_ELEMENT, parser.next());
+    EXPECT_EQ(Parser::END_ELEMENT, parser.next());
+    EXPECT_EQ(static_cast<size_t>(1), parser.getDepth());
+    EXPECT_EQ(Parser::END_DOCUMENT, parser.next());
+    EXPECT_EQ(Parser::END_DOCUMENT, parser.next());
+}
+
+//===========================================================================//
+TEST(Parser, Errors)
+{
+    EXPECT_EQ("XML parse error at line 2 column 4: Mismatched closing tag "
+              "</b>, expected </a>",
+              getError("<a>\n   </b>"));
+    EXPECT_EQ("XML parse error at line 1 column 4: Unexpected end of "
+              "document, expected </a>",
+              getError("<a>"));
+    EXPECT_EQ("XML parse error at line 1 column 1: Text outside of an "
+              "element",
+              getError("text"));
+    EXPECT_EQ("XML parse error at line 1 column 6: Expected '='",
+              getError("<a b c='1'/>"));
+    EXPECT_EQ("XML parse error at line 1 column 6: "
+              "Unterminated attribute value",
+              getError("<a b='1/>"));
+    EXPECT_EQ("XML parse error at line 1 column 1: Unterminated comment",
+              getError("<!-- <a/>"));
+    EXPECT_FALSE(getError("</a>").empty());
+    EXPECT_FALSE(getError("<>").empty());
+}
+
+//===========================================================================//
+TEST(Parser, File)
+{
+    const std::string pathname = "test_xml_parser.xml";
+    {
+        std::ofstream stream(pathname);
+        stream << "\xEF\xBB\xBF<a>text</a>";
+    }
+
+    std::vector<std::string> events;
+    {
+        Parser parser(pathname);
+        events = record(parser);
+    }
+    std::remove(pathname.c_str());
+
+    EXPECT_EQ(std::vector<std::string>({"<a", "text:text", "</a"}), events);
+    EXPECT_ANY_THROW(Parser("missing_file.xml"));
+}
+
+//===========================================================================//
+TEST(Parser, ParseList)
+{
+    std::vector<float> floats;
+    parseList(Span(" 1 -2.5\n3e2\t", 12), floats);
+    EXPECT_EQ(std::vector<float>({1.0f, -2.5f, 300.0f}), floats);
+    EXPECT_THROW(parseList(Span("1 x", 3), floats), std::runtime_error);
+
+    std::vector<size_t> indices;
+    parseList(Span("0 1\n  20 ", 9), indices);
+    EXPECT_EQ(std::vector<size_t>({0, 1, 20}), indices);
+    EXPECT_THROW(parseList(Span("1 -2", 4), indices), std::runtime_error);
+    EXPECT_THROW(parseList(Span("99999999999999999999999", 23), indices),
+                 std::runtime_error);
+}
+}
+}
+
+NYRA_TEST()